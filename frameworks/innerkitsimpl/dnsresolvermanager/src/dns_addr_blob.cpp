@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_addr_blob.h"
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr size_t IPV4_ADDR_LEN = 4;
+constexpr size_t IPV6_ADDR_LEN = 16;
+constexpr size_t FAMILY_TAG_LEN = 1;
+
+size_t GetAddrLen(uint8_t family)
+{
+    if (family == AF_INET) {
+        return IPV4_ADDR_LEN;
+    }
+    return (family == AF_INET6) ? IPV6_ADDR_LEN : 0;
+}
+} // namespace
+
+bool DnsAddrBlob::Append(int32_t family, const void *addr)
+{
+    size_t addrLen = GetAddrLen(static_cast<uint8_t>(family));
+    if (addrLen == 0 || addr == nullptr || data_.size() + FAMILY_TAG_LEN + addrLen > MAX_BLOB_LEN) {
+        return false;
+    }
+    offsets_.push_back(static_cast<uint32_t>(data_.size()));
+    data_.push_back(static_cast<uint8_t>(family));
+    const uint8_t *bytes = static_cast<const uint8_t *>(addr);
+    data_.insert(data_.end(), bytes, bytes + addrLen);
+    return true;
+}
+
+bool DnsAddrBlob::Append(const INetAddr &addr)
+{
+    uint8_t bytes[IPV6_ADDR_LEN] = {0};
+    if (inet_pton(addr.family_, addr.address_.c_str(), bytes) != 1) {
+        return false;
+    }
+    return Append(addr.family_, bytes);
+}
+
+void DnsAddrBlob::Clear()
+{
+    data_.clear();
+    offsets_.clear();
+}
+
+size_t DnsAddrBlob::Size() const
+{
+    return offsets_.size();
+}
+
+bool DnsAddrBlob::Empty() const
+{
+    return offsets_.empty();
+}
+
+int32_t DnsAddrBlob::GetFamily(size_t index) const
+{
+    return data_[offsets_[index]];
+}
+
+const uint8_t *DnsAddrBlob::GetAddress(size_t index) const
+{
+    return data_.data() + offsets_[index] + FAMILY_TAG_LEN;
+}
+
+bool DnsAddrBlob::Decode(size_t index, INetAddr &addr) const
+{
+    if (index >= offsets_.size()) {
+        return false;
+    }
+    char addrBuf[INET6_ADDRSTRLEN] = {0};
+    int32_t family = GetFamily(index);
+    if (inet_ntop(family, GetAddress(index), addrBuf, sizeof(addrBuf)) == nullptr) {
+        return false;
+    }
+    addr.family_ = static_cast<uint8_t>(family);
+    addr.address_ = addrBuf;
+    return true;
+}
+
+void DnsAddrBlob::DecodeAll(std::vector<INetAddr> &addrInfo) const
+{
+    addrInfo.reserve(addrInfo.size() + offsets_.size());
+    for (size_t i = 0; i < offsets_.size(); i++) {
+        INetAddr addr;
+        if (Decode(i, addr)) {
+            addrInfo.push_back(std::move(addr));
+        }
+    }
+}
+
+bool DnsAddrBlob::Marshalling(Parcel &parcel) const
+{
+    if (!parcel.WriteUint32(static_cast<uint32_t>(data_.size()))) {
+        return false;
+    }
+    return data_.empty() || parcel.WriteBuffer(data_.data(), data_.size());
+}
+
+bool DnsAddrBlob::Unmarshalling(Parcel &parcel, DnsAddrBlob &blob)
+{
+    blob.Clear();
+    uint32_t len = 0;
+    if (!parcel.ReadUint32(len) || len > MAX_BLOB_LEN) {
+        return false;
+    }
+    if (len == 0) {
+        return true;
+    }
+    const uint8_t *buf = parcel.ReadBuffer(len);
+    if (buf == nullptr) {
+        return false;
+    }
+    /* Only the offsets are worked out here, the text form of an address is built when it is decoded */
+    for (size_t pos = 0; pos < len;) {
+        size_t addrLen = GetAddrLen(buf[pos]);
+        if (addrLen == 0 || pos + FAMILY_TAG_LEN + addrLen > len) {
+            NETMGR_LOGE("DnsAddrBlob malformed entry at [%{public}zu]", pos);
+            blob.Clear();
+            return false;
+        }
+        blob.offsets_.push_back(static_cast<uint32_t>(pos));
+        pos += FAMILY_TAG_LEN + addrLen;
+    }
+    blob.data_.assign(buf, buf + len);
+    return true;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -15,10 +15,28 @@
 
 #include "dns_addr_info.h"
 
+#include <algorithm>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
 #include "net_mgr_log_wrapper.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
+namespace {
+constexpr size_t DNS_RECORD_ADDR_LEN = 16;
+constexpr uint32_t DNS_MAX_RECORDS = 1024;
+
+/* One result on the wire, the address stays in network byte order */
+struct DnsAddrInfoRecord {
+    int32_t flags;
+    int32_t family;
+    int32_t sockType;
+    int32_t protocol;
+    uint8_t addr[DNS_RECORD_ADDR_LEN];
+};
+} // namespace
+
 bool DnsAddrInfo::Marshalling(Parcel &parcel) const
 {
     if (!parcel.WriteInt32(flags_)) {
@@ -63,5 +81,61 @@ sptr<DnsAddrInfo> DnsAddrInfo::Unmarshalling(Parcel &parcel)
     }
     return ptr;
 }
+
+bool DnsAddrInfo::MarshallingList(Parcel &parcel, const std::vector<sptr<DnsAddrInfo>> &list)
+{
+    std::vector<DnsAddrInfoRecord> records;
+    records.reserve(list.size());
+    for (const auto &info : list) {
+        if (info == nullptr) {
+            continue;
+        }
+        DnsAddrInfoRecord record = {info->flags_, info->family_, info->sockType_, info->protocol_, {0}};
+        if (!info->addr_.empty() && inet_pton(info->family_, info->addr_.c_str(), record.addr) != 1) {
+            NETMGR_LOGE("DnsAddrInfo address is not numeric");
+            return false;
+        }
+        records.push_back(record);
+    }
+    if (!parcel.WriteUint32(static_cast<uint32_t>(records.size()))) {
+        return false;
+    }
+    return records.empty() || parcel.WriteBuffer(records.data(), records.size() * sizeof(DnsAddrInfoRecord));
+}
+
+bool DnsAddrInfo::UnmarshallingList(Parcel &parcel, std::vector<sptr<DnsAddrInfo>> &list)
+{
+    uint32_t count = 0;
+    if (!parcel.ReadUint32(count) || count > DNS_MAX_RECORDS) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    const uint8_t *buf = parcel.ReadBuffer(count * sizeof(DnsAddrInfoRecord));
+    if (buf == nullptr) {
+        return false;
+    }
+    char addrBuf[INET6_ADDRSTRLEN] = {0};
+    for (uint32_t i = 0; i < count; i++) {
+        DnsAddrInfoRecord record;
+        std::copy_n(buf + i * sizeof(DnsAddrInfoRecord), sizeof(DnsAddrInfoRecord),
+            reinterpret_cast<uint8_t *>(&record));
+        sptr<DnsAddrInfo> info = (std::make_unique<DnsAddrInfo>()).release();
+        if (info == nullptr) {
+            return false;
+        }
+        info->flags_ = record.flags;
+        info->family_ = record.family;
+        info->sockType_ = record.sockType;
+        info->protocol_ = record.protocol;
+        if ((record.family == AF_INET || record.family == AF_INET6) &&
+            inet_ntop(record.family, record.addr, addrBuf, sizeof(addrBuf)) != nullptr) {
+            info->addr_ = addrBuf;
+        }
+        list.push_back(info);
+    }
+    return true;
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_resolver_cache.h"
+
+#include <algorithm>
+
+#include "dns_resolver_constants.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint64_t PERCENT = 100;
+} // namespace
+
+DnsResolverCache::DnsResolverCache(uint32_t capacity, uint32_t shardCount)
+{
+    if (shardCount == 0) {
+        shardCount = 1;
+    }
+    shardCapacity_ = (capacity + shardCount - 1) / shardCount;
+    if (shardCapacity_ == 0) {
+        shardCapacity_ = 1;
+    }
+    for (uint32_t i = 0; i < shardCount; i++) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+DnsResolverCache::Shard &DnsResolverCache::GetShard(const CacheKey &key)
+{
+    return *shards_[CacheKeyHash()(key) % shards_.size()];
+}
+
+bool DnsResolverCache::Get(uint16_t netId, const std::string &hostName, int32_t &result,
+    std::vector<INetAddr> &addrInfo)
+{
+    CacheKey key = {netId, hostName};
+    Shard &shard = GetShard(key);
+    auto now = Clock::now();
+    bool refresh = false;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            misses_++;
+            return false;
+        }
+        CacheEntry &entry = *it->second;
+        bool stale = now >= entry.expireTime;
+        if (stale && now >= entry.staleUntil) {
+            expired_++;
+            misses_++;
+            /* Answers are kept through the stale window in case the lookup that follows fails */
+            if (entry.result != DNS_SUCCESS ||
+                now >= entry.expireTime + std::chrono::milliseconds(staleWindowMs_.load())) {
+                shard.lru.erase(it->second);
+                shard.index.erase(it);
+            }
+            return false;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        result = entry.result;
+        addrInfo.insert(addrInfo.end(), entry.addrInfo.begin(), entry.addrInfo.end());
+        if (entry.result != DNS_SUCCESS) {
+            negativeHits_++;
+        }
+        if (stale) {
+            staleHits_++;
+        } else {
+            refresh = ShouldRefresh(entry, now);
+        }
+        hits_++;
+    }
+    if (refresh) {
+        refresh_(netId, hostName);
+    }
+    return true;
+}
+
+bool DnsResolverCache::GetStale(uint16_t netId, const std::string &hostName, std::vector<INetAddr> &addrInfo)
+{
+    uint32_t staleWindowMs = staleWindowMs_;
+    if (staleWindowMs == 0) {
+        return false;
+    }
+    CacheKey key = {netId, hostName};
+    Shard &shard = GetShard(key);
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end() || it->second->result != DNS_SUCCESS) {
+        return false;
+    }
+    CacheEntry &entry = *it->second;
+    auto staleEnd = entry.expireTime + std::chrono::milliseconds(staleWindowMs);
+    if (now >= staleEnd) {
+        return false;
+    }
+    entry.staleUntil = std::min(now + std::chrono::milliseconds(staleRecheckMs_.load()), staleEnd);
+    addrInfo.insert(addrInfo.end(), entry.addrInfo.begin(), entry.addrInfo.end());
+    staleHits_++;
+    return true;
+}
+
+void DnsResolverCache::Put(uint16_t netId, const std::string &hostName, int32_t result,
+    const std::vector<INetAddr> &addrInfo, uint32_t ttlMs)
+{
+    if (ttlMs == 0) {
+        return;
+    }
+    CacheEntry entry;
+    entry.key = {netId, hostName};
+    entry.result = result;
+    entry.addrInfo = addrInfo;
+    entry.ttlMs = ttlMs;
+    entry.expireTime = Clock::now() + std::chrono::milliseconds(ttlMs);
+    Shard &shard = GetShard(entry.key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(entry.key);
+    if (it != shard.index.end()) {
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+    } else if (shard.lru.size() >= shardCapacity_) {
+        shard.index.erase(shard.lru.back().key);
+        shard.lru.pop_back();
+        evictions_++;
+    }
+    shard.lru.push_front(std::move(entry));
+    shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+}
+
+void DnsResolverCache::SetRefreshFunc(const DnsCacheRefreshFunc &refresh)
+{
+    refresh_ = refresh;
+}
+
+void DnsResolverCache::CancelRefresh(uint16_t netId, const std::string &hostName)
+{
+    CacheKey key = {netId, hostName};
+    Shard &shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        it->second->refreshing = false;
+    }
+}
+
+void DnsResolverCache::SetRefreshPolicy(const DnsCacheRefreshPolicy &policy)
+{
+    prefetchPercent_ = policy.prefetchPercent;
+    prefetchMinHits_ = policy.prefetchMinHits;
+    maxRefreshPerSecond_ = policy.maxRefreshPerSecond;
+    staleWindowMs_ = policy.staleWindowMs;
+    staleRecheckMs_ = policy.staleRecheckMs;
+}
+
+void DnsResolverCache::Invalidate(uint16_t netId)
+{
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (auto it = shard->lru.begin(); it != shard->lru.end();) {
+            if (it->key.netId != netId) {
+                ++it;
+                continue;
+            }
+            shard->index.erase(it->key);
+            it = shard->lru.erase(it);
+            invalidations_++;
+        }
+    }
+}
+
+void DnsResolverCache::Clear()
+{
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        invalidations_ += shard->lru.size();
+        shard->index.clear();
+        shard->lru.clear();
+    }
+}
+
+size_t DnsResolverCache::Size() const
+{
+    size_t size = 0;
+    for (const auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        size += shard->lru.size();
+    }
+    return size;
+}
+
+DnsResolverCacheStats DnsResolverCache::GetStats() const
+{
+    DnsResolverCacheStats stats;
+    stats.hits = hits_;
+    stats.negativeHits = negativeHits_;
+    stats.misses = misses_;
+    stats.expired = expired_;
+    stats.evictions = evictions_;
+    stats.invalidations = invalidations_;
+    stats.prefetches = prefetches_;
+    stats.prefetchesLimited = prefetchesLimited_;
+    stats.staleHits = staleHits_;
+    return stats;
+}
+
+/* Called under the shard lock on a live hit, marks the entry so only one refresh is in flight for it */
+bool DnsResolverCache::ShouldRefresh(CacheEntry &entry, Clock::time_point now)
+{
+    entry.hits++;
+    uint32_t prefetchPercent = prefetchPercent_;
+    if (prefetchPercent == 0 || refresh_ == nullptr || entry.refreshing || entry.result != DNS_SUCCESS ||
+        entry.hits < prefetchMinHits_) {
+        return false;
+    }
+    auto refreshWindow = std::chrono::milliseconds(static_cast<uint64_t>(entry.ttlMs) * prefetchPercent / PERCENT);
+    if (entry.expireTime - now > refreshWindow) {
+        return false;
+    }
+    if (!TakeRefreshSlot(now)) {
+        prefetchesLimited_++;
+        return false;
+    }
+    entry.refreshing = true;
+    prefetches_++;
+    return true;
+}
+
+bool DnsResolverCache::TakeRefreshSlot(Clock::time_point now)
+{
+    uint32_t maxRefreshPerSecond = maxRefreshPerSecond_;
+    if (maxRefreshPerSecond == 0) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(refreshMutex_);
+    if (now - refreshWindowStart_ >= std::chrono::seconds(1)) {
+        refreshWindowStart_ = now;
+        refreshesInWindow_ = 0;
+    }
+    if (refreshesInWindow_ >= maxRefreshPerSecond) {
+        return false;
+    }
+    refreshesInWindow_++;
+    return true;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
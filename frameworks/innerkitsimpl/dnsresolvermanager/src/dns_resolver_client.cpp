@@ -15,25 +15,149 @@
 
 #include "dns_resolver_client.h"
 
+#include <netdb.h>
+
 #include "iservice_registry.h"
 #include "system_ability_definition.h"
 
+#include "dns_resolver_constants.h"
 #include "net_mgr_log_wrapper.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
-DnsResolverClient::DnsResolverClient() : dnsResolverService_(nullptr), deathRecipient_(nullptr) {}
+namespace {
+bool IsNameNotFound(int32_t result)
+{
+#ifdef EAI_NODATA
+    if (result == EAI_NODATA) {
+        return true;
+    }
+#endif
+    return result == EAI_NONAME;
+}
+} // namespace
 
-DnsResolverClient::~DnsResolverClient() {}
+DnsResolverClient::DnsResolverClient() : dnsResolverService_(nullptr), deathRecipient_(nullptr)
+{
+    cache_.SetRefreshFunc([this](uint16_t, const std::string &hostName) { RefreshLookup(hostName); });
+    DnsCacheRefreshPolicy policy;
+    policy.prefetchPercent = DNS_CACHE_PREFETCH_PERCENT;
+    policy.prefetchMinHits = DNS_CACHE_PREFETCH_MIN_HITS;
+    policy.maxRefreshPerSecond = DNS_CACHE_MAX_REFRESH_PER_SECOND;
+    policy.staleWindowMs = DNS_CACHE_STALE_WINDOW_MS;
+    policy.staleRecheckMs = DNS_CACHE_STALE_RECHECK_MS;
+    cache_.SetRefreshPolicy(policy);
+}
+
+DnsResolverClient::~DnsResolverClient()
+{
+    {
+        std::lock_guard<std::mutex> lock(refreshMutex_);
+        refreshStop_ = true;
+    }
+    refreshCond_.notify_all();
+    if (refreshThread_.joinable()) {
+        refreshThread_.join();
+    }
+}
 
 int32_t DnsResolverClient::GetAddressesByName(const std::string &hostName, std::vector<INetAddr> &addrInfo)
+{
+    int32_t result = DNS_SUCCESS;
+    if (cache_.Get(DNS_DEFAULT_NETID, hostName, result, addrInfo)) {
+        return result;
+    }
+    sptr<IDnsResolverService> proxy = GetProxy();
+    if (proxy == nullptr) {
+        NETMGR_LOGE("proxy is nullptr");
+        result = IPC_PROXY_ERR;
+        ServeStale(hostName, result, addrInfo);
+        return result;
+    }
+    std::vector<INetAddr> addrs;
+    result = proxy->GetAddressesByName(hostName, addrs);
+    if (ServeStale(hostName, result, addrInfo)) {
+        return result;
+    }
+    CacheLookup(hostName, result, addrs);
+    addrInfo.insert(addrInfo.end(), addrs.begin(), addrs.end());
+    return result;
+}
+
+int32_t DnsResolverClient::GetAddressesByNamePacked(const std::string &hostName, DnsAddrBlob &addrBlob)
+{
+    sptr<IDnsResolverService> proxy = GetProxy();
+    if (proxy == nullptr) {
+        NETMGR_LOGE("proxy is nullptr");
+        return IPC_PROXY_ERR;
+    }
+    return proxy->GetAddressesByNamePacked(hostName, addrBlob);
+}
+
+int32_t DnsResolverClient::GetAddressesByNames(const std::vector<std::string> &hostNames,
+    std::vector<int32_t> &results, std::vector<std::vector<INetAddr>> &addrInfos)
+{
+    if (hostNames.empty() || hostNames.size() > DNS_MAX_BATCH_NAMES) {
+        NETMGR_LOGE("GetAddressesByNames invalid batch size [%{public}zu]", hostNames.size());
+        return DNS_ERROR;
+    }
+    results.assign(hostNames.size(), DNS_ERROR);
+    addrInfos.assign(hostNames.size(), {});
+    /* Cached names are answered here, only the rest goes to the service and in a single request */
+    std::vector<std::string> missNames;
+    std::vector<size_t> missIndexes;
+    for (size_t i = 0; i < hostNames.size(); i++) {
+        if (!cache_.Get(DNS_DEFAULT_NETID, hostNames[i], results[i], addrInfos[i])) {
+            missNames.push_back(hostNames[i]);
+            missIndexes.push_back(i);
+        }
+    }
+    if (missNames.empty()) {
+        return DNS_SUCCESS;
+    }
+    sptr<IDnsResolverService> proxy = GetProxy();
+    if (proxy == nullptr) {
+        NETMGR_LOGE("proxy is nullptr");
+        return IPC_PROXY_ERR;
+    }
+    std::vector<int32_t> missResults;
+    std::vector<std::vector<INetAddr>> missAddrInfos;
+    int32_t ret = proxy->GetAddressesByNames(missNames, missResults, missAddrInfos);
+    if (ret != DNS_SUCCESS) {
+        return ret;
+    }
+    for (size_t i = 0; i < missIndexes.size(); i++) {
+        size_t index = missIndexes[i];
+        results[index] = missResults[i];
+        if (ServeStale(hostNames[index], results[index], addrInfos[index])) {
+            continue;
+        }
+        addrInfos[index] = std::move(missAddrInfos[i]);
+        CacheLookup(hostNames[index], results[index], addrInfos[index]);
+    }
+    return DNS_SUCCESS;
+}
+
+int32_t DnsResolverClient::GetAddressesByNameAsync(const std::string &hostName,
+    const sptr<IDnsResolverCallback> &callback)
+{
+    sptr<IDnsResolverService> proxy = GetProxy();
+    if (proxy == nullptr) {
+        NETMGR_LOGE("proxy is nullptr");
+        return IPC_PROXY_ERR;
+    }
+    return proxy->GetAddressesByNameAsync(hostName, callback);
+}
+
+int32_t DnsResolverClient::GetAddressesByNameDualStack(const std::string &hostName,
+    const sptr<IDnsResolverCallback> &callback)
 {
     sptr<IDnsResolverService> proxy = GetProxy();
     if (proxy == nullptr) {
         NETMGR_LOGE("proxy is nullptr");
         return IPC_PROXY_ERR;
     }
-    return proxy->GetAddressesByName(hostName, addrInfo);
+    return proxy->GetAddressesByNameDualStack(hostName, callback);
 }
 
 int32_t DnsResolverClient::GetAddrInfo(const std::string &hostName, const std::string &server,
@@ -64,7 +188,9 @@ int32_t DnsResolverClient::DestoryNetworkCache(uint16_t netId)
         NETMGR_LOGE("proxy is nullptr");
         return IPC_PROXY_ERR;
     }
-    return proxy->DestoryNetworkCache(netId);
+    int32_t result = proxy->DestoryNetworkCache(netId);
+    InvalidateCache(netId);
+    return result;
 }
 
 int32_t DnsResolverClient::FlushNetworkCache(uint16_t netId)
@@ -74,7 +200,9 @@ int32_t DnsResolverClient::FlushNetworkCache(uint16_t netId)
         NETMGR_LOGE("proxy is nullptr");
         return IPC_PROXY_ERR;
     }
-    return proxy->FlushNetworkCache(netId);
+    int32_t result = proxy->FlushNetworkCache(netId);
+    InvalidateCache(netId);
+    return result;
 }
 
 int32_t DnsResolverClient::SetResolverConfig(uint16_t netId, uint16_t baseTimeoutMsec, uint8_t retryCount,
@@ -85,7 +213,9 @@ int32_t DnsResolverClient::SetResolverConfig(uint16_t netId, uint16_t baseTimeou
         NETMGR_LOGE("proxy is nullptr");
         return IPC_PROXY_ERR;
     }
-    return proxy->SetResolverConfig(netId, baseTimeoutMsec, retryCount, servers, domains);
+    int32_t result = proxy->SetResolverConfig(netId, baseTimeoutMsec, retryCount, servers, domains);
+    InvalidateCache(netId);
+    return result;
 }
 
 int32_t DnsResolverClient::GetResolverInfo(uint16_t netId, std::vector<std::string> &servers,
@@ -99,6 +229,107 @@ int32_t DnsResolverClient::GetResolverInfo(uint16_t netId, std::vector<std::stri
     return proxy->GetResolverInfo(netId, servers, domains, baseTimeoutMsec, retryCount);
 }
 
+int32_t DnsResolverClient::GetResolverStats(uint16_t netId, std::vector<DnsServerStats> &stats)
+{
+    sptr<IDnsResolverService> proxy = GetProxy();
+    if (proxy == nullptr) {
+        NETMGR_LOGE("proxy is nullptr");
+        return IPC_PROXY_ERR;
+    }
+    return proxy->GetResolverStats(netId, stats);
+}
+
+void DnsResolverClient::SetCacheTtl(uint32_t positiveTtlMs, uint32_t negativeTtlMs)
+{
+    positiveTtlMs_ = positiveTtlMs;
+    negativeTtlMs_ = negativeTtlMs;
+    cache_.Clear();
+}
+
+DnsResolverCacheStats DnsResolverClient::GetCacheStats() const
+{
+    return cache_.GetStats();
+}
+
+void DnsResolverClient::SetCacheRefreshPolicy(const DnsCacheRefreshPolicy &policy)
+{
+    cache_.SetRefreshPolicy(policy);
+}
+
+bool DnsResolverClient::CacheLookup(const std::string &hostName, int32_t result,
+    const std::vector<INetAddr> &addrInfo)
+{
+    /* Only answers are cached, transport and validation errors are retried by the next call */
+    if (result == DNS_SUCCESS) {
+        cache_.Put(DNS_DEFAULT_NETID, hostName, result, addrInfo, positiveTtlMs_);
+    } else if (IsNameNotFound(result)) {
+        cache_.Put(DNS_DEFAULT_NETID, hostName, result, addrInfo, negativeTtlMs_);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void DnsResolverClient::RefreshLookup(const std::string &hostName)
+{
+    /* Called by a lookup that hit the entry, which must not wait for the refresh */
+    std::lock_guard<std::mutex> lock(refreshMutex_);
+    if (refreshStop_) {
+        return;
+    }
+    refreshQueue_.push_back(hostName);
+    if (!refreshThread_.joinable()) {
+        refreshThread_ = std::thread([this]() { RunRefresh(); });
+    }
+    refreshCond_.notify_one();
+}
+
+void DnsResolverClient::RunRefresh()
+{
+    std::unique_lock<std::mutex> lock(refreshMutex_);
+    while (true) {
+        refreshCond_.wait(lock, [this]() { return refreshStop_ || !refreshQueue_.empty(); });
+        if (refreshStop_) {
+            return;
+        }
+        std::string hostName = std::move(refreshQueue_.front());
+        refreshQueue_.pop_front();
+        lock.unlock();
+        /* The same lookup that filled the entry, so hosts, search domains and family handling stay the same */
+        int32_t result = IPC_PROXY_ERR;
+        std::vector<INetAddr> addrs;
+        sptr<IDnsResolverService> proxy = GetProxy();
+        if (proxy != nullptr) {
+            result = proxy->GetAddressesByName(hostName, addrs);
+        }
+        if (!CacheLookup(hostName, result, addrs)) {
+            NETMGR_LOGE("DnsResolverClient refresh of a cached name failed ret[%{public}d]", result);
+            cache_.CancelRefresh(DNS_DEFAULT_NETID, hostName);
+        }
+        lock.lock();
+    }
+}
+
+bool DnsResolverClient::ServeStale(const std::string &hostName, int32_t &result, std::vector<INetAddr> &addrInfo)
+{
+    /* Only an unreachable upstream or service falls back, an answer saying the name is gone is believed */
+    if ((result != EAI_AGAIN && result != IPC_PROXY_ERR) ||
+        !cache_.GetStale(DNS_DEFAULT_NETID, hostName, addrInfo)) {
+        return false;
+    }
+    result = DNS_SUCCESS;
+    return true;
+}
+
+void DnsResolverClient::InvalidateCache(uint16_t netId)
+{
+    /* Lookups without a netId go to the default network, which may be the one being changed */
+    cache_.Invalidate(netId);
+    if (netId != DNS_DEFAULT_NETID) {
+        cache_.Invalidate(DNS_DEFAULT_NETID);
+    }
+}
+
 sptr<IDnsResolverService> DnsResolverClient::GetProxy()
 {
     std::lock_guard lock(mutex_);
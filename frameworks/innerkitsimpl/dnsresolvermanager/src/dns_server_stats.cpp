@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_server_stats.h"
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+uint32_t DnsServerStats::GetBucketUpperMs(uint32_t bucket)
+{
+    return (bucket + 1 < DNS_LATENCY_BUCKETS) ? (1u << bucket) : UINT32_MAX;
+}
+
+bool DnsServerStats::Marshalling(Parcel &parcel) const
+{
+    if (!parcel.WriteString(server_) || !parcel.WriteUint64(queries_) || !parcel.WriteUint64(successes_) ||
+        !parcel.WriteUint64(timeouts_) || !parcel.WriteUint64(nxDomains_) || !parcel.WriteUint64(servFails_) ||
+        !parcel.WriteUint64(errors_)) {
+        return false;
+    }
+    if (!parcel.WriteUint32(static_cast<uint32_t>(latencyBuckets_.size()))) {
+        return false;
+    }
+    for (uint64_t count : latencyBuckets_) {
+        if (!parcel.WriteUint64(count)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+sptr<DnsServerStats> DnsServerStats::Unmarshalling(Parcel &parcel)
+{
+    sptr<DnsServerStats> ptr = (std::make_unique<DnsServerStats>()).release();
+    if (ptr == nullptr) {
+        NETMGR_LOGE("create DnsServerStats failed");
+        return nullptr;
+    }
+    uint32_t bucketCount = 0;
+    if (!parcel.ReadString(ptr->server_) || !parcel.ReadUint64(ptr->queries_) ||
+        !parcel.ReadUint64(ptr->successes_) || !parcel.ReadUint64(ptr->timeouts_) ||
+        !parcel.ReadUint64(ptr->nxDomains_) || !parcel.ReadUint64(ptr->servFails_) ||
+        !parcel.ReadUint64(ptr->errors_) || !parcel.ReadUint32(bucketCount) || bucketCount > DNS_LATENCY_BUCKETS) {
+        return nullptr;
+    }
+    ptr->latencyBuckets_.resize(bucketCount);
+    for (uint32_t i = 0; i < bucketCount; i++) {
+        if (!parcel.ReadUint64(ptr->latencyBuckets_[i])) {
+            return nullptr;
+        }
+    }
+    return ptr;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_resolver_callback_stub.h"
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+bool ReadResult(MessageParcel &data, std::string &hostName, int32_t &result, std::vector<INetAddr> &addrInfo)
+{
+    int32_t size = 0;
+    if (!data.ReadString(hostName) || !data.ReadInt32(result) || !data.ReadInt32(size) || size < 0) {
+        NETMGR_LOGE("Read parcel failed");
+        return false;
+    }
+    for (int32_t i = 0; i < size; ++i) {
+        sptr<INetAddr> addr = INetAddr::Unmarshalling(data);
+        if (addr == nullptr) {
+            NETMGR_LOGE("Unmarshalling address failed");
+            return false;
+        }
+        addrInfo.push_back(*addr);
+    }
+    return true;
+}
+} // namespace
+
+DnsResolverCallbackStub::DnsResolverCallbackStub()
+{
+    memberFuncMap_[DNS_RESOLVED] = &DnsResolverCallbackStub::OnDnsResolved;
+    memberFuncMap_[DNS_PARTIAL_RESOLVED] = &DnsResolverCallbackStub::OnDnsPartialResolved;
+}
+
+DnsResolverCallbackStub::~DnsResolverCallbackStub() {}
+
+int32_t DnsResolverCallbackStub::OnRemoteRequest(
+    uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option)
+{
+    std::u16string myDescripter = DnsResolverCallbackStub::GetDescriptor();
+    std::u16string remoteDescripter = data.ReadInterfaceToken();
+    if (myDescripter != remoteDescripter) {
+        NETMGR_LOGE("Descriptor checked failed");
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    auto itFunc = memberFuncMap_.find(code);
+    if (itFunc != memberFuncMap_.end()) {
+        auto requestFunc = itFunc->second;
+        if (requestFunc != nullptr) {
+            return (this->*requestFunc)(data, reply);
+        }
+    }
+
+    NETMGR_LOGI("Stub default case, need check");
+    return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
+}
+
+int32_t DnsResolverCallbackStub::OnDnsResolved(MessageParcel &data, MessageParcel &reply)
+{
+    std::string hostName;
+    int32_t result = 0;
+    std::vector<INetAddr> addrInfo;
+    if (!ReadResult(data, hostName, result, addrInfo)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+    OnResolved(hostName, result, addrInfo);
+    return ERR_NONE;
+}
+
+int32_t DnsResolverCallbackStub::OnDnsPartialResolved(MessageParcel &data, MessageParcel &reply)
+{
+    std::string hostName;
+    int32_t result = 0;
+    std::vector<INetAddr> addrInfo;
+    if (!ReadResult(data, hostName, result, addrInfo)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+    OnPartialResolved(hostName, addrInfo);
+    return ERR_NONE;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
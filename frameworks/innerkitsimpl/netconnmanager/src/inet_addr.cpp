@@ -15,17 +15,62 @@
 
 #include "inet_addr.h"
 
+#include <arpa/inet.h>
+#include <cstring>
+
 #include "net_mgr_log_wrapper.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
+namespace {
+constexpr size_t HASH_MIX = 0x9e3779b9;
+constexpr size_t HASH_SHIFT_LEFT = 6;
+constexpr size_t HASH_SHIFT_RIGHT = 2;
+constexpr uint32_t TYPE_SHIFT = 16;
+constexpr uint32_t FAMILY_SHIFT = 8;
+
+size_t HashCombine(size_t seed, size_t value)
+{
+    return seed ^ (value + HASH_MIX + (seed << HASH_SHIFT_LEFT) + (seed >> HASH_SHIFT_RIGHT));
+}
+
+bool ParseAddress(const std::string &address, uint8_t &family, std::array<uint8_t, 16> &bytes)
+{
+    bytes.fill(0);
+    if (inet_pton(AF_INET, address.c_str(), bytes.data()) == 1) {
+        family = AF_INET;
+        return true;
+    }
+    if (inet_pton(AF_INET6, address.c_str(), bytes.data()) == 1) {
+        family = AF_INET6;
+        return true;
+    }
+    family = 0;
+    bytes.fill(0);
+    return false;
+}
+
+size_t HashAddress(uint8_t family, const std::array<uint8_t, 16> &bytes)
+{
+    uint64_t high = 0;
+    uint64_t low = 0;
+    memcpy(&high, bytes.data(), sizeof(high));
+    memcpy(&low, bytes.data() + sizeof(high), sizeof(low));
+    return HashCombine(HashCombine(family, std::hash<uint64_t>()(high)), std::hash<uint64_t>()(low));
+}
+} // namespace
+
 bool INetAddr::operator==(const INetAddr &obj) const
 {
     bool out = true;
     out = out && (type_ == obj.type_);
     out = out && (family_ == obj.family_);
     out = out && (prefixlen_ == obj.prefixlen_);
-    out = out && (address_ == obj.address_);
+    if (parsed_ && obj.parsed_) {
+        out = out && (addrFamily_ == obj.addrFamily_) && (addrBytes_ == obj.addrBytes_);
+    } else {
+        out = out && (address_ == obj.address_);
+    }
     out = out && (netMask_ == obj.netMask_);
     out = out && (hostName_ == obj.hostName_);
     return out;
@@ -61,25 +106,63 @@ sptr<INetAddr> INetAddr::Unmarshalling(Parcel &parcel)
         NETMGR_LOGE("create INetAddr failed");
         return nullptr;
     }
-    if (!parcel.ReadUint8(ptr->type_)) {
+    if (!ptr->ReadFromParcel(parcel)) {
         return nullptr;
     }
-    if (!parcel.ReadUint8(ptr->family_)) {
-        return nullptr;
+    return ptr;
+}
+
+bool INetAddr::ReadFromParcel(Parcel &parcel)
+{
+    if (!parcel.ReadUint8(type_)) {
+        return false;
     }
-    if (!parcel.ReadUint8(ptr->prefixlen_)) {
-        return nullptr;
+    if (!parcel.ReadUint8(family_)) {
+        return false;
     }
-    if (!parcel.ReadString(ptr->address_)) {
-        return nullptr;
+    if (!parcel.ReadUint8(prefixlen_)) {
+        return false;
     }
-    if (!parcel.ReadString(ptr->netMask_)) {
-        return nullptr;
+    if (!parcel.ReadString(address_)) {
+        return false;
     }
-    if (!parcel.ReadString(ptr->hostName_)) {
-        return nullptr;
+    if (!parcel.ReadString(netMask_)) {
+        return false;
     }
-    return ptr;
+    if (!parcel.ReadString(hostName_)) {
+        return false;
+    }
+    Parse();
+    return true;
+}
+
+bool INetAddr::Parse()
+{
+    parsed_ = ParseAddress(address_, addrFamily_, addrBytes_);
+    return parsed_;
+}
+
+size_t INetAddr::Hash() const
+{
+    size_t seed = 0;
+    uint8_t family = 0;
+    std::array<uint8_t, 16> bytes;
+    if (parsed_) {
+        seed = HashAddress(addrFamily_, addrBytes_);
+    } else if (ParseAddress(address_, family, bytes)) {
+        seed = HashAddress(family, bytes);
+    } else {
+        seed = std::hash<std::string>()(address_);
+    }
+    seed = HashCombine(seed, (static_cast<uint32_t>(type_) << TYPE_SHIFT) |
+        (static_cast<uint32_t>(family_) << FAMILY_SHIFT) | prefixlen_);
+    if (!netMask_.empty()) {
+        seed = HashCombine(seed, std::hash<std::string>()(netMask_));
+    }
+    if (!hostName_.empty()) {
+        seed = HashCombine(seed, std::hash<std::string>()(hostName_));
+    }
+    return seed;
 }
 
 bool INetAddr::Marshalling(Parcel &parcel, const sptr<INetAddr> &object)
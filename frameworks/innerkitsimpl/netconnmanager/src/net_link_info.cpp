@@ -19,144 +19,149 @@
 
 namespace OHOS {
 namespace NetManagerStandard {
-bool NetLinkInfo::Marshalling(Parcel &parcel) const
+namespace {
+/* Parcel stores every field in 4 byte words, a string as its length word then the bytes, a NUL and padding */
+constexpr size_t PARCEL_WORD = sizeof(int32_t);
+constexpr size_t INET_ADDR_INT_FIELDS = 3;
+
+size_t StringParcelSize(const std::string &str)
 {
-    if (!parcel.WriteString(ifaceName_)) {
-        return false;
-    }
-    if (!parcel.WriteString(domain_)) {
-        return false;
-    }
-    if (!parcel.WriteUint32(netAddrList_.size())) {
-        return false;
-    }
-    for (auto it = netAddrList_.begin(); it != netAddrList_.end(); it++) {
-        if (!it->Marshalling(parcel)) {
-            NETMGR_LOGE("write net address to parcel failed");
-            return false;
-        }
-    }
-    if (!parcel.WriteUint32(dnsList_.size())) {
+    return PARCEL_WORD + ((str.size() + 1 + PARCEL_WORD - 1) & ~(PARCEL_WORD - 1));
+}
+
+size_t AddrParcelSize(const INetAddr &addr)
+{
+    return INET_ADDR_INT_FIELDS * PARCEL_WORD + StringParcelSize(addr.address_) +
+        StringParcelSize(addr.netMask_) + StringParcelSize(addr.hostName_);
+}
+
+template <typename T>
+bool WriteList(Parcel &parcel, const std::list<T> &list)
+{
+    if (!parcel.WriteUint32(list.size())) {
         return false;
     }
-    for (auto it = dnsList_.begin(); it != dnsList_.end(); it++) {
-        if (!it->Marshalling(parcel)) {
-            NETMGR_LOGE("write dns to parcel failed");
+    for (const auto &element : list) {
+        if (!element.Marshalling(parcel)) {
             return false;
         }
     }
-    if (!parcel.WriteUint32(routeList_.size())) {
+    return true;
+}
+
+/* Each element is read in place in a new list node, so no temporary object or string copy is made */
+template <typename T>
+bool ReadList(Parcel &parcel, std::list<T> &list)
+{
+    uint32_t size = 0;
+    if (!parcel.ReadUint32(size)) {
         return false;
     }
-    for (auto it = routeList_.begin(); it != routeList_.end(); it++) {
-        if (!it->Marshalling(parcel)) {
-            NETMGR_LOGE("write route to parcel failed");
+    list.clear();
+    for (uint32_t i = 0; i < size; i++) {
+        list.emplace_back();
+        if (!list.back().ReadFromParcel(parcel)) {
+            list.pop_back();
             return false;
         }
     }
-    if (!parcel.WriteUint16(mtu_)) {
-        return false;
-    }
     return true;
 }
+} // namespace
 
-sptr<NetLinkInfo> NetLinkInfo::Unmarshalling(Parcel &parcel)
+size_t NetLinkInfo::GetMarshalledSize() const
 {
-    sptr<NetLinkInfo> ptr = (std::make_unique<NetLinkInfo>()).release();
-    if (ptr == nullptr) {
-        return nullptr;
+    constexpr size_t listCount = 3;
+    constexpr size_t mtuWords = 1;
+    size_t size = StringParcelSize(ifaceName_) + StringParcelSize(domain_) + (listCount + mtuWords) * PARCEL_WORD;
+    for (const auto &addr : netAddrList_) {
+        size += AddrParcelSize(addr);
     }
-    if (!parcel.ReadString(ptr->ifaceName_)) {
-        return nullptr;
+    for (const auto &dns : dnsList_) {
+        size += AddrParcelSize(dns);
     }
-    if (!parcel.ReadString(ptr->domain_)) {
-        return nullptr;
+    for (const auto &route : routeList_) {
+        size += StringParcelSize(route.iface_) + AddrParcelSize(route.destination_) + AddrParcelSize(route.gateway_);
     }
-    uint32_t size = 0;
-    if (!parcel.ReadUint32(size)) {
-        return nullptr;
+    return size;
+}
+
+bool NetLinkInfo::Marshalling(Parcel &parcel) const
+{
+    /* Grow the parcel once instead of once per doubling while the lists are written */
+    size_t needed = parcel.GetDataSize() + GetMarshalledSize();
+    if (needed > parcel.GetDataCapacity() && !parcel.SetDataCapacity(needed)) {
+        NETMGR_LOGI("reserve %{public}zu bytes in parcel failed, growing on demand", needed);
     }
-    sptr<INetAddr> netAddr;
-    for (uint32_t i = 0; i < size; i++) {
-        netAddr = INetAddr::Unmarshalling(parcel);
-        if (netAddr == nullptr) {
-            NETMGR_LOGE("INetAddr::Unmarshalling(parcel) is null");
-            return nullptr;
-        }
-        ptr->netAddrList_.push_back(*netAddr);
+    if (!parcel.WriteString(ifaceName_)) {
+        return false;
     }
-    if (!parcel.ReadUint32(size)) {
-        return nullptr;
+    if (!parcel.WriteString(domain_)) {
+        return false;
     }
-    for (uint32_t i = 0; i < size; i++) {
-        netAddr = INetAddr::Unmarshalling(parcel);
-        if (netAddr == nullptr) {
-            NETMGR_LOGE("INetAddr::Unmarshalling(parcel) is null");
-            return nullptr;
-        }
-        ptr->dnsList_.push_back(*netAddr);
+    if (!WriteList(parcel, netAddrList_)) {
+        NETMGR_LOGE("write net address to parcel failed");
+        return false;
     }
-    if (!parcel.ReadUint32(size)) {
-        return nullptr;
+    if (!WriteList(parcel, dnsList_)) {
+        NETMGR_LOGE("write dns to parcel failed");
+        return false;
     }
-    sptr<Route> route;
-    for (uint32_t i = 0; i < size; i++) {
-        route = Route::Unmarshalling(parcel);
-        if (route == nullptr) {
-            NETMGR_LOGE("Route::Unmarshalling(parcel) is null");
-            return nullptr;
-        }
-        ptr->routeList_.push_back(*route);
+    if (!WriteList(parcel, routeList_)) {
+        NETMGR_LOGE("write route to parcel failed");
+        return false;
     }
-    if (!parcel.ReadUint16(ptr->mtu_)) {
-        return nullptr;
+    if (!parcel.WriteUint16(mtu_)) {
+        return false;
     }
-    return ptr;
+    return true;
 }
 
-bool NetLinkInfo::Marshalling(Parcel &parcel, const sptr<NetLinkInfo> &object)
+bool NetLinkInfo::ReadFromParcel(Parcel &parcel)
 {
-    if (object == nullptr) {
-        NETMGR_LOGE("NetLinkInfo object ptr is nullptr");
+    if (!parcel.ReadString(ifaceName_)) {
         return false;
     }
-    if (!parcel.WriteString(object->ifaceName_)) {
+    if (!parcel.ReadString(domain_)) {
         return false;
     }
-    if (!parcel.WriteString(object->domain_)) {
+    if (!ReadList(parcel, netAddrList_)) {
+        NETMGR_LOGE("read net address from parcel failed");
         return false;
     }
-    if (!parcel.WriteUint32(object->netAddrList_.size())) {
+    if (!ReadList(parcel, dnsList_)) {
+        NETMGR_LOGE("read dns from parcel failed");
         return false;
     }
-    for (auto it = object->netAddrList_.begin(); it != object->netAddrList_.end(); it++) {
-        if (!it->Marshalling(parcel)) {
-            NETMGR_LOGE("write objects net address to parcel failed");
-            return false;
-        }
-    }
-    if (!parcel.WriteUint32(object->dnsList_.size())) {
+    if (!ReadList(parcel, routeList_)) {
+        NETMGR_LOGE("read route from parcel failed");
         return false;
     }
-    for (auto it = object->dnsList_.begin(); it != object->dnsList_.end(); it++) {
-        if (!it->Marshalling(parcel)) {
-            NETMGR_LOGE("write objects dns to parcel failed");
-            return false;
-        }
-    }
-    if (!parcel.WriteUint32(object->routeList_.size())) {
+    if (!parcel.ReadUint16(mtu_)) {
         return false;
     }
-    for (auto it = object->routeList_.begin(); it != object->routeList_.end(); it++) {
-        if (!it->Marshalling(parcel)) {
-            NETMGR_LOGE("write objects route to parcel failed");
-            return false;
-        }
+    return true;
+}
+
+sptr<NetLinkInfo> NetLinkInfo::Unmarshalling(Parcel &parcel)
+{
+    sptr<NetLinkInfo> ptr = (std::make_unique<NetLinkInfo>()).release();
+    if (ptr == nullptr) {
+        return nullptr;
+    }
+    if (!ptr->ReadFromParcel(parcel)) {
+        return nullptr;
     }
-    if (!parcel.WriteUint16(object->mtu_)) {
+    return ptr;
+}
+
+bool NetLinkInfo::Marshalling(Parcel &parcel, const sptr<NetLinkInfo> &object)
+{
+    if (object == nullptr) {
+        NETMGR_LOGE("NetLinkInfo object ptr is nullptr");
         return false;
     }
-    return true;
+    return object->Marshalling(parcel);
 }
 
 std::string NetLinkInfo::ToString(const std::string &tab) const
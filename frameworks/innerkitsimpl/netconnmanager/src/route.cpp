@@ -19,8 +19,22 @@
 
 namespace OHOS {
 namespace NetManagerStandard {
+namespace {
+constexpr size_t HASH_MIX = 0x9e3779b9;
+constexpr size_t HASH_SHIFT_LEFT = 6;
+constexpr size_t HASH_SHIFT_RIGHT = 2;
+
+size_t HashCombine(size_t seed, size_t value)
+{
+    return seed ^ (value + HASH_MIX + (seed << HASH_SHIFT_LEFT) + (seed >> HASH_SHIFT_RIGHT));
+}
+} // namespace
+
 bool Route::operator==(const Route &obj) const
 {
+    if (parsed_ && obj.parsed_ && hash_ != obj.hash_) {
+        return false;
+    }
     bool out = true;
     out = out && (iface_ == obj.iface_);
     out = out && (destination_ == obj.destination_);
@@ -51,22 +65,49 @@ sptr<Route> Route::Unmarshalling(Parcel &parcel)
         NETMGR_LOGE("make_unique<Route>() failed");
         return nullptr;
     }
-    if (!parcel.ReadString(ptr->iface_)) {
+    if (!ptr->ReadFromParcel(parcel)) {
         return nullptr;
     }
-    sptr<INetAddr> destination = INetAddr::Unmarshalling(parcel);
-    if (destination == nullptr) {
+    return ptr;
+}
+
+bool Route::ReadFromParcel(Parcel &parcel)
+{
+    parsed_ = false;
+    if (!parcel.ReadString(iface_)) {
+        return false;
+    }
+    if (!destination_.ReadFromParcel(parcel)) {
         NETMGR_LOGE("read destination from parcel failed");
-        return nullptr;
+        return false;
     }
-    ptr->destination_ = *destination;
-    sptr<INetAddr> gateway = INetAddr::Unmarshalling(parcel);
-    if (gateway == nullptr) {
+    if (!gateway_.ReadFromParcel(parcel)) {
         NETMGR_LOGE("read gateway from parcel failed");
-        return nullptr;
+        return false;
     }
-    ptr->gateway_ = *gateway;
-    return ptr;
+    /* Both addresses were parsed as they were read */
+    hash_ = Hash();
+    parsed_ = true;
+    return true;
+}
+
+void Route::Parse()
+{
+    destination_.Parse();
+    gateway_.Parse();
+    parsed_ = false;
+    hash_ = Hash();
+    parsed_ = true;
+}
+
+size_t Route::Hash() const
+{
+    if (parsed_) {
+        return hash_;
+    }
+    size_t seed = std::hash<std::string>()(iface_);
+    seed = HashCombine(seed, destination_.Hash());
+    return HashCombine(seed, gateway_.Hash());
 }
 
 bool Route::Marshalling(Parcel &parcel, const sptr<Route> &object)
@@ -35,6 +35,16 @@ NetPolicyResultCode NetPolicyClient::SetUidPolicy(uint32_t uid, NetUidPolicy pol
     return proxy->SetUidPolicy(uid, policy);
 }
 
+NetPolicyResultCode NetPolicyClient::SetUidPolicies(const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies)
+{
+    sptr<INetPolicyService> proxy = GetProxy();
+    if (proxy == nullptr) {
+        NETMGR_LOGE("proxy is nullptr");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+    return proxy->SetUidPolicies(uidPolicies);
+}
+
 NetUidPolicy NetPolicyClient::GetUidPolicy(uint32_t uid)
 {
     sptr<INetPolicyService> proxy = GetProxy();
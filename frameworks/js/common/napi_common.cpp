@@ -15,6 +15,8 @@
 
 #include "napi_common.h"
 
+#include <cstdint>
+
 namespace OHOS {
 namespace NetManagerStandard {
 napi_value NapiCommon::CreateCodeMessage(napi_env env, const std::string &msg, int32_t code)
@@ -62,6 +64,30 @@ void NapiCommon::GetPropertyInt32(napi_env env, napi_value object, const std::st
     NAPI_CALL_RETURN_VOID(env, napi_get_value_int32(env, value, &property));
 }
 
+bool NapiCommon::GetPropertyUint32(
+    napi_env env, napi_value object, const std::string &propertyName, uint32_t &property)
+{
+    bool hasProperty = false;
+    NAPI_CALL_BASE(env, napi_has_named_property(env, object, propertyName.c_str(), &hasProperty), false);
+    if (!hasProperty) {
+        return false;
+    }
+    napi_value value = nullptr;
+    napi_valuetype valueType = napi_undefined;
+    NAPI_CALL_BASE(env, napi_get_named_property(env, object, propertyName.c_str(), &value), false);
+    NAPI_CALL_BASE(env, napi_typeof(env, value, &valueType), false);
+    if (valueType != napi_number) {
+        return false;
+    }
+    int64_t number = 0;
+    NAPI_CALL_BASE(env, napi_get_value_int64(env, value, &number), false);
+    if (number < 0 || number > UINT32_MAX) {
+        return false;
+    }
+    property = static_cast<uint32_t>(number);
+    return true;
+}
+
 napi_value NapiCommon::NapiValueByInt32(napi_env env, int32_t property)
 {
     napi_value value = nullptr;
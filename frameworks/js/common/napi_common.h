@@ -63,6 +63,18 @@ public:
     static void GetPropertyString(napi_env env, napi_value object, const std::string &propertyName,
         std::string &property);
     static void GetPropertyInt32(napi_env env, napi_value object, const std::string &propertyName, int32_t &property);
+
+    /**
+     * @brief Read a required uint32 property, unlike GetPropertyInt32 a missing or malformed one is reported
+     *
+     * @param env The napi environment
+     * @param object The object holding the property
+     * @param propertyName The property name
+     * @param property Set to the value on success
+     * @return Returns false if the property is missing, not a number or out of the uint32 range
+     */
+    static bool GetPropertyUint32(napi_env env, napi_value object, const std::string &propertyName,
+        uint32_t &property);
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -36,6 +36,18 @@ struct DnsResolverAsyncContext {
     std::vector<std::string> hostAddress;
 };
 
+// batch dns resolver async context
+struct DnsResolverBatchAsyncContext {
+    napi_async_work work = nullptr;
+    napi_deferred deferred = nullptr;
+    napi_ref callbackRef = nullptr;
+    // Data context
+    std::vector<std::string> hosts;
+    int32_t result = 0;
+    std::vector<int32_t> hostResults;
+    std::vector<std::vector<std::string>> hostAddresses;
+};
+
 class NapiDnsResolver {
 public:
     NapiDnsResolver();
@@ -46,6 +58,9 @@ public:
     static void CompleteDnsResolverCallback(napi_env env, napi_status status, void *data);
     // declare napi interface for JS
     static napi_value GetAddressesByName(napi_env env, napi_callback_info info);
+    static void ExecDnsResolverBatchCallback(napi_env env, void *data);
+    static void CompleteDnsResolverBatchCallback(napi_env env, napi_status status, void *data);
+    static napi_value GetAddressesByNames(napi_env env, napi_callback_info info);
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
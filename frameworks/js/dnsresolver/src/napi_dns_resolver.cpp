@@ -126,10 +126,131 @@ napi_value NapiDnsResolver::GetAddressesByName(napi_env env, napi_callback_info
     return result;
 }
 
+void NapiDnsResolver::ExecDnsResolverBatchCallback(napi_env env, void *data)
+{
+    DnsResolverBatchAsyncContext *context = static_cast<DnsResolverBatchAsyncContext *>(data);
+    if (context == nullptr) {
+        NETMGR_LOGE("context == nullptr");
+        return;
+    }
+    std::vector<std::vector<INetAddr>> addrInfos;
+    context->result = DelayedSingleton<DnsResolverClient>::GetInstance()->GetAddressesByNames(context->hosts,
+        context->hostResults, addrInfos);
+    NETMGR_LOGI("ExecDnsResolverBatchCallback, hosts.size = [%{public}zu], result = [%{public}d]",
+        context->hosts.size(), context->result);
+    context->hostAddresses.resize(addrInfos.size());
+    std::string tap;
+    for (size_t i = 0; i < addrInfos.size(); i++) {
+        for (auto &addr : addrInfos[i]) {
+            context->hostAddresses[i].push_back(addr.ToString(tap));
+        }
+    }
+}
+
+void NapiDnsResolver::CompleteDnsResolverBatchCallback(napi_env env, napi_status status, void *data)
+{
+    NETMGR_LOGI("CompleteDnsResolverBatchCallback");
+    DnsResolverBatchAsyncContext *context = static_cast<DnsResolverBatchAsyncContext *>(data);
+    if (context == nullptr) {
+        NETMGR_LOGE("context == nullptr");
+        return;
+    }
+    // one {result, addresses} object per host, in the order of the hosts
+    napi_value infoArray = nullptr;
+    napi_value info = nullptr;
+    napi_create_string_utf8(env, "fail", NAPI_AUTO_LENGTH, &info);
+    napi_create_array_with_length(env, context->hostAddresses.size(), &infoArray);
+    for (size_t index = 0; index < context->hostAddresses.size(); index++) {
+        napi_value hostInfo = nullptr;
+        napi_create_object(env, &hostInfo);
+        int32_t hostResult = (index < context->hostResults.size()) ? context->hostResults[index] : context->result;
+        NapiCommon::SetPropertyInt32(env, hostInfo, "result", hostResult);
+        napi_value addrArray = nullptr;
+        napi_create_array_with_length(env, context->hostAddresses[index].size(), &addrArray);
+        for (size_t i = 0; i < context->hostAddresses[index].size(); i++) {
+            napi_value addr = nullptr;
+            napi_create_string_utf8(env, context->hostAddresses[index][i].c_str(), NAPI_AUTO_LENGTH, &addr);
+            napi_set_element(env, addrArray, i, addr);
+        }
+        napi_set_named_property(env, hostInfo, "addresses", addrArray);
+        napi_set_element(env, infoArray, index, hostInfo);
+    }
+    bool success = context->result == 0;
+    if (context->callbackRef == nullptr) {
+        if (success) {
+            NAPI_CALL_RETURN_VOID(env, napi_resolve_deferred(env, context->deferred, infoArray));
+        } else {
+            NAPI_CALL_RETURN_VOID(env, napi_reject_deferred(env, context->deferred, info));
+        }
+    } else {
+        napi_value callbackValues[static_cast<int32_t>(JS_CALLBACK_ARGV::CALLBACK_ARGV_CNT)] = {nullptr, nullptr};
+        napi_value recv = nullptr;
+        napi_value result = nullptr;
+        napi_value callbackFunc = nullptr;
+        napi_get_undefined(env, &recv);
+        napi_get_reference_value(env, context->callbackRef, &callbackFunc);
+        if (success) {
+            callbackValues[static_cast<int32_t>(JS_CALLBACK_ARGV::CALLBACK_ARGV_INDEX_1)] = infoArray;
+        } else {
+            callbackValues[static_cast<int32_t>(JS_CALLBACK_ARGV::CALLBACK_ARGV_INDEX_0)] = info;
+        }
+        napi_call_function(env, recv, callbackFunc, std::size(callbackValues), callbackValues, &result);
+        napi_delete_reference(env, context->callbackRef);
+    }
+    napi_delete_async_work(env, context->work);
+    delete context;
+    context = nullptr;
+}
+
+napi_value NapiDnsResolver::GetAddressesByNames(napi_env env, napi_callback_info info)
+{
+    NETMGR_LOGI("NapiDnsResolver GetAddressesByNames");
+    size_t argc = static_cast<size_t>(JS_ARGV_NUM::ARGV_NUM_2);
+    napi_value argv[] = {nullptr, nullptr};
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    bool isArray = false;
+    napi_value hostArray = argv[static_cast<int32_t>(JS_ARGV_INDEX::ARGV_INDEX_0)];
+    NAPI_CALL(env, napi_is_array(env, hostArray, &isArray));
+    NAPI_ASSERT(env, isArray, "GetAddressesByNames expects an array of host names");
+    uint32_t length = 0;
+    NAPI_CALL(env, napi_get_array_length(env, hostArray, &length));
+    auto context = std::make_unique<DnsResolverBatchAsyncContext>();
+    char host[HOST_MAX_BYTES] = {0};
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value element = nullptr;
+        size_t hostRealBytes = 0;
+        NAPI_CALL(env, napi_get_element(env, hostArray, i, &element));
+        NAPI_CALL(env, napi_get_value_string_utf8(env, element, host, HOST_MAX_BYTES, &hostRealBytes));
+        context->hosts.emplace_back(host, hostRealBytes);
+    }
+    napi_value result = nullptr;
+    if (argc == static_cast<size_t>(JS_ARGV_NUM::ARGV_NUM_2)) {
+        NAPI_CALL(env, napi_create_reference(env, argv[static_cast<int32_t>(JS_ARGV_INDEX::ARGV_INDEX_1)],
+            CALLBACK_REF_CNT, &context->callbackRef));
+        NAPI_CALL(env, napi_get_undefined(env, &result));
+    } else {
+        NAPI_CALL(env, napi_create_promise(env, &context->deferred, &result));
+    }
+    // creat async work
+    napi_value resource = nullptr;
+    napi_value resourceName = nullptr;
+    NAPI_CALL(env, napi_get_undefined(env, &resource));
+    NAPI_CALL(env, napi_create_string_utf8(env, "GetAddressesByNames", NAPI_AUTO_LENGTH, &resourceName));
+    DnsResolverBatchAsyncContext *asyncContext = context.release();
+    NAPI_CALL(env, napi_create_async_work(env, resource, resourceName,
+        ExecDnsResolverBatchCallback,
+        CompleteDnsResolverBatchCallback,
+        static_cast<void *>(asyncContext),
+        &asyncContext->work));
+    NAPI_CALL(env, napi_queue_async_work(env, asyncContext->work));
+    return result;
+}
+
 napi_value NapiDnsResolver::DeclareNapiDnsResolverInterface(napi_env env, napi_value exports)
 {
     napi_property_descriptor desc[] = {
         DECLARE_NAPI_FUNCTION("getAddressesByName", GetAddressesByName),
+        DECLARE_NAPI_FUNCTION("getAddressesByNames", GetAddressesByNames),
     };
     NAPI_CALL(env, napi_define_properties(env, exports, sizeof(desc) / sizeof(desc[0]), desc));
     return exports;
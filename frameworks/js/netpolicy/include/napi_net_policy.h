@@ -17,6 +17,7 @@
 #define NAPI_NET_POLICY_H
 
 #include <string>
+#include <utility>
 #include <vector>
 #include "napi/native_api.h"
 #include "napi/native_node_api.h"
@@ -43,6 +44,8 @@ struct NetPolicyAsyncContext {
     bool metered = false;
     // interface name
     std::string interfaceName;
+    // pairs of uid and policy
+    std::vector<std::pair<uint32_t, NetUidPolicy>> uidPolicies;
 };
 
 class NapiNetPolicy {
@@ -55,6 +58,7 @@ public:
     static napi_value DeclareNapiNetPolicyResultData(napi_env env, napi_value exports);
 
     static void ExecSetUidPolicy(napi_env env, void *data);
+    static void ExecSetUidPolicies(napi_env env, void *data);
     static void ExecGetUids(napi_env env, void *data);
     static void ExecGetUidPolicy(napi_env env, void *data);
     static void ExecIsUidNetAccess(napi_env env, void *data);
@@ -64,6 +68,7 @@ public:
     static void CompleteIsUidNetAccess(napi_env env, napi_status status, void *data);
     // Declare napi interfaces for JS
     static napi_value SetUidPolicy(napi_env env, napi_callback_info info);
+    static napi_value SetUidPolicies(napi_env env, napi_callback_info info);
     static napi_value GetUidPolicy(napi_env env, napi_callback_info info);
     static napi_value GetUids(napi_env env, napi_callback_info info);
     static napi_value IsUidNetAccess(napi_env env, napi_callback_info info);
@@ -39,6 +39,19 @@ void NapiNetPolicy::ExecSetUidPolicy(napi_env env, void *data)
         context->policy, context->policyResult);
 }
 
+void NapiNetPolicy::ExecSetUidPolicies(napi_env env, void *data)
+{
+    NetPolicyAsyncContext* context = static_cast<NetPolicyAsyncContext *>(data);
+    if (context == nullptr) {
+        NETMGR_LOGE("context == nullptr");
+        return;
+    }
+    context->policyResult =
+        static_cast<int32_t>(DelayedSingleton<NetPolicyClient>::GetInstance()->SetUidPolicies(context->uidPolicies));
+    NETMGR_LOGI("ExecSetUidPolicies, size = [%{public}zu], policyResult = [%{public}d]",
+        context->uidPolicies.size(), context->policyResult);
+}
+
 void NapiNetPolicy::ExecGetUids(napi_env env, void *data)
 {
     NetPolicyAsyncContext* context = static_cast<NetPolicyAsyncContext *>(data);
@@ -252,6 +265,7 @@ napi_value NapiNetPolicy::DeclareNapiNetPolicyInterface(napi_env env, napi_value
 {
     napi_property_descriptor desc[] = {
         DECLARE_NAPI_FUNCTION("setUidPolicy", SetUidPolicy),
+        DECLARE_NAPI_FUNCTION("setUidPolicies", SetUidPolicies),
         DECLARE_NAPI_FUNCTION("getUidPolicy", GetUidPolicy),
         DECLARE_NAPI_FUNCTION("getUids", GetUids),
         DECLARE_NAPI_FUNCTION("isUidNetAccess", IsUidNetAccess),
@@ -299,6 +313,64 @@ napi_value NapiNetPolicy::SetUidPolicy(napi_env env, napi_callback_info info)
     return result;
 }
 
+napi_value NapiNetPolicy::SetUidPolicies(napi_env env, napi_callback_info info)
+{
+    size_t argc = static_cast<size_t>(JS_ARGV_NUM::ARGV_NUM_2);
+    napi_value argv[] = {nullptr, nullptr};
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    bool isArray = false;
+    NAPI_CALL(env, napi_is_array(env, argv[static_cast<int32_t>(JS_ARGV_INDEX::ARGV_INDEX_0)], &isArray));
+    if (!isArray) {
+        NETMGR_LOGE("SetUidPolicies argv[0] is not an array");
+        return nullptr;
+    }
+    uint32_t length = 0;
+    NAPI_CALL(env, napi_get_array_length(env, argv[static_cast<int32_t>(JS_ARGV_INDEX::ARGV_INDEX_0)], &length));
+    /* Parsed before the context exists, a malformed element rejects the whole call and nothing leaks */
+    std::vector<std::pair<uint32_t, NetUidPolicy>> uidPolicies;
+    uidPolicies.reserve(length);
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value element = nullptr;
+        napi_valuetype elementType = napi_undefined;
+        NAPI_CALL(env, napi_get_element(env, argv[static_cast<int32_t>(JS_ARGV_INDEX::ARGV_INDEX_0)], i, &element));
+        NAPI_CALL(env, napi_typeof(env, element, &elementType));
+        uint32_t uid = 0;
+        uint32_t policy = 0;
+        /* A missing policy must not turn into NET_POLICY_NONE, which deletes the uid policy */
+        if (elementType != napi_object || !NapiCommon::GetPropertyUint32(env, element, "uid", uid) ||
+            !NapiCommon::GetPropertyUint32(env, element, "policy", policy)) {
+            NETMGR_LOGE("SetUidPolicies element[%{public}u] is not a {uid, policy} pair", i);
+            return nullptr;
+        }
+        uidPolicies.emplace_back(uid, static_cast<NetUidPolicy>(policy));
+    }
+    NetPolicyAsyncContext* context = std::make_unique<NetPolicyAsyncContext>().release();
+    context->uidPolicies = std::move(uidPolicies);
+    NETMGR_LOGI("JS agvc count = [%{public}d], uidPolicies size = [%{public}u]", static_cast<int>(argc), length);
+    napi_value result = nullptr;
+    if (argc == static_cast<int32_t>(JS_ARGV_NUM::ARGV_NUM_1)) {
+        NAPI_CALL(env, napi_create_promise(env, &context->deferred, &result));
+    } else if (argc == static_cast<int32_t>(JS_ARGV_NUM::ARGV_NUM_2)) {
+        NAPI_CALL(env, napi_create_reference(env, argv[static_cast<int32_t>(JS_ARGV_INDEX::ARGV_INDEX_1)],
+            CALLBACK_REF_CNT, &context->callbackRef));
+        NAPI_CALL(env, napi_get_undefined(env, &result));
+    } else {
+        NETMGR_LOGE("SetUidPolicies exception");
+    }
+    // creat async work
+    napi_value resource = nullptr;
+    napi_value resourceName = nullptr;
+    NAPI_CALL(env, napi_get_undefined(env, &resource));
+    NAPI_CALL(env, napi_create_string_utf8(env, "SetUidPolicies", NAPI_AUTO_LENGTH, &resourceName));
+    NAPI_CALL(env, napi_create_async_work(env, resource, resourceName,
+        ExecSetUidPolicies,
+        CompleteSetUidPolicy,
+        (void *)context,
+        &context->work));
+    NAPI_CALL(env, napi_queue_async_work(env, context->work));
+    return result;
+}
+
 napi_value NapiNetPolicy::GetUidPolicy(napi_env env, napi_callback_info info)
 {
     size_t argc = static_cast<size_t>(JS_ARGV_INDEX::ARGV_INDEX_2);
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_ADDR_BLOB_H
+#define DNS_ADDR_BLOB_H
+
+#include <cstdint>
+#include <vector>
+
+#include "parcel.h"
+
+#include "inet_addr.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Addresses of one lookup packed for IPC: per entry a family tag byte followed by the 4 or 16 address bytes, back
+ * to back in one buffer. The list crosses the parcel as one length and one buffer instead of one INetAddr with
+ * its strings per address, and an INetAddr is only built for the entries a caller decodes.
+ */
+class DnsAddrBlob {
+public:
+    static constexpr uint32_t MAX_BLOB_LEN = 64 * 1024;
+
+    /**
+     * @brief Append an address in network byte order
+     *
+     * @param family AF_INET or AF_INET6
+     * @param addr The 4 or 16 address bytes
+     * @return Returns false for another family
+     */
+    bool Append(int32_t family, const void *addr);
+
+    /**
+     * @brief Append a numeric address
+     *
+     * @param addr The address, its family_ and address_ are used
+     * @return Returns false when the address is not numeric
+     */
+    bool Append(const INetAddr &addr);
+    void Clear();
+    size_t Size() const;
+    bool Empty() const;
+
+    /**
+     * @brief Get the family of an entry
+     *
+     * @param index The entry, below Size()
+     * @return AF_INET or AF_INET6
+     */
+    int32_t GetFamily(size_t index) const;
+
+    /**
+     * @brief Get the raw bytes of an entry, valid until the blob changes
+     *
+     * @param index The entry, below Size()
+     * @return The 4 or 16 address bytes in network byte order
+     */
+    const uint8_t *GetAddress(size_t index) const;
+
+    /**
+     * @brief Build the INetAddr of one entry
+     *
+     * @param index The entry
+     * @param addr Set to the family and the text form of the address
+     * @return Returns false when index is out of range
+     */
+    bool Decode(size_t index, INetAddr &addr) const;
+
+    /**
+     * @brief Build the INetAddr of every entry
+     *
+     * @param addrInfo The addresses are appended here, in order
+     */
+    void DecodeAll(std::vector<INetAddr> &addrInfo) const;
+    bool Marshalling(Parcel &parcel) const;
+    static bool Unmarshalling(Parcel &parcel, DnsAddrBlob &blob);
+
+private:
+    std::vector<uint8_t> data_;
+    std::vector<uint32_t> offsets_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_ADDR_BLOB_H
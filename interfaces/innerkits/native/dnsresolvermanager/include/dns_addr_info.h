@@ -33,6 +33,24 @@ struct DnsAddrInfo : public Parcelable {
 
     bool Marshalling(Parcel &parcel) const override;
     static sptr<DnsAddrInfo> Unmarshalling(Parcel &parcel);
+
+    /**
+     * @brief Write a result list as one buffer of fixed size records with binary addresses
+     *
+     * @param parcel The parcel
+     * @param list The results, addr_ must be numeric
+     * @return Returns true as success
+     */
+    static bool MarshallingList(Parcel &parcel, const std::vector<sptr<DnsAddrInfo>> &list);
+
+    /**
+     * @brief Read a result list written by MarshallingList
+     *
+     * @param parcel The parcel
+     * @param list The results are appended here
+     * @return Returns true as success
+     */
+    static bool UnmarshallingList(Parcel &parcel, std::vector<sptr<DnsAddrInfo>> &list);
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_RESOLVER_CACHE_H
+#define DNS_RESOLVER_CACHE_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "inet_addr.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+struct DnsResolverCacheStats {
+    uint64_t hits = 0;
+    uint64_t negativeHits = 0;
+    uint64_t misses = 0;
+    uint64_t expired = 0;
+    uint64_t evictions = 0;
+    uint64_t invalidations = 0;
+    uint64_t prefetches = 0;
+    uint64_t prefetchesLimited = 0;
+    uint64_t staleHits = 0;
+};
+
+/* Called outside the cache locks to look a name up again, the answer is expected back through Put */
+using DnsCacheRefreshFunc = std::function<void(uint16_t netId, const std::string &hostName)>;
+
+struct DnsCacheRefreshPolicy {
+    /* An entry hit prefetchMinHits times is refreshed once less than this share of its TTL is left, 0 never */
+    uint32_t prefetchPercent = 0;
+    uint32_t prefetchMinHits = 0;
+    /* Refreshes started per second at most, 0 does not limit them, the rest wait for the entry to expire */
+    uint32_t maxRefreshPerSecond = 0;
+    /* How long past its TTL a successful entry may answer while the upstream is unreachable (RFC 8767), 0 never */
+    uint32_t staleWindowMs = 0;
+    /* Once a stale answer is served, Get keeps serving it this long before the upstream is tried again */
+    uint32_t staleRecheckMs = 0;
+};
+
+/**
+ * Bounded in-process cache of name lookups keyed by netId and host name. Entries are spread over shards with their
+ * own lock and LRU list so concurrent lookups of different names rarely contend. A cached failure is returned with
+ * its original result code until its own, usually shorter, TTL expires.
+ */
+class DnsResolverCache {
+public:
+    static constexpr uint32_t DEFAULT_CAPACITY = 512;
+    static constexpr uint32_t DEFAULT_SHARD_COUNT = 16;
+
+    explicit DnsResolverCache(uint32_t capacity = DEFAULT_CAPACITY, uint32_t shardCount = DEFAULT_SHARD_COUNT);
+    ~DnsResolverCache() = default;
+    DnsResolverCache(const DnsResolverCache &) = delete;
+    DnsResolverCache &operator=(const DnsResolverCache &) = delete;
+
+    /**
+     * @brief Look up a live entry and append its addresses
+     *
+     * @param netId The network of the lookup
+     * @param hostName The host name
+     * @param result Set to the result code of the cached lookup
+     * @param addrInfo The cached addresses are appended here
+     * @return Returns true on a hit, expired entries count as a miss and are dropped unless kept to be served stale
+     */
+    bool Get(uint16_t netId, const std::string &hostName, int32_t &result, std::vector<INetAddr> &addrInfo);
+
+    /**
+     * @brief Look up an expired answer after the upstream failed, within the stale window of the policy
+     *
+     * @param netId The network of the lookup
+     * @param hostName The host name
+     * @param addrInfo The cached addresses are appended here
+     * @return Returns true when a successful answer is served stale
+     */
+    bool GetStale(uint16_t netId, const std::string &hostName, std::vector<INetAddr> &addrInfo);
+
+    /**
+     * @brief Insert or replace an entry, the least recently used entry of the shard is evicted when it is full
+     *
+     * @param netId The network of the lookup
+     * @param hostName The host name
+     * @param result The result code of the lookup
+     * @param addrInfo The addresses, empty for a failed lookup
+     * @param ttlMs The time to live, 0 does not cache anything
+     */
+    void Put(uint16_t netId, const std::string &hostName, int32_t result, const std::vector<INetAddr> &addrInfo,
+        uint32_t ttlMs);
+
+    /**
+     * @brief Set the function refreshing hot entries, before the first lookup
+     *
+     * @param refresh Looks the name up again, it must not block
+     */
+    void SetRefreshFunc(const DnsCacheRefreshFunc &refresh);
+
+    /**
+     * @brief Rearm an entry whose refresh failed without an answer to Put, so a later hit can try again
+     *
+     * @param netId The network of the lookup
+     * @param hostName The host name
+     */
+    void CancelRefresh(uint16_t netId, const std::string &hostName);
+    void SetRefreshPolicy(const DnsCacheRefreshPolicy &policy);
+    void Invalidate(uint16_t netId);
+    void Clear();
+    size_t Size() const;
+    DnsResolverCacheStats GetStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct CacheKey {
+        uint16_t netId = 0;
+        std::string hostName;
+        bool operator==(const CacheKey &other) const
+        {
+            return netId == other.netId && hostName == other.hostName;
+        }
+    };
+
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey &key) const
+        {
+            return std::hash<std::string>()(key.hostName) ^ key.netId;
+        }
+    };
+
+    struct CacheEntry {
+        CacheKey key;
+        int32_t result = 0;
+        std::vector<INetAddr> addrInfo;
+        uint32_t ttlMs = 0;
+        uint32_t hits = 0;
+        bool refreshing = false;
+        Clock::time_point expireTime;
+        Clock::time_point staleUntil;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<CacheEntry> lru;
+        std::unordered_map<CacheKey, std::list<CacheEntry>::iterator, CacheKeyHash> index;
+    };
+
+    Shard &GetShard(const CacheKey &key);
+    bool ShouldRefresh(CacheEntry &entry, Clock::time_point now);
+    bool TakeRefreshSlot(Clock::time_point now);
+
+private:
+    uint32_t shardCapacity_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<uint64_t> hits_ {0};
+    std::atomic<uint64_t> negativeHits_ {0};
+    std::atomic<uint64_t> misses_ {0};
+    std::atomic<uint64_t> expired_ {0};
+    std::atomic<uint64_t> evictions_ {0};
+    std::atomic<uint64_t> invalidations_ {0};
+    std::atomic<uint64_t> prefetches_ {0};
+    std::atomic<uint64_t> prefetchesLimited_ {0};
+    std::atomic<uint64_t> staleHits_ {0};
+
+    DnsCacheRefreshFunc refresh_;
+    std::atomic<uint32_t> prefetchPercent_ {0};
+    std::atomic<uint32_t> prefetchMinHits_ {0};
+    std::atomic<uint32_t> maxRefreshPerSecond_ {0};
+    std::atomic<uint32_t> staleWindowMs_ {0};
+    std::atomic<uint32_t> staleRecheckMs_ {0};
+    std::mutex refreshMutex_;
+    Clock::time_point refreshWindowStart_;
+    uint32_t refreshesInWindow_ = 0;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_RESOLVER_CACHE_H
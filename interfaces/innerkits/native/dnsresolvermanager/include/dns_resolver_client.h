@@ -16,15 +16,31 @@
 #ifndef DNS_RESOLVER_MANAGER_H
 #define DNS_RESOLVER_MANAGER_H
 
+#include <condition_variable>
+#include <deque>
 #include <string>
+#include <thread>
 
 #include "parcel.h"
 #include "singleton.h"
 
+#include "dns_resolver_cache.h"
+#include "dns_resolver_callback_stub.h"
+#include "dns_resolver_constants.h"
 #include "i_dns_resolver_service.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
+/* The reply carries no record TTL, so lookups are cached for a short fixed time on top of the resolver cache */
+constexpr uint32_t DNS_CACHE_POSITIVE_TTL_MS = 5000;
+constexpr uint32_t DNS_CACHE_NEGATIVE_TTL_MS = 2000;
+/* Names hit twice are looked up again in the last tenth of their TTL, so a steady user never sees the miss */
+constexpr uint32_t DNS_CACHE_PREFETCH_PERCENT = 10;
+constexpr uint32_t DNS_CACHE_PREFETCH_MIN_HITS = 2;
+constexpr uint32_t DNS_CACHE_MAX_REFRESH_PER_SECOND = 8;
+constexpr uint32_t DNS_CACHE_STALE_WINDOW_MS = 60000;
+constexpr uint32_t DNS_CACHE_STALE_RECHECK_MS = 5000;
+
 class DnsResolverClient {
     DECLARE_DELAYED_SINGLETON(DnsResolverClient)
 
@@ -37,6 +53,46 @@ public:
      * @return Returns 0 as success, other values as failure
      */
     int32_t GetAddressesByName(const std::string &hostName, std::vector<INetAddr> &addrInfo);
+    /**
+     * @brief Get Addresses By domain Name in their packed form, without the in process cache
+     *
+     * @param The domain name
+     * @param Set to the addresses, decode only the entries that are used
+     * @return Returns 0 as success, other values as failure
+     */
+    int32_t GetAddressesByNamePacked(const std::string &hostName, DnsAddrBlob &addrBlob);
+    /**
+     * @brief Get the addresses of several domain names in one call
+     *
+     * @param The domain names, at most DNS_MAX_BATCH_NAMES
+     * @param Set to the result code of each name, 0 as success
+     * @param Set to the addresses of each name, in the order of the domain names
+     * @return Returns 0 when every name has a result, other values as failure of the whole call
+     */
+    int32_t GetAddressesByNames(const std::vector<std::string> &hostNames, std::vector<int32_t> &results,
+        std::vector<std::vector<INetAddr>> &addrInfos);
+    /**
+     * @brief Get Addresses By domain Name without holding a service thread while the query is outstanding
+     *
+     * The query goes straight to the DNS servers of the default network, the hosts file and the search domains are
+     * not applied, so pass a fully qualified name.
+     *
+     * @param The domain name
+     * @param Receives the result code and the addresses on a binder thread, or nothing when the call fails
+     * @return Returns 0 when the query is queued, other values as failure
+     */
+    int32_t GetAddressesByNameAsync(const std::string &hostName, const sptr<IDnsResolverCallback> &callback);
+    /**
+     * @brief Get the IPv6 and IPv4 Addresses of a domain Name with both queries in flight at once
+     *
+     * Resolved like GetAddressesByNameAsync, without the hosts file and the search domains.
+     *
+     * @param The domain name
+     * @param Receives the first family early through OnPartialResolved, then all addresses through OnResolved,
+     *        both ordered by RFC 6724 destination address selection
+     * @return Returns 0 when the queries are queued, other values as failure
+     */
+    int32_t GetAddressesByNameDualStack(const std::string &hostName, const sptr<IDnsResolverCallback> &callback);
     /**
      * @brief Get Addresses By domain Name
      *
@@ -93,6 +149,33 @@ public:
      */
     int32_t GetResolverInfo(uint16_t netId, std::vector<std::string> &servers,
         std::vector<std::string> &domains, uint16_t &baseTimeoutMsec, uint8_t &retryCount);
+    /**
+     * @brief Get the query counters and latency histogram of every server of a network
+     *
+     * @param netId
+     * @param Set to one entry per server, an empty server stands for the system resolver
+     * @return Returns 0 as success, other values as failure
+     */
+    int32_t GetResolverStats(uint16_t netId, std::vector<DnsServerStats> &stats);
+    /**
+     * @brief Set how long GetAddressesByName results are cached in this process
+     *
+     * @param Time to live of a successful lookup in milliseconds, 0 disables it
+     * @param Time to live of a name that does not exist in milliseconds, 0 disables it
+     */
+    void SetCacheTtl(uint32_t positiveTtlMs, uint32_t negativeTtlMs);
+    /**
+     * @brief Get the hit and miss counters of the GetAddressesByName cache
+     *
+     * @return The cache counters
+     */
+    DnsResolverCacheStats GetCacheStats() const;
+    /**
+     * @brief Set when hot GetAddressesByName results are refreshed and how long expired ones are served stale
+     *
+     * @param The prefetch, rate limit and serve stale settings
+     */
+    void SetCacheRefreshPolicy(const DnsCacheRefreshPolicy &policy);
 
 private:
     class DnsResolverDeathRecipient : public IRemoteObject::DeathRecipient {
@@ -111,11 +194,25 @@ private:
 private:
     sptr<IDnsResolverService> GetProxy();
     void OnRemoteDied(const wptr<IRemoteObject> &remote);
+    void InvalidateCache(uint16_t netId);
+    bool CacheLookup(const std::string &hostName, int32_t result, const std::vector<INetAddr> &addrInfo);
+    void RefreshLookup(const std::string &hostName);
+    void RunRefresh();
+    bool ServeStale(const std::string &hostName, int32_t &result, std::vector<INetAddr> &addrInfo);
 
 private:
     std::mutex mutex_;
     sptr<IDnsResolverService> dnsResolverService_;
     sptr<IRemoteObject::DeathRecipient> deathRecipient_;
+    DnsResolverCache cache_;
+    std::atomic<uint32_t> positiveTtlMs_ {DNS_CACHE_POSITIVE_TTL_MS};
+    std::atomic<uint32_t> negativeTtlMs_ {DNS_CACHE_NEGATIVE_TTL_MS};
+    /* Names whose cache entry is being refreshed, looked up again one at a time by refreshThread_ */
+    std::mutex refreshMutex_;
+    std::condition_variable refreshCond_;
+    std::deque<std::string> refreshQueue_;
+    std::thread refreshThread_;
+    bool refreshStop_ = false;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -16,12 +16,16 @@
 #ifndef DNS_RESOLVER_CONSTANTS_H
 #define DNS_RESOLVER_CONSTANTS_H
 
+#include <cstdint>
+
 #include "netmanager_constants.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
 constexpr int DNS_ERROR = -1;
 constexpr int DNS_SUCCESS = 0;
+constexpr uint32_t DNS_MAX_BATCH_NAMES = 64;
+constexpr uint16_t DNS_DEFAULT_NETID = 0;
 } // namespace NetManagerStandard
 } // namespace OHOS
 #endif // DNS_RESOLVER_CONSTANTS_H
\ No newline at end of file
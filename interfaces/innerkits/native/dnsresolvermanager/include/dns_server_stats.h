@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_SERVER_STATS_H
+#define DNS_SERVER_STATS_H
+
+#include <string>
+#include <vector>
+
+#include "parcel.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/* Latency buckets double from 1ms, bucket 0 is below 1ms and the last one is open ended */
+constexpr uint32_t DNS_LATENCY_BUCKETS = 13;
+
+struct DnsServerStats : public Parcelable {
+    /* Empty for lookups done by the system resolver, which does not say which server answered */
+    std::string server_;
+    uint64_t queries_ = 0;
+    uint64_t successes_ = 0;
+    uint64_t timeouts_ = 0;
+    /* Answers without an address, the name does not exist or has no record of the family */
+    uint64_t nxDomains_ = 0;
+    uint64_t servFails_ = 0;
+    uint64_t errors_ = 0;
+    std::vector<uint64_t> latencyBuckets_;
+
+    /**
+     * @brief Upper bound of a latency bucket
+     *
+     * @param bucket The bucket index
+     * @return The exclusive upper bound in milliseconds, UINT32_MAX for the last bucket
+     */
+    static uint32_t GetBucketUpperMs(uint32_t bucket);
+
+    bool Marshalling(Parcel &parcel) const override;
+    static sptr<DnsServerStats> Unmarshalling(Parcel &parcel);
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_SERVER_STATS_H
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_RESOLVER_CALLBACK_STUB_H
+#define DNS_RESOLVER_CALLBACK_STUB_H
+
+#include <map>
+
+#include "iremote_stub.h"
+
+#include "i_dns_resolver_callback.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+class DnsResolverCallbackStub : public IRemoteStub<IDnsResolverCallback> {
+public:
+    DnsResolverCallbackStub();
+    virtual ~DnsResolverCallbackStub();
+
+    int32_t OnRemoteRequest(
+        uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override;
+
+private:
+    using DnsResolverCallbackFunc = int32_t (DnsResolverCallbackStub::*)(MessageParcel &, MessageParcel &);
+
+private:
+    int32_t OnDnsResolved(MessageParcel &data, MessageParcel &reply);
+    int32_t OnDnsPartialResolved(MessageParcel &data, MessageParcel &reply);
+
+private:
+    std::map<uint32_t, DnsResolverCallbackFunc> memberFuncMap_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_RESOLVER_CALLBACK_STUB_H
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef I_DNS_RESOLVER_CALLBACK_H
+#define I_DNS_RESOLVER_CALLBACK_H
+
+#include <string>
+#include <vector>
+
+#include "iremote_broker.h"
+
+#include "inet_addr.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+class IDnsResolverCallback : public IRemoteBroker {
+public:
+    virtual ~IDnsResolverCallback() = default;
+public:
+    DECLARE_INTERFACE_DESCRIPTOR(u"OHOS.NetManagerStandard.IDnsResolverCallback");
+    enum {
+        DNS_RESOLVED = 0,
+        DNS_PARTIAL_RESOLVED,
+    };
+
+public:
+    virtual int32_t OnResolved(const std::string &hostName, int32_t result, const std::vector<INetAddr> &addrInfo) = 0;
+    /**
+     * @brief Addresses of the first family of a dual stack lookup, OnResolved still follows with all of them
+     *
+     * @param hostName The domain name
+     * @param addrInfo The addresses found so far, in connection order
+     * @return Returns 0 as success
+     */
+    virtual int32_t OnPartialResolved(const std::string &hostName, const std::vector<INetAddr> &addrInfo) = 0;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // I_DNS_RESOLVER_CALLBACK_H
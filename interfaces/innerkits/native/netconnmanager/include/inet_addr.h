@@ -16,6 +16,7 @@
 #ifndef INET_ADDR_H
 #define INET_ADDR_H
 
+#include <array>
 #include <string>
 
 #include "parcel.h"
@@ -35,9 +36,35 @@ struct INetAddr : public Parcelable {
     std::string address_;
     std::string netMask_;
     std::string hostName_;
+    /* Binary form of address_ filled by Parse, which has to run again after address_ changes */
+    bool parsed_ = false;
+    uint8_t addrFamily_ = 0;
+    std::array<uint8_t, 16> addrBytes_ {};
 
     bool operator==(const INetAddr& obj) const;
 
+    /**
+     * @brief Parse address_ into its binary form, an invalid address stays unparsed and compares as a string
+     *
+     * @return Returns true if address_ is a valid address
+     */
+    bool Parse();
+
+    /**
+     * @brief Hash consistent with operator==, the same for a parsed and an unparsed copy
+     *
+     * @return The hash
+     */
+    size_t Hash() const;
+
+    /**
+     * @brief Read the fields written by Marshalling straight into this object, then parse the address
+     *
+     * @param parcel Parcel positioned at a marshalled INetAddr
+     * @return Returns true on success
+     */
+    bool ReadFromParcel(Parcel &parcel);
+
     virtual bool Marshalling(Parcel &parcel) const override;
     static sptr<INetAddr> Unmarshalling(Parcel &parcel);
     static bool Marshalling(Parcel &parcel, const sptr<INetAddr> &object);
@@ -32,6 +32,22 @@ struct NetLinkInfo : public Parcelable {
     std::list<Route> routeList_;
     uint16_t mtu_ = 0;
 
+    /**
+     * @brief Read the fields written by Marshalling straight into this object, each element is decoded
+     *        in place in its list node
+     *
+     * @param parcel Parcel positioned at a marshalled NetLinkInfo
+     * @return Returns true on success
+     */
+    bool ReadFromParcel(Parcel &parcel);
+
+    /**
+     * @brief Size of the marshalled form, so Marshalling can grow the parcel once up front
+     *
+     * @return Bytes Marshalling writes
+     */
+    size_t GetMarshalledSize() const;
+
     virtual bool Marshalling(Parcel &parcel) const override;
     static sptr<NetLinkInfo> Unmarshalling(Parcel &parcel);
     static bool Marshalling(Parcel &parcel, const sptr<NetLinkInfo> &object);
@@ -26,9 +26,26 @@ struct Route : public Parcelable {
     std::string iface_;
     INetAddr destination_;
     INetAddr gateway_;
+    /* Hash of the route, valid once Parse has run */
+    bool parsed_ = false;
+    size_t hash_ = 0;
 
     bool operator==(const Route& obj) const;
 
+    /**
+     * @brief Parse both addresses and cache the hash, so two parsed routes that differ compare in O(1)
+     */
+    void Parse();
+    size_t Hash() const;
+
+    /**
+     * @brief Read the fields written by Marshalling straight into this object and cache the hash
+     *
+     * @param parcel Parcel positioned at a marshalled Route
+     * @return Returns true on success
+     */
+    bool ReadFromParcel(Parcel &parcel);
+
     virtual bool Marshalling(Parcel &parcel) const override;
     static sptr<Route> Unmarshalling(Parcel &parcel);
     static bool Marshalling(Parcel &parcel, const sptr<Route> &object);
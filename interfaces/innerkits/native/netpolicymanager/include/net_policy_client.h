@@ -28,6 +28,14 @@ class NetPolicyClient {
 
 public:
     NetPolicyResultCode SetUidPolicy(uint32_t uid, NetUidPolicy policy);
+
+    /**
+     * @brief Set the policys of many uids with one IPC call, the batch is applied atomically
+     *
+     * @param uidPolicies Pairs of uid and policy, at most MAX_UID_POLICY_BATCH_SIZE entries
+     * @return Returns ERR_NONE success, otherwise fail and no policy is changed
+     */
+    NetPolicyResultCode SetUidPolicies(const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies);
     NetUidPolicy GetUidPolicy(uint32_t uid);
     std::vector<uint32_t> GetUids(NetUidPolicy policy);
     bool IsUidNetAccess(uint32_t uid, bool metered);
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_MANAGER_IPC_STUB_DISPATCH_TABLE_H
+#define NET_MANAGER_IPC_STUB_DISPATCH_TABLE_H
+
+#include <array>
+#include <cstdint>
+
+#include "message_parcel.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Handlers of a stub in an array indexed by command code. The command codes of a stub are a small dense enum, so a
+ * request costs one bounds check and one load instead of a tree walk. The table is built by a constexpr constructor,
+ * which makes a stub's table constant initialized, and a handler registered for a code at or past CodeCount does
+ * not compile when the table is defined constexpr.
+ */
+template <typename Stub, uint32_t CodeCount>
+class IpcStubDispatchTable {
+public:
+    using Handler = int32_t (Stub::*)(MessageParcel &, MessageParcel &);
+
+    struct Entry {
+        uint32_t code;
+        Handler handler;
+    };
+
+    template <size_t N>
+    constexpr explicit IpcStubDispatchTable(const Entry (&entries)[N]) : handlers_ {}
+    {
+        for (size_t i = 0; i < N; ++i) {
+            handlers_[entries[i].code] = entries[i].handler;
+        }
+    }
+
+    /**
+     * @brief Find the handler of a command code
+     *
+     * @param code The command code of the request
+     * @return The handler, nullptr for a code without one
+     */
+    constexpr Handler Find(uint32_t code) const
+    {
+        return (code < CodeCount) ? handlers_[code] : nullptr;
+    }
+
+private:
+    std::array<Handler, CodeCount> handlers_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_MANAGER_IPC_STUB_DISPATCH_TABLE_H
@@ -18,6 +18,7 @@
 
 #include <string>
 #include <mutex>
+#include <vector>
 #ifdef NATIVE_NETD_FEATURE
 #include "dnsresolv_service.h"
 #include "fwmark_server.h"
@@ -103,6 +104,17 @@ public:
     int32_t NetworkRemoveRoute(int32_t netId, const std::string &ifName, const std::string &destination,
         const std::string &nextHop);
 
+    /**
+     * @brief Apply a route delta in one go, removals first
+     *
+     * @param netId
+     * @param removed Routes to remove
+     * @param added Routes to add
+     * @return Return 0 when every route is applied, otherwise the first failure
+     */
+    int32_t NetworkApplyRouteDelta(int32_t netId, const std::vector<Route> &removed,
+        const std::vector<Route> &added);
+
     /**
      * @brief Turn off the device
      *
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_MANAGER_NETLINK_EVENT_LOOP_H
+#define NET_MANAGER_NETLINK_EVENT_LOOP_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <linux/netlink.h>
+#include <sys/socket.h>
+
+namespace OHOS {
+namespace NetManagerStandard {
+struct NetlinkEventLoopStats {
+    uint64_t wakeups = 0;
+    uint64_t batches = 0;
+    uint64_t datagrams = 0;
+    uint64_t messages = 0;
+    uint64_t overflows = 0;
+    uint64_t truncated = 0;
+};
+
+/**
+ * Event loop reading a datagram socket, normally a netlink multicast socket, on its own thread. The socket is
+ * watched with edge triggered epoll and drained until EAGAIN on every wakeup, each recvmmsg call fills a batch of
+ * preallocated buffers so a burst of events costs a few syscalls. When the kernel reports ENOBUFS, or a datagram
+ * did not fit a buffer, events were lost and the overflow callback is asked to resync the whole state. Any other
+ * read or epoll error stops the loop, IsRunning turns false and Start can bring it back on a new socket.
+ */
+class NetlinkEventLoop {
+public:
+    using MessageCallback = std::function<void(const struct nlmsghdr &nh)>;
+    using OverflowCallback = std::function<void()>;
+
+    static constexpr uint32_t DEFAULT_BATCH_SIZE = 32;
+    static constexpr uint32_t DEFAULT_BUFFER_SIZE = 8192;
+
+    NetlinkEventLoop(uint32_t batchSize = DEFAULT_BATCH_SIZE, uint32_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ~NetlinkEventLoop();
+    NetlinkEventLoop(const NetlinkEventLoop &) = delete;
+    NetlinkEventLoop &operator=(const NetlinkEventLoop &) = delete;
+
+    /**
+     * @brief Open a non blocking netlink socket joined to the multicast groups
+     *
+     * @param protocol The netlink protocol, such as NETLINK_ROUTE
+     * @param groups The multicast group mask
+     * @param rcvBufSize The receive buffer size, the forced size is tried first
+     * @return The socket, or -1 on failure
+     */
+    static int32_t CreateSocket(int32_t protocol, uint32_t groups, int32_t rcvBufSize);
+
+    /**
+     * @brief Start the loop thread on the socket, the loop owns the socket from now on. A loop that stopped on a
+     *        read or epoll error is cleaned up and started again
+     *
+     * @param fd The datagram socket, switched to non blocking mode
+     * @param onMessage Called on the loop thread for every complete netlink message
+     * @param onOverflow Called on the loop thread after events were lost
+     * @return Returns true if the loop runs, a loop already running keeps its socket and callbacks and the new
+     *         socket is closed, returns false and closes the socket if epoll could not be set up
+     */
+    bool Start(int32_t fd, const MessageCallback &onMessage, const OverflowCallback &onOverflow);
+
+    /**
+     * @brief Wake the loop thread, wait for it to exit and close the socket
+     */
+    void Stop();
+
+    /**
+     * @brief Whether the loop thread reads the socket, false once the loop stopped on an error even if Stop was
+     *        not called
+     */
+    bool IsRunning() const;
+    NetlinkEventLoopStats GetStats() const;
+
+private:
+    void Run();
+    bool Drain();
+    void DispatchDatagram(const uint8_t *data, uint32_t len);
+    void NotifyOverflow();
+    void CloseFds();
+
+private:
+    uint32_t batchSize_;
+    uint32_t bufferSize_;
+    std::vector<uint8_t> buffers_;
+    std::vector<struct iovec> iovecs_;
+    std::vector<struct mmsghdr> msgs_;
+    MessageCallback onMessage_;
+    OverflowCallback onOverflow_;
+    int32_t sockFd_ = -1;
+    int32_t epollFd_ = -1;
+    int32_t wakeFd_ = -1;
+    std::thread thread_;
+    std::atomic<bool> running_ {false};
+    std::atomic<uint64_t> wakeups_ {0};
+    std::atomic<uint64_t> batches_ {0};
+    std::atomic<uint64_t> datagrams_ {0};
+    std::atomic<uint64_t> messages_ {0};
+    std::atomic<uint64_t> overflows_ {0};
+    std::atomic<uint64_t> truncated_ {0};
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_MANAGER_NETLINK_EVENT_LOOP_H
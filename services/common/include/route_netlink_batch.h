@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_MANAGER_ROUTE_NETLINK_BATCH_H
+#define NET_MANAGER_ROUTE_NETLINK_BATCH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <linux/rtnetlink.h>
+
+#include "route.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Route changes sent to the kernel as multi-message rtnetlink transactions. Every route is one RTM_DELROUTE or
+ * RTM_NEWROUTE message asking for an ACK, the messages are written with one send per chunk and the ACKs are matched
+ * back by sequence number, so a whole route delta costs a few syscalls and its outcome is known per route. Adding a
+ * route that exists or removing one that is gone counts as applied.
+ */
+class RouteNetlinkBatch {
+public:
+    static constexpr int32_t ACK_PENDING = 1;
+    /* Keeps the ACKs of one chunk well within the default receive buffer */
+    static constexpr uint32_t MAX_MESSAGES_PER_SEND = 256;
+
+    explicit RouteNetlinkBatch(uint32_t table = RT_TABLE_MAIN);
+
+    /**
+     * @brief Queue a route to add
+     *
+     * @param ifName The output interface, empty for none
+     * @param destination The destination as address[/prefix], without a prefix the unspecified address is the
+     *        default route and any other address a host route
+     * @param nextHop The gateway, empty or the unspecified address for a directly connected route
+     * @return Returns false if an address or the interface is invalid, nothing is queued then
+     */
+    bool Add(const std::string &ifName, const std::string &destination, const std::string &nextHop);
+    bool Remove(const std::string &ifName, const std::string &destination, const std::string &nextHop);
+
+    /**
+     * @brief Queue a route using the binary addresses it was parsed into, a zero prefixlen_ follows the rules of
+     *        the string form
+     *
+     * @param route The route
+     * @return Returns false if an address or the interface is invalid, nothing is queued then
+     */
+    bool Add(const Route &route);
+    bool Remove(const Route &route);
+    size_t Size() const;
+    const std::vector<uint8_t> &GetMessages() const;
+
+    /**
+     * @brief Send every queued route and wait for all ACKs
+     *
+     * @return Returns 0 when every route is applied, otherwise the negative errno of the first route that failed
+     */
+    int32_t Commit();
+
+    /**
+     * @brief Get the outcome of each route in queue order after Commit, 0 or a negative errno
+     *
+     * @return The outcomes
+     */
+    const std::vector<int32_t> &GetErrors() const;
+
+    /**
+     * @brief Match the ACKs in a netlink reply to the routes they answer
+     *
+     * @param buf The reply
+     * @param len The reply length
+     * @param errors One entry per route indexed by sequence number minus one, ACK_PENDING ones are filled in
+     * @return The number of routes answered by this reply
+     */
+    static uint32_t ParseAcks(const uint8_t *buf, size_t len, std::vector<int32_t> &errors);
+
+private:
+    bool Append(uint16_t type, const std::string &ifName, const std::string &destination, const std::string &nextHop);
+    bool Append(uint16_t type, const Route &route);
+    /* gateway is nullptr for a directly connected route */
+    bool Append(uint16_t type, const std::string &ifName, uint8_t family, const uint8_t *destination, int32_t prefix,
+        const uint8_t *gateway);
+    uint32_t GetIfIndex(const std::string &ifName);
+    void FailPending(size_t begin, size_t end, int32_t error);
+
+private:
+    uint32_t table_;
+    std::vector<uint8_t> messages_;
+    /* Start of every message in messages_, plus the end */
+    std::vector<size_t> offsets_ {0};
+    std::vector<int32_t> errors_;
+    /* Routes of a delta mostly share one interface */
+    std::string lastIfName_;
+    uint32_t lastIfIndex_ = 0;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_MANAGER_ROUTE_NETLINK_BATCH_H
@@ -16,27 +16,24 @@
 #ifndef NET_MANAGER_TIMER_H
 #define NET_MANAGER_TIMER_H
 
-#include <atomic>
-#include <chrono>
-#include <condition_variable>
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <thread>
+#include <vector>
 
-#include "net_mgr_log_wrapper.h"
+#include "timer_wheel.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
+/**
+ * Owner-scoped timers on the shared TimerWheel, tasks still pending are cancelled when the Timer is destroyed.
+ */
 class Timer {
 public:
-    Timer() : stopStatus_(true), tryStopFlag_(false) {}
+    Timer() : wheel_(DelayedSingleton<TimerWheel>::GetInstance()) {}
 
-    Timer(const Timer &timer)
-    {
-        stopStatus_ = timer.stopStatus_.load();
-        tryStopFlag_ = timer.tryStopFlag_.load();
-    }
+    Timer(const Timer &timer) : wheel_(timer.wheel_) {}
 
     ~Timer()
     {
@@ -45,52 +42,45 @@ public:
 
     void Start(int interval, std::function<void()> taskFun)
     {
-        if (stopStatus_ == false) {
+        std::lock_guard<std::mutex> locker(mutex_);
+        if (periodicId_ != TimerWheel::INVALID_TIMER_ID) {
             return;
         }
-        NETMGR_LOGI("start thread...");
-        stopStatus_ = false;
-        std::thread([this, interval, taskFun]() {
-            while (!tryStopFlag_) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(interval));
-                taskFun();
-            }
-
-            std::lock_guard<std::mutex> locker(mutex_);
-            stopStatus_ = true;
-            timerCond_.notify_one();
-        }).detach();
+        periodicId_ = wheel_->StartPeriodic(static_cast<uint32_t>(interval), taskFun);
     }
 
     void StartOnce(int interval, std::function<void()> taskFun)
     {
-        std::thread([this, interval, taskFun]() {
-            if (!tryStopFlag_) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(interval));
-                taskFun();
-            }
-        }).detach();
+        std::lock_guard<std::mutex> locker(mutex_);
+        onceIds_.erase(std::remove_if(onceIds_.begin(), onceIds_.end(),
+            [this](TimerWheel::TimerId id) { return !wheel_->IsPending(id); }), onceIds_.end());
+        TimerWheel::TimerId id = wheel_->StartOnce(static_cast<uint32_t>(interval), taskFun);
+        if (id != TimerWheel::INVALID_TIMER_ID) {
+            onceIds_.push_back(id);
+        }
     }
 
     void Stop()
     {
-        if (stopStatus_ || tryStopFlag_) {
-            return;
+        std::vector<TimerWheel::TimerId> ids;
+        {
+            std::lock_guard<std::mutex> locker(mutex_);
+            ids.swap(onceIds_);
+            if (periodicId_ != TimerWheel::INVALID_TIMER_ID) {
+                ids.push_back(periodicId_);
+                periodicId_ = TimerWheel::INVALID_TIMER_ID;
+            }
+        }
+        for (auto id : ids) {
+            wheel_->Cancel(id);
         }
-        NETMGR_LOGI("stop thread...");
-        tryStopFlag_ = true;
-        std::unique_lock<std::mutex> locker(mutex_);
-        timerCond_.wait(locker, [this] { return stopStatus_ == true; });
-
-        if (stopStatus_ == true)
-            tryStopFlag_ = false;
     }
 
 private:
-    std::atomic<bool> stopStatus_;
-    std::atomic<bool> tryStopFlag_;
+    std::shared_ptr<TimerWheel> wheel_;
     std::mutex mutex_;
-    std::condition_variable timerCond_;
+    TimerWheel::TimerId periodicId_ = TimerWheel::INVALID_TIMER_ID;
+    std::vector<TimerWheel::TimerId> onceIds_;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_MANAGER_TIMER_WHEEL_H
+#define NET_MANAGER_TIMER_WHEEL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "singleton.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Hashed timer wheel shared by the whole process. One thread advances the wheel every tick and runs the expired
+ * tasks, so tasks must be short; timers beyond one wheel turn wait for their remaining rounds in the same slot.
+ * Insert and cancel are O(1).
+ */
+class TimerWheel {
+    DECLARE_DELAYED_SINGLETON(TimerWheel)
+public:
+    using TimerId = uint64_t;
+    static constexpr TimerId INVALID_TIMER_ID = 0;
+
+    /**
+     * @brief Run the task once after the delay
+     *
+     * @param delayMs Delay in milliseconds, rounded up to the wheel tick
+     * @param task The task to run on the wheel thread
+     * @return The handle to cancel the timer
+     */
+    TimerId StartOnce(uint32_t delayMs, const std::function<void()> &task);
+
+    /**
+     * @brief Run the task every interval until it is cancelled
+     *
+     * @param intervalMs Interval in milliseconds, rounded up to the wheel tick
+     * @param task The task to run on the wheel thread
+     * @return The handle to cancel the timer
+     */
+    TimerId StartPeriodic(uint32_t intervalMs, const std::function<void()> &task);
+
+    /**
+     * @brief Cancel the timer, if the task is running on another thread wait for it to return
+     *
+     * @param timerId The handle returned by StartOnce or StartPeriodic
+     * @return Returns true if the timer was pending or running
+     */
+    bool Cancel(TimerId timerId);
+    bool IsPending(TimerId timerId);
+    size_t GetPendingSize();
+
+    /**
+     * @brief Exponential backoff with equal jitter: half of min(maxMs, baseMs * 2^attempt) plus a random part
+     *
+     * @param baseMs The delay of the first attempt
+     * @param maxMs The upper bound of the delay
+     * @param attempt The number of failed attempts so far
+     * @return The delay in milliseconds
+     */
+    static uint32_t GetBackoffDelay(uint32_t baseMs, uint32_t maxMs, uint32_t attempt);
+
+private:
+    struct TimerNode {
+        TimerId id = INVALID_TIMER_ID;
+        uint32_t rounds = 0;
+        uint32_t intervalTicks = 0;
+        std::function<void()> task;
+    };
+    using TIMER_NODE_LIST = std::list<TimerNode>;
+
+    struct TimerPos {
+        uint32_t slot = 0;
+        TIMER_NODE_LIST::iterator it;
+    };
+
+    TimerId AddTimer(uint32_t delayMs, uint32_t intervalTicks, const std::function<void()> &task);
+    void InsertLocked(TimerNode &&node, uint32_t ticks);
+    void Run();
+    void Tick(std::unique_lock<std::mutex> &lock);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::condition_variable runningCond_;
+    bool stop_ = false;
+    TimerId nextId_ = INVALID_TIMER_ID;
+    TimerId runningId_ = INVALID_TIMER_ID;
+    bool runningCancelled_ = false;
+    uint32_t currentSlot_ = 0;
+    std::chrono::steady_clock::time_point nextTick_;
+    std::vector<TIMER_NODE_LIST> slots_;
+    TIMER_NODE_LIST expired_;
+    std::unordered_map<TimerId, TimerPos> index_;
+    std::thread thread_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_MANAGER_TIMER_WHEEL_H
@@ -19,8 +19,10 @@
 #include <signal.h>
 #include "net_conn_types.h"
 #else
+#include <cerrno>
 #include <sys/ioctl.h>
 #include <fcntl.h>
+#include "route_netlink_batch.h"
 #endif
 
 namespace OHOS {
@@ -166,6 +168,46 @@ int32_t NetdController::NetworkRemoveRoute(int32_t netId, const std::string &ifN
 #endif
 }
 
+int32_t NetdController::NetworkApplyRouteDelta(int32_t netId, const std::vector<Route> &removed,
+    const std::vector<Route> &added)
+{
+    NETMGR_LOGI("Apply route delta: netId[%{public}d], removed[%{public}zu], added[%{public}zu]", netId,
+        removed.size(), added.size());
+#ifdef NATIVE_NETD_FEATURE
+    if (netdService_ == nullptr) {
+        NETMGR_LOGE("netdService_ is null");
+        return ERR_SERVICE_UPDATE_NET_LINK_INFO_FAIL;
+    }
+    /* netd owns the per interface route tables and has no batch call, so the delta goes route by route */
+    int32_t result = 0;
+    for (const auto &route : removed) {
+        int32_t ret = netdService_->networkRemoveRoute(netId, route.iface_, route.destination_.address_,
+            route.gateway_.address_);
+        result = (result == 0) ? ret : result;
+    }
+    for (const auto &route : added) {
+        int32_t ret = netdService_->networkAddRoute(netId, route.iface_, route.destination_.address_,
+            route.gateway_.address_);
+        result = (result == 0) ? ret : result;
+    }
+    return result;
+#else
+    RouteNetlinkBatch batch;
+    for (const auto &route : removed) {
+        batch.Remove(route);
+    }
+    for (const auto &route : added) {
+        batch.Add(route);
+    }
+    int32_t ret = batch.Commit();
+    if (ret != 0 || batch.Size() != removed.size() + added.size()) {
+        NETMGR_LOGE("Route delta partly failed: queued[%{public}zu], ret[%{public}d]", batch.Size(), ret);
+        return (ret != 0) ? ret : -EINVAL;
+    }
+    return 0;
+#endif
+}
+
 void NetdController::SetInterfaceDown(const std::string &iface)
 {
     NETMGR_LOGI("Set interface down: iface[%{public}s]", iface.c_str());
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "netlink_event_loop.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr int32_t EPOLL_MAX_EVENTS = 2;
+constexpr uint64_t WAKE_VALUE = 1;
+} // namespace
+
+NetlinkEventLoop::NetlinkEventLoop(uint32_t batchSize, uint32_t bufferSize)
+    : batchSize_(batchSize > 0 ? batchSize : DEFAULT_BATCH_SIZE),
+      bufferSize_(NLMSG_ALIGN(bufferSize > 0 ? bufferSize : DEFAULT_BUFFER_SIZE))
+{
+    /* The buffers are wired to the message headers once and reused by every recvmmsg call */
+    buffers_.resize(static_cast<size_t>(batchSize_) * bufferSize_);
+    iovecs_.resize(batchSize_);
+    msgs_.resize(batchSize_);
+    for (uint32_t i = 0; i < batchSize_; i++) {
+        iovecs_[i].iov_base = buffers_.data() + static_cast<size_t>(i) * bufferSize_;
+        iovecs_[i].iov_len = bufferSize_;
+        msgs_[i] = {};
+        msgs_[i].msg_hdr.msg_iov = &iovecs_[i];
+        msgs_[i].msg_hdr.msg_iovlen = 1;
+    }
+}
+
+NetlinkEventLoop::~NetlinkEventLoop()
+{
+    Stop();
+}
+
+int32_t NetlinkEventLoop::CreateSocket(int32_t protocol, uint32_t groups, int32_t rcvBufSize)
+{
+    int32_t fd = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol);
+    if (fd < 0) {
+        NETMGR_LOGE("NetlinkEventLoop create socket failed, errno[%{public}d]", errno);
+        return -1;
+    }
+    /* The forced size ignores rmem_max but needs CAP_NET_ADMIN, fall back to the limited one */
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &rcvBufSize, sizeof(rcvBufSize)) != 0 &&
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvBufSize, sizeof(rcvBufSize)) != 0) {
+        NETMGR_LOGE("NetlinkEventLoop set rcvbuf failed, errno[%{public}d]", errno);
+        close(fd);
+        return -1;
+    }
+    struct sockaddr_nl sa = {};
+    sa.nl_family = AF_NETLINK;
+    sa.nl_groups = groups;
+    if (bind(fd, reinterpret_cast<struct sockaddr *>(&sa), sizeof(sa)) != 0) {
+        NETMGR_LOGE("NetlinkEventLoop bind failed, errno[%{public}d]", errno);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool NetlinkEventLoop::Start(int32_t fd, const MessageCallback &onMessage, const OverflowCallback &onOverflow)
+{
+    if (fd < 0) {
+        return false;
+    }
+    if (running_) {
+        /* The running loop keeps the socket it was started on */
+        NETMGR_LOGI("NetlinkEventLoop is already running");
+        close(fd);
+        return true;
+    }
+    /* A loop that died on its own still has its thread and descriptors */
+    Stop();
+    sockFd_ = fd;
+    int32_t flags = fcntl(sockFd_, F_GETFL);
+    if (flags < 0 || fcntl(sockFd_, F_SETFL, flags | O_NONBLOCK) < 0) {
+        NETMGR_LOGE("NetlinkEventLoop set nonblock failed, errno[%{public}d]", errno);
+        CloseFds();
+        return false;
+    }
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd_ < 0 || wakeFd_ < 0) {
+        NETMGR_LOGE("NetlinkEventLoop create epoll failed, errno[%{public}d]", errno);
+        CloseFds();
+        return false;
+    }
+    struct epoll_event sockEvent = {};
+    sockEvent.events = EPOLLIN | EPOLLET;
+    sockEvent.data.fd = sockFd_;
+    struct epoll_event wakeEvent = {};
+    wakeEvent.events = EPOLLIN;
+    wakeEvent.data.fd = wakeFd_;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, sockFd_, &sockEvent) != 0 ||
+        epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &wakeEvent) != 0) {
+        NETMGR_LOGE("NetlinkEventLoop epoll_ctl failed, errno[%{public}d]", errno);
+        CloseFds();
+        return false;
+    }
+    onMessage_ = onMessage;
+    onOverflow_ = onOverflow;
+    running_ = true;
+    thread_ = std::thread(&NetlinkEventLoop::Run, this);
+    return true;
+}
+
+void NetlinkEventLoop::Stop()
+{
+    running_ = false;
+    if (!thread_.joinable()) {
+        return;
+    }
+    uint64_t value = WAKE_VALUE;
+    if (TEMP_FAILURE_RETRY(write(wakeFd_, &value, sizeof(value))) < 0) {
+        NETMGR_LOGE("NetlinkEventLoop wake failed, errno[%{public}d]", errno);
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    CloseFds();
+}
+
+bool NetlinkEventLoop::IsRunning() const
+{
+    return running_;
+}
+
+NetlinkEventLoopStats NetlinkEventLoop::GetStats() const
+{
+    NetlinkEventLoopStats stats;
+    stats.wakeups = wakeups_;
+    stats.batches = batches_;
+    stats.datagrams = datagrams_;
+    stats.messages = messages_;
+    stats.overflows = overflows_;
+    stats.truncated = truncated_;
+    return stats;
+}
+
+void NetlinkEventLoop::Run()
+{
+    struct epoll_event events[EPOLL_MAX_EVENTS];
+    while (running_) {
+        int32_t count = epoll_wait(epollFd_, events, EPOLL_MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            NETMGR_LOGE("NetlinkEventLoop epoll_wait failed, errno[%{public}d], loop stopped", errno);
+            running_ = false;
+            return;
+        }
+        for (int32_t i = 0; i < count; i++) {
+            if (events[i].data.fd == wakeFd_) {
+                return;
+            }
+            wakeups_++;
+            if (!Drain()) {
+                NETMGR_LOGE("NetlinkEventLoop read failed, loop stopped");
+                running_ = false;
+                return;
+            }
+        }
+    }
+}
+
+bool NetlinkEventLoop::Drain()
+{
+    /* Edge triggered: keep reading until the queue is empty or no further wakeup will come */
+    while (true) {
+        int32_t count = recvmmsg(sockFd_, msgs_.data(), batchSize_, MSG_DONTWAIT, nullptr);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return true;
+            }
+            if (errno == ENOBUFS) {
+                overflows_++;
+                NotifyOverflow();
+                continue;
+            }
+            NETMGR_LOGE("NetlinkEventLoop recvmmsg failed, errno[%{public}d]", errno);
+            return false;
+        }
+        if (count == 0) {
+            return true;
+        }
+        batches_++;
+        bool isLost = false;
+        for (int32_t i = 0; i < count; i++) {
+            datagrams_++;
+            if (msgs_[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                truncated_++;
+                isLost = true;
+                continue;
+            }
+            DispatchDatagram(static_cast<const uint8_t *>(iovecs_[i].iov_base), msgs_[i].msg_len);
+        }
+        if (isLost) {
+            NotifyOverflow();
+        }
+    }
+}
+
+void NetlinkEventLoop::DispatchDatagram(const uint8_t *data, uint32_t len)
+{
+    int32_t remain = static_cast<int32_t>(len);
+    for (auto nh = reinterpret_cast<const struct nlmsghdr *>(data); NLMSG_OK(nh, remain);
+        nh = NLMSG_NEXT(nh, remain)) {
+        if (nh->nlmsg_type == NLMSG_NOOP) {
+            continue;
+        }
+        messages_++;
+        if (onMessage_) {
+            onMessage_(*nh);
+        }
+    }
+}
+
+void NetlinkEventLoop::NotifyOverflow()
+{
+    NETMGR_LOGE("NetlinkEventLoop events lost, resync");
+    if (onOverflow_) {
+        onOverflow_();
+    }
+}
+
+void NetlinkEventLoop::CloseFds()
+{
+    for (int32_t *fd : {&sockFd_, &epollFd_, &wakeFd_}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
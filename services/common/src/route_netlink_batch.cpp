@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "route_netlink_batch.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <linux/netlink.h>
+
+#include "net_mgr_log_wrapper.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t ACK_TIMEOUT_SECONDS = 1;
+constexpr size_t ACK_BUFFER_SIZE = 32768;
+constexpr int32_t IPV4_PREFIX_MAX = 32;
+constexpr int32_t IPV6_PREFIX_MAX = 128;
+constexpr int32_t DECIMAL_BASE = 10;
+
+struct RouteAddress {
+    uint8_t family = AF_UNSPEC;
+    uint8_t length = 0;
+    uint8_t bytes[sizeof(in6_addr)] = {0};
+};
+
+bool ParseAddress(const std::string &text, RouteAddress &address)
+{
+    if (inet_pton(AF_INET, text.c_str(), address.bytes) == 1) {
+        address.family = AF_INET;
+        address.length = sizeof(in_addr);
+        return true;
+    }
+    if (inet_pton(AF_INET6, text.c_str(), address.bytes) == 1) {
+        address.family = AF_INET6;
+        address.length = sizeof(in6_addr);
+        return true;
+    }
+    return false;
+}
+
+bool IsUnspecified(const RouteAddress &address)
+{
+    for (uint8_t i = 0; i < address.length; ++i) {
+        if (address.bytes[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ParseDestination(const std::string &text, RouteAddress &address, int32_t &prefix)
+{
+    size_t slash = text.find('/');
+    if (!ParseAddress(text.substr(0, slash), address)) {
+        return false;
+    }
+    int32_t maxPrefix = (address.family == AF_INET) ? IPV4_PREFIX_MAX : IPV6_PREFIX_MAX;
+    if (slash == std::string::npos) {
+        prefix = IsUnspecified(address) ? 0 : maxPrefix;
+        return true;
+    }
+    std::string prefixText = text.substr(slash + 1);
+    char *end = nullptr;
+    long value = strtol(prefixText.c_str(), &end, DECIMAL_BASE);
+    if (prefixText.empty() || *end != '\0' || value < 0 || value > maxPrefix) {
+        return false;
+    }
+    prefix = static_cast<int32_t>(value);
+    return true;
+}
+
+void AppendAttribute(std::vector<uint8_t> &buf, uint16_t type, const void *data, size_t len)
+{
+    size_t offset = buf.size();
+    buf.resize(offset + RTA_SPACE(len), 0);
+    auto attr = reinterpret_cast<rtattr *>(buf.data() + offset);
+    attr->rta_type = type;
+    attr->rta_len = RTA_LENGTH(len);
+    memcpy_s(RTA_DATA(attr), len, data, len);
+}
+} // namespace
+
+RouteNetlinkBatch::RouteNetlinkBatch(uint32_t table) : table_(table) {}
+
+bool RouteNetlinkBatch::Add(const std::string &ifName, const std::string &destination, const std::string &nextHop)
+{
+    return Append(RTM_NEWROUTE, ifName, destination, nextHop);
+}
+
+bool RouteNetlinkBatch::Remove(const std::string &ifName, const std::string &destination, const std::string &nextHop)
+{
+    return Append(RTM_DELROUTE, ifName, destination, nextHop);
+}
+
+size_t RouteNetlinkBatch::Size() const
+{
+    return offsets_.size() - 1;
+}
+
+const std::vector<uint8_t> &RouteNetlinkBatch::GetMessages() const
+{
+    return messages_;
+}
+
+const std::vector<int32_t> &RouteNetlinkBatch::GetErrors() const
+{
+    return errors_;
+}
+
+bool RouteNetlinkBatch::Add(const Route &route)
+{
+    return Append(RTM_NEWROUTE, route);
+}
+
+bool RouteNetlinkBatch::Remove(const Route &route)
+{
+    return Append(RTM_DELROUTE, route);
+}
+
+bool RouteNetlinkBatch::Append(uint16_t type, const std::string &ifName, const std::string &destination,
+    const std::string &nextHop)
+{
+    RouteAddress dst;
+    int32_t prefix = 0;
+    if (!ParseDestination(destination, dst, prefix)) {
+        NETMGR_LOGE("Invalid route destination[%{public}s]", destination.c_str());
+        return false;
+    }
+    RouteAddress gateway;
+    if (!nextHop.empty()) {
+        if (!ParseAddress(nextHop, gateway) || gateway.family != dst.family) {
+            NETMGR_LOGE("Invalid route gateway[%{public}s]", nextHop.c_str());
+            return false;
+        }
+    }
+    bool hasGateway = gateway.family != AF_UNSPEC && !IsUnspecified(gateway);
+    return Append(type, ifName, dst.family, dst.bytes, prefix, hasGateway ? gateway.bytes : nullptr);
+}
+
+bool RouteNetlinkBatch::Append(uint16_t type, const Route &route)
+{
+    if (!route.destination_.parsed_ || (!route.gateway_.address_.empty() && !route.gateway_.parsed_)) {
+        std::string destination = route.destination_.address_;
+        if (route.destination_.prefixlen_ != 0) {
+            destination += "/" + std::to_string(route.destination_.prefixlen_);
+        }
+        return Append(type, route.iface_, destination, route.gateway_.address_);
+    }
+    RouteAddress dst;
+    dst.family = route.destination_.addrFamily_;
+    dst.length = (dst.family == AF_INET) ? sizeof(in_addr) : sizeof(in6_addr);
+    int32_t maxPrefix = (dst.family == AF_INET) ? IPV4_PREFIX_MAX : IPV6_PREFIX_MAX;
+    memcpy_s(dst.bytes, sizeof(dst.bytes), route.destination_.addrBytes_.data(), dst.length);
+    int32_t prefix = route.destination_.prefixlen_;
+    if (prefix == 0) {
+        prefix = IsUnspecified(dst) ? 0 : maxPrefix;
+    }
+    if (prefix > maxPrefix) {
+        NETMGR_LOGE("Invalid route prefix[%{public}d]", prefix);
+        return false;
+    }
+    RouteAddress gateway;
+    if (route.gateway_.parsed_) {
+        if (route.gateway_.addrFamily_ != dst.family) {
+            NETMGR_LOGE("Invalid route gateway[%{public}s]", route.gateway_.address_.c_str());
+            return false;
+        }
+        gateway.family = dst.family;
+        gateway.length = dst.length;
+        memcpy_s(gateway.bytes, sizeof(gateway.bytes), route.gateway_.addrBytes_.data(), gateway.length);
+    }
+    bool hasGateway = gateway.family != AF_UNSPEC && !IsUnspecified(gateway);
+    return Append(type, route.iface_, dst.family, dst.bytes, prefix, hasGateway ? gateway.bytes : nullptr);
+}
+
+uint32_t RouteNetlinkBatch::GetIfIndex(const std::string &ifName)
+{
+    if (ifName != lastIfName_ || lastIfIndex_ == 0) {
+        lastIfName_ = ifName;
+        lastIfIndex_ = if_nametoindex(ifName.c_str());
+    }
+    return lastIfIndex_;
+}
+
+bool RouteNetlinkBatch::Append(uint16_t type, const std::string &ifName, uint8_t family, const uint8_t *destination,
+    int32_t prefix, const uint8_t *gateway)
+{
+    uint32_t ifIndex = 0;
+    if (!ifName.empty()) {
+        ifIndex = GetIfIndex(ifName);
+        if (ifIndex == 0) {
+            NETMGR_LOGE("Route interface[%{public}s] not found", ifName.c_str());
+            return false;
+        }
+    }
+    size_t addressLength = (family == AF_INET) ? sizeof(in_addr) : sizeof(in6_addr);
+    bool hasGateway = gateway != nullptr;
+
+    std::vector<uint8_t> msg(NLMSG_SPACE(sizeof(rtmsg)), 0);
+    auto rtm = reinterpret_cast<rtmsg *>(NLMSG_DATA(reinterpret_cast<nlmsghdr *>(msg.data())));
+    rtm->rtm_family = family;
+    rtm->rtm_dst_len = static_cast<uint8_t>(prefix);
+    rtm->rtm_table = (table_ < RT_TABLE_COMPAT) ? static_cast<uint8_t>(table_) : static_cast<uint8_t>(RT_TABLE_UNSPEC);
+    if (type == RTM_NEWROUTE) {
+        rtm->rtm_protocol = RTPROT_STATIC;
+        rtm->rtm_scope = hasGateway ? RT_SCOPE_UNIVERSE : RT_SCOPE_LINK;
+        rtm->rtm_type = RTN_UNICAST;
+    } else {
+        rtm->rtm_scope = RT_SCOPE_NOWHERE;
+    }
+    AppendAttribute(msg, RTA_TABLE, &table_, sizeof(table_));
+    if (prefix > 0) {
+        AppendAttribute(msg, RTA_DST, destination, addressLength);
+    }
+    if (hasGateway) {
+        AppendAttribute(msg, RTA_GATEWAY, gateway, addressLength);
+    }
+    if (ifIndex != 0) {
+        AppendAttribute(msg, RTA_OIF, &ifIndex, sizeof(ifIndex));
+    }
+
+    auto hdr = reinterpret_cast<nlmsghdr *>(msg.data());
+    hdr->nlmsg_len = msg.size();
+    hdr->nlmsg_type = type;
+    hdr->nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK;
+    if (type == RTM_NEWROUTE) {
+        hdr->nlmsg_flags |= NLM_F_CREATE | NLM_F_EXCL;
+    }
+    /* Every Commit uses its own socket, so the queue position is a unique sequence number */
+    hdr->nlmsg_seq = static_cast<uint32_t>(Size() + 1);
+    messages_.insert(messages_.end(), msg.begin(), msg.end());
+    offsets_.push_back(messages_.size());
+    return true;
+}
+
+uint32_t RouteNetlinkBatch::ParseAcks(const uint8_t *buf, size_t len, std::vector<int32_t> &errors)
+{
+    uint32_t answered = 0;
+    int32_t remaining = static_cast<int32_t>(len);
+    for (auto hdr = reinterpret_cast<const nlmsghdr *>(buf); NLMSG_OK(hdr, remaining);
+         hdr = NLMSG_NEXT(hdr, remaining)) {
+        if (hdr->nlmsg_type != NLMSG_ERROR || hdr->nlmsg_len < NLMSG_LENGTH(sizeof(nlmsgerr))) {
+            continue;
+        }
+        size_t index = static_cast<size_t>(hdr->nlmsg_seq) - 1;
+        if (hdr->nlmsg_seq == 0 || index >= errors.size() || errors[index] != ACK_PENDING) {
+            continue;
+        }
+        auto err = reinterpret_cast<const nlmsgerr *>(NLMSG_DATA(hdr));
+        int32_t error = err->error;
+        if ((err->msg.nlmsg_type == RTM_NEWROUTE && error == -EEXIST) ||
+            (err->msg.nlmsg_type == RTM_DELROUTE && error == -ESRCH)) {
+            error = 0;
+        }
+        errors[index] = error;
+        ++answered;
+    }
+    return answered;
+}
+
+void RouteNetlinkBatch::FailPending(size_t begin, size_t end, int32_t error)
+{
+    for (size_t i = begin; i < end; ++i) {
+        if (errors_[i] == ACK_PENDING) {
+            errors_[i] = error;
+        }
+    }
+}
+
+int32_t RouteNetlinkBatch::Commit()
+{
+    size_t count = Size();
+    errors_.assign(count, ACK_PENDING);
+    if (count == 0) {
+        return 0;
+    }
+    int32_t fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0) {
+        int32_t error = -errno;
+        NETMGR_LOGE("Open route netlink socket failed, errno[%{public}d]", errno);
+        FailPending(0, count, error);
+        return error;
+    }
+    timeval timeout = {ACK_TIMEOUT_SECONDS, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_nl kernel = {};
+    kernel.nl_family = AF_NETLINK;
+    std::vector<uint8_t> reply(ACK_BUFFER_SIZE);
+
+    for (size_t begin = 0; begin < count; begin += MAX_MESSAGES_PER_SEND) {
+        size_t end = std::min(count, begin + MAX_MESSAGES_PER_SEND);
+        size_t len = offsets_[end] - offsets_[begin];
+        ssize_t sent = sendto(fd, messages_.data() + offsets_[begin], len, 0,
+            reinterpret_cast<sockaddr *>(&kernel), sizeof(kernel));
+        if (sent != static_cast<ssize_t>(len)) {
+            NETMGR_LOGE("Send route batch failed, errno[%{public}d]", errno);
+            FailPending(begin, count, (sent < 0) ? -errno : -EIO);
+            break;
+        }
+        size_t answered = 0;
+        while (answered < end - begin) {
+            ssize_t received = recv(fd, reply.data(), reply.size(), 0);
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received <= 0) {
+                NETMGR_LOGE("Wait route batch ACK failed, errno[%{public}d]", errno);
+                FailPending(begin, end, (received < 0) ? -errno : -EIO);
+                break;
+            }
+            answered += ParseAcks(reply.data(), static_cast<size_t>(received), errors_);
+        }
+    }
+    close(fd);
+
+    for (int32_t error : errors_) {
+        if (error != 0) {
+            return error;
+        }
+    }
+    return 0;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
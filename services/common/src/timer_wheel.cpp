@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "timer_wheel.h"
+
+#include <random>
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t TICK_MS = 10;
+constexpr uint32_t SLOT_NUM = 512;
+constexpr uint32_t EXPIRED_SLOT = SLOT_NUM;
+constexpr uint32_t BACKOFF_MAX_SHIFT = 31;
+
+uint32_t ToTicks(uint32_t ms)
+{
+    uint32_t ticks = (ms + TICK_MS - 1) / TICK_MS;
+    return (ticks == 0) ? 1 : ticks;
+}
+} // namespace
+
+TimerWheel::TimerWheel() : slots_(SLOT_NUM)
+{
+    thread_ = std::thread([this]() { Run(); });
+}
+
+TimerWheel::~TimerWheel()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    if (!thread_.joinable()) {
+        return;
+    }
+    if (thread_.get_id() == std::this_thread::get_id()) {
+        thread_.detach();
+    } else {
+        thread_.join();
+    }
+}
+
+TimerWheel::TimerId TimerWheel::StartOnce(uint32_t delayMs, const std::function<void()> &task)
+{
+    return AddTimer(delayMs, 0, task);
+}
+
+TimerWheel::TimerId TimerWheel::StartPeriodic(uint32_t intervalMs, const std::function<void()> &task)
+{
+    return AddTimer(intervalMs, ToTicks(intervalMs), task);
+}
+
+TimerWheel::TimerId TimerWheel::AddTimer(uint32_t delayMs, uint32_t intervalTicks, const std::function<void()> &task)
+{
+    if (task == nullptr) {
+        NETMGR_LOGE("timer task is nullptr");
+        return INVALID_TIMER_ID;
+    }
+    TimerNode node;
+    node.intervalTicks = intervalTicks;
+    node.task = task;
+    std::unique_lock<std::mutex> lock(mutex_);
+    node.id = ++nextId_;
+    bool idle = index_.empty() && runningId_ == INVALID_TIMER_ID;
+    if (idle) {
+        nextTick_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(TICK_MS);
+    }
+    TimerId timerId = node.id;
+    InsertLocked(std::move(node), ToTicks(delayMs));
+    lock.unlock();
+    if (idle) {
+        cond_.notify_all();
+    }
+    return timerId;
+}
+
+void TimerWheel::InsertLocked(TimerNode &&node, uint32_t ticks)
+{
+    uint32_t slot = (currentSlot_ + ticks) % SLOT_NUM;
+    node.rounds = (ticks - 1) / SLOT_NUM;
+    TimerId timerId = node.id;
+    auto it = slots_[slot].insert(slots_[slot].end(), std::move(node));
+    TimerPos pos;
+    pos.slot = slot;
+    pos.it = it;
+    index_[timerId] = pos;
+}
+
+bool TimerWheel::Cancel(TimerId timerId)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = index_.find(timerId);
+    if (it != index_.end()) {
+        TIMER_NODE_LIST &list = (it->second.slot == EXPIRED_SLOT) ? expired_ : slots_[it->second.slot];
+        list.erase(it->second.it);
+        index_.erase(it);
+        return true;
+    }
+    if (timerId == INVALID_TIMER_ID || timerId != runningId_) {
+        return false;
+    }
+    runningCancelled_ = true;
+    if (thread_.get_id() != std::this_thread::get_id()) {
+        runningCond_.wait(lock, [this, timerId]() { return runningId_ != timerId; });
+    }
+    return true;
+}
+
+bool TimerWheel::IsPending(TimerId timerId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.find(timerId) != index_.end() || (timerId != INVALID_TIMER_ID && timerId == runningId_);
+}
+
+size_t TimerWheel::GetPendingSize()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.size();
+}
+
+uint32_t TimerWheel::GetBackoffDelay(uint32_t baseMs, uint32_t maxMs, uint32_t attempt)
+{
+    uint64_t delay = baseMs;
+    uint32_t shift = (attempt > BACKOFF_MAX_SHIFT) ? BACKOFF_MAX_SHIFT : attempt;
+    delay <<= shift;
+    if (delay > maxMs) {
+        delay = maxMs;
+    }
+    uint64_t half = delay / 2;
+    thread_local std::mt19937 engine(std::random_device {}());
+    std::uniform_int_distribution<uint64_t> jitter(0, delay - half);
+    return static_cast<uint32_t>(half + jitter(engine));
+}
+
+void TimerWheel::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        if (index_.empty()) {
+            // Nothing to wait for, sleep until a timer is added instead of ticking
+            cond_.wait(lock, [this]() { return stop_ || !index_.empty(); });
+            continue;
+        }
+        if (cond_.wait_until(lock, nextTick_, [this]() { return stop_; })) {
+            break;
+        }
+        nextTick_ += std::chrono::milliseconds(TICK_MS);
+        Tick(lock);
+    }
+}
+
+void TimerWheel::Tick(std::unique_lock<std::mutex> &lock)
+{
+    currentSlot_ = (currentSlot_ + 1) % SLOT_NUM;
+    TIMER_NODE_LIST &slot = slots_[currentSlot_];
+    for (auto it = slot.begin(); it != slot.end();) {
+        if (it->rounds > 0) {
+            it->rounds--;
+            ++it;
+            continue;
+        }
+        auto next = std::next(it);
+        index_[it->id].slot = EXPIRED_SLOT;
+        expired_.splice(expired_.end(), slot, it);
+        it = next;
+    }
+
+    while (!expired_.empty()) {
+        TimerNode node = std::move(expired_.front());
+        expired_.pop_front();
+        index_.erase(node.id);
+        runningId_ = node.id;
+        runningCancelled_ = false;
+        lock.unlock();
+        node.task();
+        lock.lock();
+        if (node.intervalTicks > 0 && !runningCancelled_ && !stop_) {
+            uint32_t ticks = node.intervalTicks;
+            InsertLocked(std::move(node), ticks);
+        }
+        runningId_ = INVALID_TIMER_ID;
+        runningCond_.notify_all();
+    }
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_ADDR_SORTER_H
+#define DNS_ADDR_SORTER_H
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "inet_addr.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/* Fills the source address the kernel would use towards the destination, false when there is no route */
+using DnsSourceLookup = std::function<bool(const INetAddr &dest, INetAddr &source)>;
+
+/**
+ * Remembers the source address towards each destination for a short while, so answers that keep naming the same
+ * addresses probe the route once per TTL instead of once per answer. A full cache starts over.
+ */
+class DnsSourceCache {
+public:
+    static constexpr uint32_t DEFAULT_TTL_MS = 3000;
+    static constexpr size_t MAX_ENTRIES = 256;
+
+    explicit DnsSourceCache(const DnsSourceLookup &lookup, uint32_t ttlMs = DEFAULT_TTL_MS);
+
+    /**
+     * @brief Find the source address towards the destination, probing only when it is not cached
+     *
+     * @param dest The destination
+     * @param source Set to the source address
+     * @return Returns false when there is no route, that answer is cached as well
+     */
+    bool Lookup(const INetAddr &dest, INetAddr &source);
+    void Clear();
+
+private:
+    struct Entry {
+        bool found = false;
+        INetAddr source;
+        std::chrono::steady_clock::time_point expiry;
+    };
+
+    DnsSourceLookup lookup_;
+    std::chrono::milliseconds ttl_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+/**
+ * Orders the answers of a lookup by the destination address selection rules of RFC 6724 with its default policy
+ * table: unusable destinations last, then matching scope, matching label, higher precedence, smaller scope and
+ * longest matching prefix. Rules 3, 4 and 7 need source address flags the resolver does not know and are skipped.
+ * Addresses no rule separates keep the order of the answer.
+ */
+class DnsAddrSorter {
+public:
+    /**
+     * @brief Sort the addresses, the source of each one is found by connecting a UDP socket to it, cached for
+     * DnsSourceCache::DEFAULT_TTL_MS
+     *
+     * @param addrInfo The numeric addresses of one host
+     */
+    static void Sort(std::vector<INetAddr> &addrInfo);
+
+    /**
+     * @brief Forget the cached sources, for when the routes of the device changed
+     */
+    static void ClearSourceCache();
+
+    /**
+     * @brief Sort the addresses with the given source lookup
+     *
+     * @param addrInfo The numeric addresses of one host
+     * @param lookup Finds the source address towards each destination
+     */
+    static void Sort(std::vector<INetAddr> &addrInfo, const DnsSourceLookup &lookup);
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_ADDR_SORTER_H
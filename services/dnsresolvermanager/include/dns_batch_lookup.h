@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_BATCH_LOOKUP_H
+#define DNS_BATCH_LOOKUP_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dns_addr_blob.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using DnsLookupFunc = std::function<int32_t(const std::string &hostName, DnsAddrBlob &addrBlob)>;
+using DnsLookupDone = std::function<void(int32_t result, const DnsAddrBlob &addrBlob)>;
+
+/**
+ * Fans the lookups of a batch out over a worker pool shared by every batch, so the batch costs about its slowest
+ * lookup instead of the sum of all of them. The calling thread resolves names too, and the pool never grows past
+ * maxWorkers - 1 threads however many batches run at once. A name given more than once is resolved once and its
+ * result is copied. Addresses stay packed the way the reply carries them. A single name can also be posted to the
+ * pool without waiting for it, it then queues behind the names of the running batches.
+ */
+class DnsBatchLookup {
+public:
+    static constexpr uint32_t DEFAULT_MAX_WORKERS = 8;
+
+    /**
+     * @param maxWorkers Upper bound of concurrent lookups of one batch, the calling thread included, 1 resolves
+     *        the names in the calling thread only
+     */
+    explicit DnsBatchLookup(uint32_t maxWorkers = DEFAULT_MAX_WORKERS);
+    ~DnsBatchLookup();
+    DnsBatchLookup(const DnsBatchLookup &) = delete;
+    DnsBatchLookup &operator=(const DnsBatchLookup &) = delete;
+
+    /**
+     * @brief Resolve every name of the batch, returns once all of them are resolved
+     *
+     * @param hostNames The host names
+     * @param lookup Resolves one name, called concurrently from the calling thread and the pool
+     * @param results Set to the result code of each name, in the order of hostNames
+     * @param addrBlobs Set to the addresses of each name, in the order of hostNames
+     */
+    void Run(const std::vector<std::string> &hostNames, const DnsLookupFunc &lookup,
+        std::vector<int32_t> &results, std::vector<DnsAddrBlob> &addrBlobs);
+
+    /**
+     * @brief Resolve one name on the pool, returns at once
+     *
+     * @param hostName The host name
+     * @param lookup Resolves the name, called from the pool, or from the calling thread when the pool has no threads
+     * @param done Receives the result in the thread that resolved the name, not called when the pool is destroyed
+     *        first
+     */
+    void Post(const std::string &hostName, const DnsLookupFunc &lookup, const DnsLookupDone &done);
+
+private:
+    struct Batch;
+
+    static void Work(Batch &batch);
+    void RunWorker();
+
+private:
+    uint32_t maxWorkers_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    /* One entry per pool thread a batch asks for, a thread finding its batch finished moves on at once */
+    std::deque<std::shared_ptr<Batch>> pending_;
+    std::vector<std::thread> workers_;
+    bool stop_ = false;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_BATCH_LOOKUP_H
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_DUAL_STACK_QUERY_H
+#define DNS_DUAL_STACK_QUERY_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "dns_query_engine.h"
+#include "inet_addr.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using DnsPartialCallback = std::function<void(const std::vector<INetAddr> &addrInfo)>;
+
+/**
+ * Resolves both address families of a name at once on the query engine instead of one after the other. The
+ * addresses of the first family to answer are handed out straight away so a connection attempt can start, the
+ * merged answer follows once the other family is in. Both lists are ordered by DnsAddrSorter.
+ */
+class DnsDualStackQuery {
+public:
+    /**
+     * @brief Queue the AAAA and the A query of a name
+     *
+     * @param engine The running query engine
+     * @param hostName The host name, already validated
+     * @param servers Numeric addresses of the upstream servers
+     * @param timeoutMs Deadline of each attempt
+     * @param retryCount Number of attempts after the first one of each family
+     * @param onPartial Receives the addresses of the first family when it has some, always before onComplete
+     * @param onComplete Receives the addresses of both families, succeeds when either family has addresses, gets
+     *        DnsQueryEngine::RESULT_TRUNCATED and no addresses when either reply was truncated
+     * @param netId The network the servers belong to, only the default network is accepted
+     * @return Returns 0 when the queries are queued, the callbacks are not called otherwise
+     */
+    static int32_t Start(DnsQueryEngine &engine, const std::string &hostName, const std::vector<std::string> &servers,
+        uint32_t timeoutMs, uint8_t retryCount, const DnsPartialCallback &onPartial,
+        const DnsQueryCallback &onComplete, uint16_t netId = 0);
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_DUAL_STACK_QUERY_H
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_HOSTS_FILE_H
+#define DNS_HOSTS_FILE_H
+
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+#include "inet_addr.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * The static entries of the hosts file, for the lookups that do not go through the system resolver. The file is
+ * parsed on first use and again whenever its modification time or size changes, names match case insensitively.
+ */
+class DnsHostsFile {
+public:
+    static constexpr const char *DEFAULT_PATH = "/etc/hosts";
+
+    explicit DnsHostsFile(const std::string &path = DEFAULT_PATH);
+    ~DnsHostsFile() = default;
+    DnsHostsFile(const DnsHostsFile &) = delete;
+    DnsHostsFile &operator=(const DnsHostsFile &) = delete;
+
+    /**
+     * @brief Look a name up in the hosts file
+     *
+     * @param hostName The host name
+     * @param family AF_INET or AF_INET6 for the addresses of one family, AF_UNSPEC for both
+     * @param addrInfo Receives the addresses in file order
+     * @return Returns true if the file lists the name with an address of the family
+     */
+    bool Lookup(const std::string &hostName, int32_t family, std::vector<INetAddr> &addrInfo);
+
+private:
+    void ReloadIfChanged();
+
+private:
+    std::string path_;
+    std::mutex mutex_;
+    bool loaded_ = false;
+    time_t mtime_ = 0;
+    long mtimeNsec_ = 0;
+    off_t size_ = 0;
+    std::unordered_map<std::string, std::vector<INetAddr>> entries_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_HOSTS_FILE_H
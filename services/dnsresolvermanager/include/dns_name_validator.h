@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_NAME_VALIDATOR_H
+#define DNS_NAME_VALIDATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Host name syntax check of RFC 1035 and RFC 1123 run as a small DFA over the characters, in one pass and without
+ * allocation. Labels hold letters, digits, hyphens and, as resolvers accept for service names, underscores; they
+ * are 1 to 63 characters long and do not start or end with a hyphen. The whole name is at most 253 characters, not
+ * counting one optional trailing dot. Single label names and long top level domains are valid.
+ */
+class DnsNameValidator {
+public:
+    static constexpr size_t MAX_NAME_LEN = 253;
+    static constexpr size_t MAX_LABEL_LEN = 63;
+
+    static bool IsValid(const char *name, size_t len);
+    static bool IsValid(const std::string &hostName)
+    {
+        return IsValid(hostName.data(), hostName.size());
+    }
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_NAME_VALIDATOR_H
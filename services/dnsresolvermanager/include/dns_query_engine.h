@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_QUERY_ENGINE_H
+#define DNS_QUERY_ENGINE_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "dns_resolver_stats.h"
+#include "dns_server_selector.h"
+#include "inet_addr.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+struct DnsQueryEngineStats {
+    uint64_t submitted = 0;
+    uint64_t answered = 0;
+    uint64_t failed = 0;
+    uint64_t timeouts = 0;
+    uint64_t retries = 0;
+    uint64_t strayReplies = 0;
+    uint32_t pending = 0;
+};
+
+using DnsQueryCallback = std::function<void(int32_t result, const std::vector<INetAddr> &addrInfo)>;
+
+/**
+ * Resolver that never blocks its callers on the network. Every outstanding query owns a connected non-blocking UDP
+ * socket registered with one epoll instance, and a single loop thread multiplexes the replies and the deadline of
+ * each attempt. An attempt that times out, is refused or gets a server failure is sent again to the next server
+ * until the retry budget is spent. The callback runs on the loop thread, so it must be short and must not call Stop.
+ * Should the loop fail, it stops and every outstanding query completes with EAI_AGAIN.
+ *
+ * The engine only speaks DNS over UDP to the given servers. It does not read the hosts file, does not append the
+ * search domains and does not bind its sockets to a network, so callers pass fully qualified names and servers
+ * reachable from the default network, and a query for any other network is refused. A truncated reply is not
+ * retried over TCP, the query completes with RESULT_TRUNCATED and no addresses so the caller can fall back to the
+ * system resolver instead of using a partial answer.
+ */
+class DnsQueryEngine {
+public:
+    static constexpr uint16_t DNS_PORT = 53;
+    static constexpr uint32_t DEFAULT_MAX_PENDING = 256;
+    static constexpr uint32_t DEFAULT_TIMEOUT_MS = 5000;
+    /* Positive so it cannot be mistaken for DNS_SUCCESS or a getaddrinfo error */
+    static constexpr int32_t RESULT_TRUNCATED = 1;
+
+    explicit DnsQueryEngine(uint16_t serverPort = DNS_PORT, uint32_t maxPending = DEFAULT_MAX_PENDING);
+    ~DnsQueryEngine();
+    DnsQueryEngine(const DnsQueryEngine &) = delete;
+    DnsQueryEngine &operator=(const DnsQueryEngine &) = delete;
+
+    /**
+     * @brief Count every attempt in the stats of its server, set before Start
+     *
+     * @param stats The stats, must outlive the engine
+     */
+    void SetStats(DnsResolverStats *stats);
+
+    /**
+     * @brief Let the health of the servers order them for every query, set before Start
+     *
+     * @param selector The selector fed by every attempt, must outlive the engine, the configured order is kept
+     * without it
+     */
+    void SetSelector(DnsServerSelector *selector);
+    bool Start();
+
+    /**
+     * @brief Stop the loop thread, queries still outstanding complete with EAI_AGAIN in the calling thread
+     */
+    void Stop();
+
+    /**
+     * @brief Whether queries are accepted, false once the loop failed even if Stop was not called
+     */
+    bool IsRunning() const;
+
+    /**
+     * @brief Queue a query, it is sent from the loop thread
+     *
+     * @param hostName The host name, already validated
+     * @param family AF_INET for an A query, AF_INET6 for an AAAA query
+     * @param servers Numeric addresses of the upstream servers, tried in turn from the one the selector ranks first
+     * @param timeoutMs Deadline of each attempt
+     * @param retryCount Number of attempts after the first one
+     * @param callback Receives the result code and the addresses
+     * @param netId The network the servers belong to, keys the stats and the server health, only the default
+     *        network is accepted as the sockets are not bound
+     * @return Returns 0 when the query is queued, the callback is not called otherwise
+     */
+    int32_t Query(const std::string &hostName, int32_t family, const std::vector<std::string> &servers,
+        uint32_t timeoutMs, uint8_t retryCount, const DnsQueryCallback &callback, uint16_t netId = 0);
+    DnsQueryEngineStats GetStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct PendingQuery {
+        std::string hostName;
+        uint16_t qtype = 0;
+        uint16_t netId = 0;
+        std::vector<sockaddr_storage> servers;
+        /* Parallel to servers */
+        std::vector<std::string> serverNames;
+        /* Parallel to servers, empty without stats */
+        std::vector<std::shared_ptr<DnsServerCounters>> counters;
+        uint32_t timeoutMs = 0;
+        uint32_t attempts = 0;
+        uint32_t maxAttempts = 0;
+        uint16_t id = 0;
+        int32_t fd = -1;
+        Clock::time_point sentAt;
+        Clock::time_point deadline;
+        DnsQueryCallback callback;
+    };
+
+    void Run();
+    int32_t GetWaitMs();
+    void TakeSubmissions();
+    void SendNextAttempt(uint64_t key, PendingQuery &query);
+    void HandleReadable(uint64_t key);
+    void ExpireDeadlines();
+    void CloseAttempt(uint64_t key, PendingQuery &query);
+    void RecordOutcome(const PendingQuery &query, DnsQueryOutcome outcome);
+    void Complete(uint64_t key, int32_t result, const std::vector<INetAddr> &addrInfo);
+    void FailAll();
+
+private:
+    uint16_t serverPort_;
+    uint32_t maxPending_;
+    int32_t epollFd_ = -1;
+    int32_t wakeFd_ = -1;
+    std::atomic<bool> running_ {false};
+    std::thread thread_;
+    std::mt19937 random_;
+    DnsResolverStats *stats_ = nullptr;
+    DnsServerSelector *selector_ = nullptr;
+
+    /* Queries handed over by Query, only this part is shared with the loop thread */
+    mutable std::mutex mutex_;
+    std::vector<PendingQuery> submissions_;
+    uint32_t inFlight_ = 0;
+
+    /* Owned by the loop thread */
+    uint64_t nextKey_ = 0;
+    std::unordered_map<uint64_t, PendingQuery> pending_;
+    std::set<std::pair<Clock::time_point, uint64_t>> deadlines_;
+
+    std::atomic<uint64_t> submitted_ {0};
+    std::atomic<uint64_t> answered_ {0};
+    std::atomic<uint64_t> failed_ {0};
+    std::atomic<uint64_t> timeouts_ {0};
+    std::atomic<uint64_t> retries_ {0};
+    std::atomic<uint64_t> strayReplies_ {0};
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_QUERY_ENGINE_H
@@ -16,9 +16,16 @@
 #ifndef DNS_RESOLVER_SERVICE_H
 #define DNS_RESOLVER_SERVICE_H
 
+#include <memory>
+
 #include "singleton.h"
 #include "system_ability.h"
 
+#include "dns_batch_lookup.h"
+#include "dns_hosts_file.h"
+#include "dns_query_engine.h"
+#include "dns_resolver_stats.h"
+#include "dns_server_selector.h"
 #include "ipc/dns_resolver_service_stub.h"
 
 namespace OHOS {
@@ -39,6 +46,7 @@ public:
     void OnStop() override;
 
     int32_t GetAddressesByName(const std::string &hostName, std::vector<INetAddr> &addrInfo) override;
+    int32_t GetAddressesByNamePacked(const std::string &hostName, DnsAddrBlob &addrBlob) override;
     int32_t GetAddrInfo(const std::string &hostName, const std::string &server,
         const sptr<DnsAddrInfo> &hints, std::vector<sptr<DnsAddrInfo>> &dnsAddrInfo) override;
     int32_t CreateNetworkCache(uint16_t netId) override;
@@ -48,13 +56,36 @@ public:
         const std::vector<std::string> &servers, const std::vector<std::string> &domains) override;
     int32_t GetResolverInfo(uint16_t netId, std::vector<std::string> &servers,
         std::vector<std::string> &domains, uint16_t &baseTimeoutMsec, uint8_t &retryCount) override;
+    int32_t GetAddressesByNames(const std::vector<std::string> &hostNames, std::vector<int32_t> &results,
+        std::vector<std::vector<INetAddr>> &addrInfos) override;
+    int32_t GetAddressesByNamesPacked(const std::vector<std::string> &hostNames, std::vector<int32_t> &results,
+        std::vector<DnsAddrBlob> &addrBlobs) override;
+    int32_t GetAddressesByNameAsync(const std::string &hostName,
+        const sptr<IDnsResolverCallback> &callback) override;
+    int32_t GetAddressesByNameDualStack(const std::string &hostName,
+        const sptr<IDnsResolverCallback> &callback) override;
+    int32_t GetResolverStats(uint16_t netId, std::vector<DnsServerStats> &stats) override;
+    int32_t Dump(int32_t fd, const std::vector<std::u16string> &args) override;
 
 private:
     bool Init();
+    bool GetUpstreamConfig(std::vector<std::string> &servers, std::vector<std::string> &domains,
+        uint16_t &baseTimeoutMsec, uint8_t &retryCount);
+    int32_t LookupBySystem(const std::string &hostName, int32_t family, DnsAddrBlob &addrBlob);
+    void ResolveBySystem(const std::string &hostName, int32_t family, const sptr<IDnsResolverCallback> &callback);
+    std::shared_ptr<DnsServerCounters> GetSystemCounters();
 
 private:
     ServiceRunningState state_ = ServiceRunningState::STATE_STOPPED;
     bool registerToService_ = false;
+    /* Declared before the engine, which keeps a pointer to it */
+    DnsResolverStats stats_;
+    /* Counters of the system resolver on the default network, read with std::atomic_load so a lookup takes no lock */
+    std::shared_ptr<DnsServerCounters> systemCounters_;
+    DnsServerSelector selector_;
+    DnsQueryEngine queryEngine_;
+    DnsBatchLookup batchLookup_;
+    DnsHostsFile hostsFile_;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
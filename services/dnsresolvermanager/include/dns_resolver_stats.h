@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_RESOLVER_STATS_H
+#define DNS_RESOLVER_STATS_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dns_server_stats.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+enum DnsQueryOutcome {
+    DNS_OUTCOME_SUCCESS = 0,
+    DNS_OUTCOME_TIMEOUT,
+    DNS_OUTCOME_NXDOMAIN,
+    DNS_OUTCOME_SERVFAIL,
+    DNS_OUTCOME_ERROR,
+};
+
+/* Counters of one upstream server, updated with relaxed atomics so recording never takes a lock */
+struct DnsServerCounters {
+    std::atomic<uint64_t> queries {0};
+    std::atomic<uint64_t> successes {0};
+    std::atomic<uint64_t> timeouts {0};
+    std::atomic<uint64_t> nxDomains {0};
+    std::atomic<uint64_t> servFails {0};
+    std::atomic<uint64_t> errors {0};
+    std::atomic<uint64_t> latencyBuckets[DNS_LATENCY_BUCKETS] = {};
+
+    void RecordQuery();
+
+    /**
+     * @brief Count the outcome of one attempt
+     *
+     * @param outcome How the attempt ended
+     * @param latencyMs Time from sending to the reply, not put in the histogram for a timeout
+     */
+    void RecordOutcome(DnsQueryOutcome outcome, uint32_t latencyMs);
+};
+
+/**
+ * Query statistics per netId and upstream server. The counters of a server are looked up once per query under a
+ * lock and then updated lock free by every attempt sent to it, so the resolver threads never contend on them.
+ */
+class DnsResolverStats {
+public:
+    /**
+     * @brief Get the counters of a server, created on first use
+     *
+     * @param netId The network of the server
+     * @param server The server address, empty for the system resolver
+     * @return The counters, they stay valid after the network is removed
+     */
+    std::shared_ptr<DnsServerCounters> GetCounters(uint16_t netId, const std::string &server);
+
+    /**
+     * @brief Count one query and its outcome
+     *
+     * @param netId The network of the server
+     * @param server The server address, empty for the system resolver
+     * @param outcome How the query ended
+     * @param latencyMs Time the query took
+     */
+    void Record(uint16_t netId, const std::string &server, DnsQueryOutcome outcome, uint32_t latencyMs);
+    void GetStats(uint16_t netId, std::vector<DnsServerStats> &stats) const;
+    void Remove(uint16_t netId);
+    void Dump(std::string &info) const;
+
+    /**
+     * @brief Map a getaddrinfo style result code to the outcome it stands for, a name without addresses of the
+     * family counts as NXDOMAIN like a name that does not exist
+     *
+     * @param result 0 or an EAI_ code
+     * @return The outcome
+     */
+    static DnsQueryOutcome GetOutcome(int32_t result);
+    static uint32_t GetBucket(uint32_t latencyMs);
+
+private:
+    mutable std::mutex mutex_;
+    std::map<uint16_t, std::map<std::string, std::shared_ptr<DnsServerCounters>>> networks_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_RESOLVER_STATS_H
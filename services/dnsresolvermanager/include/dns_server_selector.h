@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_SERVER_SELECTOR_H
+#define DNS_SERVER_SELECTOR_H
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dns_resolver_stats.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/* Health of one upstream server as seen by the queries sent to it */
+struct DnsServerHealth {
+    bool hasRtt = false;
+    uint32_t srttMs = 0;
+    uint32_t rttVarMs = 0;
+    /* Moving average of the failed attempts, in 1/1024 */
+    uint32_t failureRate = 0;
+    uint32_t consecutiveFailures = 0;
+    uint32_t backoffMs = 0;
+    std::chrono::steady_clock::time_point skipUntil;
+};
+
+/**
+ * Orders the configured servers of a network for each query. Every answered attempt feeds the smoothed round trip
+ * time of its server the way TCP does (RFC 6298) and every attempt moves its failure rate, so the fastest healthy
+ * server is tried first. A few queries probe another server first to keep the estimates of the others fresh. A
+ * server failing in a row is skipped for a backoff that doubles at each further failure, it is still tried last
+ * when no other server is left.
+ */
+class DnsServerSelector {
+public:
+    static constexpr uint32_t DEFAULT_PROBE_ONE_IN = 32;
+
+    /**
+     * @param probeOneIn One query in this many starts on a random other live server, 0 never probes
+     */
+    explicit DnsServerSelector(uint32_t probeOneIn = DEFAULT_PROBE_ONE_IN);
+
+    /**
+     * @brief Order the servers of a query
+     *
+     * @param netId The network of the servers
+     * @param servers The configured servers
+     * @param timeoutMs Deadline of one attempt, the cost of a failure when ranking
+     * @param order Receives the indexes of the servers in the order to try them
+     */
+    void Order(uint16_t netId, const std::vector<std::string> &servers, uint32_t timeoutMs,
+        std::vector<size_t> &order);
+
+    /**
+     * @brief Feed the outcome of one attempt
+     *
+     * @param netId The network of the server
+     * @param server The server the attempt went to
+     * @param outcome How the attempt ended, NXDOMAIN is an answer like any other
+     * @param rttMs Time from sending to the reply
+     */
+    void Record(uint16_t netId, const std::string &server, DnsQueryOutcome outcome, uint32_t rttMs);
+    bool GetHealth(uint16_t netId, const std::string &server, DnsServerHealth &health) const;
+    void Remove(uint16_t netId);
+    void Dump(std::string &info) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    uint32_t GetScore(const DnsServerHealth &health, uint32_t timeoutMs) const;
+
+private:
+    uint32_t probeOneIn_;
+    mutable std::mutex mutex_;
+    std::mt19937 random_;
+    std::map<std::pair<uint16_t, std::string>, DnsServerHealth> servers_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_SERVER_SELECTOR_H
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNS_RESOLVER_CALLBACK_PROXY_H
+#define DNS_RESOLVER_CALLBACK_PROXY_H
+
+#include "iremote_proxy.h"
+
+#include "i_dns_resolver_callback.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+class DnsResolverCallbackProxy : public IRemoteProxy<IDnsResolverCallback> {
+public:
+    explicit DnsResolverCallbackProxy(const sptr<IRemoteObject> &impl);
+    virtual ~DnsResolverCallbackProxy();
+
+public:
+    int32_t OnResolved(const std::string &hostName, int32_t result, const std::vector<INetAddr> &addrInfo) override;
+    int32_t OnPartialResolved(const std::string &hostName, const std::vector<INetAddr> &addrInfo) override;
+
+private:
+    bool WriteInterfaceToken(MessageParcel &data);
+    int32_t SendResult(uint32_t code, const std::string &hostName, int32_t result,
+        const std::vector<INetAddr> &addrInfo);
+
+private:
+    static inline BrokerDelegator<DnsResolverCallbackProxy> delegator_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // DNS_RESOLVER_CALLBACK_PROXY_H
@@ -29,6 +29,7 @@ public:
     virtual ~DnsResolverServiceProxy();
     bool WriteInterfaceToken(MessageParcel &data);
     int32_t GetAddressesByName(const std::string &hostName, std::vector<INetAddr> &addrInfo) override;
+    int32_t GetAddressesByNamePacked(const std::string &hostName, DnsAddrBlob &addrBlob) override;
     int32_t GetAddrInfo(const std::string &hostName, const std::string &server,
         const sptr<DnsAddrInfo> &hints, std::vector<sptr<DnsAddrInfo>> &dnsAddrInfo) override;
     int32_t CreateNetworkCache(uint16_t netId) override;
@@ -38,6 +39,19 @@ public:
         const std::vector<std::string> &servers, const std::vector<std::string> &domains) override;
     int32_t GetResolverInfo(uint16_t netId, std::vector<std::string> &servers,
         std::vector<std::string> &domains, uint16_t &baseTimeoutMsec, uint8_t &retryCount) override;
+    int32_t GetAddressesByNames(const std::vector<std::string> &hostNames, std::vector<int32_t> &results,
+        std::vector<std::vector<INetAddr>> &addrInfos) override;
+    int32_t GetAddressesByNamesPacked(const std::vector<std::string> &hostNames, std::vector<int32_t> &results,
+        std::vector<DnsAddrBlob> &addrBlobs) override;
+    int32_t GetAddressesByNameAsync(const std::string &hostName,
+        const sptr<IDnsResolverCallback> &callback) override;
+    int32_t GetAddressesByNameDualStack(const std::string &hostName,
+        const sptr<IDnsResolverCallback> &callback) override;
+    int32_t GetResolverStats(uint16_t netId, std::vector<DnsServerStats> &stats) override;
+
+private:
+    int32_t SendNameWithCallback(uint32_t code, const std::string &hostName,
+        const sptr<IDnsResolverCallback> &callback);
 
 private:
     static inline BrokerDelegator<DnsResolverServiceProxy> delegator_;
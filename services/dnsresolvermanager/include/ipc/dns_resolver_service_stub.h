@@ -16,15 +16,13 @@
 #ifndef DNS_RESOLVER_SERVICE_STUB_H
 #define DNS_RESOLVER_SERVICE_STUB_H
 
-#include <map>
 #include "iremote_stub.h"
 #include "i_dns_resolver_service.h"
+#include "ipc_stub_dispatch_table.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
 class DnsResolverServiceStub : public IRemoteStub<IDnsResolverService> {
-    using DnsResolverServiceFunc = int32_t (DnsResolverServiceStub::*)(MessageParcel &, MessageParcel &);
-
 public:
     DnsResolverServiceStub();
     ~DnsResolverServiceStub();
@@ -39,7 +37,13 @@ private:
     int32_t OnFlushNetworkCache(MessageParcel &data, MessageParcel &reply);
     int32_t OnSetResolverConfig(MessageParcel &data, MessageParcel &reply);
     int32_t OnGetResolverInfo(MessageParcel &data, MessageParcel &reply);
-    std::map<uint32_t, DnsResolverServiceFunc> memberFuncMap_;
+    int32_t OnGetAddressesByNames(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetAddressesByNameAsync(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetAddressesByNameDualStack(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetResolverStats(MessageParcel &data, MessageParcel &reply);
+    int32_t ReadNameWithCallback(MessageParcel &data, std::string &hostName, sptr<IDnsResolverCallback> &callback);
+    using DispatchTable = IpcStubDispatchTable<DnsResolverServiceStub, CMD_GET_RESOLVER_STATS + 1>;
+    static const DispatchTable &GetDispatchTable();
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
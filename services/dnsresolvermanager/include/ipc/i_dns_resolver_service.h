@@ -23,7 +23,10 @@
 #include "iremote_object.h"
 #include "inet_addr.h"
 
+#include "dns_addr_blob.h"
 #include "dns_addr_info.h"
+#include "dns_server_stats.h"
+#include "i_dns_resolver_callback.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
@@ -38,10 +41,15 @@ public:
         CMD_FLS_NETWORK_CACHE,
         CMD_SET_RESOLVER_CONFIG,
         CMD_GET_RESOLVER_INFO,
+        CMD_GET_ADDR_BY_NAMES,
+        CMD_GET_ADDR_BY_NAME_ASYNC,
+        CMD_GET_ADDR_BY_NAME_DUAL_STACK,
+        CMD_GET_RESOLVER_STATS,
     };
 
 public:
     virtual int32_t GetAddressesByName(const std::string &hostName, std::vector<INetAddr> &addrInfo) = 0;
+    virtual int32_t GetAddressesByNamePacked(const std::string &hostName, DnsAddrBlob &addrBlob) = 0;
     virtual int32_t GetAddrInfo(const std::string &hostName, const std::string &server,
         const sptr<DnsAddrInfo> &hints, std::vector<sptr<DnsAddrInfo>> &dnsAddrInfo) = 0;
     virtual int32_t CreateNetworkCache(uint16_t netId) = 0;
@@ -51,6 +59,15 @@ public:
         const std::vector<std::string> &servers, const std::vector<std::string> &domains) = 0;
     virtual int32_t GetResolverInfo(uint16_t netId, std::vector<std::string> &servers,
         std::vector<std::string> &domains, uint16_t &baseTimeoutMsec, uint8_t &retryCount) = 0;
+    virtual int32_t GetAddressesByNames(const std::vector<std::string> &hostNames, std::vector<int32_t> &results,
+        std::vector<std::vector<INetAddr>> &addrInfos) = 0;
+    virtual int32_t GetAddressesByNamesPacked(const std::vector<std::string> &hostNames,
+        std::vector<int32_t> &results, std::vector<DnsAddrBlob> &addrBlobs) = 0;
+    virtual int32_t GetAddressesByNameAsync(const std::string &hostName,
+        const sptr<IDnsResolverCallback> &callback) = 0;
+    virtual int32_t GetAddressesByNameDualStack(const std::string &hostName,
+        const sptr<IDnsResolverCallback> &callback) = 0;
+    virtual int32_t GetResolverStats(uint16_t netId, std::vector<DnsServerStats> &stats) = 0;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_addr_sorter.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+/* Connecting a UDP socket only picks the route and the source address, nothing is sent to this port */
+constexpr uint16_t PROBE_PORT = 53;
+constexpr int32_t SCOPE_LINK_LOCAL = 0x2;
+constexpr int32_t SCOPE_SITE_LOCAL = 0x5;
+constexpr int32_t SCOPE_GLOBAL = 0xe;
+constexpr uint8_t MULTICAST_SCOPE_MASK = 0x0f;
+constexpr size_t IPV4_MAPPED_OFFSET = 12;
+constexpr uint8_t IPV4_LOOPBACK_NET = 127;
+constexpr uint8_t IPV4_LINK_LOCAL_NET0 = 169;
+constexpr uint8_t IPV4_LINK_LOCAL_NET1 = 254;
+constexpr uint32_t BYTE_BITS = 8;
+constexpr uint32_t IPV6_ADDR_BITS = 128;
+
+struct PolicyEntry {
+    uint8_t prefix[sizeof(in6_addr)];
+    uint32_t prefixLen;
+    int32_t precedence;
+    int32_t label;
+};
+
+/* Default policy table of RFC 6724 section 2.1, longest prefix first so the first match is the best one */
+const PolicyEntry POLICY_TABLE[] = {
+    {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}, 128, 50, 0},
+    {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff}, 96, 35, 4},
+    {{0}, 96, 1, 3},
+    {{0x20, 0x01, 0, 0}, 32, 5, 5},
+    {{0x20, 0x02}, 16, 30, 2},
+    {{0x3f, 0xfe}, 16, 1, 12},
+    {{0xfe, 0xc0}, 10, 1, 11},
+    {{0xfc}, 7, 3, 13},
+    {{0}, 0, 40, 1},
+};
+
+struct SortEntry {
+    INetAddr addr;
+    bool native6 = false;
+    bool hasSource = false;
+    int32_t scope = SCOPE_GLOBAL;
+    int32_t label = 0;
+    int32_t precedence = 0;
+    int32_t sourceScope = 0;
+    int32_t sourceLabel = 0;
+    uint32_t prefixLen = 0;
+};
+
+/* IPv4 addresses become IPv4 mapped IPv6 addresses, the policy table and the scopes are written for those */
+bool ToIn6(const std::string &address, in6_addr &addr6, bool &native6)
+{
+    in_addr addr4 = {};
+    if (inet_pton(AF_INET, address.c_str(), &addr4) == 1) {
+        addr6 = {};
+        addr6.s6_addr[IPV4_MAPPED_OFFSET - 2] = 0xff;
+        addr6.s6_addr[IPV4_MAPPED_OFFSET - 1] = 0xff;
+        std::copy_n(reinterpret_cast<const uint8_t *>(&addr4), sizeof(addr4), addr6.s6_addr + IPV4_MAPPED_OFFSET);
+        native6 = false;
+        return true;
+    }
+    native6 = true;
+    return inet_pton(AF_INET6, address.c_str(), &addr6) == 1;
+}
+
+uint32_t CommonPrefixLen(const in6_addr &a, const in6_addr &b)
+{
+    for (uint32_t i = 0; i < sizeof(in6_addr); i++) {
+        uint8_t diff = a.s6_addr[i] ^ b.s6_addr[i];
+        if (diff != 0) {
+            return i * BYTE_BITS + static_cast<uint32_t>(__builtin_clz(diff)) - (sizeof(uint32_t) - 1) * BYTE_BITS;
+        }
+    }
+    return IPV6_ADDR_BITS;
+}
+
+const PolicyEntry &LookupPolicy(const in6_addr &addr6)
+{
+    for (const auto &entry : POLICY_TABLE) {
+        in6_addr prefix = {};
+        std::copy_n(entry.prefix, sizeof(entry.prefix), prefix.s6_addr);
+        if (CommonPrefixLen(addr6, prefix) >= entry.prefixLen) {
+            return entry;
+        }
+    }
+    return POLICY_TABLE[sizeof(POLICY_TABLE) / sizeof(POLICY_TABLE[0]) - 1];
+}
+
+int32_t GetScope(const in6_addr &addr6)
+{
+    if (IN6_IS_ADDR_MULTICAST(&addr6)) {
+        return addr6.s6_addr[1] & MULTICAST_SCOPE_MASK;
+    }
+    if (IN6_IS_ADDR_LOOPBACK(&addr6) || IN6_IS_ADDR_LINKLOCAL(&addr6)) {
+        return SCOPE_LINK_LOCAL;
+    }
+    if (IN6_IS_ADDR_SITELOCAL(&addr6)) {
+        return SCOPE_SITE_LOCAL;
+    }
+    if (IN6_IS_ADDR_V4MAPPED(&addr6)) {
+        const uint8_t *addr4 = addr6.s6_addr + IPV4_MAPPED_OFFSET;
+        if (addr4[0] == IPV4_LOOPBACK_NET || (addr4[0] == IPV4_LINK_LOCAL_NET0 && addr4[1] == IPV4_LINK_LOCAL_NET1)) {
+            return SCOPE_LINK_LOCAL;
+        }
+    }
+    return SCOPE_GLOBAL;
+}
+
+bool LookupSourceByConnect(const INetAddr &dest, INetAddr &source)
+{
+    sockaddr_storage addr = {};
+    socklen_t addrLen = 0;
+    auto addr4 = reinterpret_cast<sockaddr_in *>(&addr);
+    auto addr6 = reinterpret_cast<sockaddr_in6 *>(&addr);
+    if (inet_pton(AF_INET, dest.address_.c_str(), &addr4->sin_addr) == 1) {
+        addr4->sin_family = AF_INET;
+        addr4->sin_port = htons(PROBE_PORT);
+        addrLen = sizeof(sockaddr_in);
+    } else if (inet_pton(AF_INET6, dest.address_.c_str(), &addr6->sin6_addr) == 1) {
+        addr6->sin6_family = AF_INET6;
+        addr6->sin6_port = htons(PROBE_PORT);
+        addrLen = sizeof(sockaddr_in6);
+    } else {
+        return false;
+    }
+    int32_t fd = socket(addr.ss_family, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    bool found = connect(fd, reinterpret_cast<const sockaddr *>(&addr), addrLen) == 0 &&
+        getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &addrLen) == 0;
+    close(fd);
+    char addrBuf[INET6_ADDRSTRLEN] = {0};
+    const void *src = (addr.ss_family == AF_INET) ? static_cast<const void *>(&addr4->sin_addr) :
+        static_cast<const void *>(&addr6->sin6_addr);
+    if (!found || inet_ntop(addr.ss_family, src, addrBuf, sizeof(addrBuf)) == nullptr) {
+        return false;
+    }
+    source.family_ = addr.ss_family;
+    source.address_ = addrBuf;
+    return true;
+}
+
+bool ComesBefore(const SortEntry &a, const SortEntry &b)
+{
+    /* Rule 1, avoid unusable destinations */
+    if (a.hasSource != b.hasSource) {
+        return a.hasSource;
+    }
+    /* Rule 2, prefer matching scope */
+    bool scopeMatchA = a.hasSource && a.scope == a.sourceScope;
+    bool scopeMatchB = b.hasSource && b.scope == b.sourceScope;
+    if (scopeMatchA != scopeMatchB) {
+        return scopeMatchA;
+    }
+    /* Rule 5, prefer matching label */
+    bool labelMatchA = a.hasSource && a.label == a.sourceLabel;
+    bool labelMatchB = b.hasSource && b.label == b.sourceLabel;
+    if (labelMatchA != labelMatchB) {
+        return labelMatchA;
+    }
+    /* Rule 6, prefer higher precedence */
+    if (a.precedence != b.precedence) {
+        return a.precedence > b.precedence;
+    }
+    /* Rule 8, prefer smaller scope */
+    if (a.scope != b.scope) {
+        return a.scope < b.scope;
+    }
+    /* Rule 9, use longest matching prefix, only between IPv6 destinations */
+    if (a.hasSource && a.native6 && b.native6 && a.prefixLen != b.prefixLen) {
+        return a.prefixLen > b.prefixLen;
+    }
+    /* Rule 10, otherwise leave the order unchanged */
+    return false;
+}
+DnsSourceCache &GetSourceCache()
+{
+    static DnsSourceCache cache(LookupSourceByConnect);
+    return cache;
+}
+} // namespace
+
+DnsSourceCache::DnsSourceCache(const DnsSourceLookup &lookup, uint32_t ttlMs) : lookup_(lookup), ttl_(ttlMs) {}
+
+bool DnsSourceCache::Lookup(const INetAddr &dest, INetAddr &source)
+{
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(dest.address_);
+        if (it != entries_.end() && it->second.expiry > now) {
+            source = it->second.source;
+            return it->second.found;
+        }
+    }
+    /* Probed outside the lock, two threads racing on one destination both probe and store the same answer */
+    Entry entry;
+    entry.found = lookup_(dest, entry.source);
+    entry.expiry = now + ttl_;
+    source = entry.source;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= MAX_ENTRIES) {
+        entries_.clear();
+    }
+    entries_[dest.address_] = entry;
+    return entry.found;
+}
+
+void DnsSourceCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+void DnsAddrSorter::Sort(std::vector<INetAddr> &addrInfo)
+{
+    DnsSourceCache &cache = GetSourceCache();
+    Sort(addrInfo, [&cache](const INetAddr &dest, INetAddr &source) { return cache.Lookup(dest, source); });
+}
+
+void DnsAddrSorter::ClearSourceCache()
+{
+    GetSourceCache().Clear();
+}
+
+void DnsAddrSorter::Sort(std::vector<INetAddr> &addrInfo, const DnsSourceLookup &lookup)
+{
+    if (addrInfo.size() < 2) {
+        return;
+    }
+    std::vector<SortEntry> entries(addrInfo.size());
+    for (size_t i = 0; i < addrInfo.size(); i++) {
+        SortEntry &entry = entries[i];
+        entry.addr = std::move(addrInfo[i]);
+        in6_addr dest = {};
+        if (!ToIn6(entry.addr.address_, dest, entry.native6)) {
+            continue;
+        }
+        const PolicyEntry &policy = LookupPolicy(dest);
+        entry.scope = GetScope(dest);
+        entry.label = policy.label;
+        entry.precedence = policy.precedence;
+        INetAddr source;
+        in6_addr source6 = {};
+        bool sourceNative6 = false;
+        if (!lookup(entry.addr, source) || !ToIn6(source.address_, source6, sourceNative6)) {
+            continue;
+        }
+        entry.hasSource = true;
+        entry.sourceScope = GetScope(source6);
+        entry.sourceLabel = LookupPolicy(source6).label;
+        entry.prefixLen = CommonPrefixLen(dest, source6);
+    }
+    std::stable_sort(entries.begin(), entries.end(), ComesBefore);
+    for (size_t i = 0; i < entries.size(); i++) {
+        addrInfo[i] = std::move(entries[i].addr);
+    }
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_batch_lookup.h"
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+
+#include "dns_resolver_constants.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/* Shared with the pool, a worker only touches the batch through a name it claimed before the batch finished */
+struct DnsBatchLookup::Batch {
+    const std::vector<std::string> *hostNames = nullptr;
+    const std::vector<size_t> *uniques = nullptr;
+    const DnsLookupFunc *lookup = nullptr;
+    std::vector<int32_t> *results = nullptr;
+    std::vector<DnsAddrBlob> *addrBlobs = nullptr;
+    size_t count = 0;
+    std::atomic<size_t> next {0};
+    std::mutex mutex;
+    std::condition_variable cond;
+    size_t done = 0;
+    /* A posted name owns its inputs and reports through onDone */
+    std::vector<std::string> ownedNames;
+    std::vector<size_t> ownedUniques;
+    DnsLookupFunc ownedLookup;
+    std::vector<int32_t> ownedResults;
+    std::vector<DnsAddrBlob> ownedBlobs;
+    DnsLookupDone onDone;
+};
+
+DnsBatchLookup::DnsBatchLookup(uint32_t maxWorkers) : maxWorkers_(std::max<uint32_t>(maxWorkers, 1)) {}
+
+DnsBatchLookup::~DnsBatchLookup()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+void DnsBatchLookup::Work(Batch &batch)
+{
+    /* The inputs are only valid while a name is left, so claim before touching them */
+    for (size_t n = batch.next++; n < batch.count; n = batch.next++) {
+        size_t index = (*batch.uniques)[n];
+        (*batch.results)[index] = (*batch.lookup)((*batch.hostNames)[index], (*batch.addrBlobs)[index]);
+        bool finished = false;
+        {
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            finished = (++batch.done == batch.count);
+            if (finished) {
+                batch.cond.notify_all();
+            }
+        }
+        if (finished && batch.onDone != nullptr) {
+            batch.onDone(batch.ownedResults[0], batch.ownedBlobs[0]);
+        }
+    }
+}
+
+void DnsBatchLookup::RunWorker()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cond_.wait(lock, [this]() { return stop_ || !pending_.empty(); });
+        if (stop_) {
+            return;
+        }
+        std::shared_ptr<Batch> batch = std::move(pending_.front());
+        pending_.pop_front();
+        lock.unlock();
+        Work(*batch);
+        lock.lock();
+    }
+}
+
+void DnsBatchLookup::Run(const std::vector<std::string> &hostNames, const DnsLookupFunc &lookup,
+    std::vector<int32_t> &results, std::vector<DnsAddrBlob> &addrBlobs)
+{
+    results.assign(hostNames.size(), DNS_ERROR);
+    addrBlobs.assign(hostNames.size(), {});
+    std::vector<size_t> uniques;
+    std::vector<size_t> firstOf(hostNames.size());
+    std::unordered_map<std::string, size_t> seen;
+    for (size_t i = 0; i < hostNames.size(); i++) {
+        auto inserted = seen.emplace(hostNames[i], i);
+        firstOf[i] = inserted.first->second;
+        if (inserted.second) {
+            uniques.push_back(i);
+        }
+    }
+
+    /* Every worker claims the next unresolved name, each slot is written by one worker only */
+    auto batch = std::make_shared<Batch>();
+    batch->hostNames = &hostNames;
+    batch->uniques = &uniques;
+    batch->lookup = &lookup;
+    batch->results = &results;
+    batch->addrBlobs = &addrBlobs;
+    batch->count = uniques.size();
+    size_t helperCount = std::min<size_t>(maxWorkers_, uniques.size());
+    helperCount = (helperCount > 0) ? helperCount - 1 : 0;
+    if (helperCount > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < helperCount; i++) {
+            pending_.push_back(batch);
+        }
+        /* Threads start on first use and stay, the pool is bounded by maxWorkers - 1 */
+        while (workers_.size() < maxWorkers_ - 1 && workers_.size() < pending_.size()) {
+            workers_.emplace_back([this]() { RunWorker(); });
+        }
+    }
+    cond_.notify_all();
+    Work(*batch);
+    {
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->cond.wait(lock, [&batch]() { return batch->done == batch->count; });
+    }
+    if (helperCount > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.erase(std::remove(pending_.begin(), pending_.end(), batch), pending_.end());
+    }
+
+    for (size_t i = 0; i < hostNames.size(); i++) {
+        if (firstOf[i] != i) {
+            results[i] = results[firstOf[i]];
+            addrBlobs[i] = addrBlobs[firstOf[i]];
+        }
+    }
+}
+
+void DnsBatchLookup::Post(const std::string &hostName, const DnsLookupFunc &lookup, const DnsLookupDone &done)
+{
+    auto batch = std::make_shared<Batch>();
+    batch->ownedNames.push_back(hostName);
+    batch->ownedUniques.push_back(0);
+    batch->ownedLookup = lookup;
+    batch->ownedResults.assign(1, DNS_ERROR);
+    batch->ownedBlobs.assign(1, {});
+    batch->onDone = done;
+    batch->hostNames = &batch->ownedNames;
+    batch->uniques = &batch->ownedUniques;
+    batch->lookup = &batch->ownedLookup;
+    batch->results = &batch->ownedResults;
+    batch->addrBlobs = &batch->ownedBlobs;
+    batch->count = 1;
+    if (maxWorkers_ == 1) {
+        Work(*batch);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(batch);
+        while (workers_.size() < maxWorkers_ - 1 && workers_.size() < pending_.size()) {
+            workers_.emplace_back([this]() { RunWorker(); });
+        }
+    }
+    cond_.notify_one();
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
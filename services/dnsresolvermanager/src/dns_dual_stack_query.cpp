@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_dual_stack_query.h"
+
+#include <memory>
+#include <mutex>
+#include <netdb.h>
+
+#include "dns_addr_sorter.h"
+#include "dns_resolver_constants.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t DUAL_STACK_FAMILIES = 2;
+
+struct DualStackState {
+    std::mutex mutex;
+    uint32_t outstanding = DUAL_STACK_FAMILIES;
+    int32_t result4 = DNS_ERROR;
+    bool truncated = false;
+    std::vector<INetAddr> addrInfo;
+    DnsPartialCallback onPartial;
+    DnsQueryCallback onComplete;
+};
+
+void OnFamilyDone(const std::shared_ptr<DualStackState> &state, int32_t family, int32_t result,
+    const std::vector<INetAddr> &addrInfo)
+{
+    /* Sorted before taking the lock, the sort probes the route of every address it has not seen lately */
+    std::vector<INetAddr> partial = addrInfo;
+    DnsAddrSorter::Sort(partial);
+    {
+        /* The partial answer goes out under the lock, so the last family cannot overtake it from another thread */
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (family == AF_INET) {
+            state->result4 = result;
+        }
+        state->truncated = state->truncated || (result == DnsQueryEngine::RESULT_TRUNCATED);
+        state->addrInfo.insert(state->addrInfo.end(), addrInfo.begin(), addrInfo.end());
+        if (--state->outstanding > 0) {
+            if (!partial.empty()) {
+                state->onPartial(partial);
+            }
+            return;
+        }
+    }
+    if (state->truncated) {
+        /* The addresses of the other family alone would pass for the whole answer */
+        state->onComplete(DnsQueryEngine::RESULT_TRUNCATED, {});
+        return;
+    }
+    std::vector<INetAddr> merged = std::move(state->addrInfo);
+    DnsAddrSorter::Sort(merged);
+    /* When both failed the IPv4 result is reported, as the single family lookups would have done */
+    state->onComplete(merged.empty() ? state->result4 : DNS_SUCCESS, merged);
+}
+} // namespace
+
+int32_t DnsDualStackQuery::Start(DnsQueryEngine &engine, const std::string &hostName,
+    const std::vector<std::string> &servers, uint32_t timeoutMs, uint8_t retryCount,
+    const DnsPartialCallback &onPartial, const DnsQueryCallback &onComplete, uint16_t netId)
+{
+    if (onPartial == nullptr || onComplete == nullptr) {
+        return DNS_ERROR;
+    }
+    auto state = std::make_shared<DualStackState>();
+    state->onPartial = onPartial;
+    state->onComplete = onComplete;
+    int32_t ret = engine.Query(hostName, AF_INET6, servers, timeoutMs, retryCount,
+        [state](int32_t result, const std::vector<INetAddr> &addrInfo) {
+            OnFamilyDone(state, AF_INET6, result, addrInfo);
+        }, netId);
+    if (ret != DNS_SUCCESS) {
+        return ret;
+    }
+    ret = engine.Query(hostName, AF_INET, servers, timeoutMs, retryCount,
+        [state](int32_t result, const std::vector<INetAddr> &addrInfo) {
+            OnFamilyDone(state, AF_INET, result, addrInfo);
+        }, netId);
+    if (ret != DNS_SUCCESS) {
+        /* The AAAA query is already out, it completes the lookup alone */
+        OnFamilyDone(state, AF_INET, EAI_AGAIN, {});
+    }
+    return DNS_SUCCESS;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
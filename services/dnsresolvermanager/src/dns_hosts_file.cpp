@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_hosts_file.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr size_t ADDR_BUF_LEN = 16;
+
+std::string ToLower(std::string name)
+{
+    std::transform(name.begin(), name.end(), name.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return name;
+}
+
+/* The text of the address in the form inet_ntop gives it, so it compares equal to a resolved one */
+bool ParseAddress(const std::string &text, INetAddr &addr)
+{
+    uint8_t buf[ADDR_BUF_LEN];
+    char addrBuf[INET6_ADDRSTRLEN];
+    int32_t family = AF_INET;
+    if (inet_pton(AF_INET, text.c_str(), buf) != 1) {
+        family = AF_INET6;
+        if (inet_pton(AF_INET6, text.c_str(), buf) != 1) {
+            return false;
+        }
+    }
+    if (inet_ntop(family, buf, addrBuf, sizeof(addrBuf)) == nullptr) {
+        return false;
+    }
+    addr.family_ = static_cast<uint8_t>(family);
+    addr.address_ = addrBuf;
+    return true;
+}
+} // namespace
+
+DnsHostsFile::DnsHostsFile(const std::string &path) : path_(path) {}
+
+void DnsHostsFile::ReloadIfChanged()
+{
+    struct stat st = {};
+    if (stat(path_.c_str(), &st) != 0) {
+        entries_.clear();
+        loaded_ = false;
+        return;
+    }
+    if (loaded_ && st.st_mtim.tv_sec == mtime_ && st.st_mtim.tv_nsec == mtimeNsec_ && st.st_size == size_) {
+        return;
+    }
+    std::ifstream file(path_);
+    if (!file.is_open()) {
+        NETMGR_LOGE("DnsHostsFile open hosts file failed");
+        return;
+    }
+    entries_.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string text;
+        INetAddr addr;
+        if (!(fields >> text) || !ParseAddress(text, addr)) {
+            continue;
+        }
+        std::string name;
+        while (fields >> name) {
+            entries_[ToLower(name)].push_back(addr);
+        }
+    }
+    loaded_ = true;
+    mtime_ = st.st_mtim.tv_sec;
+    mtimeNsec_ = st.st_mtim.tv_nsec;
+    size_ = st.st_size;
+}
+
+bool DnsHostsFile::Lookup(const std::string &hostName, int32_t family, std::vector<INetAddr> &addrInfo)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReloadIfChanged();
+    std::string key = ToLower(hostName);
+    if (!key.empty() && key.back() == '.') {
+        key.pop_back();
+    }
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return false;
+    }
+    size_t found = 0;
+    for (const INetAddr &addr : it->second) {
+        if (family == AF_UNSPEC || addr.family_ == family) {
+            addrInfo.push_back(addr);
+            found++;
+        }
+    }
+    return found > 0;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
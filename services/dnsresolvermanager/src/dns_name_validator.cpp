@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_name_validator.h"
+
+#include <algorithm>
+#include <array>
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+enum CharClass : uint8_t {
+    CLASS_INVALID = 0,
+    CLASS_LETTER_DIGIT,
+    CLASS_HYPHEN,
+    CLASS_DOT,
+    CLASS_COUNT,
+};
+
+constexpr size_t CHAR_COUNT = 256;
+
+constexpr std::array<uint8_t, CHAR_COUNT> MakeCharClasses()
+{
+    std::array<uint8_t, CHAR_COUNT> classes = {};
+    for (size_t c = '0'; c <= '9'; c++) {
+        classes[c] = CLASS_LETTER_DIGIT;
+    }
+    for (size_t c = 'a'; c <= 'z'; c++) {
+        classes[c] = CLASS_LETTER_DIGIT;
+    }
+    for (size_t c = 'A'; c <= 'Z'; c++) {
+        classes[c] = CLASS_LETTER_DIGIT;
+    }
+    classes['_'] = CLASS_LETTER_DIGIT;
+    classes['-'] = CLASS_HYPHEN;
+    classes['.'] = CLASS_DOT;
+    return classes;
+}
+
+constexpr std::array<uint8_t, CHAR_COUNT> CHAR_CLASSES = MakeCharClasses();
+
+/*
+ * The DFA state is the class of the previous character, the start state is DOT as a label starts there. A state
+ * never depends on an earlier one, so the loop carries no table lookup from one character to the next and only
+ * collects the rejected transitions: an invalid character, a label starting with a hyphen or a dot, or a hyphen
+ * ending a label.
+ */
+constexpr uint8_t REJECTS[CLASS_COUNT][CLASS_COUNT] = {
+    /* INVALID LETTER_DIGIT HYPHEN DOT */
+    {1, 1, 1, 1},
+    {1, 0, 0, 0},
+    {1, 0, 0, 1},
+    {1, 0, 1, 1},
+};
+
+static_assert(CHAR_CLASSES['a'] == CLASS_LETTER_DIGIT && CHAR_CLASSES['.'] == CLASS_DOT, "bad char classes");
+static_assert(CHAR_CLASSES[' '] == CLASS_INVALID && CHAR_CLASSES[0] == CLASS_INVALID, "bad char classes");
+} // namespace
+
+bool DnsNameValidator::IsValid(const char *name, size_t len)
+{
+    if (name == nullptr || len == 0) {
+        return false;
+    }
+    /* One trailing dot marks the name as fully qualified and is not part of its length */
+    if (name[len - 1] == '.') {
+        len--;
+    }
+    if (len == 0 || len > MAX_NAME_LEN) {
+        return false;
+    }
+    /* Branch free body: dots sit at unpredictable places, the label length is tracked with selects */
+    uint8_t state = CLASS_DOT;
+    uint8_t reject = 0;
+    size_t labelLen = 0;
+    size_t maxLabelLen = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t charClass = CHAR_CLASSES[static_cast<uint8_t>(name[i])];
+        reject |= REJECTS[state][charClass];
+        state = charClass;
+        labelLen = (charClass == CLASS_DOT) ? 0 : labelLen + 1;
+        maxLabelLen = std::max(maxLabelLen, labelLen);
+    }
+    return reject == 0 && state == CLASS_LETTER_DIGIT && maxLabelLen <= MAX_LABEL_LEN;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
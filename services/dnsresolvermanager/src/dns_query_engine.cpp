@@ -0,0 +1,545 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_query_engine.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netdb.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "dns_resolver_constants.h"
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr int32_t EPOLL_MAX_EVENTS = 64;
+constexpr uint64_t WAKE_KEY = UINT64_MAX;
+constexpr uint64_t WAKE_VALUE = 1;
+constexpr size_t DNS_HEADER_LEN = 12;
+constexpr size_t DNS_MAX_PACKET_LEN = 1500;
+constexpr size_t DNS_MAX_QUERY_LEN = DNS_HEADER_LEN + 256 + 4;
+constexpr uint16_t DNS_FLAG_QR = 0x8000;
+constexpr uint16_t DNS_FLAG_TC = 0x0200;
+constexpr uint16_t DNS_FLAG_RD = 0x0100;
+constexpr uint16_t DNS_RCODE_MASK = 0x000F;
+constexpr uint16_t DNS_RCODE_NOERROR = 0;
+constexpr uint16_t DNS_RCODE_SERVFAIL = 2;
+constexpr uint16_t DNS_RCODE_NXDOMAIN = 3;
+constexpr uint16_t DNS_TYPE_A = 1;
+constexpr uint16_t DNS_TYPE_AAAA = 28;
+constexpr uint16_t DNS_CLASS_IN = 1;
+constexpr uint8_t DNS_LABEL_POINTER = 0xC0;
+constexpr size_t DNS_RR_FIXED_LEN = 10;
+constexpr size_t DNS_QUESTION_FIXED_LEN = 4;
+constexpr size_t IPV4_ADDR_LEN = 4;
+constexpr size_t IPV6_ADDR_LEN = 16;
+constexpr uint32_t BYTE_BITS = 8;
+
+#ifdef EAI_NODATA
+constexpr int32_t DNS_RESULT_NODATA = EAI_NODATA;
+#else
+constexpr int32_t DNS_RESULT_NODATA = EAI_NONAME;
+#endif
+
+uint16_t ReadU16(const uint8_t *buf, size_t pos)
+{
+    return static_cast<uint16_t>((buf[pos] << BYTE_BITS) | buf[pos + 1]);
+}
+
+void WriteU16(std::vector<uint8_t> &packet, uint16_t value)
+{
+    packet.push_back(static_cast<uint8_t>(value >> BYTE_BITS));
+    packet.push_back(static_cast<uint8_t>(value));
+}
+
+std::vector<uint8_t> BuildQuery(uint16_t id, const std::string &hostName, uint16_t qtype)
+{
+    std::vector<uint8_t> packet;
+    packet.reserve(DNS_MAX_QUERY_LEN);
+    WriteU16(packet, id);
+    WriteU16(packet, DNS_FLAG_RD);
+    WriteU16(packet, 1);
+    WriteU16(packet, 0);
+    WriteU16(packet, 0);
+    WriteU16(packet, 0);
+    size_t start = 0;
+    while (start < hostName.size()) {
+        size_t end = hostName.find('.', start);
+        if (end == std::string::npos) {
+            end = hostName.size();
+        }
+        packet.push_back(static_cast<uint8_t>(end - start));
+        packet.insert(packet.end(), hostName.begin() + start, hostName.begin() + end);
+        start = end + 1;
+    }
+    packet.push_back(0);
+    WriteU16(packet, qtype);
+    WriteU16(packet, DNS_CLASS_IN);
+    return packet;
+}
+
+bool SkipName(const uint8_t *buf, size_t len, size_t &pos)
+{
+    while (pos < len) {
+        uint8_t labelLen = buf[pos];
+        if (labelLen == 0) {
+            pos++;
+            return true;
+        }
+        if ((labelLen & DNS_LABEL_POINTER) == DNS_LABEL_POINTER) {
+            pos += sizeof(uint16_t);
+            return pos <= len;
+        }
+        if ((labelLen & DNS_LABEL_POINTER) != 0) {
+            return false;
+        }
+        pos += labelLen + 1;
+    }
+    return false;
+}
+
+/* The answers matching the question type, the owner names are not compared as the socket and id already pair it */
+bool ParseAnswers(const uint8_t *buf, size_t len, uint16_t qtype, std::vector<INetAddr> &addrInfo)
+{
+    uint16_t qdCount = ReadU16(buf, sizeof(uint16_t) * 2);
+    uint16_t anCount = ReadU16(buf, sizeof(uint16_t) * 3);
+    size_t pos = DNS_HEADER_LEN;
+    for (uint16_t i = 0; i < qdCount; i++) {
+        if (!SkipName(buf, len, pos) || pos + DNS_QUESTION_FIXED_LEN > len) {
+            return false;
+        }
+        pos += DNS_QUESTION_FIXED_LEN;
+    }
+    int32_t family = (qtype == DNS_TYPE_A) ? AF_INET : AF_INET6;
+    size_t addrLen = (qtype == DNS_TYPE_A) ? IPV4_ADDR_LEN : IPV6_ADDR_LEN;
+    char addrBuf[INET6_ADDRSTRLEN] = {0};
+    for (uint16_t i = 0; i < anCount; i++) {
+        if (!SkipName(buf, len, pos) || pos + DNS_RR_FIXED_LEN > len) {
+            return false;
+        }
+        uint16_t type = ReadU16(buf, pos);
+        uint16_t rrClass = ReadU16(buf, pos + sizeof(uint16_t));
+        uint16_t rdLen = ReadU16(buf, pos + DNS_RR_FIXED_LEN - sizeof(uint16_t));
+        pos += DNS_RR_FIXED_LEN;
+        if (pos + rdLen > len) {
+            return false;
+        }
+        if (type == qtype && rrClass == DNS_CLASS_IN && rdLen == addrLen &&
+            inet_ntop(family, buf + pos, addrBuf, sizeof(addrBuf)) != nullptr) {
+            INetAddr addr;
+            addr.family_ = family;
+            addr.address_ = addrBuf;
+            addrInfo.push_back(addr);
+        }
+        pos += rdLen;
+    }
+    return true;
+}
+} // namespace
+
+DnsQueryEngine::DnsQueryEngine(uint16_t serverPort, uint32_t maxPending)
+    : serverPort_(serverPort), maxPending_(maxPending > 0 ? maxPending : DEFAULT_MAX_PENDING),
+      random_(std::random_device()())
+{}
+
+DnsQueryEngine::~DnsQueryEngine()
+{
+    Stop();
+}
+
+void DnsQueryEngine::SetStats(DnsResolverStats *stats)
+{
+    stats_ = stats;
+}
+
+void DnsQueryEngine::SetSelector(DnsServerSelector *selector)
+{
+    selector_ = selector;
+}
+
+bool DnsQueryEngine::Start()
+{
+    if (running_) {
+        return true;
+    }
+    /* A loop that died on its own still has its thread and descriptors */
+    Stop();
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    struct epoll_event wakeEvent = {};
+    wakeEvent.events = EPOLLIN;
+    wakeEvent.data.u64 = WAKE_KEY;
+    if (epollFd_ < 0 || wakeFd_ < 0 || epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &wakeEvent) != 0) {
+        NETMGR_LOGE("DnsQueryEngine create epoll failed, errno[%{public}d]", errno);
+        if (epollFd_ >= 0) {
+            close(epollFd_);
+            epollFd_ = -1;
+        }
+        if (wakeFd_ >= 0) {
+            close(wakeFd_);
+            wakeFd_ = -1;
+        }
+        return false;
+    }
+    running_ = true;
+    thread_ = std::thread(&DnsQueryEngine::Run, this);
+    return true;
+}
+
+void DnsQueryEngine::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    if (!thread_.joinable()) {
+        return;
+    }
+    uint64_t value = WAKE_VALUE;
+    if (TEMP_FAILURE_RETRY(write(wakeFd_, &value, sizeof(value))) < 0) {
+        NETMGR_LOGE("DnsQueryEngine wake failed, errno[%{public}d]", errno);
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    /* The loop is gone, whatever is left is failed here so no caller waits forever */
+    FailAll();
+    close(epollFd_);
+    close(wakeFd_);
+    epollFd_ = -1;
+    wakeFd_ = -1;
+}
+
+bool DnsQueryEngine::IsRunning() const
+{
+    return running_;
+}
+
+int32_t DnsQueryEngine::Query(const std::string &hostName, int32_t family, const std::vector<std::string> &servers,
+    uint32_t timeoutMs, uint8_t retryCount, const DnsQueryCallback &callback, uint16_t netId)
+{
+    if (hostName.empty() || callback == nullptr || (family != AF_INET && family != AF_INET6)) {
+        return DNS_ERROR;
+    }
+    if (netId != DNS_DEFAULT_NETID) {
+        NETMGR_LOGE("DnsQueryEngine cannot bind to netId[%{public}d]", netId);
+        return DNS_ERROR;
+    }
+    PendingQuery query;
+    query.hostName = hostName;
+    query.qtype = (family == AF_INET) ? DNS_TYPE_A : DNS_TYPE_AAAA;
+    query.timeoutMs = (timeoutMs > 0) ? timeoutMs : DEFAULT_TIMEOUT_MS;
+    query.maxAttempts = static_cast<uint32_t>(retryCount) + 1;
+    query.callback = callback;
+    query.netId = netId;
+    std::vector<size_t> order;
+    if (selector_ != nullptr) {
+        selector_->Order(netId, servers, query.timeoutMs, order);
+    } else {
+        for (size_t i = 0; i < servers.size(); i++) {
+            order.push_back(i);
+        }
+    }
+    for (size_t index : order) {
+        const std::string &server = servers[index];
+        sockaddr_storage addr = {};
+        auto addr4 = reinterpret_cast<sockaddr_in *>(&addr);
+        auto addr6 = reinterpret_cast<sockaddr_in6 *>(&addr);
+        if (inet_pton(AF_INET, server.c_str(), &addr4->sin_addr) == 1) {
+            addr4->sin_family = AF_INET;
+            addr4->sin_port = htons(serverPort_);
+        } else if (inet_pton(AF_INET6, server.c_str(), &addr6->sin6_addr) == 1) {
+            addr6->sin6_family = AF_INET6;
+            addr6->sin6_port = htons(serverPort_);
+        } else {
+            NETMGR_LOGE("DnsQueryEngine skip invalid server address");
+            continue;
+        }
+        query.servers.push_back(addr);
+        query.serverNames.push_back(server);
+        if (stats_ != nullptr) {
+            query.counters.push_back(stats_->GetCounters(netId, server));
+        }
+    }
+    if (query.servers.empty()) {
+        return DNS_ERROR;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || inFlight_ >= maxPending_) {
+            NETMGR_LOGE("DnsQueryEngine refuse query, in flight[%{public}u]", inFlight_);
+            return DNS_ERROR;
+        }
+        inFlight_++;
+        submissions_.push_back(std::move(query));
+        /* Woken under the lock, Stop cannot close the eventfd before it takes the lock to drain the submissions */
+        uint64_t value = WAKE_VALUE;
+        if (TEMP_FAILURE_RETRY(write(wakeFd_, &value, sizeof(value))) < 0) {
+            NETMGR_LOGE("DnsQueryEngine wake failed, errno[%{public}d]", errno);
+        }
+    }
+    submitted_++;
+    return DNS_SUCCESS;
+}
+
+DnsQueryEngineStats DnsQueryEngine::GetStats() const
+{
+    DnsQueryEngineStats stats;
+    stats.submitted = submitted_;
+    stats.answered = answered_;
+    stats.failed = failed_;
+    stats.timeouts = timeouts_;
+    stats.retries = retries_;
+    stats.strayReplies = strayReplies_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.pending = inFlight_;
+    return stats;
+}
+
+void DnsQueryEngine::Run()
+{
+    struct epoll_event events[EPOLL_MAX_EVENTS];
+    while (running_) {
+        int32_t count = epoll_wait(epollFd_, events, EPOLL_MAX_EVENTS, GetWaitMs());
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            NETMGR_LOGE("DnsQueryEngine epoll_wait failed, errno[%{public}d]", errno);
+            FailAll();
+            return;
+        }
+        for (int32_t i = 0; i < count; i++) {
+            if (events[i].data.u64 == WAKE_KEY) {
+                uint64_t value = 0;
+                while (read(wakeFd_, &value, sizeof(value)) > 0) {}
+                continue;
+            }
+            HandleReadable(events[i].data.u64);
+        }
+        TakeSubmissions();
+        ExpireDeadlines();
+    }
+}
+
+void DnsQueryEngine::FailAll()
+{
+    /* Refused under the lock, a query queued before that is taken below and failed */
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    TakeSubmissions();
+    while (!pending_.empty()) {
+        Complete(pending_.begin()->first, EAI_AGAIN, {});
+    }
+}
+
+int32_t DnsQueryEngine::GetWaitMs()
+{
+    if (deadlines_.empty()) {
+        return -1;
+    }
+    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(deadlines_.begin()->first - Clock::now());
+    /* Rounded up so the loop does not spin on a deadline that is less than a millisecond away */
+    return (wait.count() < 0) ? 0 : static_cast<int32_t>(wait.count()) + 1;
+}
+
+void DnsQueryEngine::TakeSubmissions()
+{
+    std::vector<PendingQuery> submissions;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        submissions.swap(submissions_);
+    }
+    for (auto &query : submissions) {
+        uint64_t key = nextKey_++;
+        auto it = pending_.emplace(key, std::move(query)).first;
+        if (!running_) {
+            Complete(key, EAI_AGAIN, {});
+            continue;
+        }
+        SendNextAttempt(key, it->second);
+    }
+}
+
+void DnsQueryEngine::SendNextAttempt(uint64_t key, PendingQuery &query)
+{
+    CloseAttempt(key, query);
+    while (query.attempts < query.maxAttempts) {
+        if (query.attempts > 0) {
+            retries_++;
+        }
+        const sockaddr_storage &server = query.servers[query.attempts % query.servers.size()];
+        query.attempts++;
+        socklen_t addrLen = (server.ss_family == AF_INET) ? sizeof(sockaddr_in) : sizeof(sockaddr_in6);
+        /* A fresh socket per attempt gets a fresh source port, a late reply to an earlier attempt is not read */
+        int32_t fd = socket(server.ss_family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            NETMGR_LOGE("DnsQueryEngine create socket failed, errno[%{public}d]", errno);
+            continue;
+        }
+        if (!query.counters.empty()) {
+            query.counters[(query.attempts - 1) % query.counters.size()]->RecordQuery();
+        }
+        query.sentAt = Clock::now();
+        query.id = static_cast<uint16_t>(random_());
+        std::vector<uint8_t> packet = BuildQuery(query.id, query.hostName, query.qtype);
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = key;
+        if (connect(fd, reinterpret_cast<const sockaddr *>(&server), addrLen) != 0 ||
+            send(fd, packet.data(), packet.size(), 0) != static_cast<ssize_t>(packet.size()) ||
+            epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+            NETMGR_LOGE("DnsQueryEngine send query failed, errno[%{public}d]", errno);
+            RecordOutcome(query, DNS_OUTCOME_ERROR);
+            close(fd);
+            continue;
+        }
+        query.fd = fd;
+        query.deadline = Clock::now() + std::chrono::milliseconds(query.timeoutMs);
+        deadlines_.emplace(query.deadline, key);
+        return;
+    }
+    Complete(key, EAI_AGAIN, {});
+}
+
+void DnsQueryEngine::HandleReadable(uint64_t key)
+{
+    auto it = pending_.find(key);
+    if (it == pending_.end()) {
+        return;
+    }
+    PendingQuery &query = it->second;
+    uint8_t buf[DNS_MAX_PACKET_LEN];
+    while (true) {
+        ssize_t len = recv(query.fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            }
+            /* Usually ECONNREFUSED from an ICMP port unreachable, move on to the next server */
+            RecordOutcome(query, DNS_OUTCOME_ERROR);
+            SendNextAttempt(key, query);
+            return;
+        }
+        if (static_cast<size_t>(len) < DNS_HEADER_LEN || ReadU16(buf, 0) != query.id ||
+            (ReadU16(buf, sizeof(uint16_t)) & DNS_FLAG_QR) == 0) {
+            strayReplies_++;
+            continue;
+        }
+        uint16_t flags = ReadU16(buf, sizeof(uint16_t));
+        uint16_t rcode = flags & DNS_RCODE_MASK;
+        if (rcode == DNS_RCODE_NXDOMAIN) {
+            RecordOutcome(query, DNS_OUTCOME_NXDOMAIN);
+            Complete(key, EAI_NONAME, {});
+            return;
+        }
+        if (rcode == DNS_RCODE_NOERROR && (flags & DNS_FLAG_TC) != 0) {
+            /* The server is fine, the answer just does not fit, any other server would truncate it as well */
+            RecordOutcome(query, DNS_OUTCOME_SUCCESS);
+            Complete(key, RESULT_TRUNCATED, {});
+            return;
+        }
+        std::vector<INetAddr> addrInfo;
+        bool parsed = (rcode == DNS_RCODE_NOERROR) && ParseAnswers(buf, static_cast<size_t>(len), query.qtype,
+            addrInfo);
+        if (!addrInfo.empty()) {
+            RecordOutcome(query, DNS_OUTCOME_SUCCESS);
+            Complete(key, DNS_SUCCESS, addrInfo);
+        } else if (parsed) {
+            RecordOutcome(query, DNS_OUTCOME_NXDOMAIN);
+            Complete(key, DNS_RESULT_NODATA, {});
+        } else {
+            /* Server failure, refusal or a malformed reply */
+            RecordOutcome(query, (rcode == DNS_RCODE_SERVFAIL) ? DNS_OUTCOME_SERVFAIL : DNS_OUTCOME_ERROR);
+            SendNextAttempt(key, query);
+        }
+        return;
+    }
+}
+
+void DnsQueryEngine::ExpireDeadlines()
+{
+    auto now = Clock::now();
+    while (!deadlines_.empty() && deadlines_.begin()->first <= now) {
+        uint64_t key = deadlines_.begin()->second;
+        deadlines_.erase(deadlines_.begin());
+        auto it = pending_.find(key);
+        if (it == pending_.end()) {
+            continue;
+        }
+        timeouts_++;
+        RecordOutcome(it->second, DNS_OUTCOME_TIMEOUT);
+        SendNextAttempt(key, it->second);
+    }
+}
+
+void DnsQueryEngine::CloseAttempt(uint64_t key, PendingQuery &query)
+{
+    if (query.fd < 0) {
+        return;
+    }
+    deadlines_.erase({query.deadline, key});
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, query.fd, nullptr);
+    close(query.fd);
+    query.fd = -1;
+}
+
+void DnsQueryEngine::RecordOutcome(const PendingQuery &query, DnsQueryOutcome outcome)
+{
+    if (query.attempts == 0) {
+        return;
+    }
+    size_t index = (query.attempts - 1) % query.servers.size();
+    auto latency = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - query.sentAt).count());
+    if (!query.counters.empty()) {
+        query.counters[index]->RecordOutcome(outcome, latency);
+    }
+    if (selector_ != nullptr) {
+        selector_->Record(query.netId, query.serverNames[index], outcome, latency);
+    }
+}
+
+void DnsQueryEngine::Complete(uint64_t key, int32_t result, const std::vector<INetAddr> &addrInfo)
+{
+    auto it = pending_.find(key);
+    if (it == pending_.end()) {
+        return;
+    }
+    CloseAttempt(key, it->second);
+    DnsQueryCallback callback = std::move(it->second.callback);
+    pending_.erase(it);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inFlight_--;
+    }
+    if (result == DNS_SUCCESS) {
+        answered_++;
+    } else {
+        failed_++;
+    }
+    callback(result, addrInfo);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
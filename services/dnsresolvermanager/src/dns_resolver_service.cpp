@@ -15,12 +15,17 @@
 
 #include "dns_resolver_service.h"
 
-#include <regex>
 #include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
 #include <netdb.h>
 
 #include "system_ability_definition.h"
 
+#include "dns_addr_sorter.h"
+#include "dns_batch_lookup.h"
+#include "dns_dual_stack_query.h"
+#include "dns_name_validator.h"
 #include "dns_resolver_constants.h"
 #include "net_mgr_log_wrapper.h"
 #include "netd_controller.h"
@@ -34,7 +39,10 @@ constexpr int32_t IPV6_SIZE = 48;
 
 DnsResolverService::DnsResolverService()
     : SystemAbility(COMM_DNS_MANAGER_SYS_ABILITY_ID, true)
-{}
+{
+    queryEngine_.SetStats(&stats_);
+    queryEngine_.SetSelector(&selector_);
+}
 
 DnsResolverService::~DnsResolverService() {}
 
@@ -56,6 +64,7 @@ void DnsResolverService::OnStop()
 {
     state_ = STATE_STOPPED;
     registerToService_ = false;
+    queryEngine_.Stop();
 }
 
 bool DnsResolverService::Init()
@@ -71,6 +80,10 @@ bool DnsResolverService::Init()
         }
         registerToService_ = true;
     }
+    /* The synchronous lookups keep working without it, only the asynchronous ones are refused */
+    if (!queryEngine_.Start()) {
+        NETMGR_LOGE("DnsResolverService start query engine failed");
+    }
     NETMGR_LOGI("GetDnsServer suc");
     return true;
 }
@@ -95,40 +108,10 @@ static void FreeAddrInfo2(struct addrinfo *aiHead)
     }
 }
 
-static bool IsDomainValid(const std::string &hostName)
-{
-    if (hostName.empty()) {
-        return false;
-    }
-    static std::regex domainPattern("([0-9A-Za-z\\-_\\.]+)\\.([0-9a-z]+\\.[a-z]{2,3}(\\.[a-z]{2})?)");
-    if (regex_match(hostName, domainPattern)) {
-        return true;
-    }
-    return false;
-}
-
-static void ProcessIPV4(const struct addrinfo &addr, std::vector<INetAddr> &addrInfo)
+/* A single label is what the system resolver expands with the search domains, the engine sends names as they are */
+static bool NeedsSearchDomains(const std::string &hostName, const std::vector<std::string> &domains)
 {
-    char ip4Buf[IPV4_SIZE];
-    bzero(ip4Buf, IPV4_SIZE);
-    struct sockaddr_in *sockAddr4 = reinterpret_cast<struct sockaddr_in*>(addr.ai_addr);
-    inet_ntop(AF_INET, &sockAddr4->sin_addr, ip4Buf, IPV4_SIZE);
-    INetAddr iNetAddr;
-    iNetAddr.family_ = addr.ai_family;
-    iNetAddr.address_ = std::string(ip4Buf);
-    addrInfo.push_back(iNetAddr);
-}
-
-static void ProcessIPV6(const struct addrinfo &addr, std::vector<INetAddr> &addrInfo)
-{
-    char ip6Buf[IPV6_SIZE];
-    bzero(ip6Buf, IPV6_SIZE);
-    struct sockaddr_in6 *sockAddr6 = reinterpret_cast<struct sockaddr_in6*>(addr.ai_addr);
-    inet_ntop(AF_INET6, &sockAddr6->sin6_addr, ip6Buf, IPV6_SIZE);
-    INetAddr iNetAddr;
-    iNetAddr.family_ = addr.ai_family;
-    iNetAddr.address_ = std::string(ip6Buf);
-    addrInfo.push_back(iNetAddr);
+    return !domains.empty() && hostName.find('.') == std::string::npos;
 }
 
 inline void InitAddrInfo(struct addrinfo &hints, int32_t family, int32_t flags, int32_t protocol, int32_t sockType)
@@ -142,16 +125,33 @@ inline void InitAddrInfo(struct addrinfo &hints, int32_t family, int32_t flags,
 
 int32_t DnsResolverService::GetAddressesByName(const std::string &hostName, std::vector<INetAddr> &addrInfo)
 {
-    if (!IsDomainValid(hostName)) {
+    DnsAddrBlob addrBlob;
+    int32_t ret = GetAddressesByNamePacked(hostName, addrBlob);
+    addrBlob.DecodeAll(addrInfo);
+    return ret;
+}
+
+int32_t DnsResolverService::GetAddressesByNamePacked(const std::string &hostName, DnsAddrBlob &addrBlob)
+{
+    if (!DnsNameValidator::IsValid(hostName)) {
         NETMGR_LOGE("Invalid domain name format");
         return DNS_ERROR;
     }
+    return LookupBySystem(hostName, AF_INET, addrBlob);
+}
+
+int32_t DnsResolverService::LookupBySystem(const std::string &hostName, int32_t family, DnsAddrBlob &addrBlob)
+{
     struct addrinfo hints;
-    InitAddrInfo(hints, AF_INET, AI_PASSIVE, 0, SOCK_DGRAM);
+    InitAddrInfo(hints, family, AI_PASSIVE, 0, SOCK_DGRAM);
     std::unique_ptr<addrinfo> res;
     std::string server;
-    uint16_t netId = 0;
-    int32_t ret = NetdController::GetInstance()->GetAddrInfo(hostName, server, hints, res, netId);
+    auto start = std::chrono::steady_clock::now();
+    int32_t ret = NetdController::GetInstance()->GetAddrInfo(hostName, server, hints, res, DNS_DEFAULT_NETID);
+    auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::shared_ptr<DnsServerCounters> counters = GetSystemCounters();
+    counters->RecordQuery();
+    counters->RecordOutcome(DnsResolverStats::GetOutcome(ret), static_cast<uint32_t>(latency.count()));
     if (ret != 0) {
         NETMGR_LOGE("GetAddressesByName Call GetAddrInfo of NetdController ret[%{public}d]", ret);
         return ret;
@@ -162,24 +162,34 @@ int32_t DnsResolverService::GetAddressesByName(const std::string &hostName, std:
         NETMGR_LOGE("GetAddrInfo of NetdController return resAddr error");
         return DNS_ERROR;
     }
+    /* The raw address bytes go straight into the reply, the text form is only built by a client that needs it */
     for (cur = resAddr; cur != nullptr; cur = cur->ai_next) {
         if (cur->ai_family == AF_INET) {
-            ProcessIPV4(*cur, addrInfo);
+            addrBlob.Append(AF_INET, &reinterpret_cast<struct sockaddr_in*>(cur->ai_addr)->sin_addr);
         } else if (cur->ai_family == AF_INET6) {
-            ProcessIPV6(*cur, addrInfo);
+            addrBlob.Append(AF_INET6, &reinterpret_cast<struct sockaddr_in6*>(cur->ai_addr)->sin6_addr);
         }
     }
-    if (resAddr != nullptr) {
-        FreeAddrInfo2(resAddr);
-    }
-    NETMGR_LOGE("GetAddressesByName addrInfo size [%{public}d]", addrInfo.size());
+    FreeAddrInfo2(resAddr);
+    NETMGR_LOGI("GetAddressesByName addrInfo size [%{public}zu]", addrBlob.Size());
     return DNS_SUCCESS;
 }
 
+std::shared_ptr<DnsServerCounters> DnsResolverService::GetSystemCounters()
+{
+    std::shared_ptr<DnsServerCounters> counters = std::atomic_load(&systemCounters_);
+    if (counters == nullptr) {
+        /* The system resolver does not say which server answered, its lookups are counted under an empty server */
+        counters = stats_.GetCounters(DNS_DEFAULT_NETID, "");
+        std::atomic_store(&systemCounters_, counters);
+    }
+    return counters;
+}
+
 int32_t DnsResolverService::GetAddrInfo(const std::string &hostName, const std::string &server,
     const sptr<DnsAddrInfo> &hints, std::vector<sptr<DnsAddrInfo>> &dnsAddrInfo)
 {
-    if (!IsDomainValid(hostName)) {
+    if (!DnsNameValidator::IsValid(hostName)) {
         return DNS_ERROR;
     }
     struct addrinfo hints2;
@@ -195,7 +205,7 @@ int32_t DnsResolverService::GetAddrInfo(const std::string &hostName, const std::
     if (resAddr == nullptr) {
         return DNS_ERROR;
     }
-    char ipbuf[IPV4_SIZE];
+    char ipbuf[IPV6_SIZE];
     for (cur = resAddr; cur != nullptr; cur = cur->ai_next) {
         sptr<DnsAddrInfo> d = (std::make_unique<DnsAddrInfo>()).release();
         if (d == nullptr) {
@@ -206,10 +216,15 @@ int32_t DnsResolverService::GetAddrInfo(const std::string &hostName, const std::
         d->sockType_ = cur->ai_socktype;
         d->protocol_ = cur->ai_protocol;
         if (d->family_ == AF_INET) {
-            bzero(ipbuf, IPV4_SIZE);
+            bzero(ipbuf, IPV6_SIZE);
             auto addr = reinterpret_cast<struct sockaddr_in*>(cur->ai_addr);
             inet_ntop(AF_INET, &addr->sin_addr, ipbuf, IPV4_SIZE);
             d->addr_ = std::string(ipbuf);
+        } else if (d->family_ == AF_INET6) {
+            bzero(ipbuf, IPV6_SIZE);
+            auto addr = reinterpret_cast<struct sockaddr_in6*>(cur->ai_addr);
+            inet_ntop(AF_INET6, &addr->sin6_addr, ipbuf, IPV6_SIZE);
+            d->addr_ = std::string(ipbuf);
         }
         dnsAddrInfo.push_back(d);
     }
@@ -225,6 +240,12 @@ int32_t DnsResolverService::CreateNetworkCache(uint16_t netId)
 int32_t DnsResolverService::DestoryNetworkCache(uint16_t netId)
 {
     NETMGR_LOGI("DnsResolverService DestoryNetworkCache netId[%{public}d]", netId);
+    stats_.Remove(netId);
+    if (netId == DNS_DEFAULT_NETID) {
+        std::atomic_store(&systemCounters_, std::shared_ptr<DnsServerCounters>());
+    }
+    selector_.Remove(netId);
+    DnsAddrSorter::ClearSourceCache();
     return static_cast<int32_t>(NetdController::GetInstance()->DestoryNetworkCache(netId));
 }
 
@@ -238,6 +259,11 @@ int32_t DnsResolverService::SetResolverConfig(uint16_t netId, uint16_t baseTimeo
     const std::vector<std::string> &servers, const std::vector<std::string> &domains)
 {
     NETMGR_LOGI("DnsResolverService SetResolverConfig netId[%{public}d]", netId);
+    /* A new configuration usually comes with a link change, the cached sources may be stale */
+    DnsAddrSorter::ClearSourceCache();
+    if (netId == DNS_DEFAULT_NETID) {
+        GetSystemCounters();
+    }
     return static_cast<int32_t>(NetdController::GetInstance()->SetResolverConfig(netId, baseTimeoutMsec,
         retryCount, servers, domains));
 }
@@ -249,5 +275,155 @@ int32_t DnsResolverService::GetResolverInfo(uint16_t netId, std::vector<std::str
     return static_cast<int32_t>(NetdController::GetInstance()->GetResolverInfo(netId, servers, domains,
         baseTimeoutMsec, retryCount));
 }
+
+int32_t DnsResolverService::GetAddressesByNames(const std::vector<std::string> &hostNames,
+    std::vector<int32_t> &results, std::vector<std::vector<INetAddr>> &addrInfos)
+{
+    std::vector<DnsAddrBlob> addrBlobs;
+    int32_t ret = GetAddressesByNamesPacked(hostNames, results, addrBlobs);
+    addrInfos.assign(addrBlobs.size(), {});
+    for (size_t i = 0; i < addrBlobs.size(); i++) {
+        addrBlobs[i].DecodeAll(addrInfos[i]);
+    }
+    return ret;
+}
+
+int32_t DnsResolverService::GetAddressesByNamesPacked(const std::vector<std::string> &hostNames,
+    std::vector<int32_t> &results, std::vector<DnsAddrBlob> &addrBlobs)
+{
+    if (hostNames.empty() || hostNames.size() > DNS_MAX_BATCH_NAMES) {
+        NETMGR_LOGE("GetAddressesByNames invalid batch size [%{public}zu]", hostNames.size());
+        return DNS_ERROR;
+    }
+    batchLookup_.Run(hostNames, [this](const std::string &hostName, DnsAddrBlob &addrBlob) {
+        return GetAddressesByNamePacked(hostName, addrBlob);
+    }, results, addrBlobs);
+    NETMGR_LOGI("GetAddressesByNames resolved [%{public}zu] names", hostNames.size());
+    return DNS_SUCCESS;
+}
+
+void DnsResolverService::ResolveBySystem(const std::string &hostName, int32_t family,
+    const sptr<IDnsResolverCallback> &callback)
+{
+    /* Run on the batch pool, neither the binder thread nor the engine loop may wait for the system resolver */
+    batchLookup_.Post(hostName, [this, family](const std::string &name, DnsAddrBlob &addrBlob) {
+            return LookupBySystem(name, family, addrBlob);
+        },
+        [hostName, family, callback](int32_t result, const DnsAddrBlob &addrBlob) {
+            std::vector<INetAddr> addrInfo;
+            addrBlob.DecodeAll(addrInfo);
+            if (family == AF_UNSPEC) {
+                DnsAddrSorter::Sort(addrInfo);
+            }
+            callback->OnResolved(hostName, result, addrInfo);
+        });
+}
+
+bool DnsResolverService::GetUpstreamConfig(std::vector<std::string> &servers, std::vector<std::string> &domains,
+    uint16_t &baseTimeoutMsec, uint8_t &retryCount)
+{
+    int32_t ret = NetdController::GetInstance()->GetResolverInfo(DNS_DEFAULT_NETID, servers, domains, baseTimeoutMsec,
+        retryCount);
+    if (ret != 0 || servers.empty()) {
+        NETMGR_LOGE("DnsResolverService no resolver config ret[%{public}d]", ret);
+        return false;
+    }
+    return true;
+}
+
+int32_t DnsResolverService::GetAddressesByNameAsync(const std::string &hostName,
+    const sptr<IDnsResolverCallback> &callback)
+{
+    if (callback == nullptr || !DnsNameValidator::IsValid(hostName)) {
+        NETMGR_LOGE("GetAddressesByNameAsync invalid parameter");
+        return DNS_ERROR;
+    }
+    std::vector<INetAddr> hostsAddrInfo;
+    if (hostsFile_.Lookup(hostName, AF_INET, hostsAddrInfo)) {
+        callback->OnResolved(hostName, DNS_SUCCESS, hostsAddrInfo);
+        return DNS_SUCCESS;
+    }
+    std::vector<std::string> servers;
+    std::vector<std::string> domains;
+    uint16_t baseTimeoutMsec = 0;
+    uint8_t retryCount = 0;
+    if (!GetUpstreamConfig(servers, domains, baseTimeoutMsec, retryCount)) {
+        return DNS_ERROR;
+    }
+    if (NeedsSearchDomains(hostName, domains)) {
+        ResolveBySystem(hostName, AF_INET, callback);
+        return DNS_SUCCESS;
+    }
+    /* The binder thread returns as soon as the query is queued, the result goes back one way */
+    return queryEngine_.Query(hostName, AF_INET, servers, baseTimeoutMsec, retryCount,
+        [this, hostName, callback](int32_t result, const std::vector<INetAddr> &addrInfo) {
+            if (result == DnsQueryEngine::RESULT_TRUNCATED) {
+                ResolveBySystem(hostName, AF_INET, callback);
+                return;
+            }
+            callback->OnResolved(hostName, result, addrInfo);
+        }, DNS_DEFAULT_NETID);
+}
+
+int32_t DnsResolverService::GetAddressesByNameDualStack(const std::string &hostName,
+    const sptr<IDnsResolverCallback> &callback)
+{
+    if (callback == nullptr || !DnsNameValidator::IsValid(hostName)) {
+        NETMGR_LOGE("GetAddressesByNameDualStack invalid parameter");
+        return DNS_ERROR;
+    }
+    std::vector<INetAddr> hostsAddrInfo;
+    if (hostsFile_.Lookup(hostName, AF_UNSPEC, hostsAddrInfo)) {
+        DnsAddrSorter::Sort(hostsAddrInfo);
+        callback->OnResolved(hostName, DNS_SUCCESS, hostsAddrInfo);
+        return DNS_SUCCESS;
+    }
+    std::vector<std::string> servers;
+    std::vector<std::string> domains;
+    uint16_t baseTimeoutMsec = 0;
+    uint8_t retryCount = 0;
+    if (!GetUpstreamConfig(servers, domains, baseTimeoutMsec, retryCount)) {
+        return DNS_ERROR;
+    }
+    if (NeedsSearchDomains(hostName, domains)) {
+        ResolveBySystem(hostName, AF_UNSPEC, callback);
+        return DNS_SUCCESS;
+    }
+    /* A and AAAA go out together, the first family to answer reaches the client one round trip earlier */
+    return DnsDualStackQuery::Start(queryEngine_, hostName, servers, baseTimeoutMsec, retryCount,
+        [hostName, callback](const std::vector<INetAddr> &addrInfo) {
+            callback->OnPartialResolved(hostName, addrInfo);
+        },
+        [this, hostName, callback](int32_t result, const std::vector<INetAddr> &addrInfo) {
+            if (result == DnsQueryEngine::RESULT_TRUNCATED) {
+                ResolveBySystem(hostName, AF_UNSPEC, callback);
+                return;
+            }
+            callback->OnResolved(hostName, result, addrInfo);
+        }, DNS_DEFAULT_NETID);
+}
+
+int32_t DnsResolverService::GetResolverStats(uint16_t netId, std::vector<DnsServerStats> &stats)
+{
+    stats_.GetStats(netId, stats);
+    return DNS_SUCCESS;
+}
+
+int32_t DnsResolverService::Dump(int32_t fd, const std::vector<std::u16string> &args)
+{
+    std::string info;
+    stats_.Dump(info);
+    selector_.Dump(info);
+    DnsQueryEngineStats engineStats = queryEngine_.GetStats();
+    info.append("DNS query engine: submitted " + std::to_string(engineStats.submitted) + " answered " +
+        std::to_string(engineStats.answered) + " failed " + std::to_string(engineStats.failed) + " timeouts " +
+        std::to_string(engineStats.timeouts) + " retries " + std::to_string(engineStats.retries) + " stray " +
+        std::to_string(engineStats.strayReplies) + " pending " + std::to_string(engineStats.pending) + "\n");
+    if (dprintf(fd, "%s", info.c_str()) < 0) {
+        NETMGR_LOGE("DnsResolverService dump failed");
+        return DNS_ERROR;
+    }
+    return DNS_SUCCESS;
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_resolver_stats.h"
+
+#include <netdb.h>
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t UINT32_BITS = 32;
+const std::string SYSTEM_RESOLVER_NAME = "system";
+} // namespace
+
+void DnsServerCounters::RecordQuery()
+{
+    queries.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DnsServerCounters::RecordOutcome(DnsQueryOutcome outcome, uint32_t latencyMs)
+{
+    switch (outcome) {
+        case DNS_OUTCOME_SUCCESS:
+            successes.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case DNS_OUTCOME_TIMEOUT:
+            timeouts.fetch_add(1, std::memory_order_relaxed);
+            return;
+        case DNS_OUTCOME_NXDOMAIN:
+            nxDomains.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case DNS_OUTCOME_SERVFAIL:
+            servFails.fetch_add(1, std::memory_order_relaxed);
+            break;
+        default:
+            errors.fetch_add(1, std::memory_order_relaxed);
+            break;
+    }
+    latencyBuckets[DnsResolverStats::GetBucket(latencyMs)].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::shared_ptr<DnsServerCounters> DnsResolverStats::GetCounters(uint16_t netId, const std::string &server)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &counters = networks_[netId][server];
+    if (counters == nullptr) {
+        counters = std::make_shared<DnsServerCounters>();
+    }
+    return counters;
+}
+
+void DnsResolverStats::Record(uint16_t netId, const std::string &server, DnsQueryOutcome outcome,
+    uint32_t latencyMs)
+{
+    std::shared_ptr<DnsServerCounters> counters = GetCounters(netId, server);
+    counters->RecordQuery();
+    counters->RecordOutcome(outcome, latencyMs);
+}
+
+void DnsResolverStats::GetStats(uint16_t netId, std::vector<DnsServerStats> &stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto network = networks_.find(netId);
+    if (network == networks_.end()) {
+        return;
+    }
+    for (const auto &server : network->second) {
+        const DnsServerCounters &counters = *server.second;
+        DnsServerStats item;
+        item.server_ = server.first;
+        item.queries_ = counters.queries.load(std::memory_order_relaxed);
+        item.successes_ = counters.successes.load(std::memory_order_relaxed);
+        item.timeouts_ = counters.timeouts.load(std::memory_order_relaxed);
+        item.nxDomains_ = counters.nxDomains.load(std::memory_order_relaxed);
+        item.servFails_ = counters.servFails.load(std::memory_order_relaxed);
+        item.errors_ = counters.errors.load(std::memory_order_relaxed);
+        for (const auto &bucket : counters.latencyBuckets) {
+            item.latencyBuckets_.push_back(bucket.load(std::memory_order_relaxed));
+        }
+        stats.push_back(item);
+    }
+}
+
+void DnsResolverStats::Remove(uint16_t netId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    networks_.erase(netId);
+}
+
+void DnsResolverStats::Dump(std::string &info) const
+{
+    std::vector<uint16_t> netIds;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &network : networks_) {
+            netIds.push_back(network.first);
+        }
+    }
+    info.append("DNS resolver stats:\n");
+    for (uint16_t netId : netIds) {
+        std::vector<DnsServerStats> stats;
+        GetStats(netId, stats);
+        for (const auto &item : stats) {
+            info.append("  netId " + std::to_string(netId) + " server " +
+                (item.server_.empty() ? SYSTEM_RESOLVER_NAME : item.server_) + ": queries " +
+                std::to_string(item.queries_) + " successes " + std::to_string(item.successes_) + " timeouts " +
+                std::to_string(item.timeouts_) + " nxdomain " + std::to_string(item.nxDomains_) + " servfail " +
+                std::to_string(item.servFails_) + " errors " + std::to_string(item.errors_) + "\n    latency ms");
+            for (uint32_t i = 0; i < item.latencyBuckets_.size(); i++) {
+                uint32_t upper = DnsServerStats::GetBucketUpperMs(i);
+                info.append((upper == UINT32_MAX) ? " >=" + std::to_string(DnsServerStats::GetBucketUpperMs(i - 1)) :
+                    " <" + std::to_string(upper));
+                info.append(":" + std::to_string(item.latencyBuckets_[i]));
+            }
+            info.append("\n");
+        }
+    }
+}
+
+DnsQueryOutcome DnsResolverStats::GetOutcome(int32_t result)
+{
+    switch (result) {
+        case 0:
+            return DNS_OUTCOME_SUCCESS;
+#ifdef EAI_NODATA
+        case EAI_NODATA:
+#endif
+        case EAI_NONAME:
+            return DNS_OUTCOME_NXDOMAIN;
+        case EAI_AGAIN:
+            return DNS_OUTCOME_TIMEOUT;
+        case EAI_FAIL:
+            return DNS_OUTCOME_SERVFAIL;
+        default:
+            return DNS_OUTCOME_ERROR;
+    }
+}
+
+uint32_t DnsResolverStats::GetBucket(uint32_t latencyMs)
+{
+    if (latencyMs == 0) {
+        return 0;
+    }
+    uint32_t bucket = UINT32_BITS - static_cast<uint32_t>(__builtin_clz(latencyMs));
+    return (bucket < DNS_LATENCY_BUCKETS) ? bucket : DNS_LATENCY_BUCKETS - 1;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
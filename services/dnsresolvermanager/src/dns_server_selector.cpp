@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_server_selector.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t RATE_ONE = 1024;
+constexpr uint32_t RATE_SHIFT = 3;
+constexpr uint32_t SRTT_WEIGHT = 8;
+constexpr uint32_t RTTVAR_WEIGHT = 4;
+constexpr uint32_t RATE_BITS = 10;
+constexpr uint32_t DEAD_AFTER_FAILURES = 2;
+constexpr uint32_t MIN_BACKOFF_MS = 1000;
+constexpr uint32_t MAX_BACKOFF_MS = 60000;
+constexpr uint32_t PERCENT = 100;
+} // namespace
+
+DnsServerSelector::DnsServerSelector(uint32_t probeOneIn)
+    : probeOneIn_(probeOneIn), random_(std::random_device()())
+{}
+
+void DnsServerSelector::Order(uint16_t netId, const std::vector<std::string> &servers, uint32_t timeoutMs,
+    std::vector<size_t> &order)
+{
+    std::vector<std::pair<uint32_t, size_t>> live;
+    std::vector<std::pair<Clock::time_point, size_t>> skipped;
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < servers.size(); i++) {
+        const DnsServerHealth &health = servers_[{netId, servers[i]}];
+        if (now < health.skipUntil) {
+            skipped.emplace_back(health.skipUntil, i);
+        } else {
+            live.emplace_back(GetScore(health, timeoutMs), i);
+        }
+    }
+    /* Stable, servers that rank the same keep the configured order */
+    std::stable_sort(live.begin(), live.end(),
+        [](const auto &left, const auto &right) { return left.first < right.first; });
+    std::stable_sort(skipped.begin(), skipped.end(),
+        [](const auto &left, const auto &right) { return left.first < right.first; });
+    if (probeOneIn_ > 0 && live.size() > 1 && random_() % probeOneIn_ == 0) {
+        size_t probe = 1 + random_() % (live.size() - 1);
+        std::rotate(live.begin(), live.begin() + probe, live.begin() + probe + 1);
+    }
+    order.clear();
+    for (const auto &item : live) {
+        order.push_back(item.second);
+    }
+    for (const auto &item : skipped) {
+        order.push_back(item.second);
+    }
+}
+
+void DnsServerSelector::Record(uint16_t netId, const std::string &server, DnsQueryOutcome outcome, uint32_t rttMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    DnsServerHealth &health = servers_[{netId, server}];
+    if (outcome == DNS_OUTCOME_SUCCESS || outcome == DNS_OUTCOME_NXDOMAIN) {
+        if (!health.hasRtt) {
+            health.hasRtt = true;
+            health.srttMs = rttMs;
+            health.rttVarMs = rttMs / 2;
+        } else {
+            uint32_t delta = (health.srttMs > rttMs) ? health.srttMs - rttMs : rttMs - health.srttMs;
+            health.rttVarMs = (health.rttVarMs * (RTTVAR_WEIGHT - 1) + delta) / RTTVAR_WEIGHT;
+            health.srttMs = (health.srttMs * (SRTT_WEIGHT - 1) + rttMs) / SRTT_WEIGHT;
+        }
+        health.failureRate -= health.failureRate >> RATE_SHIFT;
+        health.consecutiveFailures = 0;
+        health.backoffMs = 0;
+        health.skipUntil = {};
+        return;
+    }
+    health.failureRate += (RATE_ONE - health.failureRate) >> RATE_SHIFT;
+    health.consecutiveFailures++;
+    /* Once skipped, a failed probe after the backoff skips the server again for twice as long */
+    if (health.consecutiveFailures >= DEAD_AFTER_FAILURES || health.backoffMs > 0) {
+        health.backoffMs = (health.backoffMs == 0) ? MIN_BACKOFF_MS : std::min(health.backoffMs * 2, MAX_BACKOFF_MS);
+        health.skipUntil = Clock::now() + std::chrono::milliseconds(health.backoffMs);
+    }
+}
+
+bool DnsServerSelector::GetHealth(uint16_t netId, const std::string &server, DnsServerHealth &health) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = servers_.find({netId, server});
+    if (it == servers_.end()) {
+        return false;
+    }
+    health = it->second;
+    return true;
+}
+
+void DnsServerSelector::Remove(uint16_t netId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto begin = servers_.lower_bound({netId, std::string()});
+    auto end = begin;
+    while (end != servers_.end() && end->first.first == netId) {
+        ++end;
+    }
+    servers_.erase(begin, end);
+}
+
+void DnsServerSelector::Dump(std::string &info) const
+{
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    info.append("DNS server selection:\n");
+    for (const auto &item : servers_) {
+        const DnsServerHealth &health = item.second;
+        auto skipMs = std::chrono::duration_cast<std::chrono::milliseconds>(health.skipUntil - now).count();
+        info.append("  netId " + std::to_string(item.first.first) + " server " + item.first.second + ": srtt " +
+            (health.hasRtt ? std::to_string(health.srttMs) + "ms rttvar " + std::to_string(health.rttVarMs) + "ms" :
+            std::string("unknown")) + " failures " + std::to_string(health.failureRate * PERCENT / RATE_ONE) +
+            "% skipped " + std::to_string((skipMs > 0) ? skipMs : 0) + "ms\n");
+    }
+}
+
+/* Expected cost of trying the server first, a server never answered yet ranks first so it gets measured */
+uint32_t DnsServerSelector::GetScore(const DnsServerHealth &health, uint32_t timeoutMs) const
+{
+    uint32_t rtt = health.hasRtt ? health.srttMs + health.rttVarMs : 0;
+    return rtt + static_cast<uint32_t>((static_cast<uint64_t>(health.failureRate) * timeoutMs) >> RATE_BITS);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dns_resolver_callback_proxy.h"
+
+#include "dns_resolver_constants.h"
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+DnsResolverCallbackProxy::DnsResolverCallbackProxy(const sptr<IRemoteObject> &impl)
+    : IRemoteProxy<IDnsResolverCallback>(impl)
+{}
+
+DnsResolverCallbackProxy::~DnsResolverCallbackProxy() {}
+
+int32_t DnsResolverCallbackProxy::OnResolved(const std::string &hostName, int32_t result,
+    const std::vector<INetAddr> &addrInfo)
+{
+    return SendResult(DNS_RESOLVED, hostName, result, addrInfo);
+}
+
+int32_t DnsResolverCallbackProxy::OnPartialResolved(const std::string &hostName,
+    const std::vector<INetAddr> &addrInfo)
+{
+    return SendResult(DNS_PARTIAL_RESOLVED, hostName, DNS_SUCCESS, addrInfo);
+}
+
+int32_t DnsResolverCallbackProxy::SendResult(uint32_t code, const std::string &hostName, int32_t result,
+    const std::vector<INetAddr> &addrInfo)
+{
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        NETMGR_LOGE("WriteInterfaceToken failed");
+        return ERR_FLATTEN_OBJECT;
+    }
+    if (!data.WriteString(hostName) || !data.WriteInt32(result) || !data.WriteInt32(addrInfo.size())) {
+        NETMGR_LOGE("Write parcel failed");
+        return ERR_FLATTEN_OBJECT;
+    }
+    for (const auto &addr : addrInfo) {
+        if (!addr.Marshalling(data)) {
+            NETMGR_LOGE("Proxy Marshalling failed");
+            return ERR_FLATTEN_OBJECT;
+        }
+    }
+
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOGE("Remote is null");
+        return ERR_NULL_OBJECT;
+    }
+
+    /* One way, the resolver loop thread never waits for the client to handle the result */
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+    int32_t ret = remote->SendRequest(code, data, reply, option);
+    if (ret != ERR_NONE) {
+        NETMGR_LOGE("Proxy SendRequest failed, ret code:[%{public}d]", ret);
+    }
+    return ret;
+}
+
+bool DnsResolverCallbackProxy::WriteInterfaceToken(MessageParcel &data)
+{
+    if (!data.WriteInterfaceToken(DnsResolverCallbackProxy::GetDescriptor())) {
+        NETMGR_LOGE("WriteInterfaceToken failed");
+        return false;
+    }
+    return true;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
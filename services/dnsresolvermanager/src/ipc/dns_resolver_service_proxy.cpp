@@ -37,6 +37,14 @@ bool DnsResolverServiceProxy::WriteInterfaceToken(MessageParcel &data)
 }
 
 int32_t DnsResolverServiceProxy::GetAddressesByName(const std::string &hostName, std::vector<INetAddr> &addrInfo)
+{
+    DnsAddrBlob addrBlob;
+    int32_t ret = GetAddressesByNamePacked(hostName, addrBlob);
+    addrBlob.DecodeAll(addrInfo);
+    return ret;
+}
+
+int32_t DnsResolverServiceProxy::GetAddressesByNamePacked(const std::string &hostName, DnsAddrBlob &addrBlob)
 {
     MessageParcel data;
     if (hostName.empty()) {
@@ -60,14 +68,9 @@ int32_t DnsResolverServiceProxy::GetAddressesByName(const std::string &hostName,
         NETMGR_LOGE("proxy SendRequest failed, error code: [%{public}d]", ret);
         return NETMANAGER_ERR_IPC_CONNECT_STUB_FAIL;
     }
-    int32_t vsize = 0;
-    if (!reply.ReadInt32(vsize)) {
+    if (!DnsAddrBlob::Unmarshalling(reply, addrBlob)) {
         return NETMANAGER_ERR_READ_REPLY_FAIL;
     }
-    for (int32_t i = 0; i < vsize; ++i) {
-        sptr<INetAddr> addr = INetAddr::Unmarshalling(reply);
-        addrInfo.push_back(*addr);
-    }
     return reply.ReadInt32();
 }
 
@@ -102,18 +105,9 @@ int32_t DnsResolverServiceProxy::GetAddrInfo(const std::string &hostName, const
         NETMGR_LOGE("proxy SendRequest failed, error code: [%{public}d]", ret);
         return NETMANAGER_ERR_IPC_CONNECT_STUB_FAIL;
     }
-    int32_t vsize;
-    if (!reply.ReadInt32(vsize)) {
+    if (!DnsAddrInfo::UnmarshallingList(reply, dnsAddrInfo)) {
         return NETMANAGER_ERR_READ_REPLY_FAIL;
     }
-    for (int32_t i = 0; i < vsize; ++i) {
-        auto d = DnsAddrInfo::Unmarshalling(reply);
-        if (d != nullptr) {
-            dnsAddrInfo.push_back(d);
-        } else {
-            return NETMANAGER_ERR_LOCAL_PTR_NULL;
-        }
-    }
     return reply.ReadInt32();
 }
 
@@ -290,5 +284,143 @@ int32_t DnsResolverServiceProxy::GetResolverInfo(uint16_t netId, std::vector<std
     }
     return reply.ReadInt32();
 }
+
+int32_t DnsResolverServiceProxy::GetAddressesByNames(const std::vector<std::string> &hostNames,
+    std::vector<int32_t> &results, std::vector<std::vector<INetAddr>> &addrInfos)
+{
+    std::vector<DnsAddrBlob> addrBlobs;
+    int32_t ret = GetAddressesByNamesPacked(hostNames, results, addrBlobs);
+    addrInfos.assign(addrBlobs.size(), {});
+    for (size_t i = 0; i < addrBlobs.size(); i++) {
+        addrBlobs[i].DecodeAll(addrInfos[i]);
+    }
+    return ret;
+}
+
+int32_t DnsResolverServiceProxy::GetAddressesByNamesPacked(const std::vector<std::string> &hostNames,
+    std::vector<int32_t> &results, std::vector<DnsAddrBlob> &addrBlobs)
+{
+    MessageParcel data;
+    if (hostNames.empty()) {
+        return NETMANAGER_ERR_STRING_EMPTY;
+    }
+    if (hostNames.size() > DNS_MAX_BATCH_NAMES) {
+        NETMGR_LOGE("batch of [%{public}zu] names is too large", hostNames.size());
+        return DNS_ERROR;
+    }
+    if (!WriteInterfaceToken(data)) {
+        return NETMANAGER_ERR_WRITE_DESCRIPTOR_TOKEN_FAIL;
+    }
+    if (!data.WriteInt32(hostNames.size())) {
+        return NETMANAGER_ERR_WRITE_DATA_FAIL;
+    }
+    for (const auto &hostName : hostNames) {
+        if (!data.WriteString(hostName)) {
+            return NETMANAGER_ERR_WRITE_DATA_FAIL;
+        }
+    }
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOGE("Remote is null");
+        return NETMANAGER_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    MessageParcel reply;
+    MessageOption option;
+    int32_t ret = remote->SendRequest(CMD_GET_ADDR_BY_NAMES, data, reply, option);
+    if (ret != ERR_NONE) {
+        NETMGR_LOGE("proxy SendRequest failed, error code: [%{public}d]", ret);
+        return NETMANAGER_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    int32_t size = 0;
+    if (!reply.ReadInt32(size) || size != static_cast<int32_t>(hostNames.size())) {
+        return NETMANAGER_ERR_READ_REPLY_FAIL;
+    }
+    results.assign(size, DNS_ERROR);
+    addrBlobs.assign(size, {});
+    for (int32_t i = 0; i < size; ++i) {
+        if (!reply.ReadInt32(results[i]) || !DnsAddrBlob::Unmarshalling(reply, addrBlobs[i])) {
+            return NETMANAGER_ERR_READ_REPLY_FAIL;
+        }
+    }
+    return reply.ReadInt32();
+}
+
+int32_t DnsResolverServiceProxy::GetAddressesByNameAsync(const std::string &hostName,
+    const sptr<IDnsResolverCallback> &callback)
+{
+    return SendNameWithCallback(CMD_GET_ADDR_BY_NAME_ASYNC, hostName, callback);
+}
+
+int32_t DnsResolverServiceProxy::GetAddressesByNameDualStack(const std::string &hostName,
+    const sptr<IDnsResolverCallback> &callback)
+{
+    return SendNameWithCallback(CMD_GET_ADDR_BY_NAME_DUAL_STACK, hostName, callback);
+}
+
+int32_t DnsResolverServiceProxy::GetResolverStats(uint16_t netId, std::vector<DnsServerStats> &stats)
+{
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        return NETMANAGER_ERR_WRITE_DESCRIPTOR_TOKEN_FAIL;
+    }
+    if (!data.WriteUint16(netId)) {
+        return NETMANAGER_ERR_WRITE_DATA_FAIL;
+    }
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOGE("Remote is null");
+        return NETMANAGER_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    MessageParcel reply;
+    MessageOption option;
+    int32_t ret = remote->SendRequest(CMD_GET_RESOLVER_STATS, data, reply, option);
+    if (ret != ERR_NONE) {
+        NETMGR_LOGE("proxy SendRequest failed, error code: [%{public}d]", ret);
+        return NETMANAGER_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    uint32_t size = 0;
+    if (!reply.ReadUint32(size)) {
+        return NETMANAGER_ERR_READ_REPLY_FAIL;
+    }
+    for (uint32_t i = 0; i < size; ++i) {
+        sptr<DnsServerStats> item = DnsServerStats::Unmarshalling(reply);
+        if (item == nullptr) {
+            return NETMANAGER_ERR_READ_REPLY_FAIL;
+        }
+        stats.push_back(*item);
+    }
+    return reply.ReadInt32();
+}
+
+int32_t DnsResolverServiceProxy::SendNameWithCallback(uint32_t code, const std::string &hostName,
+    const sptr<IDnsResolverCallback> &callback)
+{
+    MessageParcel data;
+    if (hostName.empty()) {
+        return NETMANAGER_ERR_STRING_EMPTY;
+    }
+    if (callback == nullptr) {
+        return NETMANAGER_ERR_LOCAL_PTR_NULL;
+    }
+    if (!WriteInterfaceToken(data)) {
+        return NETMANAGER_ERR_WRITE_DESCRIPTOR_TOKEN_FAIL;
+    }
+    if (!data.WriteString(hostName) || !data.WriteRemoteObject(callback->AsObject().GetRefPtr())) {
+        return NETMANAGER_ERR_WRITE_DATA_FAIL;
+    }
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOGE("Remote is null");
+        return NETMANAGER_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    MessageParcel reply;
+    MessageOption option;
+    int32_t ret = remote->SendRequest(code, data, reply, option);
+    if (ret != ERR_NONE) {
+        NETMGR_LOGE("proxy SendRequest failed, error code: [%{public}d]", ret);
+        return NETMANAGER_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    return reply.ReadInt32();
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
\ No newline at end of file
@@ -20,36 +20,41 @@
 
 namespace OHOS {
 namespace NetManagerStandard {
-DnsResolverServiceStub::DnsResolverServiceStub()
-{
-    memberFuncMap_[CMD_GET_ADDR_BY_NAME] = &DnsResolverServiceStub::OnGetAddressesByName;
-    memberFuncMap_[CMD_GET_ADDR_INFO] = &DnsResolverServiceStub::OnGetAddrInfo;
-    memberFuncMap_[CMD_CRT_NETWORK_CACHE] = &DnsResolverServiceStub::OnCreateNetworkCache;
-    memberFuncMap_[CMD_DEL_NETWORK_CACHE] = &DnsResolverServiceStub::OnDestoryNetworkCache;
-    memberFuncMap_[CMD_FLS_NETWORK_CACHE] = &DnsResolverServiceStub::OnFlushNetworkCache;
-    memberFuncMap_[CMD_SET_RESOLVER_CONFIG] = &DnsResolverServiceStub::OnSetResolverConfig;
-    memberFuncMap_[CMD_GET_RESOLVER_INFO] = &DnsResolverServiceStub::OnGetResolverInfo;
-}
+DnsResolverServiceStub::DnsResolverServiceStub() {}
 
 DnsResolverServiceStub::~DnsResolverServiceStub() {}
 
+const DnsResolverServiceStub::DispatchTable &DnsResolverServiceStub::GetDispatchTable()
+{
+    /* constexpr so the table is built at compile time and a code past the table end fails to compile */
+    static constexpr DispatchTable table({
+        {CMD_GET_ADDR_BY_NAME, &DnsResolverServiceStub::OnGetAddressesByName},
+        {CMD_GET_ADDR_INFO, &DnsResolverServiceStub::OnGetAddrInfo},
+        {CMD_CRT_NETWORK_CACHE, &DnsResolverServiceStub::OnCreateNetworkCache},
+        {CMD_DEL_NETWORK_CACHE, &DnsResolverServiceStub::OnDestoryNetworkCache},
+        {CMD_FLS_NETWORK_CACHE, &DnsResolverServiceStub::OnFlushNetworkCache},
+        {CMD_SET_RESOLVER_CONFIG, &DnsResolverServiceStub::OnSetResolverConfig},
+        {CMD_GET_RESOLVER_INFO, &DnsResolverServiceStub::OnGetResolverInfo},
+        {CMD_GET_ADDR_BY_NAMES, &DnsResolverServiceStub::OnGetAddressesByNames},
+        {CMD_GET_ADDR_BY_NAME_ASYNC, &DnsResolverServiceStub::OnGetAddressesByNameAsync},
+        {CMD_GET_ADDR_BY_NAME_DUAL_STACK, &DnsResolverServiceStub::OnGetAddressesByNameDualStack},
+        {CMD_GET_RESOLVER_STATS, &DnsResolverServiceStub::OnGetResolverStats},
+    });
+    return table;
+}
+
 int32_t DnsResolverServiceStub::OnRemoteRequest(
     uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option)
 {
-    NETMGR_LOGI("stub call start, code = [%{public}d]", code);
-
     std::u16string myDescripter = DnsResolverServiceStub::GetDescriptor();
     std::u16string remoteDescripter = data.ReadInterfaceToken();
     if (myDescripter != remoteDescripter) {
         NETMGR_LOGE("descriptor checked fail");
         return NETMANAGER_ERR_DESCRIPTOR_MISMATCH;
     }
-    auto itFunc = memberFuncMap_.find(code);
-    if (itFunc != memberFuncMap_.end()) {
-        auto requestFunc = itFunc->second;
-        if (requestFunc != nullptr) {
-            return (this->*requestFunc)(data, reply);
-        }
+    auto requestFunc = GetDispatchTable().Find(code);
+    if (requestFunc != nullptr) {
+        return (this->*requestFunc)(data, reply);
     }
 
     NETMGR_LOGI("stub default case, need check");
@@ -62,16 +67,11 @@ int32_t DnsResolverServiceStub::OnGetAddressesByName(MessageParcel &data, Messag
     if (!data.ReadString(hostName)) {
         return NETMANAGER_ERR_READ_DATA_FAIL;
     }
-    std::vector<INetAddr> addrInfo;
-    int32_t ret = GetAddressesByName(hostName, addrInfo);
-    if (!reply.WriteInt32(addrInfo.size())) {
+    DnsAddrBlob addrBlob;
+    int32_t ret = GetAddressesByNamePacked(hostName, addrBlob);
+    if (!addrBlob.Marshalling(reply)) {
         return NETMANAGER_ERR_WRITE_REPLY_FAIL;
     }
-    for (auto s : addrInfo) {
-        if (!s.Marshalling(reply)) {
-            return NETMANAGER_ERR_WRITE_REPLY_FAIL;
-        }
-    }
     if (!reply.WriteInt32(ret)) {
         return NETMANAGER_ERR_WRITE_REPLY_FAIL;
     }
@@ -92,13 +92,9 @@ int32_t DnsResolverServiceStub::OnGetAddrInfo(MessageParcel &data, MessageParcel
     std::vector<sptr<DnsAddrInfo>> dnsAddrInfo;
     int32_t ret = GetAddrInfo(hostname, server, hints, dnsAddrInfo);
 
-    int32_t vsize = dnsAddrInfo.size();
-    if (!reply.WriteInt32(vsize)) {
+    if (!DnsAddrInfo::MarshallingList(reply, dnsAddrInfo)) {
         return NETMANAGER_ERR_WRITE_REPLY_FAIL;
     }
-    for (std::vector<sptr<DnsAddrInfo>>::iterator it = dnsAddrInfo.begin(); it != dnsAddrInfo.end(); ++it) {
-        (*it)->Marshalling(reply);
-    }
     if (!reply.WriteInt32(ret)) {
         return NETMANAGER_ERR_WRITE_REPLY_FAIL;
     }
@@ -238,5 +234,101 @@ int32_t DnsResolverServiceStub::OnGetResolverInfo(MessageParcel &data, MessagePa
     }
     return NETMANAGER_SUCCESS;
 }
+
+int32_t DnsResolverServiceStub::OnGetAddressesByNames(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t size = 0;
+    if (!data.ReadInt32(size) || size < 0 || static_cast<uint32_t>(size) > DNS_MAX_BATCH_NAMES) {
+        return NETMANAGER_ERR_READ_DATA_FAIL;
+    }
+    std::vector<std::string> hostNames(size);
+    for (auto &hostName : hostNames) {
+        if (!data.ReadString(hostName)) {
+            return NETMANAGER_ERR_READ_DATA_FAIL;
+        }
+    }
+    std::vector<int32_t> results;
+    std::vector<DnsAddrBlob> addrBlobs;
+    int32_t ret = GetAddressesByNamesPacked(hostNames, results, addrBlobs);
+    if (!reply.WriteInt32(results.size())) {
+        return NETMANAGER_ERR_WRITE_REPLY_FAIL;
+    }
+    for (size_t i = 0; i < results.size() && i < addrBlobs.size(); i++) {
+        if (!reply.WriteInt32(results[i]) || !addrBlobs[i].Marshalling(reply)) {
+            return NETMANAGER_ERR_WRITE_REPLY_FAIL;
+        }
+    }
+    if (!reply.WriteInt32(ret)) {
+        return NETMANAGER_ERR_WRITE_REPLY_FAIL;
+    }
+    return NETMANAGER_SUCCESS;
+}
+
+int32_t DnsResolverServiceStub::ReadNameWithCallback(MessageParcel &data, std::string &hostName,
+    sptr<IDnsResolverCallback> &callback)
+{
+    if (!data.ReadString(hostName)) {
+        return NETMANAGER_ERR_READ_DATA_FAIL;
+    }
+    sptr<IRemoteObject> remote = data.ReadRemoteObject();
+    if (remote == nullptr) {
+        NETMGR_LOGE("callback ptr is nullptr.");
+        return NETMANAGER_ERR_READ_DATA_FAIL;
+    }
+    callback = iface_cast<IDnsResolverCallback>(remote);
+    return NETMANAGER_SUCCESS;
+}
+
+int32_t DnsResolverServiceStub::OnGetAddressesByNameAsync(MessageParcel &data, MessageParcel &reply)
+{
+    std::string hostName;
+    sptr<IDnsResolverCallback> callback;
+    int32_t result = ReadNameWithCallback(data, hostName, callback);
+    if (result != NETMANAGER_SUCCESS) {
+        return result;
+    }
+    int32_t ret = GetAddressesByNameAsync(hostName, callback);
+    if (!reply.WriteInt32(ret)) {
+        return NETMANAGER_ERR_WRITE_REPLY_FAIL;
+    }
+    return NETMANAGER_SUCCESS;
+}
+
+int32_t DnsResolverServiceStub::OnGetAddressesByNameDualStack(MessageParcel &data, MessageParcel &reply)
+{
+    std::string hostName;
+    sptr<IDnsResolverCallback> callback;
+    int32_t result = ReadNameWithCallback(data, hostName, callback);
+    if (result != NETMANAGER_SUCCESS) {
+        return result;
+    }
+    int32_t ret = GetAddressesByNameDualStack(hostName, callback);
+    if (!reply.WriteInt32(ret)) {
+        return NETMANAGER_ERR_WRITE_REPLY_FAIL;
+    }
+    return NETMANAGER_SUCCESS;
+}
+
+int32_t DnsResolverServiceStub::OnGetResolverStats(MessageParcel &data, MessageParcel &reply)
+{
+    uint16_t netId = 0;
+    if (!data.ReadUint16(netId)) {
+        return NETMANAGER_ERR_READ_DATA_FAIL;
+    }
+    std::vector<DnsServerStats> stats;
+    int32_t ret = GetResolverStats(netId, stats);
+    if (!reply.WriteUint32(static_cast<uint32_t>(stats.size()))) {
+        return NETMANAGER_ERR_WRITE_REPLY_FAIL;
+    }
+    for (const auto &item : stats) {
+        if (!item.Marshalling(reply)) {
+            return NETMANAGER_ERR_WRITE_REPLY_FAIL;
+        }
+    }
+    if (!reply.WriteInt32(ret)) {
+        return NETMANAGER_ERR_WRITE_REPLY_FAIL;
+    }
+    return NETMANAGER_SUCCESS;
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <iostream>
+#include <netdb.h>
+
+#include "message_parcel.h"
+
+#include "dns_addr_blob.h"
+#include "dns_addr_info.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+using Clock = std::chrono::steady_clock;
+constexpr uint32_t BENCH_ITERATIONS = 20000;
+constexpr size_t IPV6_ADDR_LEN = 16;
+
+INetAddr MakeAddr(int32_t family, const std::string &address)
+{
+    INetAddr addr;
+    addr.family_ = family;
+    addr.address_ = address;
+    return addr;
+}
+
+/* Raw answers as the resolver hands them over, every fourth one IPv6 */
+struct RawAnswer {
+    int32_t family;
+    uint8_t addr[IPV6_ADDR_LEN];
+};
+
+std::vector<RawAnswer> MakeRawAnswers(uint32_t count)
+{
+    std::vector<RawAnswer> answers;
+    for (uint32_t i = 0; i < count; i++) {
+        RawAnswer answer = {};
+        if (i % 4 == 3) {
+            answer.family = AF_INET6;
+            inet_pton(AF_INET6, ("2001:db8::" + std::to_string(i + 1)).c_str(), answer.addr);
+        } else {
+            answer.family = AF_INET;
+            inet_pton(AF_INET, ("10.0.0." + std::to_string(i + 1)).c_str(), answer.addr);
+        }
+        answers.push_back(answer);
+    }
+    return answers;
+}
+} // namespace
+
+class DnsAddrBlobTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void DnsAddrBlobTest::SetUpTestCase() {}
+
+void DnsAddrBlobTest::TearDownTestCase() {}
+
+void DnsAddrBlobTest::SetUp() {}
+
+void DnsAddrBlobTest::TearDown() {}
+
+/**
+ * @tc.name: DnsAddrBlob001
+ * @tc.desc: Entries keep their family and bytes and decode to the text form, other families are refused
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsAddrBlobTest, DnsAddrBlob001, TestSize.Level1)
+{
+    DnsAddrBlob blob;
+    EXPECT_TRUE(blob.Empty());
+    EXPECT_TRUE(blob.Append(MakeAddr(AF_INET, "192.0.2.1")));
+    EXPECT_TRUE(blob.Append(MakeAddr(AF_INET6, "2001:db8::1")));
+    EXPECT_FALSE(blob.Append(MakeAddr(AF_INET, "www.example.com")));
+    uint8_t bytes[IPV6_ADDR_LEN] = {0};
+    EXPECT_FALSE(blob.Append(AF_UNIX, bytes));
+    ASSERT_EQ(blob.Size(), 2);
+    EXPECT_EQ(blob.GetFamily(0), AF_INET);
+    EXPECT_EQ(blob.GetAddress(0)[0], 192);
+    EXPECT_EQ(blob.GetFamily(1), AF_INET6);
+    INetAddr addr;
+    ASSERT_TRUE(blob.Decode(1, addr));
+    EXPECT_EQ(addr.family_, AF_INET6);
+    EXPECT_EQ(addr.address_, "2001:db8::1");
+    EXPECT_FALSE(blob.Decode(2, addr));
+    std::vector<INetAddr> addrInfo;
+    blob.DecodeAll(addrInfo);
+    ASSERT_EQ(addrInfo.size(), 2);
+    EXPECT_EQ(addrInfo[0].address_, "192.0.2.1");
+}
+
+/**
+ * @tc.name: DnsAddrBlob002
+ * @tc.desc: A blob survives the parcel, malformed and oversized blobs are refused
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsAddrBlobTest, DnsAddrBlob002, TestSize.Level1)
+{
+    DnsAddrBlob blob;
+    blob.Append(MakeAddr(AF_INET6, "2001:db8::2"));
+    blob.Append(MakeAddr(AF_INET, "198.51.100.7"));
+    MessageParcel parcel;
+    ASSERT_TRUE(blob.Marshalling(parcel));
+    ASSERT_TRUE(DnsAddrBlob().Marshalling(parcel));
+    DnsAddrBlob read;
+    ASSERT_TRUE(DnsAddrBlob::Unmarshalling(parcel, read));
+    ASSERT_EQ(read.Size(), 2);
+    INetAddr addr;
+    ASSERT_TRUE(read.Decode(1, addr));
+    EXPECT_EQ(addr.address_, "198.51.100.7");
+    ASSERT_TRUE(DnsAddrBlob::Unmarshalling(parcel, read));
+    EXPECT_TRUE(read.Empty());
+
+    const uint8_t badTag[] = {AF_UNIX, 1, 2, 3, 4};
+    MessageParcel bad;
+    bad.WriteUint32(sizeof(badTag));
+    bad.WriteBuffer(badTag, sizeof(badTag));
+    EXPECT_FALSE(DnsAddrBlob::Unmarshalling(bad, read));
+    const uint8_t truncated[] = {AF_INET, 1, 2};
+    MessageParcel shortParcel;
+    shortParcel.WriteUint32(sizeof(truncated));
+    shortParcel.WriteBuffer(truncated, sizeof(truncated));
+    EXPECT_FALSE(DnsAddrBlob::Unmarshalling(shortParcel, read));
+    MessageParcel oversized;
+    oversized.WriteUint32(DnsAddrBlob::MAX_BLOB_LEN + 1);
+    EXPECT_FALSE(DnsAddrBlob::Unmarshalling(oversized, read));
+}
+
+/**
+ * @tc.name: DnsAddrBlob003
+ * @tc.desc: GetAddrInfo results keep their fields and both address families across the packed list
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsAddrBlobTest, DnsAddrBlob003, TestSize.Level1)
+{
+    std::vector<sptr<DnsAddrInfo>> list;
+    for (const std::string address : {"192.0.2.9", "2001:db8::9"}) {
+        sptr<DnsAddrInfo> info = (std::make_unique<DnsAddrInfo>()).release();
+        info->flags_ = AI_CANONNAME;
+        info->family_ = (address.find(':') == std::string::npos) ? AF_INET : AF_INET6;
+        info->sockType_ = SOCK_STREAM;
+        info->protocol_ = IPPROTO_TCP;
+        info->addr_ = address;
+        list.push_back(info);
+    }
+    MessageParcel parcel;
+    ASSERT_TRUE(DnsAddrInfo::MarshallingList(parcel, list));
+    std::vector<sptr<DnsAddrInfo>> read;
+    ASSERT_TRUE(DnsAddrInfo::UnmarshallingList(parcel, read));
+    ASSERT_EQ(read.size(), list.size());
+    for (size_t i = 0; i < list.size(); i++) {
+        EXPECT_EQ(read[i]->flags_, list[i]->flags_);
+        EXPECT_EQ(read[i]->family_, list[i]->family_);
+        EXPECT_EQ(read[i]->sockType_, list[i]->sockType_);
+        EXPECT_EQ(read[i]->protocol_, list[i]->protocol_);
+        EXPECT_EQ(read[i]->addr_, list[i]->addr_);
+    }
+}
+
+/**
+ * @tc.name: DnsAddrBlob004
+ * @tc.desc: Marshal and unmarshal cost of 1, 16 and 64 results, one INetAddr per address against the packed blob
+ * @tc.type: PERF
+ */
+HWTEST_F(DnsAddrBlobTest, DnsAddrBlob004, TestSize.Level2)
+{
+    for (uint32_t count : {1, 16, 64}) {
+        std::vector<RawAnswer> answers = MakeRawAnswers(count);
+        auto start = Clock::now();
+        for (uint32_t n = 0; n < BENCH_ITERATIONS; n++) {
+            /* Text form on the service side, one INetAddr per address on the wire, all of them built again */
+            MessageParcel parcel;
+            parcel.WriteInt32(count);
+            char addrBuf[INET6_ADDRSTRLEN];
+            for (const auto &answer : answers) {
+                INetAddr addr;
+                addr.family_ = answer.family;
+                addr.address_ = inet_ntop(answer.family, answer.addr, addrBuf, sizeof(addrBuf));
+                addr.Marshalling(parcel);
+            }
+            int32_t size = parcel.ReadInt32();
+            std::vector<INetAddr> addrInfo;
+            for (int32_t i = 0; i < size; i++) {
+                addrInfo.push_back(*INetAddr::Unmarshalling(parcel));
+            }
+            ASSERT_EQ(addrInfo.size(), count);
+        }
+        auto legacy = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+
+        start = Clock::now();
+        for (uint32_t n = 0; n < BENCH_ITERATIONS; n++) {
+            /* Raw bytes on the service side, one buffer on the wire, only the first address is decoded */
+            MessageParcel parcel;
+            DnsAddrBlob blob;
+            for (const auto &answer : answers) {
+                blob.Append(answer.family, answer.addr);
+            }
+            blob.Marshalling(parcel);
+            DnsAddrBlob read;
+            ASSERT_TRUE(DnsAddrBlob::Unmarshalling(parcel, read));
+            INetAddr first;
+            ASSERT_TRUE(read.Decode(0, first));
+        }
+        auto packed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+
+        start = Clock::now();
+        for (uint32_t n = 0; n < BENCH_ITERATIONS; n++) {
+            MessageParcel parcel;
+            DnsAddrBlob blob;
+            for (const auto &answer : answers) {
+                blob.Append(answer.family, answer.addr);
+            }
+            blob.Marshalling(parcel);
+            DnsAddrBlob read;
+            ASSERT_TRUE(DnsAddrBlob::Unmarshalling(parcel, read));
+            std::vector<INetAddr> addrInfo;
+            read.DecodeAll(addrInfo);
+            ASSERT_EQ(addrInfo.size(), count);
+        }
+        auto packedAll = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+        EXPECT_LT(packed, legacy);
+        std::cout << "DnsAddrBlob " << count << " results: INetAddr list " << legacy.count() / BENCH_ITERATIONS
+                  << "ns, packed first decoded " << packed.count() / BENCH_ITERATIONS << "ns, packed all decoded "
+                  << packedAll.count() / BENCH_ITERATIONS << "ns" << std::endl;
+    }
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
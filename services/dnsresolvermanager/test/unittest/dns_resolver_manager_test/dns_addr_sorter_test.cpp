@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <sys/socket.h>
+
+#include "dns_addr_sorter.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+
+INetAddr MakeAddr(const std::string &address)
+{
+    INetAddr addr;
+    addr.family_ = (address.find(':') == std::string::npos) ? AF_INET : AF_INET6;
+    addr.address_ = address;
+    return addr;
+}
+
+/* Routes only the destinations in the map, each to its listed source */
+DnsSourceLookup MakeSourceLookup(const std::map<std::string, std::string> &sources)
+{
+    return [sources](const INetAddr &dest, INetAddr &source) {
+        auto it = sources.find(dest.address_);
+        if (it == sources.end()) {
+            return false;
+        }
+        source = MakeAddr(it->second);
+        return true;
+    };
+}
+
+std::vector<std::string> SortAddresses(const std::vector<std::string> &addresses,
+    const std::map<std::string, std::string> &sources)
+{
+    std::vector<INetAddr> addrInfo;
+    for (const auto &address : addresses) {
+        addrInfo.push_back(MakeAddr(address));
+    }
+    DnsAddrSorter::Sort(addrInfo, MakeSourceLookup(sources));
+    std::vector<std::string> sorted;
+    for (const auto &addr : addrInfo) {
+        sorted.push_back(addr.address_);
+    }
+    return sorted;
+}
+} // namespace
+
+class DnsAddrSorterTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void DnsAddrSorterTest::SetUpTestCase() {}
+
+void DnsAddrSorterTest::TearDownTestCase() {}
+
+void DnsAddrSorterTest::SetUp() {}
+
+void DnsAddrSorterTest::TearDown() {}
+
+/**
+ * @tc.name: DnsAddrSorter001
+ * @tc.desc: Global IPv6 goes before IPv4 when both are routed, IPv4 goes first when IPv6 has no route
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsAddrSorterTest, DnsAddrSorter001, TestSize.Level1)
+{
+    std::vector<std::string> addresses = {"198.51.100.1", "2001:db8::1"};
+    std::vector<std::string> sorted = SortAddresses(addresses,
+        {{"198.51.100.1", "192.0.2.2"}, {"2001:db8::1", "2001:db8::2"}});
+    EXPECT_EQ(sorted, std::vector<std::string>({"2001:db8::1", "198.51.100.1"}));
+    sorted = SortAddresses({"2001:db8::1", "198.51.100.1"}, {{"198.51.100.1", "192.0.2.2"}});
+    EXPECT_EQ(sorted, std::vector<std::string>({"198.51.100.1", "2001:db8::1"}));
+}
+
+/**
+ * @tc.name: DnsAddrSorter002
+ * @tc.desc: A destination reached from a source of another scope or label goes after one that matches
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsAddrSorterTest, DnsAddrSorter002, TestSize.Level1)
+{
+    /* Only a link local IPv6 source, the global IPv6 destination would not work */
+    std::vector<std::string> sorted = SortAddresses({"2001:db8::1", "198.51.100.1"},
+        {{"2001:db8::1", "fe80::2"}, {"198.51.100.1", "192.0.2.2"}});
+    EXPECT_EQ(sorted, std::vector<std::string>({"198.51.100.1", "2001:db8::1"}));
+    /* 6to4 destination from a native source against a native destination */
+    sorted = SortAddresses({"2002:c000:201::1", "2001:db8::1"},
+        {{"2002:c000:201::1", "2001:db8::2"}, {"2001:db8::1", "2001:db8::2"}});
+    EXPECT_EQ(sorted, std::vector<std::string>({"2001:db8::1", "2002:c000:201::1"}));
+}
+
+/**
+ * @tc.name: DnsAddrSorter003
+ * @tc.desc: Precedence of the policy table, unique local IPv6 goes after IPv4 and loopback goes first
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsAddrSorterTest, DnsAddrSorter003, TestSize.Level1)
+{
+    std::vector<std::string> sorted = SortAddresses({"fd00::1", "198.51.100.1", "::1"},
+        {{"fd00::1", "fd00::2"}, {"198.51.100.1", "192.0.2.2"}, {"::1", "::1"}});
+    EXPECT_EQ(sorted, std::vector<std::string>({"::1", "198.51.100.1", "fd00::1"}));
+}
+
+/**
+ * @tc.name: DnsAddrSorter004
+ * @tc.desc: Longest matching prefix between IPv6 destinations, ties and unparsable addresses keep their order
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsAddrSorterTest, DnsAddrSorter004, TestSize.Level1)
+{
+    std::vector<std::string> sorted = SortAddresses({"2001:db8:2::1", "2001:db8:1::1"},
+        {{"2001:db8:2::1", "2001:db8:1::2"}, {"2001:db8:1::1", "2001:db8:1::2"}});
+    EXPECT_EQ(sorted, std::vector<std::string>({"2001:db8:1::1", "2001:db8:2::1"}));
+    sorted = SortAddresses({"bad", "198.51.100.2", "198.51.100.1"},
+        {{"bad", "192.0.2.2"}, {"198.51.100.2", "192.0.2.2"}, {"198.51.100.1", "192.0.2.2"}});
+    EXPECT_EQ(sorted, std::vector<std::string>({"198.51.100.2", "198.51.100.1", "bad"}));
+}
+
+/**
+ * @tc.name: DnsAddrSorter005
+ * @tc.desc: The source cache probes each destination once per TTL, a missing route included, until it is cleared
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsAddrSorterTest, DnsAddrSorter005, TestSize.Level1)
+{
+    uint32_t probes = 0;
+    DnsSourceLookup lookup = MakeSourceLookup({{"198.51.100.1", "192.0.2.2"}});
+    DnsSourceCache cache([&probes, &lookup](const INetAddr &dest, INetAddr &source) {
+        probes++;
+        return lookup(dest, source);
+    });
+    INetAddr source;
+    for (int32_t i = 0; i < 3; i++) {
+        EXPECT_TRUE(cache.Lookup(MakeAddr("198.51.100.1"), source));
+        EXPECT_EQ(source.address_, "192.0.2.2");
+        EXPECT_FALSE(cache.Lookup(MakeAddr("2001:db8::1"), source));
+    }
+    EXPECT_EQ(probes, 2);
+    cache.Clear();
+    EXPECT_TRUE(cache.Lookup(MakeAddr("198.51.100.1"), source));
+    EXPECT_EQ(probes, 3);
+
+    DnsSourceCache uncached(lookup, 0);
+    EXPECT_TRUE(uncached.Lookup(MakeAddr("198.51.100.1"), source));
+    EXPECT_TRUE(uncached.Lookup(MakeAddr("198.51.100.1"), source));
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <netdb.h>
+#include <thread>
+
+#include "dns_batch_lookup.h"
+#include "dns_resolver_constants.h"
+#include "dns_resolver_service_proxy.h"
+#include "dns_resolver_service_stub.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+constexpr uint32_t LOOKUP_DELAY_MS = 5;
+constexpr uint32_t APP_START_NAME_COUNT = 32;
+const std::string MISSING_PREFIX = "missing";
+
+/* Resolves every name to one address after a fixed delay, names with MISSING_PREFIX do not exist */
+class FakeDnsResolverService : public DnsResolverServiceStub {
+public:
+    int32_t GetAddressesByName(const std::string &hostName, std::vector<INetAddr> &addrInfo) override
+    {
+        int32_t running = ++running_;
+        int32_t peak = peak_;
+        while (running > peak && !peak_.compare_exchange_weak(peak, running)) {}
+        lookups_++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(LOOKUP_DELAY_MS));
+        running_--;
+        if (hostName.compare(0, MISSING_PREFIX.size(), MISSING_PREFIX) == 0) {
+            return EAI_NONAME;
+        }
+        INetAddr addr;
+        addr.family_ = AF_INET;
+        addr.address_ = "10.0.0." + std::to_string(hostName.size());
+        addrInfo.push_back(addr);
+        return DNS_SUCCESS;
+    }
+    int32_t GetAddressesByNamePacked(const std::string &hostName, DnsAddrBlob &addrBlob) override
+    {
+        std::vector<INetAddr> addrInfo;
+        int32_t result = GetAddressesByName(hostName, addrInfo);
+        for (const auto &addr : addrInfo) {
+            addrBlob.Append(addr);
+        }
+        return result;
+    }
+    int32_t GetAddrInfo(const std::string &hostName, const std::string &server, const sptr<DnsAddrInfo> &hints,
+        std::vector<sptr<DnsAddrInfo>> &dnsAddrInfo) override
+    {
+        return DNS_ERROR;
+    }
+    int32_t CreateNetworkCache(uint16_t netId) override
+    {
+        return DNS_SUCCESS;
+    }
+    int32_t DestoryNetworkCache(uint16_t netId) override
+    {
+        return DNS_SUCCESS;
+    }
+    int32_t FlushNetworkCache(uint16_t netId) override
+    {
+        return DNS_SUCCESS;
+    }
+    int32_t SetResolverConfig(uint16_t netId, uint16_t baseTimeoutMsec, uint8_t retryCount,
+        const std::vector<std::string> &servers, const std::vector<std::string> &domains) override
+    {
+        return DNS_SUCCESS;
+    }
+    int32_t GetResolverInfo(uint16_t netId, std::vector<std::string> &servers, std::vector<std::string> &domains,
+        uint16_t &baseTimeoutMsec, uint8_t &retryCount) override
+    {
+        return DNS_SUCCESS;
+    }
+    int32_t GetAddressesByNames(const std::vector<std::string> &hostNames, std::vector<int32_t> &results,
+        std::vector<std::vector<INetAddr>> &addrInfos) override
+    {
+        std::vector<DnsAddrBlob> addrBlobs;
+        int32_t ret = GetAddressesByNamesPacked(hostNames, results, addrBlobs);
+        addrInfos.assign(addrBlobs.size(), {});
+        for (size_t i = 0; i < addrBlobs.size(); i++) {
+            addrBlobs[i].DecodeAll(addrInfos[i]);
+        }
+        return ret;
+    }
+    int32_t GetAddressesByNamesPacked(const std::vector<std::string> &hostNames, std::vector<int32_t> &results,
+        std::vector<DnsAddrBlob> &addrBlobs) override
+    {
+        batchLookup_.Run(hostNames, [this](const std::string &hostName, DnsAddrBlob &addrBlob) {
+            return GetAddressesByNamePacked(hostName, addrBlob);
+        }, results, addrBlobs);
+        return DNS_SUCCESS;
+    }
+    int32_t GetAddressesByNameAsync(const std::string &hostName, const sptr<IDnsResolverCallback> &callback) override
+    {
+        std::vector<INetAddr> addrInfo;
+        int32_t result = GetAddressesByName(hostName, addrInfo);
+        return callback->OnResolved(hostName, result, addrInfo);
+    }
+    int32_t GetAddressesByNameDualStack(const std::string &hostName,
+        const sptr<IDnsResolverCallback> &callback) override
+    {
+        return GetAddressesByNameAsync(hostName, callback);
+    }
+    int32_t GetResolverStats(uint16_t netId, std::vector<DnsServerStats> &stats) override
+    {
+        return DNS_SUCCESS;
+    }
+
+    std::atomic<int32_t> running_ {0};
+    std::atomic<int32_t> peak_ {0};
+    std::atomic<int32_t> lookups_ {0};
+    DnsBatchLookup batchLookup_;
+};
+
+std::vector<std::string> MakeHostNames(uint32_t count)
+{
+    std::vector<std::string> hostNames;
+    for (uint32_t i = 0; i < count; i++) {
+        hostNames.push_back("host" + std::to_string(i) + ".example.com");
+    }
+    return hostNames;
+}
+} // namespace
+
+class DnsBatchLookupTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+
+    sptr<FakeDnsResolverService> service_;
+    sptr<DnsResolverServiceProxy> proxy_;
+};
+
+void DnsBatchLookupTest::SetUpTestCase() {}
+
+void DnsBatchLookupTest::TearDownTestCase() {}
+
+void DnsBatchLookupTest::SetUp()
+{
+    service_ = (std::make_unique<FakeDnsResolverService>()).release();
+    proxy_ = (std::make_unique<DnsResolverServiceProxy>(service_->AsObject())).release();
+}
+
+void DnsBatchLookupTest::TearDown()
+{
+    proxy_ = nullptr;
+    service_ = nullptr;
+}
+
+/**
+ * @tc.name: DnsBatchLookup001
+ * @tc.desc: Results keep the order of the names and a repeated name is resolved once
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsBatchLookupTest, DnsBatchLookup001, TestSize.Level1)
+{
+    std::vector<std::string> hostNames = {"a.example.com", "missing.example.com", "bb.example.com",
+        "a.example.com"};
+    std::vector<int32_t> results;
+    std::vector<std::vector<INetAddr>> addrInfos;
+    EXPECT_EQ(service_->GetAddressesByNames(hostNames, results, addrInfos), DNS_SUCCESS);
+    ASSERT_EQ(results.size(), hostNames.size());
+    ASSERT_EQ(addrInfos.size(), hostNames.size());
+    EXPECT_EQ(results[0], DNS_SUCCESS);
+    EXPECT_EQ(results[1], EAI_NONAME);
+    EXPECT_TRUE(addrInfos[1].empty());
+    ASSERT_EQ(addrInfos[2].size(), 1);
+    EXPECT_EQ(addrInfos[2][0].address_, "10.0.0.14");
+    EXPECT_EQ(results[3], DNS_SUCCESS);
+    ASSERT_EQ(addrInfos[3].size(), 1);
+    EXPECT_EQ(addrInfos[3][0].address_, addrInfos[0][0].address_);
+    EXPECT_EQ(service_->lookups_, 3);
+}
+
+/**
+ * @tc.name: DnsBatchLookup002
+ * @tc.desc: Lookups run concurrently but never on more workers than allowed
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsBatchLookupTest, DnsBatchLookup002, TestSize.Level1)
+{
+    constexpr uint32_t maxWorkers = 4;
+    std::vector<std::string> hostNames = MakeHostNames(APP_START_NAME_COUNT);
+    std::vector<int32_t> results;
+    std::vector<DnsAddrBlob> addrBlobs;
+    DnsBatchLookup batchLookup(maxWorkers);
+    batchLookup.Run(hostNames, [this](const std::string &hostName, DnsAddrBlob &addrBlob) {
+        return service_->GetAddressesByNamePacked(hostName, addrBlob);
+    }, results, addrBlobs);
+    EXPECT_EQ(service_->lookups_, APP_START_NAME_COUNT);
+    EXPECT_GT(service_->peak_, 1);
+    EXPECT_LE(service_->peak_, maxWorkers);
+
+    service_->peak_ = 0;
+    DnsBatchLookup serialLookup(1);
+    serialLookup.Run(hostNames, [this](const std::string &hostName, DnsAddrBlob &addrBlob) {
+        return service_->GetAddressesByNamePacked(hostName, addrBlob);
+    }, results, addrBlobs);
+    EXPECT_EQ(service_->peak_, 1);
+}
+
+/**
+ * @tc.name: DnsBatchLookup003
+ * @tc.desc: Per name results and addresses survive the proxy and stub marshalling
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsBatchLookupTest, DnsBatchLookup003, TestSize.Level1)
+{
+    std::vector<std::string> hostNames = {"www.example.com", "missing.example.org", "cdn.example.net"};
+    std::vector<int32_t> results;
+    std::vector<std::vector<INetAddr>> addrInfos;
+    ASSERT_EQ(proxy_->GetAddressesByNames(hostNames, results, addrInfos), DNS_SUCCESS);
+    ASSERT_EQ(results.size(), hostNames.size());
+    ASSERT_EQ(addrInfos.size(), hostNames.size());
+    for (size_t i = 0; i < hostNames.size(); i++) {
+        std::vector<INetAddr> expected;
+        EXPECT_EQ(results[i], service_->GetAddressesByName(hostNames[i], expected));
+        ASSERT_EQ(addrInfos[i].size(), expected.size());
+        for (size_t j = 0; j < expected.size(); j++) {
+            EXPECT_EQ(addrInfos[i][j].family_, expected[j].family_);
+            EXPECT_EQ(addrInfos[i][j].address_, expected[j].address_);
+        }
+    }
+}
+
+/**
+ * @tc.name: DnsBatchLookup004
+ * @tc.desc: Empty and oversized batches are refused before any request is sent
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsBatchLookupTest, DnsBatchLookup004, TestSize.Level1)
+{
+    std::vector<int32_t> results;
+    std::vector<std::vector<INetAddr>> addrInfos;
+    EXPECT_EQ(proxy_->GetAddressesByNames({}, results, addrInfos), NETMANAGER_ERR_STRING_EMPTY);
+    EXPECT_EQ(proxy_->GetAddressesByNames(MakeHostNames(DNS_MAX_BATCH_NAMES + 1), results, addrInfos), DNS_ERROR);
+    EXPECT_EQ(service_->lookups_, 0);
+}
+
+/**
+ * @tc.name: DnsBatchLookup005
+ * @tc.desc: Latency of resolving an app start list of names one by one and in one batch
+ * @tc.type: PERF
+ */
+HWTEST_F(DnsBatchLookupTest, DnsBatchLookup005, TestSize.Level2)
+{
+    std::vector<std::string> hostNames = MakeHostNames(APP_START_NAME_COUNT);
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &hostName : hostNames) {
+        std::vector<INetAddr> addrInfo;
+        proxy_->GetAddressesByName(hostName, addrInfo);
+    }
+    auto serial = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    start = std::chrono::steady_clock::now();
+    std::vector<int32_t> results;
+    std::vector<std::vector<INetAddr>> addrInfos;
+    EXPECT_EQ(proxy_->GetAddressesByNames(hostNames, results, addrInfos), DNS_SUCCESS);
+    auto batch = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_LT(batch, serial);
+    std::cout << "GetAddressesByName x" << APP_START_NAME_COUNT << " " << serial.count()
+              << "ms, GetAddressesByNames " << batch.count() << "ms" << std::endl;
+}
+
+/**
+ * @tc.name: DnsBatchLookup006
+ * @tc.desc: Batches running at once share the pool, only their calling threads come on top of it
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsBatchLookupTest, DnsBatchLookup006, TestSize.Level1)
+{
+    constexpr uint32_t maxWorkers = 4;
+    constexpr int32_t callerCount = 6;
+    DnsBatchLookup batchLookup(maxWorkers);
+    std::vector<std::thread> callers;
+    for (int32_t i = 0; i < callerCount; i++) {
+        callers.emplace_back([this, &batchLookup]() {
+            std::vector<int32_t> results;
+            std::vector<DnsAddrBlob> addrBlobs;
+            batchLookup.Run(MakeHostNames(APP_START_NAME_COUNT),
+                [this](const std::string &hostName, DnsAddrBlob &addrBlob) {
+                    return service_->GetAddressesByNamePacked(hostName, addrBlob);
+                }, results, addrBlobs);
+            EXPECT_EQ(results.size(), APP_START_NAME_COUNT);
+        });
+    }
+    for (auto &caller : callers) {
+        caller.join();
+    }
+    EXPECT_EQ(service_->lookups_, static_cast<int32_t>(callerCount * APP_START_NAME_COUNT));
+    EXPECT_LE(service_->peak_, static_cast<int32_t>(maxWorkers - 1) + callerCount);
+}
+
+/**
+ * @tc.name: DnsBatchLookup007
+ * @tc.desc: A posted name is resolved on the pool and its result handed over, a pool without threads resolves it
+ *           in the calling thread
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsBatchLookupTest, DnsBatchLookup007, TestSize.Level1)
+{
+    constexpr uint32_t waitMs = 1000;
+    auto lookup = [this](const std::string &hostName, DnsAddrBlob &addrBlob) {
+        return service_->GetAddressesByNamePacked(hostName, addrBlob);
+    };
+    DnsBatchLookup batchLookup;
+    std::promise<std::pair<int32_t, std::thread::id>> promise;
+    auto future = promise.get_future();
+    batchLookup.Post("www.example.com", lookup, [&promise](int32_t result, const DnsAddrBlob &addrBlob) {
+        std::vector<INetAddr> addrInfo;
+        addrBlob.DecodeAll(addrInfo);
+        EXPECT_EQ(addrInfo.size(), 1);
+        promise.set_value({result, std::this_thread::get_id()});
+    });
+    ASSERT_EQ(future.wait_for(std::chrono::milliseconds(waitMs)), std::future_status::ready);
+    auto posted = future.get();
+    EXPECT_EQ(posted.first, DNS_SUCCESS);
+    EXPECT_NE(posted.second, std::this_thread::get_id());
+
+    DnsBatchLookup inlineLookup(1);
+    int32_t result = DNS_ERROR;
+    inlineLookup.Post(MISSING_PREFIX + ".example.com", lookup,
+        [&result](int32_t code, const DnsAddrBlob &) { result = code; });
+    EXPECT_EQ(result, EAI_NONAME);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
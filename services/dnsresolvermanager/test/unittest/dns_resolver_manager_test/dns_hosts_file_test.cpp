@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <netinet/in.h>
+#include <unistd.h>
+
+#include "dns_hosts_file.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+const std::string TEST_HOSTS_PATH = "/data/local/tmp/dns_hosts_file_test";
+
+void WriteHosts(const std::string &content)
+{
+    std::ofstream file(TEST_HOSTS_PATH, std::ios::trunc);
+    file << content;
+}
+} // namespace
+
+class DnsHostsFileTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void DnsHostsFileTest::SetUpTestCase() {}
+
+void DnsHostsFileTest::TearDownTestCase() {}
+
+void DnsHostsFileTest::SetUp() {}
+
+void DnsHostsFileTest::TearDown()
+{
+    unlink(TEST_HOSTS_PATH.c_str());
+}
+
+/**
+ * @tc.name: DnsHostsFile001
+ * @tc.desc: Names and aliases match case insensitively and by family, comments and bad lines are skipped
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsHostsFileTest, DnsHostsFile001, TestSize.Level1)
+{
+    WriteHosts("# comment 10.0.0.9 commented.example.com\n"
+               "127.0.0.1 localhost\n"
+               "::1 localhost ip6-localhost # loopback\n"
+               "not.an.address broken.example.com\n"
+               "192.0.2.1\tPrinter.Example.com printer\n");
+    DnsHostsFile hostsFile(TEST_HOSTS_PATH);
+    std::vector<INetAddr> addrInfo;
+    ASSERT_TRUE(hostsFile.Lookup("printer.example.com.", AF_INET, addrInfo));
+    ASSERT_EQ(addrInfo.size(), 1);
+    EXPECT_EQ(addrInfo[0].family_, AF_INET);
+    EXPECT_EQ(addrInfo[0].address_, "192.0.2.1");
+    addrInfo.clear();
+    EXPECT_TRUE(hostsFile.Lookup("PRINTER", AF_INET, addrInfo));
+    addrInfo.clear();
+    ASSERT_TRUE(hostsFile.Lookup("localhost", AF_UNSPEC, addrInfo));
+    ASSERT_EQ(addrInfo.size(), 2);
+    EXPECT_EQ(addrInfo[1].address_, "::1");
+    addrInfo.clear();
+    EXPECT_FALSE(hostsFile.Lookup("ip6-localhost", AF_INET, addrInfo));
+    EXPECT_FALSE(hostsFile.Lookup("commented.example.com", AF_UNSPEC, addrInfo));
+    EXPECT_FALSE(hostsFile.Lookup("broken.example.com", AF_UNSPEC, addrInfo));
+    EXPECT_TRUE(addrInfo.empty());
+}
+
+/**
+ * @tc.name: DnsHostsFile002
+ * @tc.desc: An edited file is read again, a missing one answers nothing
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsHostsFileTest, DnsHostsFile002, TestSize.Level1)
+{
+    WriteHosts("192.0.2.1 old.example.com\n");
+    DnsHostsFile hostsFile(TEST_HOSTS_PATH);
+    std::vector<INetAddr> addrInfo;
+    EXPECT_TRUE(hostsFile.Lookup("old.example.com", AF_INET, addrInfo));
+    /* Longer content, so the size changes even where the modification time is coarse */
+    WriteHosts("192.0.2.2 new.example.com newer.example.com\n");
+    EXPECT_FALSE(hostsFile.Lookup("old.example.com", AF_INET, addrInfo));
+    EXPECT_TRUE(hostsFile.Lookup("newer.example.com", AF_INET, addrInfo));
+    unlink(TEST_HOSTS_PATH.c_str());
+    EXPECT_FALSE(hostsFile.Lookup("new.example.com", AF_INET, addrInfo));
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cctype>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "dns_name_validator.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+constexpr uint32_t FUZZ_SEED = 20211;
+constexpr uint32_t FUZZ_LOOP_COUNT = 200000;
+constexpr uint32_t FUZZ_MAX_LEN = 300;
+constexpr uint32_t PERF_LOOP_COUNT = 100000;
+constexpr uint32_t PERF_ROUND_COUNT = 5;
+
+/* Straightforward split and check of the same rules, the reference for the fuzz tests */
+bool ReferenceIsValid(std::string name)
+{
+    if (!name.empty() && name.back() == '.') {
+        name.pop_back();
+    }
+    if (name.empty() || name.size() > DnsNameValidator::MAX_NAME_LEN) {
+        return false;
+    }
+    size_t start = 0;
+    while (true) {
+        size_t end = name.find('.', start);
+        std::string label = name.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        if (label.empty() || label.size() > DnsNameValidator::MAX_LABEL_LEN || label.front() == '-' ||
+            label.back() == '-') {
+            return false;
+        }
+        for (char c : label) {
+            if (!isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_') {
+                return false;
+            }
+        }
+        if (end == std::string::npos) {
+            return true;
+        }
+        start = end + 1;
+    }
+}
+
+/* The best round is kept, so a preempted round does not skew the comparison */
+template<typename Check>
+double MeasureNsPerName(const std::vector<std::string> &names, Check check)
+{
+    auto best = std::chrono::nanoseconds::max();
+    for (uint32_t round = 0; round < PERF_ROUND_COUNT; round++) {
+        uint32_t matched = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < PERF_LOOP_COUNT; i += names.size()) {
+            for (const auto &name : names) {
+                matched += check(name) ? 1 : 0;
+            }
+        }
+        auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        EXPECT_EQ(matched, PERF_LOOP_COUNT);
+        best = std::min(best, cost);
+    }
+    return static_cast<double>(best.count()) / PERF_LOOP_COUNT;
+}
+} // namespace
+
+class DnsNameValidatorTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void DnsNameValidatorTest::SetUpTestCase() {}
+
+void DnsNameValidatorTest::TearDownTestCase() {}
+
+void DnsNameValidatorTest::SetUp() {}
+
+void DnsNameValidatorTest::TearDown() {}
+
+/**
+ * @tc.name: DnsNameValidator001
+ * @tc.desc: Valid host names, including single labels and long top level domains
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsNameValidatorTest, DnsNameValidator001, TestSize.Level1)
+{
+    std::vector<std::string> names = {
+        "localhost", "www.163.com", "example.museum", "a.b.c.d.e.photography", "xn--fiqs8s.xn--55qx5d",
+        "my-host.example.com.", "_dns.resolver.arpa", "1.2.3.4", "A1.B2", std::string(63, 'a') + ".com",
+        std::string(63, 'a') + "." + std::string(63, 'b') + "." + std::string(63, 'c') + "." +
+            std::string(61, 'd'),
+    };
+    for (const auto &name : names) {
+        EXPECT_TRUE(DnsNameValidator::IsValid(name)) << name;
+    }
+}
+
+/**
+ * @tc.name: DnsNameValidator002
+ * @tc.desc: Invalid host names
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsNameValidatorTest, DnsNameValidator002, TestSize.Level1)
+{
+    std::vector<std::string> names = {
+        "", ".", "..", "a..b", ".a", "-a.com", "a-.com", "a.-b", "a b.com", "a\tb", "exa$mple.com",
+        "www.example.com..", std::string(64, 'a') + ".com",
+        std::string(63, 'a') + "." + std::string(63, 'b') + "." + std::string(63, 'c') + "." +
+            std::string(62, 'd'),
+        std::string("a\0b", 3), "\xc3\xa9.com",
+    };
+    for (const auto &name : names) {
+        EXPECT_FALSE(DnsNameValidator::IsValid(name)) << name;
+    }
+    EXPECT_FALSE(DnsNameValidator::IsValid(nullptr, 0));
+}
+
+/**
+ * @tc.name: DnsNameValidator003
+ * @tc.desc: Random strings over the name alphabet agree with the reference check
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsNameValidatorTest, DnsNameValidator003, TestSize.Level1)
+{
+    const std::string alphabet = "ab09-._.-Z";
+    std::mt19937 gen(FUZZ_SEED);
+    std::uniform_int_distribution<uint32_t> lenDist(0, FUZZ_MAX_LEN);
+    std::uniform_int_distribution<size_t> charDist(0, alphabet.size() - 1);
+    uint32_t validCount = 0;
+    for (uint32_t i = 0; i < FUZZ_LOOP_COUNT; i++) {
+        std::string name(lenDist(gen) % ((i % 8 == 0) ? FUZZ_MAX_LEN : 16), ' ');
+        for (auto &c : name) {
+            c = alphabet[charDist(gen)];
+        }
+        bool expected = ReferenceIsValid(name);
+        validCount += expected ? 1 : 0;
+        ASSERT_EQ(DnsNameValidator::IsValid(name), expected) << name;
+    }
+    EXPECT_GT(validCount, 0);
+}
+
+/**
+ * @tc.name: DnsNameValidator004
+ * @tc.desc: Random bytes agree with the reference check
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsNameValidatorTest, DnsNameValidator004, TestSize.Level1)
+{
+    std::mt19937 gen(FUZZ_SEED);
+    std::uniform_int_distribution<uint32_t> lenDist(0, FUZZ_MAX_LEN);
+    std::uniform_int_distribution<uint32_t> byteDist(0, UINT8_MAX);
+    for (uint32_t i = 0; i < FUZZ_LOOP_COUNT; i++) {
+        std::string name(lenDist(gen), ' ');
+        for (auto &c : name) {
+            c = static_cast<char>(byteDist(gen));
+        }
+        ASSERT_EQ(DnsNameValidator::IsValid(name), ReferenceIsValid(name));
+    }
+}
+
+/**
+ * @tc.name: DnsNameValidator005
+ * @tc.desc: Cost of the validator against the std::regex check it replaced
+ * @tc.type: PERF
+ */
+HWTEST_F(DnsNameValidatorTest, DnsNameValidator005, TestSize.Level2)
+{
+    const std::vector<std::string> names = {"www.163.com", "img.alicdn.example.com.cn", "api.weather.example.org",
+        "cdn-01.static.example.net"};
+    std::regex domainPattern("([0-9A-Za-z\\-_\\.]+)\\.([0-9a-z]+\\.[a-z]{2,3}(\\.[a-z]{2})?)");
+    double regexCost = MeasureNsPerName(names, [&domainPattern](const std::string &name) {
+        return std::regex_match(name, domainPattern);
+    });
+    double dfaCost = MeasureNsPerName(names, [](const std::string &name) { return DnsNameValidator::IsValid(name); });
+    double speedup = regexCost / dfaCost;
+    std::cout << "DnsNameValidator regex " << regexCost << "ns/name, dfa " << dfaCost << "ns/name, speedup "
+              << speedup << "x" << std::endl;
+    testing::Test::RecordProperty("DnsNameValidator.regex_ns", static_cast<int>(regexCost));
+    testing::Test::RecordProperty("DnsNameValidator.dfa_ns", static_cast<int>(dfaCost));
+    testing::Test::RecordProperty("DnsNameValidator.speedup_x", static_cast<int>(speedup));
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,760 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <future>
+#include <iostream>
+#include <map>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "dns_dual_stack_query.h"
+#include "dns_query_engine.h"
+#include "dns_resolver_callback_proxy.h"
+#include "dns_resolver_callback_stub.h"
+#include "dns_resolver_constants.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+using Clock = std::chrono::steady_clock;
+constexpr uint32_t FAST_LATENCY_MS = 2;
+constexpr uint32_t SLOW_LATENCY_MS = 200;
+constexpr uint32_t QUERY_TIMEOUT_MS = 100;
+constexpr uint32_t WAIT_TIMEOUT_MS = 3000;
+constexpr size_t DNS_HEADER_LEN = 12;
+constexpr size_t MAX_PACKET_LEN = 512;
+constexpr uint8_t RCODE_SERVFAIL = 2;
+constexpr uint8_t RCODE_NXDOMAIN = 3;
+constexpr uint8_t DNS_TYPE_AAAA = 28;
+const std::string LOCAL_SERVER = "127.0.0.1";
+/* Nothing listens on the port at this address, the kernel answers with a port unreachable */
+const std::string REFUSING_SERVER = "127.0.0.2";
+/* Bound but never read, queries to it are silently lost */
+const std::string BLACKHOLE_SERVER = "127.0.0.3";
+const std::string SECOND_SERVER = "127.0.0.4";
+
+/* The most recently opened epoll descriptor of the process, -1 when there is none */
+int32_t FindLastEpollFd()
+{
+    int32_t found = -1;
+    DIR *dir = opendir("/proc/self/fd");
+    if (dir == nullptr) {
+        return found;
+    }
+    char target[PATH_MAX] = {0};
+    while (dirent *entry = readdir(dir)) {
+        std::string path = std::string("/proc/self/fd/") + entry->d_name;
+        ssize_t len = readlink(path.c_str(), target, sizeof(target) - 1);
+        if (len > 0 && std::string(target, len) == "anon_inode:[eventpoll]") {
+            found = std::max(found, std::atoi(entry->d_name));
+        }
+    }
+    closedir(dir);
+    return found;
+}
+
+/*
+ * Answers on the loopback with A 10.0.0.<name length> and AAAA 2001:db8::<name length> after a latency chosen by
+ * the first label: "slow" names take SLOW_LATENCY_MS, "late6" names take it for AAAA only, "v4only" names have no
+ * AAAA record, "drop" names are never answered, "nx" names do not exist, "fail" names get a server failure, "tc6"
+ * names get a truncated AAAA answer, other "tc" names a truncated answer of either type, and everything else takes
+ * FAST_LATENCY_MS. Replies are queued by due time so a slow one never holds back the fast
+ * ones behind it.
+ */
+class StubDnsServer {
+public:
+    bool Start(const std::string &address = LOCAL_SERVER, uint16_t port = 0, bool answer = true)
+    {
+        fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        inet_pton(AF_INET, address.c_str(), &addr.sin_addr);
+        socklen_t len = sizeof(addr);
+        if (fd_ < 0 || bind(fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+            getsockname(fd_, reinterpret_cast<sockaddr *>(&addr), &len) != 0) {
+            return false;
+        }
+        port_ = ntohs(addr.sin_port);
+        if (!answer) {
+            return true;
+        }
+        running_ = true;
+        thread_ = std::thread(&StubDnsServer::Run, this);
+        return true;
+    }
+
+    void Stop()
+    {
+        running_ = false;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    ~StubDnsServer()
+    {
+        Stop();
+    }
+
+    uint16_t GetPort() const
+    {
+        return port_;
+    }
+
+    std::atomic<uint32_t> received_ {0};
+
+private:
+    struct Reply {
+        sockaddr_in peer;
+        std::vector<uint8_t> packet;
+    };
+
+    void Run()
+    {
+        constexpr int32_t pollMs = 1;
+        while (running_) {
+            pollfd pfd = {fd_, POLLIN, 0};
+            int32_t wait = replies_.empty() ? pollMs : 0;
+            if (poll(&pfd, 1, wait) > 0) {
+                Receive();
+            }
+            auto now = Clock::now();
+            while (!replies_.empty() && replies_.begin()->first <= now) {
+                const Reply &reply = replies_.begin()->second;
+                sendto(fd_, reply.packet.data(), reply.packet.size(), 0,
+                    reinterpret_cast<const sockaddr *>(&reply.peer), sizeof(reply.peer));
+                replies_.erase(replies_.begin());
+            }
+            if (!replies_.empty()) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+    }
+
+    void Receive()
+    {
+        uint8_t buf[MAX_PACKET_LEN];
+        sockaddr_in peer = {};
+        socklen_t peerLen = sizeof(peer);
+        ssize_t len;
+        while ((len = recvfrom(fd_, buf, sizeof(buf), 0, reinterpret_cast<sockaddr *>(&peer), &peerLen)) > 0) {
+            received_++;
+            if (static_cast<size_t>(len) <= DNS_HEADER_LEN) {
+                continue;
+            }
+            size_t labelLen = buf[DNS_HEADER_LEN];
+            std::string label(reinterpret_cast<char *>(buf) + DNS_HEADER_LEN + 1, labelLen);
+            size_t nameLen = 0;
+            for (size_t pos = DNS_HEADER_LEN; pos < static_cast<size_t>(len) && buf[pos] != 0; pos += buf[pos] + 1) {
+                nameLen += buf[pos] + 1;
+            }
+            size_t qtypePos = DNS_HEADER_LEN + nameLen + 1;
+            bool aaaa = qtypePos + 1 < static_cast<size_t>(len) && buf[qtypePos + 1] == DNS_TYPE_AAAA;
+            if (label.compare(0, strlen("drop"), "drop") == 0) {
+                continue;
+            }
+            uint8_t rcode = 0;
+            if (label.compare(0, strlen("nx"), "nx") == 0) {
+                rcode = RCODE_NXDOMAIN;
+            } else if (label.compare(0, strlen("fail"), "fail") == 0) {
+                rcode = RCODE_SERVFAIL;
+            }
+            Reply reply;
+            reply.peer = peer;
+            reply.packet.assign(buf, buf + len);
+            reply.packet[2] = 0x81; /* QR and RD */
+            reply.packet[3] = 0x80 | rcode; /* RA and the response code */
+            if (label.compare(0, strlen("tc6"), "tc6") == 0 ? aaaa : label.compare(0, strlen("tc"), "tc") == 0) {
+                reply.packet[2] |= 0x02; /* TC, the answer that follows is only a part of the full one */
+            }
+            if (rcode == 0 && !aaaa) {
+                reply.packet[7] = 1; /* one answer */
+                const uint8_t answer[] = {0xC0, 0x0C, 0, 1, 0, 1, 0, 0, 0, 60, 0, 4, 10, 0, 0,
+                    static_cast<uint8_t>(nameLen - 1)};
+                reply.packet.insert(reply.packet.end(), std::begin(answer), std::end(answer));
+            } else if (rcode == 0 && label.compare(0, strlen("v4only"), "v4only") != 0) {
+                reply.packet[7] = 1; /* one answer */
+                const uint8_t answer[] = {0xC0, 0x0C, 0, DNS_TYPE_AAAA, 0, 1, 0, 0, 0, 60, 0, 16, 0x20, 0x01, 0x0d,
+                    0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, static_cast<uint8_t>(nameLen - 1)};
+                reply.packet.insert(reply.packet.end(), std::begin(answer), std::end(answer));
+            }
+            bool slow = label.compare(0, strlen("slow"), "slow") == 0 ||
+                (aaaa && label.compare(0, strlen("late6"), "late6") == 0);
+            uint32_t latency = slow ? SLOW_LATENCY_MS : FAST_LATENCY_MS;
+            replies_.emplace(Clock::now() + std::chrono::milliseconds(latency), std::move(reply));
+            peerLen = sizeof(peer);
+        }
+    }
+
+    int32_t fd_ = -1;
+    uint16_t port_ = 0;
+    std::atomic<bool> running_ {false};
+    std::thread thread_;
+    std::multimap<Clock::time_point, Reply> replies_;
+};
+
+struct QueryResult {
+    int32_t result = DNS_ERROR;
+    std::vector<INetAddr> addrInfo;
+    Clock::duration latency;
+};
+
+struct DualStackResult {
+    std::vector<INetAddr> partial;
+    Clock::duration partialLatency;
+    QueryResult complete;
+    bool partialFirst = true;
+};
+
+class DnsCallbackRecorder : public DnsResolverCallbackStub {
+public:
+    int32_t OnResolved(const std::string &hostName, int32_t result, const std::vector<INetAddr> &addrInfo) override
+    {
+        hostName_ = hostName;
+        result_ = result;
+        addrInfo_ = addrInfo;
+        return ERR_NONE;
+    }
+    int32_t OnPartialResolved(const std::string &hostName, const std::vector<INetAddr> &addrInfo) override
+    {
+        partialAddrInfo_ = addrInfo;
+        return ERR_NONE;
+    }
+
+    std::string hostName_;
+    int32_t result_ = DNS_ERROR;
+    std::vector<INetAddr> addrInfo_;
+    std::vector<INetAddr> partialAddrInfo_;
+};
+} // namespace
+
+class DnsQueryEngineTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+
+    QueryResult Resolve(DnsQueryEngine &engine, const std::string &hostName, const std::vector<std::string> &servers,
+        uint8_t retryCount = 0, uint32_t timeoutMs = QUERY_TIMEOUT_MS);
+    DualStackResult ResolveDualStack(DnsQueryEngine &engine, const std::string &hostName,
+        uint32_t timeoutMs = WAIT_TIMEOUT_MS);
+
+    StubDnsServer server_;
+};
+
+void DnsQueryEngineTest::SetUpTestCase() {}
+
+void DnsQueryEngineTest::TearDownTestCase() {}
+
+void DnsQueryEngineTest::SetUp()
+{
+    ASSERT_TRUE(server_.Start());
+}
+
+void DnsQueryEngineTest::TearDown()
+{
+    server_.Stop();
+}
+
+QueryResult DnsQueryEngineTest::Resolve(DnsQueryEngine &engine, const std::string &hostName,
+    const std::vector<std::string> &servers, uint8_t retryCount, uint32_t timeoutMs)
+{
+    auto promise = std::make_shared<std::promise<QueryResult>>();
+    auto future = promise->get_future();
+    auto start = Clock::now();
+    int32_t ret = engine.Query(hostName, AF_INET, servers, timeoutMs, retryCount,
+        [promise, start](int32_t result, const std::vector<INetAddr> &addrInfo) {
+            promise->set_value({result, addrInfo, Clock::now() - start});
+        });
+    EXPECT_EQ(ret, DNS_SUCCESS);
+    if (ret != DNS_SUCCESS || future.wait_for(std::chrono::milliseconds(WAIT_TIMEOUT_MS)) !=
+        std::future_status::ready) {
+        return {};
+    }
+    return future.get();
+}
+
+DualStackResult DnsQueryEngineTest::ResolveDualStack(DnsQueryEngine &engine, const std::string &hostName,
+    uint32_t timeoutMs)
+{
+    auto result = std::make_shared<DualStackResult>();
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future();
+    auto start = Clock::now();
+    int32_t ret = DnsDualStackQuery::Start(engine, hostName, {LOCAL_SERVER}, timeoutMs, 0,
+        [result, start](const std::vector<INetAddr> &addrInfo) {
+            result->partial = addrInfo;
+            result->partialLatency = Clock::now() - start;
+        },
+        [result, promise, start](int32_t code, const std::vector<INetAddr> &addrInfo) {
+            result->complete = {code, addrInfo, Clock::now() - start};
+            result->partialFirst = result->partial.empty() || result->partialLatency <= result->complete.latency;
+            promise->set_value();
+        });
+    EXPECT_EQ(ret, DNS_SUCCESS);
+    if (ret != DNS_SUCCESS || future.wait_for(std::chrono::milliseconds(WAIT_TIMEOUT_MS)) !=
+        std::future_status::ready) {
+        return {};
+    }
+    return *result;
+}
+
+/**
+ * @tc.name: DnsQueryEngine001
+ * @tc.desc: An answered query returns the A record, a missing name returns EAI_NONAME
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine001, TestSize.Level1)
+{
+    DnsQueryEngine engine(server_.GetPort());
+    ASSERT_TRUE(engine.Start());
+    QueryResult answer = Resolve(engine, "www.example.com", {LOCAL_SERVER});
+    EXPECT_EQ(answer.result, DNS_SUCCESS);
+    ASSERT_EQ(answer.addrInfo.size(), 1);
+    EXPECT_EQ(answer.addrInfo[0].family_, AF_INET);
+    EXPECT_EQ(answer.addrInfo[0].address_, "10.0.0.15");
+    EXPECT_EQ(Resolve(engine, "nx.example.com", {LOCAL_SERVER}).result, EAI_NONAME);
+    DnsQueryEngineStats stats = engine.GetStats();
+    EXPECT_EQ(stats.submitted, 2);
+    EXPECT_EQ(stats.answered, 1);
+    EXPECT_EQ(stats.failed, 1);
+    EXPECT_EQ(stats.pending, 0);
+}
+
+/**
+ * @tc.name: DnsQueryEngine002
+ * @tc.desc: A refusing server and a server failure move the query on to the next server
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine002, TestSize.Level1)
+{
+    DnsQueryEngine engine(server_.GetPort());
+    ASSERT_TRUE(engine.Start());
+    QueryResult answer = Resolve(engine, "www.example.com", {REFUSING_SERVER, LOCAL_SERVER}, 1);
+    EXPECT_EQ(answer.result, DNS_SUCCESS);
+    EXPECT_LT(answer.latency, std::chrono::milliseconds(QUERY_TIMEOUT_MS));
+    EXPECT_EQ(engine.GetStats().retries, 1);
+    EXPECT_EQ(Resolve(engine, "fail.example.com", {LOCAL_SERVER}, 2).result, EAI_AGAIN);
+    EXPECT_EQ(server_.received_, 4);
+}
+
+/**
+ * @tc.name: DnsQueryEngine003
+ * @tc.desc: An unanswered query is retried at each deadline and fails once the retries are spent
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine003, TestSize.Level1)
+{
+    constexpr uint8_t retryCount = 2;
+    DnsQueryEngine engine(server_.GetPort());
+    ASSERT_TRUE(engine.Start());
+    QueryResult answer = Resolve(engine, "drop.example.com", {LOCAL_SERVER}, retryCount);
+    EXPECT_EQ(answer.result, EAI_AGAIN);
+    EXPECT_GE(answer.latency, std::chrono::milliseconds(QUERY_TIMEOUT_MS * (retryCount + 1)));
+    DnsQueryEngineStats stats = engine.GetStats();
+    EXPECT_EQ(stats.timeouts, retryCount + 1);
+    EXPECT_EQ(stats.retries, retryCount);
+    EXPECT_EQ(server_.received_, retryCount + 1);
+}
+
+/**
+ * @tc.name: DnsQueryEngine004
+ * @tc.desc: Bad parameters and a full engine refuse the query, stopping fails the outstanding ones
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine004, TestSize.Level1)
+{
+    constexpr uint32_t maxPending = 2;
+    DnsQueryEngine engine(server_.GetPort(), maxPending);
+    auto ignore = [](int32_t, const std::vector<INetAddr> &) {};
+    EXPECT_EQ(engine.Query("www.example.com", AF_INET, {LOCAL_SERVER}, 0, 0, ignore), DNS_ERROR);
+    ASSERT_TRUE(engine.Start());
+    EXPECT_EQ(engine.Query("www.example.com", AF_INET, {"not.an.address"}, 0, 0, ignore), DNS_ERROR);
+    EXPECT_EQ(engine.Query("www.example.com", AF_UNIX, {LOCAL_SERVER}, 0, 0, ignore), DNS_ERROR);
+    /* The sockets are not bound to a network, so only the default one is served */
+    constexpr uint16_t otherNetId = 101;
+    EXPECT_EQ(engine.Query("www.example.com", AF_INET, {LOCAL_SERVER}, 0, 0, ignore, otherNetId), DNS_ERROR);
+    std::atomic<uint32_t> failed {0};
+    auto count = [&failed](int32_t result, const std::vector<INetAddr> &) {
+        failed += (result == EAI_AGAIN) ? 1 : 0;
+    };
+    EXPECT_EQ(engine.Query("drop1.example.com", AF_INET, {LOCAL_SERVER}, WAIT_TIMEOUT_MS, 0, count), DNS_SUCCESS);
+    EXPECT_EQ(engine.Query("drop2.example.com", AF_INET, {LOCAL_SERVER}, WAIT_TIMEOUT_MS, 0, count), DNS_SUCCESS);
+    EXPECT_EQ(engine.Query("drop3.example.com", AF_INET, {LOCAL_SERVER}, WAIT_TIMEOUT_MS, 0, count), DNS_ERROR);
+    engine.Stop();
+    EXPECT_EQ(failed, maxPending);
+    EXPECT_EQ(engine.GetStats().pending, 0);
+}
+
+/**
+ * @tc.name: DnsQueryEngine005
+ * @tc.desc: The result survives the one way callback proxy and stub
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine005, TestSize.Level1)
+{
+    sptr<DnsCallbackRecorder> recorder = (std::make_unique<DnsCallbackRecorder>()).release();
+    sptr<IDnsResolverCallback> proxy = (std::make_unique<DnsResolverCallbackProxy>(recorder->AsObject())).release();
+    INetAddr addr;
+    addr.family_ = AF_INET;
+    addr.address_ = "10.0.0.1";
+    EXPECT_EQ(proxy->OnResolved("www.example.com", DNS_SUCCESS, {addr, addr}), ERR_NONE);
+    EXPECT_EQ(recorder->hostName_, "www.example.com");
+    EXPECT_EQ(recorder->result_, DNS_SUCCESS);
+    ASSERT_EQ(recorder->addrInfo_.size(), 2);
+    EXPECT_EQ(recorder->addrInfo_[1].address_, "10.0.0.1");
+}
+
+/**
+ * @tc.name: DnsQueryEngine006
+ * @tc.desc: Load with slow upstream names, blocking lookups on a few service threads against one async engine
+ * @tc.type: PERF
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine006, TestSize.Level2)
+{
+    constexpr uint32_t queryCount = 256;
+    constexpr uint32_t slowEvery = 8;
+    constexpr uint32_t binderThreads = 4;
+    constexpr uint32_t percentile = 99;
+    constexpr uint32_t hundred = 100;
+    std::vector<std::string> names;
+    for (uint32_t i = 0; i < queryCount; i++) {
+        names.push_back(((i % slowEvery == 0) ? "slow" : "fast") + std::to_string(i) + ".example.com");
+    }
+    DnsQueryEngine engine(server_.GetPort(), queryCount);
+    ASSERT_TRUE(engine.Start());
+    auto fastP99 = [&names](std::vector<Clock::duration> &latencies) {
+        std::vector<Clock::duration> fast;
+        for (size_t i = 0; i < names.size(); i++) {
+            if (names[i].compare(0, strlen("fast"), "fast") == 0) {
+                fast.push_back(latencies[i]);
+            }
+        }
+        std::sort(fast.begin(), fast.end());
+        return std::chrono::duration_cast<std::chrono::milliseconds>(fast[fast.size() * percentile / hundred]);
+    };
+
+    /* Blocking model: each service thread waits for its lookup before it takes the next request */
+    std::vector<Clock::duration> blockingLatencies(queryCount);
+    std::atomic<uint32_t> next {0};
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < binderThreads; t++) {
+        threads.emplace_back([&]() {
+            for (uint32_t i = next++; i < queryCount; i = next++) {
+                QueryResult answer = Resolve(engine, names[i], {LOCAL_SERVER}, 0, WAIT_TIMEOUT_MS);
+                blockingLatencies[i] = Clock::now() - start;
+                EXPECT_EQ(answer.result, DNS_SUCCESS);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    auto blockingTotal = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+
+    /* Async model: every request is queued at once and answered as its reply arrives */
+    std::vector<Clock::duration> asyncLatencies(queryCount);
+    std::mutex mutex;
+    std::condition_variable cond;
+    uint32_t done = 0;
+    uint32_t answered = 0;
+    start = Clock::now();
+    for (uint32_t i = 0; i < queryCount; i++) {
+        ASSERT_EQ(engine.Query(names[i], AF_INET, {LOCAL_SERVER}, WAIT_TIMEOUT_MS, 0,
+            [&, i](int32_t result, const std::vector<INetAddr> &) {
+                std::lock_guard<std::mutex> lock(mutex);
+                asyncLatencies[i] = Clock::now() - start;
+                answered += (result == DNS_SUCCESS) ? 1 : 0;
+                if (++done == queryCount) {
+                    cond.notify_one();
+                }
+            }), DNS_SUCCESS);
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cond.wait_for(lock, std::chrono::milliseconds(WAIT_TIMEOUT_MS * 2),
+            [&done]() { return done == queryCount; }));
+    }
+    auto asyncTotal = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    EXPECT_EQ(answered, queryCount);
+    EXPECT_LT(asyncTotal, blockingTotal);
+    std::cout << "DnsQueryEngine " << queryCount << " queries, 1/" << slowEvery << " slow: blocking on "
+              << binderThreads << " threads " << blockingTotal.count() << "ms (fast p99 "
+              << fastP99(blockingLatencies).count() << "ms), async " << asyncTotal.count() << "ms (fast p99 "
+              << fastP99(asyncLatencies).count() << "ms)" << std::endl;
+}
+
+/**
+ * @tc.name: DnsQueryEngine007
+ * @tc.desc: A dual stack lookup returns the addresses of both families and streams the first one ahead
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine007, TestSize.Level1)
+{
+    DnsQueryEngine engine(server_.GetPort());
+    ASSERT_TRUE(engine.Start());
+    DualStackResult answer = ResolveDualStack(engine, "www.example.com");
+    EXPECT_EQ(answer.complete.result, DNS_SUCCESS);
+    ASSERT_EQ(answer.complete.addrInfo.size(), 2);
+    std::vector<std::string> addrs = {answer.complete.addrInfo[0].address_, answer.complete.addrInfo[1].address_};
+    std::sort(addrs.begin(), addrs.end());
+    EXPECT_EQ(addrs[0], "10.0.0.15");
+    EXPECT_EQ(addrs[1], "2001:db8::f");
+    ASSERT_EQ(answer.partial.size(), 1);
+    EXPECT_TRUE(answer.partialFirst);
+    EXPECT_EQ(engine.GetStats().submitted, 2);
+}
+
+/**
+ * @tc.name: DnsQueryEngine008
+ * @tc.desc: A slow AAAA answer does not hold back the A answer, a missing family does not fail the lookup
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine008, TestSize.Level1)
+{
+    DnsQueryEngine engine(server_.GetPort());
+    ASSERT_TRUE(engine.Start());
+    DualStackResult answer = ResolveDualStack(engine, "late6.example.com");
+    ASSERT_EQ(answer.partial.size(), 1);
+    EXPECT_EQ(answer.partial[0].family_, AF_INET);
+    EXPECT_LT(answer.partialLatency, std::chrono::milliseconds(SLOW_LATENCY_MS));
+    EXPECT_GE(answer.complete.latency, std::chrono::milliseconds(SLOW_LATENCY_MS));
+    EXPECT_EQ(answer.complete.addrInfo.size(), 2);
+
+    answer = ResolveDualStack(engine, "v4only.example.com");
+    EXPECT_EQ(answer.complete.result, DNS_SUCCESS);
+    ASSERT_EQ(answer.complete.addrInfo.size(), 1);
+    EXPECT_EQ(answer.complete.addrInfo[0].family_, AF_INET);
+
+    answer = ResolveDualStack(engine, "nx.example.com");
+    EXPECT_EQ(answer.complete.result, EAI_NONAME);
+    EXPECT_TRUE(answer.partial.empty());
+    EXPECT_TRUE(answer.complete.addrInfo.empty());
+}
+
+/**
+ * @tc.name: DnsQueryEngine009
+ * @tc.desc: The partial answer survives the one way callback proxy and stub
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine009, TestSize.Level1)
+{
+    sptr<DnsCallbackRecorder> recorder = (std::make_unique<DnsCallbackRecorder>()).release();
+    sptr<IDnsResolverCallback> proxy = (std::make_unique<DnsResolverCallbackProxy>(recorder->AsObject())).release();
+    INetAddr addr;
+    addr.family_ = AF_INET6;
+    addr.address_ = "2001:db8::1";
+    EXPECT_EQ(proxy->OnPartialResolved("www.example.com", {addr}), ERR_NONE);
+    ASSERT_EQ(recorder->partialAddrInfo_.size(), 1);
+    EXPECT_EQ(recorder->partialAddrInfo_[0].family_, AF_INET6);
+    EXPECT_EQ(recorder->partialAddrInfo_[0].address_, "2001:db8::1");
+    EXPECT_TRUE(recorder->addrInfo_.empty());
+}
+
+/**
+ * @tc.name: DnsQueryEngine010
+ * @tc.desc: Time to the first address, AAAA then A one after the other against both queries at once
+ * @tc.type: PERF
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine010, TestSize.Level2)
+{
+    const std::string hostName = "slow.example.com";
+    DnsQueryEngine engine(server_.GetPort());
+    ASSERT_TRUE(engine.Start());
+    auto start = Clock::now();
+    auto query = [&engine, &hostName](int32_t family) {
+        auto promise = std::make_shared<std::promise<int32_t>>();
+        auto future = promise->get_future();
+        EXPECT_EQ(engine.Query(hostName, family, {LOCAL_SERVER}, WAIT_TIMEOUT_MS, 0,
+            [promise](int32_t result, const std::vector<INetAddr> &) { promise->set_value(result); }), DNS_SUCCESS);
+        return future.get();
+    };
+    EXPECT_EQ(query(AF_INET6), DNS_SUCCESS);
+    EXPECT_EQ(query(AF_INET), DNS_SUCCESS);
+    auto serial = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    DualStackResult answer = ResolveDualStack(engine, hostName);
+    EXPECT_EQ(answer.complete.result, DNS_SUCCESS);
+    auto first = std::chrono::duration_cast<std::chrono::milliseconds>(answer.partialLatency);
+    auto complete = std::chrono::duration_cast<std::chrono::milliseconds>(answer.complete.latency);
+    EXPECT_LT(complete, serial);
+    std::cout << "Dual stack lookup with " << SLOW_LATENCY_MS << "ms upstream: serial AAAA then A " << serial.count()
+              << "ms, parallel first family " << first.count() << "ms, both " << complete.count() << "ms"
+              << std::endl;
+}
+/**
+ * @tc.name: DnsQueryEngine011
+ * @tc.desc: Every attempt is counted in the stats of the server it went to
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine011, TestSize.Level1)
+{
+    constexpr uint16_t netId = DNS_DEFAULT_NETID;
+    DnsResolverStats stats;
+    DnsQueryEngine engine(server_.GetPort());
+    engine.SetStats(&stats);
+    ASSERT_TRUE(engine.Start());
+    auto resolve = [this, &engine](const std::string &hostName, const std::vector<std::string> &servers) {
+        auto promise = std::make_shared<std::promise<int32_t>>();
+        auto future = promise->get_future();
+        EXPECT_EQ(engine.Query(hostName, AF_INET, servers, QUERY_TIMEOUT_MS, 1,
+            [promise](int32_t result, const std::vector<INetAddr> &) { promise->set_value(result); }, netId),
+            DNS_SUCCESS);
+        return future.get();
+    };
+    EXPECT_EQ(resolve("www.example.com", {REFUSING_SERVER, LOCAL_SERVER}), DNS_SUCCESS);
+    EXPECT_EQ(resolve("nx.example.com", {LOCAL_SERVER}), EAI_NONAME);
+    EXPECT_EQ(resolve("fail.example.com", {LOCAL_SERVER}), EAI_AGAIN);
+    EXPECT_EQ(resolve("drop.example.com", {LOCAL_SERVER}), EAI_AGAIN);
+    std::vector<DnsServerStats> result;
+    stats.GetStats(netId, result);
+    ASSERT_EQ(result.size(), 2);
+    const DnsServerStats &local = (result[0].server_ == LOCAL_SERVER) ? result[0] : result[1];
+    const DnsServerStats &refusing = (result[0].server_ == LOCAL_SERVER) ? result[1] : result[0];
+    EXPECT_EQ(refusing.queries_, 1);
+    EXPECT_EQ(refusing.errors_, 1);
+    EXPECT_EQ(local.queries_, 6);
+    EXPECT_EQ(local.successes_, 1);
+    EXPECT_EQ(local.nxDomains_, 1);
+    EXPECT_EQ(local.servFails_, 2);
+    EXPECT_EQ(local.timeouts_, 2);
+    uint64_t answered = 0;
+    for (uint64_t count : local.latencyBuckets_) {
+        answered += count;
+    }
+    EXPECT_EQ(answered, 4);
+}
+
+/**
+ * @tc.name: DnsQueryEngine012
+ * @tc.desc: Latency with the first of three servers blackholed, fixed server order against adaptive selection
+ * @tc.type: PERF
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine012, TestSize.Level2)
+{
+    constexpr uint32_t fixedQueries = 50;
+    constexpr uint32_t adaptiveQueries = 500;
+    constexpr uint32_t percentile = 99;
+    constexpr uint32_t hundred = 100;
+    StubDnsServer blackhole;
+    StubDnsServer second;
+    ASSERT_TRUE(blackhole.Start(BLACKHOLE_SERVER, server_.GetPort(), false));
+    ASSERT_TRUE(second.Start(SECOND_SERVER, server_.GetPort()));
+    const std::vector<std::string> servers = {BLACKHOLE_SERVER, LOCAL_SERVER, SECOND_SERVER};
+    /* The retry budget Network::UpdateDnses configures, one retry */
+    auto measure = [this, &servers](DnsQueryEngine &engine, uint32_t count) {
+        std::vector<Clock::duration> latencies;
+        for (uint32_t i = 0; i < count; i++) {
+            QueryResult answer = Resolve(engine, "host" + std::to_string(i) + ".example.com", servers, 1);
+            EXPECT_EQ(answer.result, DNS_SUCCESS);
+            latencies.push_back(answer.latency);
+        }
+        std::sort(latencies.begin(), latencies.end());
+        return std::chrono::duration_cast<std::chrono::microseconds>(latencies[count * percentile / hundred]);
+    };
+    DnsQueryEngine fixedEngine(server_.GetPort());
+    ASSERT_TRUE(fixedEngine.Start());
+    auto fixedP99 = measure(fixedEngine, fixedQueries);
+    fixedEngine.Stop();
+
+    DnsServerSelector selector;
+    DnsQueryEngine adaptiveEngine(server_.GetPort());
+    adaptiveEngine.SetSelector(&selector);
+    ASSERT_TRUE(adaptiveEngine.Start());
+    auto adaptiveP99 = measure(adaptiveEngine, adaptiveQueries);
+    DnsServerHealth health;
+    ASSERT_TRUE(selector.GetHealth(0, BLACKHOLE_SERVER, health));
+    EXPECT_GT(health.failureRate, 0);
+    EXPECT_FALSE(health.hasRtt);
+    EXPECT_LT(adaptiveP99, fixedP99);
+    std::cout << "Three servers, first blackholed, " << QUERY_TIMEOUT_MS << "ms timeout: fixed order p99 "
+              << fixedP99.count() << "us, adaptive p99 " << adaptiveP99.count() << "us" << std::endl;
+}
+
+/**
+ * @tc.name: DnsQueryEngine013
+ * @tc.desc: A failing loop fails the outstanding queries and refuses new ones until the engine is started again
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine013, TestSize.Level1)
+{
+    DnsQueryEngine engine(server_.GetPort());
+    ASSERT_TRUE(engine.Start());
+    auto promise = std::make_shared<std::promise<int32_t>>();
+    auto future = promise->get_future();
+    ASSERT_EQ(engine.Query("drop.example.com", AF_INET, {LOCAL_SERVER}, WAIT_TIMEOUT_MS * 2, 0,
+        [promise](int32_t result, const std::vector<INetAddr> &) { promise->set_value(result); }), DNS_SUCCESS);
+    ASSERT_EQ(Resolve(engine, "www.example.com", {LOCAL_SERVER}).result, DNS_SUCCESS);
+
+    /* Swap the epoll descriptor for one epoll_wait rejects, the next query wakes the loop into the failure */
+    int32_t epollFd = FindLastEpollFd();
+    ASSERT_GE(epollFd, 0);
+    int32_t nullFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    ASSERT_GE(nullFd, 0);
+    ASSERT_EQ(dup2(nullFd, epollFd), epollFd);
+    close(nullFd);
+    auto ignore = [](int32_t, const std::vector<INetAddr> &) {};
+    EXPECT_EQ(engine.Query("wake.example.com", AF_INET, {LOCAL_SERVER}, 0, 0, ignore), DNS_SUCCESS);
+    ASSERT_EQ(future.wait_for(std::chrono::milliseconds(WAIT_TIMEOUT_MS)), std::future_status::ready);
+    EXPECT_EQ(future.get(), EAI_AGAIN);
+    EXPECT_FALSE(engine.IsRunning());
+    EXPECT_EQ(engine.Query("www.example.com", AF_INET, {LOCAL_SERVER}, 0, 0, ignore), DNS_ERROR);
+    EXPECT_EQ(engine.GetStats().pending, 0);
+
+    ASSERT_TRUE(engine.Start());
+    EXPECT_EQ(Resolve(engine, "www.example.com", {LOCAL_SERVER}).result, DNS_SUCCESS);
+}
+
+/**
+ * @tc.name: DnsQueryEngine014
+ * @tc.desc: A truncated reply completes the query without its partial answers and without trying another server
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsQueryEngineTest, DnsQueryEngine014, TestSize.Level1)
+{
+    DnsQueryEngine engine(server_.GetPort());
+    ASSERT_TRUE(engine.Start());
+    QueryResult answer = Resolve(engine, "tc.example.com", {LOCAL_SERVER, LOCAL_SERVER}, 1);
+    EXPECT_EQ(answer.result, DnsQueryEngine::RESULT_TRUNCATED);
+    EXPECT_TRUE(answer.addrInfo.empty());
+    EXPECT_EQ(server_.received_, 1);
+    EXPECT_EQ(engine.GetStats().retries, 0);
+
+    /* The A answer is complete, the merged one would still miss the AAAA records */
+    DualStackResult dualStack = ResolveDualStack(engine, "tc6.example.com");
+    EXPECT_EQ(dualStack.complete.result, DnsQueryEngine::RESULT_TRUNCATED);
+    EXPECT_TRUE(dualStack.complete.addrInfo.empty());
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
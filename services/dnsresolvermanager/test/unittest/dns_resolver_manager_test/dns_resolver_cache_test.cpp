@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <netdb.h>
+#include <thread>
+#include <vector>
+
+#include "dns_resolver_cache.h"
+#include "dns_resolver_client.h"
+#include "dns_resolver_constants.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+constexpr uint32_t TEST_TTL_MS = 60000;
+constexpr uint32_t SHORT_TTL_MS = 20;
+constexpr uint32_t UPSTREAM_LATENCY_MS = 20;
+constexpr uint32_t LOOKUP_INTERVAL_MS = 5;
+constexpr uint16_t TEST_NETID = 100;
+const std::string TEST_HOST = "www.example.com";
+
+std::vector<INetAddr> MakeAddrs(const std::string &address)
+{
+    INetAddr addr;
+    addr.family_ = AF_INET;
+    addr.address_ = address;
+    return {addr};
+}
+} // namespace
+
+class DnsResolverCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void DnsResolverCacheTest::SetUpTestCase() {}
+
+void DnsResolverCacheTest::TearDownTestCase() {}
+
+void DnsResolverCacheTest::SetUp() {}
+
+void DnsResolverCacheTest::TearDown() {}
+
+/**
+ * @tc.name: DnsResolverCache001
+ * @tc.desc: A cached lookup is appended to the output and counted as a hit
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverCacheTest, DnsResolverCache001, TestSize.Level1)
+{
+    DnsResolverCache cache;
+    int32_t result = DNS_ERROR;
+    std::vector<INetAddr> addrInfo;
+    EXPECT_FALSE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    cache.Put(DNS_DEFAULT_NETID, TEST_HOST, DNS_SUCCESS, MakeAddrs("1.2.3.4"), TEST_TTL_MS);
+    addrInfo = MakeAddrs("5.6.7.8");
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    EXPECT_EQ(result, DNS_SUCCESS);
+    ASSERT_EQ(addrInfo.size(), 2);
+    EXPECT_EQ(addrInfo[1].address_, "1.2.3.4");
+    EXPECT_FALSE(cache.Get(TEST_NETID, TEST_HOST, result, addrInfo));
+    DnsResolverCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 2);
+}
+
+/**
+ * @tc.name: DnsResolverCache002
+ * @tc.desc: Entries expire after their TTL and a zero TTL caches nothing
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverCacheTest, DnsResolverCache002, TestSize.Level1)
+{
+    DnsResolverCache cache;
+    int32_t result = DNS_ERROR;
+    std::vector<INetAddr> addrInfo;
+    cache.Put(DNS_DEFAULT_NETID, TEST_HOST, DNS_SUCCESS, MakeAddrs("1.2.3.4"), SHORT_TTL_MS);
+    cache.Put(DNS_DEFAULT_NETID, "www.example.org", DNS_SUCCESS, MakeAddrs("1.2.3.4"), 0);
+    EXPECT_EQ(cache.Size(), 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(SHORT_TTL_MS * 2));
+    EXPECT_FALSE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    EXPECT_EQ(cache.Size(), 0);
+    EXPECT_EQ(cache.GetStats().expired, 1);
+}
+
+/**
+ * @tc.name: DnsResolverCache003
+ * @tc.desc: A full shard evicts its least recently used entry
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverCacheTest, DnsResolverCache003, TestSize.Level1)
+{
+    constexpr uint32_t capacity = 4;
+    DnsResolverCache cache(capacity, 1);
+    int32_t result = DNS_ERROR;
+    std::vector<INetAddr> addrInfo;
+    for (uint32_t i = 0; i < capacity; i++) {
+        cache.Put(DNS_DEFAULT_NETID, "host" + std::to_string(i), DNS_SUCCESS, MakeAddrs("1.2.3.4"), TEST_TTL_MS);
+    }
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, "host0", result, addrInfo));
+    cache.Put(DNS_DEFAULT_NETID, "host" + std::to_string(capacity), DNS_SUCCESS, MakeAddrs("1.2.3.4"),
+        TEST_TTL_MS);
+    EXPECT_EQ(cache.Size(), capacity);
+    EXPECT_TRUE(cache.Get(DNS_DEFAULT_NETID, "host0", result, addrInfo));
+    EXPECT_FALSE(cache.Get(DNS_DEFAULT_NETID, "host1", result, addrInfo));
+    EXPECT_EQ(cache.GetStats().evictions, 1);
+}
+
+/**
+ * @tc.name: DnsResolverCache004
+ * @tc.desc: Invalidating a netId only drops the entries of that network
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverCacheTest, DnsResolverCache004, TestSize.Level1)
+{
+    DnsResolverCache cache;
+    int32_t result = DNS_ERROR;
+    std::vector<INetAddr> addrInfo;
+    cache.Put(DNS_DEFAULT_NETID, TEST_HOST, DNS_SUCCESS, MakeAddrs("1.2.3.4"), TEST_TTL_MS);
+    cache.Put(TEST_NETID, TEST_HOST, DNS_SUCCESS, MakeAddrs("1.2.3.4"), TEST_TTL_MS);
+    cache.Invalidate(TEST_NETID);
+    EXPECT_TRUE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    EXPECT_FALSE(cache.Get(TEST_NETID, TEST_HOST, result, addrInfo));
+    cache.Clear();
+    EXPECT_EQ(cache.Size(), 0);
+    EXPECT_EQ(cache.GetStats().invalidations, 2);
+}
+
+/**
+ * @tc.name: DnsResolverCache005
+ * @tc.desc: A failed lookup is returned with its result code and counted as a negative hit
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverCacheTest, DnsResolverCache005, TestSize.Level1)
+{
+    DnsResolverCache cache;
+    int32_t result = DNS_SUCCESS;
+    std::vector<INetAddr> addrInfo;
+    cache.Put(DNS_DEFAULT_NETID, TEST_HOST, EAI_NONAME, {}, TEST_TTL_MS);
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    EXPECT_EQ(result, EAI_NONAME);
+    EXPECT_TRUE(addrInfo.empty());
+    EXPECT_EQ(cache.GetStats().negativeHits, 1);
+}
+
+/**
+ * @tc.name: DnsResolverCache006
+ * @tc.desc: Concurrent lookups and inserts keep the cache within its capacity
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverCacheTest, DnsResolverCache006, TestSize.Level1)
+{
+    constexpr uint32_t threadCount = 8;
+    constexpr uint32_t loopCount = 10000;
+    constexpr uint32_t hostCount = 1024;
+    DnsResolverCache cache;
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([&cache, t]() {
+            for (uint32_t i = 0; i < loopCount; i++) {
+                std::string hostName = "host" + std::to_string((i * (t + 1)) % hostCount);
+                int32_t result = DNS_ERROR;
+                std::vector<INetAddr> addrInfo;
+                if (!cache.Get(DNS_DEFAULT_NETID, hostName, result, addrInfo)) {
+                    cache.Put(DNS_DEFAULT_NETID, hostName, DNS_SUCCESS, MakeAddrs("1.2.3.4"), TEST_TTL_MS);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    DnsResolverCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.hits + stats.misses, threadCount * loopCount);
+    EXPECT_LE(cache.Size(), DnsResolverCache::DEFAULT_CAPACITY);
+}
+
+/**
+ * @tc.name: DnsResolverCache007
+ * @tc.desc: Latency of GetAddressesByName with and without the client cache
+ * @tc.type: PERF
+ */
+HWTEST_F(DnsResolverCacheTest, DnsResolverCache007, TestSize.Level2)
+{
+    constexpr uint32_t loopCount = 1000;
+    auto client = DelayedSingleton<DnsResolverClient>::GetInstance();
+    auto measure = [&client]() {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < loopCount; i++) {
+            std::vector<INetAddr> addrInfo;
+            client->GetAddressesByName(TEST_HOST, addrInfo);
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    };
+    client->SetCacheTtl(0, 0);
+    auto uncached = measure();
+    client->SetCacheTtl(DNS_CACHE_POSITIVE_TTL_MS, DNS_CACHE_NEGATIVE_TTL_MS);
+    auto cached = measure();
+    DnsResolverCacheStats stats = client->GetCacheStats();
+    std::cout << "GetAddressesByName " << loopCount << " lookups uncached " << uncached.count() << "us, cached "
+              << cached.count() << "us, hits " << stats.hits << ", misses " << stats.misses << std::endl;
+}
+
+/**
+ * @tc.name: DnsResolverCache008
+ * @tc.desc: A hot entry is refreshed once when it nears expiry, the next Put rearms it
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverCacheTest, DnsResolverCache008, TestSize.Level1)
+{
+    constexpr uint32_t ttlMs = 200;
+    constexpr uint32_t prefetchPercent = 50;
+    DnsResolverCache cache;
+    std::vector<std::string> refreshed;
+    cache.SetRefreshFunc([&refreshed](uint16_t, const std::string &hostName) { refreshed.push_back(hostName); });
+    DnsCacheRefreshPolicy policy;
+    policy.prefetchPercent = prefetchPercent;
+    policy.prefetchMinHits = 2;
+    cache.SetRefreshPolicy(policy);
+    int32_t result = DNS_ERROR;
+    std::vector<INetAddr> addrInfo;
+    cache.Put(DNS_DEFAULT_NETID, TEST_HOST, DNS_SUCCESS, MakeAddrs("1.2.3.4"), ttlMs);
+    cache.Put(DNS_DEFAULT_NETID, "nx.example.com", EAI_NONAME, {}, ttlMs);
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    EXPECT_TRUE(refreshed.empty());
+    std::this_thread::sleep_for(std::chrono::milliseconds(ttlMs * prefetchPercent / 100 + SHORT_TTL_MS));
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, "nx.example.com", result, addrInfo));
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, "nx.example.com", result, addrInfo));
+    ASSERT_EQ(refreshed.size(), 1);
+    EXPECT_EQ(refreshed[0], TEST_HOST);
+
+    cache.Put(DNS_DEFAULT_NETID, TEST_HOST, DNS_SUCCESS, MakeAddrs("1.2.3.4"), ttlMs);
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    EXPECT_EQ(refreshed.size(), 1);
+    EXPECT_EQ(cache.GetStats().prefetches, 1);
+}
+
+/**
+ * @tc.name: DnsResolverCache009
+ * @tc.desc: Refreshes beyond the per second budget are dropped and counted
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverCacheTest, DnsResolverCache009, TestSize.Level1)
+{
+    constexpr uint32_t hostCount = 5;
+    constexpr uint32_t maxRefreshPerSecond = 2;
+    DnsResolverCache cache;
+    uint32_t refreshes = 0;
+    cache.SetRefreshFunc([&refreshes](uint16_t, const std::string &) { refreshes++; });
+    DnsCacheRefreshPolicy policy;
+    policy.prefetchPercent = 100;
+    policy.prefetchMinHits = 1;
+    policy.maxRefreshPerSecond = maxRefreshPerSecond;
+    cache.SetRefreshPolicy(policy);
+    int32_t result = DNS_ERROR;
+    std::vector<INetAddr> addrInfo;
+    for (uint32_t i = 0; i < hostCount; i++) {
+        cache.Put(DNS_DEFAULT_NETID, "host" + std::to_string(i), DNS_SUCCESS, MakeAddrs("1.2.3.4"), TEST_TTL_MS);
+        ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, "host" + std::to_string(i), result, addrInfo));
+    }
+    EXPECT_EQ(refreshes, maxRefreshPerSecond);
+    DnsResolverCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.prefetches, maxRefreshPerSecond);
+    EXPECT_EQ(stats.prefetchesLimited, hostCount - maxRefreshPerSecond);
+}
+
+/**
+ * @tc.name: DnsResolverCache010
+ * @tc.desc: An expired answer is served stale within its window and keeps answering until the recheck, never a
+ *           failure
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverCacheTest, DnsResolverCache010, TestSize.Level1)
+{
+    constexpr uint32_t staleWindowMs = 200;
+    DnsResolverCache cache;
+    DnsCacheRefreshPolicy policy;
+    policy.staleWindowMs = staleWindowMs;
+    policy.staleRecheckMs = TEST_TTL_MS;
+    cache.SetRefreshPolicy(policy);
+    int32_t result = DNS_ERROR;
+    std::vector<INetAddr> addrInfo;
+    cache.Put(DNS_DEFAULT_NETID, TEST_HOST, DNS_SUCCESS, MakeAddrs("1.2.3.4"), SHORT_TTL_MS);
+    cache.Put(DNS_DEFAULT_NETID, "nx.example.com", EAI_NONAME, {}, SHORT_TTL_MS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(SHORT_TTL_MS * 2));
+    EXPECT_FALSE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    EXPECT_FALSE(cache.Get(DNS_DEFAULT_NETID, "nx.example.com", result, addrInfo));
+    EXPECT_EQ(cache.Size(), 1);
+    EXPECT_FALSE(cache.GetStale(DNS_DEFAULT_NETID, "nx.example.com", addrInfo));
+    ASSERT_TRUE(cache.GetStale(DNS_DEFAULT_NETID, TEST_HOST, addrInfo));
+    ASSERT_EQ(addrInfo.size(), 1);
+    EXPECT_EQ(addrInfo[0].address_, "1.2.3.4");
+    addrInfo.clear();
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    EXPECT_EQ(result, DNS_SUCCESS);
+    EXPECT_EQ(addrInfo.size(), 1);
+    EXPECT_EQ(cache.GetStats().staleHits, 2);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(staleWindowMs));
+    EXPECT_FALSE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    EXPECT_FALSE(cache.GetStale(DNS_DEFAULT_NETID, TEST_HOST, addrInfo));
+    EXPECT_EQ(cache.Size(), 0);
+}
+
+/**
+ * @tc.name: DnsResolverCache011
+ * @tc.desc: Lookups of a warm hot name against a slow upstream, with the entry left to expire and with prefetch
+ * @tc.type: PERF
+ */
+HWTEST_F(DnsResolverCacheTest, DnsResolverCache011, TestSize.Level2)
+{
+    constexpr uint32_t lookupCount = 300;
+    auto upstream = [](DnsResolverCache &cache) {
+        constexpr uint32_t ttlMs = 200;
+        std::this_thread::sleep_for(std::chrono::milliseconds(UPSTREAM_LATENCY_MS));
+        cache.Put(DNS_DEFAULT_NETID, TEST_HOST, DNS_SUCCESS, MakeAddrs("1.2.3.4"), ttlMs);
+    };
+    auto measure = [&upstream](DnsResolverCache &cache, uint32_t &misses) {
+        std::chrono::steady_clock::duration worst {0};
+        upstream(cache);
+        for (uint32_t i = 0; i < lookupCount; i++) {
+            auto start = std::chrono::steady_clock::now();
+            int32_t result = DNS_ERROR;
+            std::vector<INetAddr> addrInfo;
+            if (!cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo)) {
+                misses++;
+                upstream(cache);
+            }
+            worst = std::max(worst, std::chrono::steady_clock::now() - start);
+            std::this_thread::sleep_for(std::chrono::milliseconds(LOOKUP_INTERVAL_MS));
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(worst);
+    };
+    DnsResolverCache plain;
+    uint32_t plainMisses = 0;
+    auto plainWorst = measure(plain, plainMisses);
+
+    DnsResolverCache prefetching;
+    std::vector<std::future<void>> refreshes;
+    prefetching.SetRefreshFunc([&](uint16_t, const std::string &) {
+        refreshes.push_back(std::async(std::launch::async, upstream, std::ref(prefetching)));
+    });
+    DnsCacheRefreshPolicy policy;
+    policy.prefetchPercent = 25;
+    policy.prefetchMinHits = DNS_CACHE_PREFETCH_MIN_HITS;
+    policy.maxRefreshPerSecond = DNS_CACHE_MAX_REFRESH_PER_SECOND;
+    prefetching.SetRefreshPolicy(policy);
+    uint32_t prefetchMisses = 0;
+    auto prefetchWorst = measure(prefetching, prefetchMisses);
+    for (auto &refresh : refreshes) {
+        refresh.wait();
+    }
+    EXPECT_LT(prefetchMisses, plainMisses);
+    std::cout << "Hot name, 200ms TTL, " << UPSTREAM_LATENCY_MS << "ms upstream: expiring misses " << plainMisses
+              << " worst " << plainWorst.count() << "ms, prefetching misses " << prefetchMisses << " worst "
+              << prefetchWorst.count() << "ms, prefetches " << prefetching.GetStats().prefetches << std::endl;
+}
+
+/**
+ * @tc.name: DnsResolverCache012
+ * @tc.desc: A refresh that failed without an answer is cancelled, the next hit on the entry refreshes it again
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverCacheTest, DnsResolverCache012, TestSize.Level1)
+{
+    DnsResolverCache cache;
+    uint32_t refreshes = 0;
+    cache.SetRefreshFunc([&refreshes](uint16_t, const std::string &) { refreshes++; });
+    DnsCacheRefreshPolicy policy;
+    policy.prefetchPercent = 100;
+    policy.prefetchMinHits = 1;
+    cache.SetRefreshPolicy(policy);
+    int32_t result = DNS_ERROR;
+    std::vector<INetAddr> addrInfo;
+    cache.Put(DNS_DEFAULT_NETID, TEST_HOST, DNS_SUCCESS, MakeAddrs("1.2.3.4"), TEST_TTL_MS);
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    EXPECT_EQ(refreshes, 1);
+
+    cache.CancelRefresh(DNS_DEFAULT_NETID, TEST_HOST);
+    cache.CancelRefresh(DNS_DEFAULT_NETID, "missing.example.com");
+    ASSERT_TRUE(cache.Get(DNS_DEFAULT_NETID, TEST_HOST, result, addrInfo));
+    EXPECT_EQ(refreshes, 2);
+    EXPECT_EQ(result, DNS_SUCCESS);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <netdb.h>
+#include <thread>
+
+#include "message_parcel.h"
+
+#include "dns_resolver_constants.h"
+#include "dns_resolver_stats.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+constexpr uint16_t TEST_NETID = 100;
+const std::string TEST_SERVER = "192.0.2.53";
+} // namespace
+
+class DnsResolverStatsTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void DnsResolverStatsTest::SetUpTestCase() {}
+
+void DnsResolverStatsTest::TearDownTestCase() {}
+
+void DnsResolverStatsTest::SetUp() {}
+
+void DnsResolverStatsTest::TearDown() {}
+
+/**
+ * @tc.name: DnsResolverStats001
+ * @tc.desc: Every outcome has its counter and answered attempts land in the bucket of their latency
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverStatsTest, DnsResolverStats001, TestSize.Level1)
+{
+    DnsResolverStats stats;
+    stats.Record(TEST_NETID, TEST_SERVER, DNS_OUTCOME_SUCCESS, 0);
+    stats.Record(TEST_NETID, TEST_SERVER, DNS_OUTCOME_SUCCESS, 3);
+    stats.Record(TEST_NETID, TEST_SERVER, DNS_OUTCOME_NXDOMAIN, 3);
+    stats.Record(TEST_NETID, TEST_SERVER, DNS_OUTCOME_SERVFAIL, 1);
+    stats.Record(TEST_NETID, TEST_SERVER, DNS_OUTCOME_ERROR, 5000);
+    stats.Record(TEST_NETID, TEST_SERVER, DNS_OUTCOME_TIMEOUT, 5000);
+    std::vector<DnsServerStats> result;
+    stats.GetStats(TEST_NETID, result);
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result[0].server_, TEST_SERVER);
+    EXPECT_EQ(result[0].queries_, 6);
+    EXPECT_EQ(result[0].successes_, 2);
+    EXPECT_EQ(result[0].nxDomains_, 1);
+    EXPECT_EQ(result[0].servFails_, 1);
+    EXPECT_EQ(result[0].errors_, 1);
+    EXPECT_EQ(result[0].timeouts_, 1);
+    ASSERT_EQ(result[0].latencyBuckets_.size(), DNS_LATENCY_BUCKETS);
+    EXPECT_EQ(result[0].latencyBuckets_[0], 1);
+    EXPECT_EQ(result[0].latencyBuckets_[1], 1);
+    EXPECT_EQ(result[0].latencyBuckets_[2], 2);
+    EXPECT_EQ(result[0].latencyBuckets_[DNS_LATENCY_BUCKETS - 1], 1);
+
+    EXPECT_EQ(DnsResolverStats::GetBucket(1), 1);
+    EXPECT_EQ(DnsResolverStats::GetBucket(2), 2);
+    EXPECT_EQ(DnsResolverStats::GetBucket(1023), 10);
+    EXPECT_EQ(DnsServerStats::GetBucketUpperMs(10), 1024);
+    EXPECT_EQ(DnsServerStats::GetBucketUpperMs(DNS_LATENCY_BUCKETS - 1), UINT32_MAX);
+    EXPECT_EQ(DnsResolverStats::GetOutcome(0), DNS_OUTCOME_SUCCESS);
+    EXPECT_EQ(DnsResolverStats::GetOutcome(EAI_NONAME), DNS_OUTCOME_NXDOMAIN);
+#ifdef EAI_NODATA
+    EXPECT_EQ(DnsResolverStats::GetOutcome(EAI_NODATA), DNS_OUTCOME_NXDOMAIN);
+#endif
+    EXPECT_EQ(DnsResolverStats::GetOutcome(EAI_AGAIN), DNS_OUTCOME_TIMEOUT);
+    EXPECT_EQ(DnsResolverStats::GetOutcome(EAI_FAIL), DNS_OUTCOME_SERVFAIL);
+    EXPECT_EQ(DnsResolverStats::GetOutcome(DNS_ERROR), DNS_OUTCOME_ERROR);
+}
+
+/**
+ * @tc.name: DnsResolverStats002
+ * @tc.desc: Concurrent recording loses no count, networks are kept apart and removed on their own
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverStatsTest, DnsResolverStats002, TestSize.Level1)
+{
+    constexpr uint32_t threadCount = 8;
+    constexpr uint32_t recordsPerThread = 10000;
+    DnsResolverStats stats;
+    std::shared_ptr<DnsServerCounters> counters = stats.GetCounters(TEST_NETID, TEST_SERVER);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([&counters]() {
+            for (uint32_t i = 0; i < recordsPerThread; i++) {
+                counters->RecordQuery();
+                counters->RecordOutcome(DNS_OUTCOME_SUCCESS, i % 8);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    stats.Record(TEST_NETID + 1, "", DNS_OUTCOME_SUCCESS, 1);
+    std::vector<DnsServerStats> result;
+    stats.GetStats(TEST_NETID, result);
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result[0].queries_, threadCount * recordsPerThread);
+    EXPECT_EQ(result[0].successes_, threadCount * recordsPerThread);
+    uint64_t histogramTotal = 0;
+    for (uint64_t count : result[0].latencyBuckets_) {
+        histogramTotal += count;
+    }
+    EXPECT_EQ(histogramTotal, threadCount * recordsPerThread);
+
+    stats.Remove(TEST_NETID);
+    result.clear();
+    stats.GetStats(TEST_NETID, result);
+    EXPECT_TRUE(result.empty());
+    stats.GetStats(TEST_NETID + 1, result);
+    EXPECT_EQ(result.size(), 1);
+    /* A query still holding the counters of a removed network keeps working */
+    counters->RecordQuery();
+    EXPECT_EQ(counters->queries, threadCount * recordsPerThread + 1);
+}
+
+/**
+ * @tc.name: DnsResolverStats003
+ * @tc.desc: The stats survive the parcel and the dump names every server with its histogram
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsResolverStatsTest, DnsResolverStats003, TestSize.Level1)
+{
+    DnsResolverStats stats;
+    stats.Record(TEST_NETID, TEST_SERVER, DNS_OUTCOME_SUCCESS, 20);
+    stats.Record(TEST_NETID, "", DNS_OUTCOME_TIMEOUT, 0);
+    std::vector<DnsServerStats> result;
+    stats.GetStats(TEST_NETID, result);
+    ASSERT_EQ(result.size(), 2);
+    MessageParcel parcel;
+    ASSERT_TRUE(result[1].Marshalling(parcel));
+    sptr<DnsServerStats> read = DnsServerStats::Unmarshalling(parcel);
+    ASSERT_NE(read, nullptr);
+    EXPECT_EQ(read->server_, TEST_SERVER);
+    EXPECT_EQ(read->queries_, 1);
+    EXPECT_EQ(read->latencyBuckets_, result[1].latencyBuckets_);
+
+    std::string info;
+    stats.Dump(info);
+    EXPECT_NE(info.find("netId 100 server system: queries 1 successes 0 timeouts 1"), std::string::npos);
+    EXPECT_NE(info.find("netId 100 server 192.0.2.53: queries 1 successes 1"), std::string::npos);
+    EXPECT_NE(info.find(" <32:1"), std::string::npos);
+    EXPECT_NE(info.find(" >=2048:0"), std::string::npos);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
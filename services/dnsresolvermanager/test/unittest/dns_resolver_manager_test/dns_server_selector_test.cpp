@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dns_server_selector.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+constexpr uint16_t TEST_NETID = 100;
+constexpr uint32_t TIMEOUT_MS = 1000;
+const std::vector<std::string> SERVERS = {"192.0.2.1", "192.0.2.2", "192.0.2.3"};
+
+std::vector<size_t> GetOrder(DnsServerSelector &selector)
+{
+    std::vector<size_t> order;
+    selector.Order(TEST_NETID, SERVERS, TIMEOUT_MS, order);
+    return order;
+}
+} // namespace
+
+class DnsServerSelectorTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void DnsServerSelectorTest::SetUpTestCase() {}
+
+void DnsServerSelectorTest::TearDownTestCase() {}
+
+void DnsServerSelectorTest::SetUp() {}
+
+void DnsServerSelectorTest::TearDown() {}
+
+/**
+ * @tc.name: DnsServerSelector001
+ * @tc.desc: Unmeasured servers keep the configured order, measured ones are ranked by smoothed round trip time
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsServerSelectorTest, DnsServerSelector001, TestSize.Level1)
+{
+    DnsServerSelector selector(0);
+    EXPECT_EQ(GetOrder(selector), std::vector<size_t>({0, 1, 2}));
+    selector.Record(TEST_NETID, SERVERS[0], DNS_OUTCOME_SUCCESS, 80);
+    selector.Record(TEST_NETID, SERVERS[1], DNS_OUTCOME_SUCCESS, 40);
+    selector.Record(TEST_NETID, SERVERS[2], DNS_OUTCOME_NXDOMAIN, 10);
+    EXPECT_EQ(GetOrder(selector), std::vector<size_t>({2, 1, 0}));
+
+    /* One slow answer moves the estimate by an eighth only */
+    selector.Record(TEST_NETID, SERVERS[2], DNS_OUTCOME_SUCCESS, 250);
+    DnsServerHealth health;
+    ASSERT_TRUE(selector.GetHealth(TEST_NETID, SERVERS[2], health));
+    EXPECT_EQ(health.srttMs, 40);
+    EXPECT_EQ(health.rttVarMs, 63);
+    EXPECT_EQ(GetOrder(selector), std::vector<size_t>({1, 2, 0}));
+
+    /* A single timeout costs a share of the timeout in the ranking but the server is still tried */
+    selector.Record(TEST_NETID, SERVERS[1], DNS_OUTCOME_TIMEOUT, TIMEOUT_MS);
+    EXPECT_EQ(GetOrder(selector), std::vector<size_t>({2, 0, 1}));
+    ASSERT_TRUE(selector.GetHealth(TEST_NETID, SERVERS[1], health));
+    EXPECT_EQ(health.consecutiveFailures, 1);
+    EXPECT_EQ(health.backoffMs, 0);
+}
+
+/**
+ * @tc.name: DnsServerSelector002
+ * @tc.desc: A server failing in a row is skipped with a growing backoff until it answers again
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsServerSelectorTest, DnsServerSelector002, TestSize.Level1)
+{
+    DnsServerSelector selector(0);
+    selector.Record(TEST_NETID, SERVERS[0], DNS_OUTCOME_SUCCESS, 1);
+    selector.Record(TEST_NETID, SERVERS[1], DNS_OUTCOME_SUCCESS, 5);
+    selector.Record(TEST_NETID, SERVERS[2], DNS_OUTCOME_SUCCESS, 5);
+    selector.Record(TEST_NETID, SERVERS[0], DNS_OUTCOME_TIMEOUT, TIMEOUT_MS);
+    selector.Record(TEST_NETID, SERVERS[0], DNS_OUTCOME_SERVFAIL, 1);
+    DnsServerHealth health;
+    ASSERT_TRUE(selector.GetHealth(TEST_NETID, SERVERS[0], health));
+    uint32_t firstBackoff = health.backoffMs;
+    EXPECT_GT(firstBackoff, 0);
+    EXPECT_EQ(GetOrder(selector), std::vector<size_t>({1, 2, 0}));
+    selector.Record(TEST_NETID, SERVERS[0], DNS_OUTCOME_ERROR, 1);
+    ASSERT_TRUE(selector.GetHealth(TEST_NETID, SERVERS[0], health));
+    EXPECT_EQ(health.backoffMs, firstBackoff * 2);
+
+    /* Skipped servers are still tried last, in the order they come back */
+    selector.Record(TEST_NETID, SERVERS[2], DNS_OUTCOME_TIMEOUT, TIMEOUT_MS);
+    selector.Record(TEST_NETID, SERVERS[2], DNS_OUTCOME_TIMEOUT, TIMEOUT_MS);
+    EXPECT_EQ(GetOrder(selector), std::vector<size_t>({1, 2, 0}));
+
+    selector.Record(TEST_NETID, SERVERS[0], DNS_OUTCOME_SUCCESS, 1);
+    ASSERT_TRUE(selector.GetHealth(TEST_NETID, SERVERS[0], health));
+    EXPECT_EQ(health.backoffMs, 0);
+    /* Back in the rotation, behind the server that never failed until its failure rate decays */
+    EXPECT_EQ(GetOrder(selector), std::vector<size_t>({1, 0, 2}));
+
+    std::string info;
+    selector.Dump(info);
+    EXPECT_NE(info.find("netId 100 server 192.0.2.3: srtt 5ms"), std::string::npos);
+    selector.Remove(TEST_NETID);
+    EXPECT_FALSE(selector.GetHealth(TEST_NETID, SERVERS[0], health));
+}
+
+/**
+ * @tc.name: DnsServerSelector003
+ * @tc.desc: About one query in the probe interval starts on another live server, a skipped one is never probed
+ * @tc.type: FUNC
+ */
+HWTEST_F(DnsServerSelectorTest, DnsServerSelector003, TestSize.Level1)
+{
+    constexpr uint32_t probeOneIn = 4;
+    constexpr uint32_t orders = 4000;
+    DnsServerSelector selector(probeOneIn);
+    selector.Record(TEST_NETID, SERVERS[0], DNS_OUTCOME_SUCCESS, 1);
+    selector.Record(TEST_NETID, SERVERS[1], DNS_OUTCOME_SUCCESS, 5);
+    selector.Record(TEST_NETID, SERVERS[2], DNS_OUTCOME_TIMEOUT, TIMEOUT_MS);
+    selector.Record(TEST_NETID, SERVERS[2], DNS_OUTCOME_TIMEOUT, TIMEOUT_MS);
+    uint32_t probes = 0;
+    for (uint32_t i = 0; i < orders; i++) {
+        std::vector<size_t> order = GetOrder(selector);
+        ASSERT_EQ(order.size(), SERVERS.size());
+        EXPECT_EQ(order[2], 2);
+        probes += (order[0] == 1) ? 1 : 0;
+    }
+    EXPECT_GT(probes, orders / probeOneIn / 2);
+    EXPECT_LT(probes, orders / probeOneIn * 2);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
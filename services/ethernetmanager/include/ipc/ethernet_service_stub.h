@@ -16,15 +16,13 @@
 #ifndef ETHERNET_SERVICE_STUB_H
 #define ETHERNET_SERVICE_STUB_H
 
-#include <map>
 #include "iremote_stub.h"
 #include "i_ethernet_service.h"
+#include "ipc_stub_dispatch_table.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
 class EthernetServiceStub : public IRemoteStub<IEthernetService> {
-    using EthernetServiceFunc = int32_t (EthernetServiceStub::*)(MessageParcel &, MessageParcel &);
-
 public:
     EthernetServiceStub();
     ~EthernetServiceStub();
@@ -38,7 +36,8 @@ private:
     int32_t OnGetActivateInterfaces(MessageParcel &data, MessageParcel &reply);
 
 private:
-    std::map<uint32_t, EthernetServiceFunc> memberFuncMap_;
+    using DispatchTable = IpcStubDispatchTable<EthernetServiceStub, CMD_GET_ACTIVATE_INTERFACE + 1>;
+    static const DispatchTable &GetDispatchTable();
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
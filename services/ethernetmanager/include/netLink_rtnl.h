@@ -16,7 +16,6 @@
 #ifndef NETLINK_RTNL_H
 #define NETLINK_RTNL_H
 
-#include <list>
 #include <vector>
 
 #include <arpa/inet.h>
@@ -28,7 +27,9 @@
 #include <linux/route.h>
 #include <linux/rtnetlink.h>
 
+#include "netlink_event_loop.h"
 #include "nlk_event_handle.h"
+#include "nlk_event_pipeline.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
@@ -36,15 +37,23 @@ constexpr int32_t NLK_SOCK_BUF_LEN = 20480;
 constexpr int32_t NLK_BUFF_LEN = 2048;
 constexpr int32_t NLK_HWADDR_BUF_LEN = 16;
 constexpr int32_t NLK_HWADDR_LEN = 6;
-constexpr int32_t NLK_TV_SEC = 5;
-constexpr int32_t NLK_TV_USEC = 0;
+constexpr int32_t NLK_EVENT_SOCK_BUF_LEN = 1024 * 1024;
+constexpr int32_t NLK_DUMP_TIMEOUT_MS = 1000;
 class NetLinkRtnl {
 public:
     NetLinkRtnl();
     ~NetLinkRtnl();
-    void NetLinkListenerThead();
     void Init();
     void RegisterHandle(sptr<NlkEventHandle> h);
+    NlkEventPipelineStats GetEventStats() const;
+
+    /**
+     * @brief Attach a socket filter so the kernel only queues RTM_NEWLINK and RTM_DELLINK of ethernet links
+     *
+     * @param fd The netlink socket
+     * @return Returns false if the filter could not be attached
+     */
+    static bool AttachLinkFilter(int32_t fd);
     static int32_t SetIpAddr(const std::string &ifName, const std::string &ip);
     static std::vector<uint8_t> GetHWaddr(const std::string &devName);
     static void GetLinkInfo(std::vector<NlkEventInfo> &infos);
@@ -52,14 +61,16 @@ public:
 private:
     static int32_t CreateNetLinkSocket();
     static int32_t NetLinkSendMsg(int32_t fd, struct nlmsghdr &nlh);
-    static void ProcessReadMsg(std::unique_ptr<int8_t> &pBuff, int32_t len, std::vector<NlkEventInfo> &infos);
+    static bool ProcessReadMsg(const int8_t *buff, int32_t len, std::vector<NlkEventInfo> &infos);
     static NlkEventInfo ProcessLinkMsg(const struct nlmsghdr &nh);
-    int NetLinkHandle(int32_t netLinkSocket, fd_set& rdSet, struct timeval& timeout);
     void ProcessIfInfoMsg(const struct nlmsghdr &nh);
-    void ProcessLinkEventMsg(std::unique_ptr<int8_t> &pBuff, int32_t len);
+    void ProcessLinkEventMsg(const struct nlmsghdr &nh);
+    void ResyncLinkInfo();
 
 private:
-    std::list<sptr<NlkEventHandle>> nlkHandles_;
+    /* The loop posts into the pipeline, so it is declared last and stopped first */
+    NlkEventPipeline pipeline_;
+    NetlinkEventLoop eventLoop_;
     static int32_t seq_;
 };
 } // namespace NetManagerStandard
@@ -18,6 +18,8 @@
 
 #include <string>
 
+#include <linux/rtnetlink.h>
+
 #include "refbase.h"
 
 namespace OHOS {
@@ -25,6 +27,7 @@ namespace NetManagerStandard {
 struct NlkEventInfo {
     std::string iface_;
     uint64_t ifiFlags_ = 0;
+    uint16_t nlmsgType_ = RTM_NEWLINK;
 };
 
 class NlkEventHandle : public virtual RefBase {
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NLK_EVENT_PIPELINE_H
+#define NLK_EVENT_PIPELINE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "nlk_event_handle.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+struct NlkEventPipelineStats {
+    uint64_t received = 0;
+    uint64_t filtered = 0;
+    uint64_t coalesced = 0;
+    uint64_t delivered = 0;
+};
+
+/**
+ * Stage between the netlink receive loop and the event handles. Only events changing IFF_UP or IFF_LOWER_UP of
+ * an interface are kept, a burst on one interface within the coalesce window collapses into its latest state, and
+ * the handles run on the pipeline worker so a slow handle never blocks the receive loop. RTM_DELLINK is always
+ * delivered, supersedes the burst still waiting on its interface and forgets the interface, so a link recreated
+ * under the same name is reported as new.
+ */
+class NlkEventPipeline {
+public:
+    static constexpr uint32_t DEFAULT_COALESCE_WINDOW_MS = 50;
+
+    explicit NlkEventPipeline(uint32_t coalesceWindowMs = DEFAULT_COALESCE_WINDOW_MS);
+    ~NlkEventPipeline();
+    NlkEventPipeline(const NlkEventPipeline &) = delete;
+    NlkEventPipeline &operator=(const NlkEventPipeline &) = delete;
+
+    void Start();
+
+    /**
+     * @brief Stop the worker, events still waiting for their window are dropped
+     */
+    void Stop();
+    void RegisterHandle(sptr<NlkEventHandle> h);
+    void SetCoalesceWindow(uint32_t coalesceWindowMs);
+
+    /**
+     * @brief Queue the event of an interface, never blocks on the handles
+     *
+     * @param info The interface, its flags and the netlink message type
+     */
+    void Post(const NlkEventInfo &info);
+    NlkEventPipelineStats GetStats() const;
+
+private:
+    void Run();
+    void PostRemoved(const NlkEventInfo &info);
+    void Deliver(const NlkEventInfo &info, std::unique_lock<std::mutex> &lock);
+
+    struct IfaceState {
+        uint64_t deliveredFlags = 0;
+        uint64_t pendingFlags = 0;
+        bool isDelivered = false;
+        bool isPending = false;
+    };
+    using Deadline = std::chrono::steady_clock::time_point;
+    /* A new link entry takes its flags from the interface state when it is due, a removal carries its own */
+    using QueuedEvent = std::pair<Deadline, NlkEventInfo>;
+
+private:
+    std::chrono::milliseconds coalesceWindow_;
+    std::unordered_map<std::string, IfaceState> ifaces_;
+    std::deque<QueuedEvent> queue_;
+    std::list<sptr<NlkEventHandle>> nlkHandles_;
+    NlkEventPipelineStats stats_;
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread worker_;
+    bool running_ = false;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NLK_EVENT_PIPELINE_H
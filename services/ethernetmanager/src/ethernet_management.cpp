@@ -177,10 +177,12 @@ void EthernetManagement::RegisterNlk(NetLinkRtnl &nlk)
 
 void EthernetManagement::Handle(const struct NlkEventInfo &info)
 {
-    bool up = static_cast<bool>(info.ifiFlags_ & IFF_UP);
-    bool lowerUp = static_cast<bool>(info.ifiFlags_ & IFF_LOWER_UP);
-    NETMGR_LOGI("EthernetManagement Handle info dev[%{public}s] up[%{public}d] lowerUp[%{public}d]",
-        info.iface_.c_str(), up, lowerUp);
+    /* A removed interface is down whatever flags its last message carried */
+    bool removed = info.nlmsgType_ == RTM_DELLINK;
+    bool up = !removed && static_cast<bool>(info.ifiFlags_ & IFF_UP);
+    bool lowerUp = !removed && static_cast<bool>(info.ifiFlags_ & IFF_LOWER_UP);
+    NETMGR_LOGI("EthernetManagement Handle info dev[%{public}s] up[%{public}d] lowerUp[%{public}d] removed[%{public}d]",
+        info.iface_.c_str(), up, lowerUp, removed);
     UpdateInterfaceState(info.iface_, up, lowerUp);
 }
 
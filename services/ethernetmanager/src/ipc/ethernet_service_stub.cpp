@@ -19,33 +19,34 @@
 
 namespace OHOS {
 namespace NetManagerStandard {
-EthernetServiceStub::EthernetServiceStub()
-{
-    memberFuncMap_[CMD_SET_IF_CFG] = &EthernetServiceStub::OnSetIfaceConfig;
-    memberFuncMap_[CMD_GET_IF_CFG] = &EthernetServiceStub::OnGetIfaceConfig;
-    memberFuncMap_[CMD_IS_ACTIVATE] = &EthernetServiceStub::OnIsActivate;
-    memberFuncMap_[CMD_GET_ACTIVATE_INTERFACE] = &EthernetServiceStub::OnGetActivateInterfaces;
-}
+EthernetServiceStub::EthernetServiceStub() {}
 
 EthernetServiceStub::~EthernetServiceStub() {}
 
+const EthernetServiceStub::DispatchTable &EthernetServiceStub::GetDispatchTable()
+{
+    /* constexpr so the table is built at compile time and a code past the table end fails to compile */
+    static constexpr DispatchTable table({
+        {CMD_SET_IF_CFG, &EthernetServiceStub::OnSetIfaceConfig},
+        {CMD_GET_IF_CFG, &EthernetServiceStub::OnGetIfaceConfig},
+        {CMD_IS_ACTIVATE, &EthernetServiceStub::OnIsActivate},
+        {CMD_GET_ACTIVATE_INTERFACE, &EthernetServiceStub::OnGetActivateInterfaces},
+    });
+    return table;
+}
+
 int32_t EthernetServiceStub::OnRemoteRequest(
     uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option)
 {
-    NETMGR_LOGI("stub call start, code = [%{public}d]", code);
-
     std::u16string myDescripter = EthernetServiceStub::GetDescriptor();
     std::u16string remoteDescripter = data.ReadInterfaceToken();
     if (myDescripter != remoteDescripter) {
         NETMGR_LOGE("descriptor checked fail");
         return NETMANAGER_ERR_DESCRIPTOR_MISMATCH;
     }
-    auto itFunc = memberFuncMap_.find(code);
-    if (itFunc != memberFuncMap_.end()) {
-        auto requestFunc = itFunc->second;
-        if (requestFunc != nullptr) {
-            return (this->*requestFunc)(data, reply);
-        }
+    auto requestFunc = GetDispatchTable().Find(code);
+    if (requestFunc != nullptr) {
+        return (this->*requestFunc)(data, reply);
     }
 
     NETMGR_LOGI("stub default case, need check");
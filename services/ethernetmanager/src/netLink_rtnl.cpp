@@ -15,7 +15,11 @@
 
 #include "netLink_rtnl.h"
 
-#include <thread>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <linux/filter.h>
+#include <poll.h>
 
 #include "securec.h"
 #include "net_mgr_log_wrapper.h"
@@ -30,120 +34,103 @@ NetLinkRtnl::NetLinkRtnl()
 
 NetLinkRtnl::~NetLinkRtnl() {}
 
-void NetLinkRtnl::NetLinkListenerThead()
+void NetLinkRtnl::Init()
 {
-    int32_t netLinkSocket = 0;
-    netLinkSocket = socket(AF_NETLINK, SOCK_RAW, NETLINK_ROUTE);
+    NETMGR_LOGI("NetLinkRtnl Init event loop start");
+    /* Only link state is consumed, the address and route groups are not joined at all */
+    int32_t netLinkSocket = NetlinkEventLoop::CreateSocket(NETLINK_ROUTE, RTMGRP_LINK, NLK_EVENT_SOCK_BUF_LEN);
     if (netLinkSocket < 0) {
-        NETMGR_LOGE("NetLinkRtnl NetLinkListenerThead netLinkSocket create socket failed");
-        return;
-    }
-    if (setsockopt(netLinkSocket, SOL_SOCKET, SO_RCVBUF, &NLK_SOCK_BUF_LEN, sizeof(NLK_SOCK_BUF_LEN)) != 0) {
-        NETMGR_LOGE("NetLinkRtnl NetLinkListenerThead setsockopt failed");
+        NETMGR_LOGE("NetLinkRtnl Init netLinkSocket create socket failed");
         return;
     }
-    struct sockaddr_nl sa;
-    bzero(&sa, sizeof(sa));
-    sa.nl_family = AF_NETLINK;
-    sa.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV4_ROUTE | RTMGRP_IPV6_IFADDR | RTMGRP_IPV6_ROUTE;
-    if (bind(netLinkSocket, (struct sockaddr *) &sa, sizeof(sa)) != 0) {
-        NETMGR_LOGE("NetLinkRtnl NetLinkListenerThead bind failed");
-        return;
+    if (!AttachLinkFilter(netLinkSocket)) {
+        NETMGR_LOGE("NetLinkRtnl Init attach filter failed, filter in user space");
     }
-    fd_set rdSet;
-    struct timeval timeout;
-    timeout.tv_sec = NLK_TV_SEC;
-    timeout.tv_usec = NLK_TV_USEC;
-    NETMGR_LOGI("NetLinkRtnl NetLinkListenerThead init suc, create netLinkSocket[%{public}d]", netLinkSocket);
-    while (true) {
-        FD_ZERO(&rdSet);
-        FD_SET(netLinkSocket, &rdSet);
-        NetLinkHandle(netLinkSocket, rdSet, timeout);
+    pipeline_.Start();
+    if (!eventLoop_.Start(netLinkSocket, [this](const struct nlmsghdr &nh) { ProcessLinkEventMsg(nh); },
+        [this]() { ResyncLinkInfo(); })) {
+        NETMGR_LOGE("NetLinkRtnl Init event loop start failed");
     }
 }
 
-void NetLinkRtnl::Init()
+void NetLinkRtnl::RegisterHandle(sptr<NlkEventHandle> h)
 {
-    NETMGR_LOGI("NetLinkRtnl Init thread start");
-    std::thread nlk(&NetLinkRtnl::NetLinkListenerThead, this);
-    nlk.detach();
-    return;
+    pipeline_.RegisterHandle(h);
 }
 
-void NetLinkRtnl::RegisterHandle(sptr<NlkEventHandle> h)
+NlkEventPipelineStats NetLinkRtnl::GetEventStats() const
 {
-    nlkHandles_.push_back(h);
-    NETMGR_LOGI("NetLinkRtnl RegisterHandle nlkHandles_ size[%{public}d]", nlkHandles_.size());
+    return pipeline_.GetStats();
+}
+
+bool NetLinkRtnl::AttachLinkFilter(int32_t fd)
+{
+    /* Classic BPF loads halfwords in network order, so the host order constants are compared through htons */
+    struct sock_filter code[] = {
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, offsetof(struct nlmsghdr, nlmsg_type)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, htons(RTM_NEWLINK), 1, 0),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, htons(RTM_DELLINK), 0, 3),
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, NLMSG_LENGTH(0) + offsetof(struct ifinfomsg, ifi_type)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, htons(ARPHRD_ETHER), 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, UINT32_MAX),
+        BPF_STMT(BPF_RET | BPF_K, 0),
+    };
+    struct sock_fprog prog = {
+        .len = sizeof(code) / sizeof(code[0]),
+        .filter = code,
+    };
+    return setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) == 0;
 }
 
 void NetLinkRtnl::ProcessIfInfoMsg(const struct nlmsghdr &nh)
 {
-    NETMGR_LOGI("NetLinkRtnl ProcessIfInfoMsg process");
-    int32_t len = 0;
-    struct rtattr *tb[IFLA_MAX + 1];
-    struct ifinfomsg *ifInfo = nullptr;
-    bzero(tb, sizeof(tb));
-    ifInfo = reinterpret_cast<struct ifinfomsg*>(NLMSG_DATA(&nh));
+    auto ifInfo = reinterpret_cast<const struct ifinfomsg *>(NLMSG_DATA(&nh));
     if (ifInfo->ifi_type != ARPHRD_ETHER) {
-        NETMGR_LOGE("NetLinkRtnl ProcessIfInfoMsg ifi_type is not ARPHRD_ETHER");
         return;
     }
-    len = nh.nlmsg_len - NLMSG_SPACE(sizeof(*ifInfo));
-    auto attr = IFLA_RTA(ifInfo);
-    for (; RTA_OK(attr, len); attr = RTA_NEXT(attr, len)) {
-        if (attr->rta_type <= IFLA_MAX) {
-            tb[attr->rta_type] = attr;
+    /* Only the name is needed, stop at the first IFLA_IFNAME instead of indexing every attribute */
+    NlkEventInfo info;
+    int32_t len = static_cast<int32_t>(nh.nlmsg_len - NLMSG_SPACE(sizeof(*ifInfo)));
+    for (auto attr = IFLA_RTA(ifInfo); RTA_OK(attr, len); attr = RTA_NEXT(attr, len)) {
+        if (attr->rta_type == IFLA_IFNAME) {
+            info.iface_ = std::string(reinterpret_cast<const char *>(RTA_DATA(attr)),
+                strnlen(reinterpret_cast<const char *>(RTA_DATA(attr)), RTA_PAYLOAD(attr)));
+            break;
         }
     }
-    NlkEventInfo info;
-    if (tb[IFLA_IFNAME]) {
-        info.iface_ = std::string(reinterpret_cast<char*>(RTA_DATA(tb[IFLA_IFNAME])));
+    if (info.iface_.empty()) {
+        return;
     }
     info.ifiFlags_ = ifInfo->ifi_flags;
-    for (auto it = nlkHandles_.begin(); it != nlkHandles_.end(); ++it) {
-        (*it)->Handle(info);
-    }
+    info.nlmsgType_ = nh.nlmsg_type;
+    pipeline_.Post(info);
 }
 
-void NetLinkRtnl::ProcessLinkEventMsg(std::unique_ptr<int8_t> &pBuff, int32_t len)
+void NetLinkRtnl::ProcessLinkEventMsg(const struct nlmsghdr &nh)
 {
-    struct nlmsghdr *nh = nullptr;
-    if (!pBuff) {
-        return;
-    }
-    for (nh = reinterpret_cast<struct nlmsghdr*>(pBuff.release()); NLMSG_OK(nh, len);
-        nh = NLMSG_NEXT(nh, len)) {
-        if (!nh) {
+    NETMGR_LOGI("NetLinkRtnl ProcessLinkEventMsg nh nlmsg_type[%{public}d]", nh.nlmsg_type);
+    switch (nh.nlmsg_type) {
+        case RTM_NEWLINK:
+        case RTM_DELLINK:
+            ProcessIfInfoMsg(nh);
             break;
-        }
-        NETMGR_LOGI("NetLinkRtnl ProcessLinkEventMsg nh nlmsg_type[%{public}d]", nh->nlmsg_type);
-        switch (nh->nlmsg_type) {
-            case RTM_NEWLINK:
-            case RTM_DELLINK:
-                ProcessIfInfoMsg(*nh);
-                break;
-            default:
-                break;
-        } // switch
-    } // for
+        default:
+            break;
+    }
 }
 
-int NetLinkRtnl::NetLinkHandle(int32_t netLinkSocket, fd_set& rdSet, struct timeval& timeout)
+void NetLinkRtnl::ResyncLinkInfo()
 {
-    int32_t selectFd = select(netLinkSocket + 1, &rdSet, nullptr, nullptr, &timeout);
-    if (selectFd < 0) {
-        NETMGR_LOGE("NetLinkRtnl NetLinkHandle select failed");
-        return ETHERNET_ERROR;
-    } else if (selectFd > 0) {
-        if (FD_ISSET(netLinkSocket, &rdSet)) {
-            int8_t buff[NLK_BUFF_LEN];
-            bzero(buff, sizeof(buff));
-            int readRet = read(netLinkSocket, buff, sizeof(buff));
-            std::unique_ptr<int8_t> pBuff(buff);
-            ProcessLinkEventMsg(pBuff, readRet);
-        } // if
-    } // else if
-    return ETHERNET_SUCCESS;
+    /* Link events were dropped by the kernel, replay the current state of every link to the handles */
+    std::vector<NlkEventInfo> infos;
+    GetLinkInfo(infos);
+    NETMGR_LOGI("NetLinkRtnl ResyncLinkInfo links size[%{public}zu]", infos.size());
+    for (const auto &info : infos) {
+        if (info.iface_.empty()) {
+            continue;
+        }
+        pipeline_.Post(info);
+    }
 }
 
 int32_t NetLinkRtnl::SetIpAddr(const std::string &ifName, const std::string &ip)
@@ -220,39 +207,51 @@ void NetLinkRtnl::GetLinkInfo(std::vector<NlkEventInfo> &infos)
     int32_t ret = NetLinkSendMsg(fd, req.nlh);
     if (ret < 0) {
         NETMGR_LOGE("NetLinkRtnl GetLinkInfo NetLinkSendMsg failed");
+        close(fd);
         return;
     }
-    int8_t buff[NLK_SOCK_BUF_LEN];
-    bzero(buff, sizeof(buff));
-    ret = read(fd, buff, sizeof(buff));
-    if (ret < 0) {
-        NETMGR_LOGE("read failed");
+    /* A dump spans several datagrams when there are many links, read until NLMSG_DONE */
+    std::vector<int8_t> buff(NLK_SOCK_BUF_LEN);
+    bool isDone = false;
+    while (!isDone) {
+        struct pollfd pfd = {.fd = fd, .events = POLLIN};
+        if (TEMP_FAILURE_RETRY(poll(&pfd, 1, NLK_DUMP_TIMEOUT_MS)) <= 0) {
+            NETMGR_LOGE("NetLinkRtnl GetLinkInfo wait dump timeout");
+            break;
+        }
+        ret = TEMP_FAILURE_RETRY(read(fd, buff.data(), buff.size()));
+        if (ret < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                continue;
+            }
+            NETMGR_LOGE("NetLinkRtnl GetLinkInfo read failed, errno[%{public}d]", errno);
+            break;
+        }
+        isDone = ProcessReadMsg(buff.data(), ret, infos);
     }
-    std::unique_ptr<int8_t> pBuff(buff);
-    ProcessReadMsg(pBuff, ret, infos);
+    close(fd);
 }
 
-void NetLinkRtnl::ProcessReadMsg(std::unique_ptr<int8_t> &pBuff, int32_t len, std::vector<NlkEventInfo> &infos)
+bool NetLinkRtnl::ProcessReadMsg(const int8_t *buff, int32_t len, std::vector<NlkEventInfo> &infos)
 {
-    struct nlmsghdr *nh = nullptr;
-    if (pBuff == nullptr) {
-            return;
+    if (buff == nullptr || len <= 0) {
+        return true;
     }
-    for (nh = reinterpret_cast<struct nlmsghdr*>(pBuff.release()); NLMSG_OK(nh, len);
-        nh = NLMSG_NEXT(nh, len)) {
-        if (!nh) {
-            break;
-        }
+    for (auto nh = reinterpret_cast<const struct nlmsghdr *>(buff); NLMSG_OK(nh, len); nh = NLMSG_NEXT(nh, len)) {
         NETMGR_LOGI("NetLinkRtnl ProcessReadMsg nh nlmsg_type[%{public}d]", nh->nlmsg_type);
         switch (nh->nlmsg_type) {
             case RTM_NEWLINK:
             case RTM_DELLINK:
                 infos.push_back(ProcessLinkMsg(*nh));
                 break;
+            case NLMSG_DONE:
+            case NLMSG_ERROR:
+                return true;
             default:
                 break;
         } // switch
     } // for
+    return false;
 }
 
 NlkEventInfo NetLinkRtnl::ProcessLinkMsg(const struct nlmsghdr &nh)
@@ -279,6 +278,7 @@ NlkEventInfo NetLinkRtnl::ProcessLinkMsg(const struct nlmsghdr &nh)
         info.iface_ = std::string(reinterpret_cast<char*>(RTA_DATA(tb[IFLA_IFNAME])));
     }
     info.ifiFlags_ = ifInfo->ifi_flags;
+    info.nlmsgType_ = nh.nlmsg_type;
     return info;
 }
 
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nlk_event_pipeline.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <linux/if.h>
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint64_t LINK_STATE_FLAGS = IFF_UP | IFF_LOWER_UP;
+} // namespace
+
+NlkEventPipeline::NlkEventPipeline(uint32_t coalesceWindowMs) : coalesceWindow_(coalesceWindowMs) {}
+
+NlkEventPipeline::~NlkEventPipeline()
+{
+    Stop();
+}
+
+void NlkEventPipeline::Start()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    worker_ = std::thread(&NlkEventPipeline::Run, this);
+}
+
+void NlkEventPipeline::Stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    cond_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (const auto &item : queue_) {
+        auto it = ifaces_.find(item.second.iface_);
+        if (item.second.nlmsgType_ != RTM_DELLINK && it != ifaces_.end()) {
+            it->second.isPending = false;
+        }
+    }
+    queue_.clear();
+}
+
+void NlkEventPipeline::RegisterHandle(sptr<NlkEventHandle> h)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    nlkHandles_.push_back(h);
+    NETMGR_LOGI("NlkEventPipeline RegisterHandle nlkHandles_ size[%{public}zu]", nlkHandles_.size());
+}
+
+void NlkEventPipeline::SetCoalesceWindow(uint32_t coalesceWindowMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    coalesceWindow_ = std::chrono::milliseconds(coalesceWindowMs);
+}
+
+void NlkEventPipeline::Post(const NlkEventInfo &info)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    stats_.received++;
+    if (info.nlmsgType_ == RTM_DELLINK) {
+        PostRemoved(info);
+        lock.unlock();
+        cond_.notify_one();
+        return;
+    }
+    IfaceState &state = ifaces_[info.iface_];
+    if (state.isPending) {
+        /* Already waiting for its window, only the latest state of the burst is delivered */
+        state.pendingFlags = info.ifiFlags_;
+        stats_.coalesced++;
+        return;
+    }
+    if (state.isDelivered && ((state.deliveredFlags ^ info.ifiFlags_) & LINK_STATE_FLAGS) == 0) {
+        stats_.filtered++;
+        return;
+    }
+    state.pendingFlags = info.ifiFlags_;
+    state.isPending = true;
+    NlkEventInfo queued;
+    queued.iface_ = info.iface_;
+    queue_.emplace_back(std::chrono::steady_clock::now() + coalesceWindow_, std::move(queued));
+    lock.unlock();
+    cond_.notify_one();
+}
+
+void NlkEventPipeline::PostRemoved(const NlkEventInfo &info)
+{
+    auto it = ifaces_.find(info.iface_);
+    if (it != ifaces_.end()) {
+        if (it->second.isPending) {
+            /* The interface is gone, its waiting burst would only report a link that no longer exists */
+            queue_.erase(std::find_if(queue_.begin(), queue_.end(), [&info](const QueuedEvent &item) {
+                return item.second.nlmsgType_ != RTM_DELLINK && item.second.iface_ == info.iface_;
+            }));
+            stats_.coalesced++;
+        }
+        ifaces_.erase(it);
+    }
+    queue_.emplace_back(std::chrono::steady_clock::now(), info);
+}
+
+NlkEventPipelineStats NlkEventPipeline::GetStats() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void NlkEventPipeline::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        if (queue_.empty()) {
+            cond_.wait(lock, [this]() { return !running_ || !queue_.empty(); });
+            continue;
+        }
+        Deadline deadline = queue_.front().first;
+        if (std::chrono::steady_clock::now() < deadline) {
+            cond_.wait_until(lock, deadline);
+            continue;
+        }
+        NlkEventInfo info = std::move(queue_.front().second);
+        queue_.pop_front();
+        if (info.nlmsgType_ == RTM_DELLINK) {
+            Deliver(info, lock);
+            continue;
+        }
+        IfaceState &state = ifaces_[info.iface_];
+        state.isPending = false;
+        /* The burst may have ended where it started */
+        if (state.isDelivered && ((state.deliveredFlags ^ state.pendingFlags) & LINK_STATE_FLAGS) == 0) {
+            stats_.filtered++;
+            continue;
+        }
+        state.deliveredFlags = state.pendingFlags;
+        state.isDelivered = true;
+        info.ifiFlags_ = state.pendingFlags;
+        Deliver(info, lock);
+    }
+}
+
+void NlkEventPipeline::Deliver(const NlkEventInfo &info, std::unique_lock<std::mutex> &lock)
+{
+    std::vector<sptr<NlkEventHandle>> handles(nlkHandles_.begin(), nlkHandles_.end());
+    stats_.delivered++;
+    lock.unlock();
+    for (auto &h : handles) {
+        h->Handle(info);
+    }
+    lock.lock();
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
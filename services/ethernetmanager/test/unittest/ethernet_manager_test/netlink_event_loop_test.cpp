@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <climits>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "netlink_event_loop.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+constexpr uint16_t TEST_MSG_TYPE = 16;
+constexpr uint32_t WAIT_TIMEOUT_MS = 5000;
+constexpr uint32_t WAIT_STEP_MS = 1;
+
+/* Build one datagram holding count empty netlink messages with consecutive sequence numbers */
+std::vector<uint8_t> MakeDatagram(uint32_t firstSeq, uint32_t count)
+{
+    std::vector<uint8_t> datagram(NLMSG_SPACE(0) * count);
+    for (uint32_t i = 0; i < count; i++) {
+        auto nh = reinterpret_cast<struct nlmsghdr *>(datagram.data() + NLMSG_SPACE(0) * i);
+        nh->nlmsg_len = NLMSG_LENGTH(0);
+        nh->nlmsg_type = TEST_MSG_TYPE;
+        nh->nlmsg_seq = firstSeq + i;
+    }
+    return datagram;
+}
+
+bool WaitFor(const std::atomic<uint32_t> &value, uint32_t expected)
+{
+    for (uint32_t i = 0; i < WAIT_TIMEOUT_MS / WAIT_STEP_MS && value < expected; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_STEP_MS));
+    }
+    return value >= expected;
+}
+
+int32_t FindLastEpollFd()
+{
+    int32_t found = -1;
+    DIR *dir = opendir("/proc/self/fd");
+    if (dir == nullptr) {
+        return found;
+    }
+    char target[PATH_MAX] = {0};
+    while (dirent *entry = readdir(dir)) {
+        std::string path = std::string("/proc/self/fd/") + entry->d_name;
+        ssize_t len = readlink(path.c_str(), target, sizeof(target) - 1);
+        if (len > 0 && std::string(target, len) == "anon_inode:[eventpoll]") {
+            found = std::max(found, std::atoi(entry->d_name));
+        }
+    }
+    closedir(dir);
+    return found;
+}
+} // namespace
+
+class NetlinkEventLoopTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+
+protected:
+    int32_t fds_[2] = {-1, -1};
+};
+
+void NetlinkEventLoopTest::SetUpTestCase() {}
+
+void NetlinkEventLoopTest::TearDownTestCase() {}
+
+void NetlinkEventLoopTest::SetUp()
+{
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds_), 0);
+}
+
+void NetlinkEventLoopTest::TearDown()
+{
+    /* fds_[0] is owned and closed by the loop */
+    if (fds_[1] >= 0) {
+        close(fds_[1]);
+    }
+}
+
+/**
+ * @tc.name: NetlinkEventLoop001
+ * @tc.desc: Every message of a datagram is dispatched in order
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetlinkEventLoopTest, NetlinkEventLoop001, TestSize.Level1)
+{
+    constexpr uint32_t msgCount = 8;
+    std::atomic<uint32_t> received = 0;
+    std::vector<uint32_t> seqs;
+    NetlinkEventLoop loop;
+    ASSERT_TRUE(loop.Start(fds_[0], [&](const struct nlmsghdr &nh) {
+        seqs.push_back(nh.nlmsg_seq);
+        received++;
+    }, nullptr));
+    std::vector<uint8_t> datagram = MakeDatagram(0, msgCount);
+    ASSERT_EQ(send(fds_[1], datagram.data(), datagram.size(), 0), static_cast<ssize_t>(datagram.size()));
+    ASSERT_TRUE(WaitFor(received, msgCount));
+    loop.Stop();
+    for (uint32_t i = 0; i < msgCount; i++) {
+        EXPECT_EQ(seqs[i], i);
+    }
+    NetlinkEventLoopStats stats = loop.GetStats();
+    EXPECT_EQ(stats.datagrams, 1);
+    EXPECT_EQ(stats.messages, msgCount);
+    EXPECT_FALSE(loop.IsRunning());
+}
+
+/**
+ * @tc.name: NetlinkEventLoop002
+ * @tc.desc: A burst queued before the loop starts is drained in batches of the preallocated buffers
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetlinkEventLoopTest, NetlinkEventLoop002, TestSize.Level1)
+{
+    constexpr uint32_t batchSize = 4;
+    constexpr uint32_t datagramCount = 64;
+    for (uint32_t i = 0; i < datagramCount; i++) {
+        std::vector<uint8_t> datagram = MakeDatagram(i, 1);
+        ASSERT_EQ(send(fds_[1], datagram.data(), datagram.size(), 0), static_cast<ssize_t>(datagram.size()));
+    }
+    std::atomic<uint32_t> received = 0;
+    std::atomic<uint32_t> outOfOrder = 0;
+    NetlinkEventLoop loop(batchSize);
+    ASSERT_TRUE(loop.Start(fds_[0], [&](const struct nlmsghdr &nh) {
+        if (nh.nlmsg_seq != received) {
+            outOfOrder++;
+        }
+        received++;
+    }, nullptr));
+    ASSERT_TRUE(WaitFor(received, datagramCount));
+    loop.Stop();
+    NetlinkEventLoopStats stats = loop.GetStats();
+    EXPECT_EQ(outOfOrder, 0);
+    EXPECT_EQ(stats.datagrams, datagramCount);
+    EXPECT_EQ(stats.batches, datagramCount / batchSize);
+    EXPECT_EQ(stats.wakeups, 1);
+}
+
+/**
+ * @tc.name: NetlinkEventLoop003
+ * @tc.desc: A datagram larger than a buffer is dropped and reported as an overflow
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetlinkEventLoopTest, NetlinkEventLoop003, TestSize.Level1)
+{
+    constexpr uint32_t bufferSize = 64;
+    std::atomic<uint32_t> received = 0;
+    std::atomic<uint32_t> overflows = 0;
+    NetlinkEventLoop loop(NetlinkEventLoop::DEFAULT_BATCH_SIZE, bufferSize);
+    ASSERT_TRUE(loop.Start(fds_[0], [&](const struct nlmsghdr &nh) { received++; }, [&]() { overflows++; }));
+    std::vector<uint8_t> large = MakeDatagram(0, bufferSize);
+    ASSERT_EQ(send(fds_[1], large.data(), large.size(), 0), static_cast<ssize_t>(large.size()));
+    ASSERT_TRUE(WaitFor(overflows, 1));
+    std::vector<uint8_t> small = MakeDatagram(0, 1);
+    ASSERT_EQ(send(fds_[1], small.data(), small.size(), 0), static_cast<ssize_t>(small.size()));
+    ASSERT_TRUE(WaitFor(received, 1));
+    loop.Stop();
+    NetlinkEventLoopStats stats = loop.GetStats();
+    EXPECT_EQ(stats.truncated, 1);
+    EXPECT_EQ(stats.messages, 1);
+}
+
+/**
+ * @tc.name: NetlinkEventLoop004
+ * @tc.desc: Stop wakes an idle loop and a stopped loop can not be started on a closed socket
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetlinkEventLoopTest, NetlinkEventLoop004, TestSize.Level1)
+{
+    NetlinkEventLoop loop;
+    ASSERT_TRUE(loop.Start(fds_[0], nullptr, nullptr));
+    EXPECT_TRUE(loop.IsRunning());
+    loop.Stop();
+    EXPECT_FALSE(loop.IsRunning());
+    loop.Stop();
+    EXPECT_FALSE(loop.Start(-1, nullptr, nullptr));
+}
+
+/**
+ * @tc.name: NetlinkEventLoop005
+ * @tc.desc: Throughput of a sustained burst of single message datagrams
+ * @tc.type: PERF
+ */
+HWTEST_F(NetlinkEventLoopTest, NetlinkEventLoop005, TestSize.Level2)
+{
+    constexpr uint32_t datagramCount = 200000;
+    std::atomic<uint32_t> received = 0;
+    NetlinkEventLoop loop;
+    ASSERT_TRUE(loop.Start(fds_[0], [&](const struct nlmsghdr &nh) { received++; }, nullptr));
+    std::vector<uint8_t> datagram = MakeDatagram(0, 1);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < datagramCount; i++) {
+        ASSERT_EQ(send(fds_[1], datagram.data(), datagram.size(), 0), static_cast<ssize_t>(datagram.size()));
+    }
+    ASSERT_TRUE(WaitFor(received, datagramCount));
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    loop.Stop();
+    NetlinkEventLoopStats stats = loop.GetStats();
+    std::cout << "NetlinkEventLoop " << datagramCount << " datagrams cost " << cost.count() << "us, "
+              << stats.batches << " batches, " << stats.wakeups << " wakeups" << std::endl;
+    EXPECT_LT(stats.batches, datagramCount);
+}
+
+/**
+ * @tc.name: NetlinkEventLoop006
+ * @tc.desc: A failing loop stops and reports it, Start brings it back on a new socket and leaves a running loop be
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetlinkEventLoopTest, NetlinkEventLoop006, TestSize.Level1)
+{
+    std::atomic<uint32_t> received = 0;
+    auto onMessage = [&received](const struct nlmsghdr &nh) { received++; };
+    NetlinkEventLoop loop;
+    ASSERT_TRUE(loop.Start(fds_[0], onMessage, nullptr));
+    std::vector<uint8_t> datagram = MakeDatagram(0, 1);
+    ASSERT_EQ(send(fds_[1], datagram.data(), datagram.size(), 0), static_cast<ssize_t>(datagram.size()));
+    ASSERT_TRUE(WaitFor(received, 1));
+
+    /* Swap the epoll descriptor for one epoll_wait rejects, the next datagram wakes the loop into the failure */
+    int32_t epollFd = FindLastEpollFd();
+    ASSERT_GE(epollFd, 0);
+    int32_t nullFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    ASSERT_GE(nullFd, 0);
+    ASSERT_EQ(dup2(nullFd, epollFd), epollFd);
+    close(nullFd);
+    ASSERT_EQ(send(fds_[1], datagram.data(), datagram.size(), 0), static_cast<ssize_t>(datagram.size()));
+    for (uint32_t i = 0; i < WAIT_TIMEOUT_MS / WAIT_STEP_MS && loop.IsRunning(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_STEP_MS));
+    }
+    EXPECT_FALSE(loop.IsRunning());
+
+    received = 0;
+    int32_t fds[2] = {-1, -1};
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds), 0);
+    ASSERT_TRUE(loop.Start(fds[0], onMessage, nullptr));
+    EXPECT_TRUE(loop.IsRunning());
+    ASSERT_EQ(send(fds[1], datagram.data(), datagram.size(), 0), static_cast<ssize_t>(datagram.size()));
+    EXPECT_TRUE(WaitFor(received, 1));
+
+    /* A second start keeps the running loop and its socket, the socket handed over is closed */
+    int32_t spare[2] = {-1, -1};
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, spare), 0);
+    EXPECT_TRUE(loop.Start(spare[0], onMessage, nullptr));
+    EXPECT_LT(send(spare[1], datagram.data(), datagram.size(), 0), 0);
+    ASSERT_EQ(send(fds[1], datagram.data(), datagram.size(), 0), static_cast<ssize_t>(datagram.size()));
+    EXPECT_TRUE(WaitFor(received, 2));
+    loop.Stop();
+    close(fds[1]);
+    close(spare[1]);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
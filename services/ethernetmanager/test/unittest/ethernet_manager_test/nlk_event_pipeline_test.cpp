@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <linux/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "netLink_rtnl.h"
+#include "nlk_event_pipeline.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+constexpr uint32_t WAIT_TIMEOUT_MS = 5000;
+constexpr uint32_t WAIT_STEP_MS = 1;
+constexpr uint32_t TEST_WINDOW_MS = 100;
+constexpr uint64_t LINK_UP = IFF_UP | IFF_LOWER_UP;
+constexpr uint64_t LINK_DOWN = IFF_UP;
+const std::string TEST_IFACE = "eth0";
+
+class TestNlkEventHandle : public NlkEventHandle {
+public:
+    explicit TestNlkEventHandle(uint32_t delayMs = 0) : delayMs_(delayMs) {}
+    void Handle(const struct NlkEventInfo &info) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delayMs_));
+        std::unique_lock<std::mutex> lock(mutex_);
+        infos_.push_back(info);
+        count_++;
+    }
+
+    bool WaitCount(uint32_t expected)
+    {
+        for (uint32_t i = 0; i < WAIT_TIMEOUT_MS / WAIT_STEP_MS && count_ < expected; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_STEP_MS));
+        }
+        return count_ >= expected;
+    }
+
+    std::vector<NlkEventInfo> GetInfos()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return infos_;
+    }
+
+private:
+    uint32_t delayMs_;
+    std::mutex mutex_;
+    std::vector<NlkEventInfo> infos_;
+    std::atomic<uint32_t> count_ = 0;
+};
+
+NlkEventInfo MakeInfo(const std::string &iface, uint64_t flags, uint16_t type = RTM_NEWLINK)
+{
+    NlkEventInfo info;
+    info.iface_ = iface;
+    info.ifiFlags_ = flags;
+    info.nlmsgType_ = type;
+    return info;
+}
+
+std::vector<uint8_t> MakeLinkMsg(uint16_t type, uint16_t ifiType)
+{
+    std::vector<uint8_t> msg(NLMSG_SPACE(sizeof(struct ifinfomsg)));
+    auto nh = reinterpret_cast<struct nlmsghdr *>(msg.data());
+    nh->nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+    nh->nlmsg_type = type;
+    auto ifInfo = reinterpret_cast<struct ifinfomsg *>(NLMSG_DATA(nh));
+    ifInfo->ifi_type = ifiType;
+    return msg;
+}
+} // namespace
+
+class NlkEventPipelineTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void NlkEventPipelineTest::SetUpTestCase() {}
+
+void NlkEventPipelineTest::TearDownTestCase() {}
+
+void NlkEventPipelineTest::SetUp() {}
+
+void NlkEventPipelineTest::TearDown() {}
+
+/**
+ * @tc.name: NlkEventPipeline001
+ * @tc.desc: Events that do not change IFF_UP or IFF_LOWER_UP are filtered
+ * @tc.type: FUNC
+ */
+HWTEST_F(NlkEventPipelineTest, NlkEventPipeline001, TestSize.Level1)
+{
+    sptr<TestNlkEventHandle> handle = (std::make_unique<TestNlkEventHandle>()).release();
+    NlkEventPipeline pipeline(0);
+    pipeline.RegisterHandle(handle);
+    pipeline.Start();
+    pipeline.Post(MakeInfo(TEST_IFACE, LINK_UP));
+    ASSERT_TRUE(handle->WaitCount(1));
+    pipeline.Post(MakeInfo(TEST_IFACE, LINK_UP | IFF_RUNNING));
+    pipeline.Post(MakeInfo(TEST_IFACE, LINK_DOWN));
+    ASSERT_TRUE(handle->WaitCount(2));
+    pipeline.Stop();
+    std::vector<NlkEventInfo> infos = handle->GetInfos();
+    ASSERT_EQ(infos.size(), 2);
+    EXPECT_EQ(infos[0].ifiFlags_, LINK_UP);
+    EXPECT_EQ(infos[1].ifiFlags_, LINK_DOWN);
+    NlkEventPipelineStats stats = pipeline.GetStats();
+    EXPECT_EQ(stats.received, 3);
+    EXPECT_EQ(stats.filtered, 1);
+    EXPECT_EQ(stats.delivered, 2);
+}
+
+/**
+ * @tc.name: NlkEventPipeline002
+ * @tc.desc: A burst on one interface collapses into its latest state, other interfaces are kept apart
+ * @tc.type: FUNC
+ */
+HWTEST_F(NlkEventPipelineTest, NlkEventPipeline002, TestSize.Level1)
+{
+    constexpr uint32_t burstSize = 100;
+    sptr<TestNlkEventHandle> handle = (std::make_unique<TestNlkEventHandle>()).release();
+    NlkEventPipeline pipeline(TEST_WINDOW_MS);
+    pipeline.RegisterHandle(handle);
+    pipeline.Start();
+    for (uint32_t i = 0; i < burstSize; i++) {
+        pipeline.Post(MakeInfo(TEST_IFACE, (i % 2 == 0) ? LINK_UP : LINK_DOWN));
+    }
+    pipeline.Post(MakeInfo("eth1", LINK_UP));
+    ASSERT_TRUE(handle->WaitCount(2));
+    pipeline.Stop();
+    std::vector<NlkEventInfo> infos = handle->GetInfos();
+    ASSERT_EQ(infos.size(), 2);
+    EXPECT_EQ(infos[0].iface_, TEST_IFACE);
+    EXPECT_EQ(infos[0].ifiFlags_, LINK_DOWN);
+    EXPECT_EQ(infos[1].iface_, "eth1");
+    NlkEventPipelineStats stats = pipeline.GetStats();
+    EXPECT_EQ(stats.received, burstSize + 1);
+    EXPECT_EQ(stats.coalesced, burstSize - 1);
+    EXPECT_EQ(stats.delivered, 2);
+}
+
+/**
+ * @tc.name: NlkEventPipeline003
+ * @tc.desc: A burst that ends in the delivered state is filtered when its window closes
+ * @tc.type: FUNC
+ */
+HWTEST_F(NlkEventPipelineTest, NlkEventPipeline003, TestSize.Level1)
+{
+    sptr<TestNlkEventHandle> handle = (std::make_unique<TestNlkEventHandle>()).release();
+    NlkEventPipeline pipeline(0);
+    pipeline.RegisterHandle(handle);
+    pipeline.Start();
+    pipeline.Post(MakeInfo(TEST_IFACE, LINK_UP));
+    ASSERT_TRUE(handle->WaitCount(1));
+    pipeline.SetCoalesceWindow(TEST_WINDOW_MS);
+    pipeline.Post(MakeInfo(TEST_IFACE, LINK_DOWN));
+    pipeline.Post(MakeInfo(TEST_IFACE, LINK_UP));
+    std::this_thread::sleep_for(std::chrono::milliseconds(TEST_WINDOW_MS * 2));
+    pipeline.Stop();
+    EXPECT_EQ(handle->GetInfos().size(), 1);
+    NlkEventPipelineStats stats = pipeline.GetStats();
+    EXPECT_EQ(stats.filtered, 1);
+    EXPECT_EQ(stats.coalesced, 1);
+    EXPECT_EQ(stats.delivered, 1);
+}
+
+/**
+ * @tc.name: NlkEventPipeline004
+ * @tc.desc: Time to post a burst of link events while the handle is slow
+ * @tc.type: PERF
+ */
+HWTEST_F(NlkEventPipelineTest, NlkEventPipeline004, TestSize.Level2)
+{
+    constexpr uint32_t handleDelayMs = 200;
+    constexpr uint32_t ifaceCount = 16;
+    sptr<TestNlkEventHandle> handle = (std::make_unique<TestNlkEventHandle>(handleDelayMs)).release();
+    NlkEventPipeline pipeline(0);
+    pipeline.RegisterHandle(handle);
+    pipeline.Start();
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ifaceCount; i++) {
+        pipeline.Post(MakeInfo("eth" + std::to_string(i), LINK_UP));
+    }
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    pipeline.Stop();
+    EXPECT_EQ(pipeline.GetStats().received, ifaceCount);
+    std::cout << "NlkEventPipeline post " << ifaceCount << " events with a " << handleDelayMs << "ms handle: "
+              << cost.count() << "us" << std::endl;
+    testing::Test::RecordProperty("NlkEventPipeline.post_burst_us", static_cast<int>(cost.count()));
+}
+
+/**
+ * @tc.name: NlkEventPipeline005
+ * @tc.desc: The socket filter only lets link messages of ethernet devices through
+ * @tc.type: FUNC
+ */
+HWTEST_F(NlkEventPipelineTest, NlkEventPipeline005, TestSize.Level1)
+{
+    int32_t fds[2] = {-1, -1};
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK, 0, fds), 0);
+    ASSERT_TRUE(NetLinkRtnl::AttachLinkFilter(fds[0]));
+    std::vector<std::vector<uint8_t>> msgs = {
+        MakeLinkMsg(RTM_NEWADDR, ARPHRD_ETHER),
+        MakeLinkMsg(RTM_NEWLINK, ARPHRD_LOOPBACK),
+        MakeLinkMsg(RTM_NEWLINK, ARPHRD_ETHER),
+        MakeLinkMsg(RTM_NEWROUTE, ARPHRD_ETHER),
+        MakeLinkMsg(RTM_DELLINK, ARPHRD_ETHER),
+    };
+    for (const auto &msg : msgs) {
+        send(fds[1], msg.data(), msg.size(), 0);
+    }
+    std::vector<uint16_t> types;
+    uint8_t buff[NLK_BUFF_LEN];
+    while (recv(fds[0], buff, sizeof(buff), 0) > 0) {
+        types.push_back(reinterpret_cast<struct nlmsghdr *>(buff)->nlmsg_type);
+    }
+    close(fds[0]);
+    close(fds[1]);
+    ASSERT_EQ(types.size(), 2);
+    EXPECT_EQ(types[0], RTM_NEWLINK);
+    EXPECT_EQ(types[1], RTM_DELLINK);
+}
+
+/**
+ * @tc.name: NlkEventPipeline006
+ * @tc.desc: A removed interface is reported even when its flags did not change, and supersedes its waiting burst
+ * @tc.type: FUNC
+ */
+HWTEST_F(NlkEventPipelineTest, NlkEventPipeline006, TestSize.Level1)
+{
+    sptr<TestNlkEventHandle> handle = (std::make_unique<TestNlkEventHandle>()).release();
+    NlkEventPipeline pipeline(0);
+    pipeline.RegisterHandle(handle);
+    pipeline.Start();
+    pipeline.Post(MakeInfo(TEST_IFACE, LINK_UP));
+    ASSERT_TRUE(handle->WaitCount(1));
+    pipeline.Post(MakeInfo(TEST_IFACE, LINK_UP, RTM_DELLINK));
+    ASSERT_TRUE(handle->WaitCount(2));
+    pipeline.SetCoalesceWindow(TEST_WINDOW_MS);
+    pipeline.Post(MakeInfo("eth1", LINK_UP));
+    pipeline.Post(MakeInfo("eth1", LINK_UP, RTM_DELLINK));
+    ASSERT_TRUE(handle->WaitCount(3));
+    std::this_thread::sleep_for(std::chrono::milliseconds(TEST_WINDOW_MS * 2));
+    pipeline.Stop();
+    std::vector<NlkEventInfo> infos = handle->GetInfos();
+    ASSERT_EQ(infos.size(), 3);
+    EXPECT_EQ(infos[1].iface_, TEST_IFACE);
+    EXPECT_EQ(infos[1].nlmsgType_, RTM_DELLINK);
+    EXPECT_EQ(infos[2].iface_, "eth1");
+    EXPECT_EQ(infos[2].nlmsgType_, RTM_DELLINK);
+    NlkEventPipelineStats stats = pipeline.GetStats();
+    EXPECT_EQ(stats.filtered, 0);
+    EXPECT_EQ(stats.coalesced, 1);
+    EXPECT_EQ(stats.delivered, 3);
+}
+
+/**
+ * @tc.name: NlkEventPipeline007
+ * @tc.desc: An interface recreated with the same name and flags after its removal is reported again
+ * @tc.type: FUNC
+ */
+HWTEST_F(NlkEventPipelineTest, NlkEventPipeline007, TestSize.Level1)
+{
+    sptr<TestNlkEventHandle> handle = (std::make_unique<TestNlkEventHandle>()).release();
+    NlkEventPipeline pipeline(0);
+    pipeline.RegisterHandle(handle);
+    pipeline.Start();
+    pipeline.Post(MakeInfo(TEST_IFACE, LINK_UP));
+    ASSERT_TRUE(handle->WaitCount(1));
+    pipeline.Post(MakeInfo(TEST_IFACE, LINK_UP, RTM_DELLINK));
+    pipeline.Post(MakeInfo(TEST_IFACE, LINK_UP));
+    ASSERT_TRUE(handle->WaitCount(3));
+    pipeline.Stop();
+    std::vector<NlkEventInfo> infos = handle->GetInfos();
+    ASSERT_EQ(infos.size(), 3);
+    EXPECT_EQ(infos[0].nlmsgType_, RTM_NEWLINK);
+    EXPECT_EQ(infos[1].nlmsgType_, RTM_DELLINK);
+    EXPECT_EQ(infos[2].nlmsgType_, RTM_NEWLINK);
+    EXPECT_EQ(infos[2].ifiFlags_, LINK_UP);
+    EXPECT_EQ(pipeline.GetStats().filtered, 0);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -16,11 +16,10 @@
 #ifndef NET_CONN_SERVICE_STUB_H
 #define NET_CONN_SERVICE_STUB_H
 
-#include <map>
-
 #include "iremote_stub.h"
 
 #include "i_net_conn_service.h"
+#include "ipc_stub_dispatch_table.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
@@ -32,9 +31,6 @@ public:
     int32_t OnRemoteRequest(
         uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override;
 
-private:
-    using NetConnServiceFunc = int32_t (NetConnServiceStub::*)(MessageParcel &, MessageParcel &);
-
 private:
     int32_t OnSystemReady(MessageParcel &data, MessageParcel &reply);
     int32_t OnRegisterNetSupplier(MessageParcel &data, MessageParcel &reply);
@@ -51,7 +47,8 @@ private:
     int32_t ConvertCode(int32_t internalCode);
 
 private:
-    std::map<uint32_t, NetConnServiceFunc> memberFuncMap_;
+    using DispatchTable = IpcStubDispatchTable<NetConnServiceStub, CMD_NM_END>;
+    static const DispatchTable &GetDispatchTable();
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
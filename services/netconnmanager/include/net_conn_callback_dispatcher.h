@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_CONN_CALLBACK_DISPATCHER_H
+#define NET_CONN_CALLBACK_DISPATCHER_H
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "singleton.h"
+
+#include "broadcast_manager.h"
+#include "i_net_conn_callback.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+struct NetConnDispatchStats {
+    uint64_t enqueued = 0;
+    uint64_t delivered = 0;
+    uint64_t coalesced = 0;
+    uint64_t dropped = 0;
+    uint32_t queueDepth = 0;
+    uint32_t maxQueueDepth = 0;
+};
+
+/**
+ * Delivers net connection state changes off the caller's thread. Every subscriber has its own queue that keeps
+ * only the latest state per service, a service being its net type and capability, and a subscriber is served by at most one worker at a time. A blocked binder
+ * peer holds one of the shared workers while the others keep serving everyone else; as many peers blocked at once
+ * as there are workers stall delivery to all subscribers until one of them returns.
+ */
+class NetConnCallbackDispatcher {
+    DECLARE_DELAYED_SINGLETON(NetConnCallbackDispatcher)
+public:
+    /**
+     * @brief Queue a state change for the callback, replacing a pending one of the same service
+     *
+     * @param callback The subscriber
+     * @param info The net connection state, its net type names the service together with netCapability
+     * @param netCapability The capability of the service whose state changed
+     */
+    void Notify(const sptr<INetConnCallback> &callback, const sptr<NetConnCallbackInfo> &info, uint64_t netCapability);
+
+    /**
+     * @brief Queue a common event broadcast, broadcasts are sent one by one in posting order
+     *
+     * @param info The broadcast information
+     * @param param The broadcast parameters
+     */
+    void Broadcast(const BroadcastInfo &info, const std::map<std::string, std::string> &param);
+
+    /**
+     * @brief Drop the pending state changes of one service for the callback
+     *
+     * @param callback The subscriber
+     * @param netType The net type of the service the subscriber unregistered from
+     * @param netCapability The capability of that service
+     */
+    void RemovePending(const sptr<INetConnCallback> &callback, int32_t netType, uint64_t netCapability);
+
+    /**
+     * @brief Block until every queued event has been delivered or dropped
+     *
+     * @param timeoutMs Max wait time in milliseconds
+     * @return Returns true if all queues are drained
+     */
+    bool WaitIdle(uint32_t timeoutMs);
+    NetConnDispatchStats GetStats();
+
+private:
+    struct PendingState {
+        uint64_t netCapability = 0;
+        sptr<NetConnCallbackInfo> info;
+    };
+
+    struct Subscriber {
+        sptr<INetConnCallback> callback;
+        std::vector<PendingState> pending;
+        bool scheduled = false;
+    };
+
+    struct BroadcastEvent {
+        BroadcastInfo info;
+        std::map<std::string, std::string> param;
+    };
+
+    void WorkerLoop();
+    void DeliverSubscriber(std::unique_lock<std::mutex> &lock, const std::shared_ptr<Subscriber> &subscriber);
+    void DeliverBroadcast(std::unique_lock<std::mutex> &lock);
+    void IncreaseDepth();
+    void DecreaseDepth(uint32_t count);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::condition_variable idleCond_;
+    bool stop_ = false;
+    uint32_t busyWorkers_ = 0;
+    std::unordered_map<IRemoteObject *, std::shared_ptr<Subscriber>> subscribers_;
+    std::deque<std::shared_ptr<Subscriber>> readyQueue_;
+    std::deque<BroadcastEvent> broadcasts_;
+    bool broadcasting_ = false;
+    NetConnDispatchStats stats_;
+    std::vector<std::thread> workers_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_CONN_CALLBACK_DISPATCHER_H
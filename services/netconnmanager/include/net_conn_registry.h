@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_CONN_REGISTRY_H
+#define NET_CONN_REGISTRY_H
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "net_service.h"
+#include "net_supplier.h"
+#include "network.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Suppliers, networks and services are read from every binder thread but only change on supplier registration and
+ * capability updates. Every update rebuilds an immutable snapshot of all indexes under the writer lock and
+ * publishes it with std::atomic_store, and every read loads the current snapshot with std::atomic_load and never
+ * takes the lock, so a lookup only ever sees a complete update. The snapshot only guards the indexes, a supplier or
+ * service reached through it guards its own state.
+ */
+class NetConnRegistry {
+public:
+    using NET_SERVICE_SNAPSHOT = std::shared_ptr<const std::vector<sptr<NetService>>>;
+
+    NetConnRegistry();
+
+    /**
+     * @brief Save the supplier and the network created for it
+     *
+     * @param supplier The network supplier
+     * @param network The network of the supplier
+     * @return Returns false if the supplier is null or the supplier id is already registered
+     */
+    bool AddSupplier(const sptr<NetSupplier> &supplier, const sptr<Network> &network);
+
+    /**
+     * @brief Remove the supplier, its network and every service created on that network
+     *
+     * @param supplierId The id of the network supplier
+     * @return Returns false if the supplier does not exist
+     */
+    bool RemoveSupplier(uint32_t supplierId);
+
+    /**
+     * @brief Find a supplier by its id, reads the snapshot without locking
+     */
+    sptr<NetSupplier> GetSupplier(uint32_t supplierId) const;
+
+    /**
+     * @brief Find a supplier by its network type and ident, reads the snapshot without locking
+     */
+    sptr<NetSupplier> GetSupplier(uint32_t netType, const std::string &ident) const;
+
+    /**
+     * @brief Find the network of a supplier, reads the snapshot without locking
+     */
+    sptr<Network> GetNetwork(uint32_t supplierId) const;
+
+    /**
+     * @brief Save the service, keyed by the netId of its network and its capability
+     *
+     * @param netId The id of the network the service runs on
+     * @param service The network service
+     * @return Returns false if the service is null or the key is already registered
+     */
+    bool AddService(int32_t netId, const sptr<NetService> &service);
+    bool RemoveService(int32_t netId, NetCapabilities netCapability);
+    void RemoveServicesByNetId(int32_t netId);
+
+    /**
+     * @brief Whether a service runs on the network with the capability, reads the snapshot without locking
+     */
+    bool IsServiceExist(int32_t netId, NetCapabilities netCapability) const;
+
+    /**
+     * @brief Find the service of the network with the capability, reads the snapshot without locking
+     */
+    sptr<NetService> GetService(int32_t netId, NetCapabilities netCapability) const;
+
+    /**
+     * @brief All services in registration order, the list stays valid after later registry updates
+     */
+    NET_SERVICE_SNAPSHOT GetServices() const;
+
+    /**
+     * @brief Number of suppliers, reads the snapshot without locking
+     */
+    size_t GetSupplierSize() const;
+
+    /**
+     * @brief Number of services, reads the snapshot without locking
+     */
+    size_t GetServiceSize() const;
+
+private:
+    struct SupplierKey {
+        uint32_t netType = 0;
+        std::string ident;
+        bool operator==(const SupplierKey &key) const
+        {
+            return netType == key.netType && ident == key.ident;
+        }
+    };
+
+    struct SupplierKeyHash {
+        size_t operator()(const SupplierKey &key) const
+        {
+            return std::hash<std::string>()(key.ident) ^ (static_cast<size_t>(key.netType) << 1);
+        }
+    };
+
+    /* Mixes the netId into the low bits, which the capability alone would leave the same for every network */
+    struct ServiceKeyHash {
+        size_t operator()(uint64_t key) const
+        {
+            constexpr uint32_t netIdShift = 32;
+            constexpr size_t netIdFactor = 31;
+            return static_cast<size_t>(key >> netIdShift) * netIdFactor + static_cast<uint32_t>(key);
+        }
+    };
+
+    struct SupplierEntry {
+        sptr<NetSupplier> supplier;
+        sptr<Network> network;
+        SupplierKey key;
+    };
+
+    /**
+     * Hash map updated by copy on write. It is split into shards so an update copies the shard of its key and
+     * shares all the others with the previous version, which keeps registering thousands of suppliers linear.
+     */
+    template <typename Key, typename Value, typename Hash = std::hash<Key>>
+    class SnapshotMap {
+    public:
+        SnapshotMap()
+        {
+            for (auto &shard : shards_) {
+                shard = std::make_shared<const Shard>();
+            }
+        }
+
+        const Value *Find(const Key &key) const
+        {
+            const Shard &shard = *shards_[ShardOf(key)];
+            auto it = shard.find(key);
+            return (it == shard.end()) ? nullptr : &it->second;
+        }
+
+        void Insert(const Key &key, const Value &value)
+        {
+            std::shared_ptr<const Shard> &shard = shards_[ShardOf(key)];
+            auto copy = std::make_shared<Shard>(*shard);
+            size_ += copy->emplace(key, value).second ? 1 : 0;
+            shard = std::move(copy);
+        }
+
+        void Erase(const Key &key)
+        {
+            std::shared_ptr<const Shard> &shard = shards_[ShardOf(key)];
+            auto copy = std::make_shared<Shard>(*shard);
+            size_ -= copy->erase(key);
+            shard = std::move(copy);
+        }
+
+        size_t Size() const
+        {
+            return size_;
+        }
+
+    private:
+        static constexpr size_t SHARD_COUNT = 64;
+        using Shard = std::unordered_map<Key, Value, Hash>;
+
+        static size_t ShardOf(const Key &key)
+        {
+            return Hash()(key) % SHARD_COUNT;
+        }
+
+        std::array<std::shared_ptr<const Shard>, SHARD_COUNT> shards_;
+        size_t size_ = 0;
+    };
+
+    /* What the readers see, a published snapshot is never changed, every update publishes a new one */
+    struct Snapshot {
+        SnapshotMap<uint32_t, SupplierEntry> suppliers;
+        SnapshotMap<SupplierKey, uint32_t, SupplierKeyHash> supplierIdents;
+        SnapshotMap<uint64_t, sptr<NetService>, ServiceKeyHash> services;
+        /* Registration order, for the callers that go through every service */
+        NET_SERVICE_SNAPSHOT serviceList;
+    };
+
+    static uint64_t MakeServiceKey(int32_t netId, NetCapabilities netCapability);
+    static bool RemoveServiceFrom(Snapshot &snapshot, int32_t netId, NetCapabilities netCapability);
+    void PublishLocked(std::shared_ptr<const Snapshot> snapshot);
+
+private:
+    /* Serializes the updates, the readers never take it */
+    std::mutex mutex_;
+    std::shared_ptr<const Snapshot> snapshot_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_CONN_REGISTRY_H
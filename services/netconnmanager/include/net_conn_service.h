@@ -16,15 +16,19 @@
 #ifndef NET_CONN_SERVICE_H
 #define NET_CONN_SERVICE_H
 
+#include <atomic>
+#include <condition_variable>
 #include <list>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "singleton.h"
 #include "system_ability.h"
 
 #include "ipc/net_conn_service_stub.h"
+#include "net_conn_registry.h"
 #include "net_service.h"
 #include "net_supplier.h"
 #include "network.h"
@@ -33,16 +37,14 @@
 namespace OHOS {
 namespace NetManagerStandard {
 constexpr uint32_t CONNECT_SERVICE_WAIT_TIME = 6000;
+constexpr uint32_t MAX_CONNECT_SERVICE_WAIT_TIME = 120000;
+constexpr uint32_t MAX_RECONNECT_SERVICE_TIMES = 8;
 class NetConnService : public SystemAbility,
                              public NetConnServiceStub,
                              public std::enable_shared_from_this<NetConnService> {
     DECLARE_DELAYED_SINGLETON(NetConnService)
     DECLARE_SYSTEM_ABILITY(NetConnService)
 
-    using NET_SERVICE_LIST = std::list<sptr<NetService>>;
-    using NET_NETWORK_LIST = std::list<sptr<Network>>;
-    using NET_SUPPLIER_LIST = std::list<sptr<NetSupplier>>;
-
 public:
     void OnStart() override;
     void OnStop() override;
@@ -138,20 +140,20 @@ public:
      * @return Returns 0, successfully update the network link attribute information, otherwise it will fail
      */
     int32_t UpdateNetLinkInfo(uint32_t supplierId, const sptr<NetLinkInfo> &netLinkInfo) override;
+
+    /**
+     * @brief Timer task of the reconnection, hands the blocking reconnect over to the reconnect thread so the
+     * shared timer wheel thread is never held by it
+     */
     static void ReConnectServiceTask();
 
 private:
     bool Init();
-    sptr<NetSupplier> GetNetSupplierFromList(
-        uint32_t netType, const std::string &ident);
-    sptr<NetSupplier> GetNetSupplierFromListById(uint32_t supplierId);
-    sptr<Network> GetNetworkFromListBySupplierId(uint32_t supplierId);
-    void DeleteSupplierFromListById(uint32_t supplierId);
-    void DeleteNetworkFromListBySupplierId(uint32_t supplierId);
-    bool DeleteServiceFromListByCap(int32_t netId, const NetCapabilities &netCapability);
-    void DeleteServiceFromListByNet(const Network &network);
-    bool IsServiceInList(int32_t netId, const NetCapabilities &netCapability) const;
+    void PostReConnectService();
+    void ReConnectLoop();
+    void RunReConnectService();
     int32_t ReConnectService();
+    void ScheduleReConnectService();
     void ThreadExitTask();
     int32_t NotifyNetConnStateChanged(const sptr<NetConnCallbackInfo> &info);
 
@@ -163,13 +165,20 @@ private:
 
     bool registerToService_;
     ServiceRunningState state_;
+    // Serializes supplier and capability updates; lookups and callback registration only go through registry_
+    std::mutex writeMutex_;
     sptr<NetService> defaultNetService_ = nullptr;
 
-    NET_SERVICE_LIST netServices_;
-    NET_NETWORK_LIST networks_;
-    NET_SUPPLIER_LIST netSupplier_;
+    NetConnRegistry registry_;
 
+    std::atomic<uint32_t> reConnectTimes_ = 0;
     Timer reConnectTimer_;
+    // Runs the reconnections posted by the timer, started on first use
+    std::mutex reConnectMutex_;
+    std::condition_variable reConnectCond_;
+    bool reConnectPending_ = false;
+    bool reConnectStop_ = false;
+    std::thread reConnectThread_;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -16,6 +16,7 @@
 #ifndef NET_SERVICE_H
 #define NET_SERVICE_H
 
+#include <atomic>
 #include <string>
 #include <mutex>
 #include <vector>
@@ -36,6 +37,10 @@ enum ServiceState {
     SERVICE_STATE_FAILURE = 7,
 };
 
+/**
+ * Reached from several threads through the registry snapshot, so the state is atomic and a connect or disconnect
+ * runs under connectMutex_ to keep its check and its transitions together.
+ */
 class NetService : public virtual RefBase {
 public:
     NetService(const std::string &ident, NetworkType networkType,
@@ -98,11 +103,13 @@ private:
 private:
     std::string ident_;
     NetworkType networkType_ = NET_TYPE_UNKNOWN;
-    ServiceState state_ = SERVICE_STATE_IDLE;
+    std::atomic<ServiceState> state_ {SERVICE_STATE_IDLE};
+    std::mutex connectMutex_;
 
     NetCapabilities netCapability_ = NET_CAPABILITIES_NONE;
     sptr<Network> network_;
 
+    std::mutex callbackMutex_;
     std::vector<sptr<INetConnCallback>> netConnCallback_;
 };
 } // namespace NetManagerStandard
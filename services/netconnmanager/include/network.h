@@ -16,6 +16,11 @@
 #ifndef NETWORK_H
 #define NETWORK_H
 
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "inet_addr.h"
 #include "net_link_info.h"
 #include "net_supplier.h"
@@ -23,6 +28,36 @@
 
 namespace OHOS {
 namespace NetManagerStandard {
+/* netd operations issued and skipped by UpdateNetLinkInfo because that part of the link did not change */
+struct NetLinkUpdateStats {
+    uint64_t updates = 0;
+    uint64_t interfaceSkipped = 0;
+    uint64_t routesAdded = 0;
+    uint64_t routesRemoved = 0;
+    uint64_t routesSkipped = 0;
+    uint64_t routeBatches = 0;
+    uint64_t routeBatchesFailed = 0;
+    uint64_t dnsApplied = 0;
+    uint64_t dnsSkipped = 0;
+    uint64_t mtuSkipped = 0;
+};
+
+/**
+ * The netd operations a link update issues, the default forwards them to NetdController. Replacing it keeps a
+ * test from touching the interfaces, routes and resolver of the host it runs on.
+ */
+class NetLinkNetd {
+public:
+    virtual ~NetLinkNetd() = default;
+    virtual int32_t AddInterface(int32_t netId, const std::string &iface);
+    virtual int32_t RemoveInterface(int32_t netId, const std::string &iface);
+    virtual int32_t ApplyRouteDelta(int32_t netId, const std::vector<Route> &removed,
+        const std::vector<Route> &added);
+    virtual int32_t SetResolverConfig(int32_t netId, const std::vector<std::string> &servers,
+        const std::vector<std::string> &domains);
+    virtual int32_t SetMtu(const std::string &iface, int32_t mtu);
+};
+
 class Network : public virtual RefBase {
 public:
     Network(sptr<NetSupplier> &supplier);
@@ -39,6 +74,14 @@ public:
     INetAddr GetDns() const;
     Route GetRoute() const;
     NetLinkInfo GetNetLinkInfo() const;
+    NetLinkUpdateStats GetLinkUpdateStats() const;
+
+    /**
+     * @brief Replace the sink of the netd operations of later link updates
+     *
+     * @param netd The sink, nullptr restores the default one
+     */
+    void SetNetLinkNetd(const std::shared_ptr<NetLinkNetd> &netd);
     int32_t GetNetId() const;
     sptr<NetSupplier> GetNetSupplier() const;
     bool UpdateNetSupplierInfo(const NetSupplierInfo &netSupplierInfo);
@@ -46,12 +89,15 @@ public:
     void SetConnected(bool connected);
     void SetConnecting(bool connecting);
     void UpdateInterfaces(const NetLinkInfo &netLinkInfo);
-    void UpdateRoutes(const NetLinkInfo &netLinkInfo);
+    bool UpdateRoutes(const NetLinkInfo &netLinkInfo);
     void UpdateDnses(const NetLinkInfo &netLinkInfo);
     void updateMtu(const NetLinkInfo &netLinkInfo);
 
 private:
+    mutable std::mutex netLinkMutex_;
     NetLinkInfo netLinkInfo_;
+    NetLinkUpdateStats linkUpdateStats_;
+    std::shared_ptr<NetLinkNetd> netd_ = std::make_shared<NetLinkNetd>();
     INetAddr ipAddr_;
     INetAddr dns_;
     Route route_;
@@ -20,29 +20,31 @@
 
 namespace OHOS {
 namespace NetManagerStandard {
-NetConnServiceStub::NetConnServiceStub()
-{
-    memberFuncMap_[CMD_NM_SYSTEM_READY]                 = &NetConnServiceStub::OnSystemReady;
-    memberFuncMap_[CMD_NM_REGISTER_NET_CONN_CALLBACK]   = &NetConnServiceStub::OnRegisterNetConnCallback;
-    memberFuncMap_[CMD_NM_REGISTER_NET_CONN_CALLBACK_BY_SPECIFIER] =
-        &NetConnServiceStub::OnRegisterNetConnCallbackBySpecifier;
-    memberFuncMap_[CMD_NM_UNREGISTER_NET_CONN_CALLBACK] = &NetConnServiceStub::OnUnregisterNetConnCallback;
-        memberFuncMap_[CMD_NM_UNREGISTER_NET_CONN_CALLBACK_BY_SPECIFIER] =
-        &NetConnServiceStub::OnUnregisterNetConnCallbackBySpecifier;
-    memberFuncMap_[CMD_NM_REG_NET_SUPPLIER]             = &NetConnServiceStub::OnRegisterNetSupplier;
-    memberFuncMap_[CMD_NM_UNREG_NETWORK]                = &NetConnServiceStub::OnUnregisterNetSupplier;
-    memberFuncMap_[CMD_NM_SET_NET_SUPPLIER_INFO]        = &NetConnServiceStub::OnUpdateNetSupplierInfo;
-    memberFuncMap_[CMD_NM_SET_NET_CAPABILTITES]         = &NetConnServiceStub::OnUpdateNetCapabilities;
-    memberFuncMap_[CMD_NM_SET_NET_LINK_INFO]            = &NetConnServiceStub::OnUpdateNetLinkInfo;
-}
+NetConnServiceStub::NetConnServiceStub() {}
 
 NetConnServiceStub::~NetConnServiceStub() {}
 
+const NetConnServiceStub::DispatchTable &NetConnServiceStub::GetDispatchTable()
+{
+    /* constexpr so the table is built at compile time and a code past the table end fails to compile */
+    static constexpr DispatchTable table({
+        {CMD_NM_SYSTEM_READY, &NetConnServiceStub::OnSystemReady},
+        {CMD_NM_REGISTER_NET_CONN_CALLBACK, &NetConnServiceStub::OnRegisterNetConnCallback},
+        {CMD_NM_REGISTER_NET_CONN_CALLBACK_BY_SPECIFIER, &NetConnServiceStub::OnRegisterNetConnCallbackBySpecifier},
+        {CMD_NM_UNREGISTER_NET_CONN_CALLBACK, &NetConnServiceStub::OnUnregisterNetConnCallback},
+        {CMD_NM_UNREGISTER_NET_CONN_CALLBACK_BY_SPECIFIER, &NetConnServiceStub::OnUnregisterNetConnCallbackBySpecifier},
+        {CMD_NM_REG_NET_SUPPLIER, &NetConnServiceStub::OnRegisterNetSupplier},
+        {CMD_NM_UNREG_NETWORK, &NetConnServiceStub::OnUnregisterNetSupplier},
+        {CMD_NM_SET_NET_SUPPLIER_INFO, &NetConnServiceStub::OnUpdateNetSupplierInfo},
+        {CMD_NM_SET_NET_CAPABILTITES, &NetConnServiceStub::OnUpdateNetCapabilities},
+        {CMD_NM_SET_NET_LINK_INFO, &NetConnServiceStub::OnUpdateNetLinkInfo},
+    });
+    return table;
+}
+
 int32_t NetConnServiceStub::OnRemoteRequest(
     uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option)
 {
-    NETMGR_LOGI("stub call start, code = [%{public}d]", code);
-
     std::u16string myDescripter = NetConnServiceStub::GetDescriptor();
     std::u16string remoteDescripter = data.ReadInterfaceToken();
     if (myDescripter != remoteDescripter) {
@@ -50,12 +52,9 @@ int32_t NetConnServiceStub::OnRemoteRequest(
         return ERR_FLATTEN_OBJECT;
     }
 
-    auto itFunc = memberFuncMap_.find(code);
-    if (itFunc != memberFuncMap_.end()) {
-        auto requestFunc = itFunc->second;
-        if (requestFunc != nullptr) {
-            return (this->*requestFunc)(data, reply);
-        }
+    auto requestFunc = GetDispatchTable().Find(code);
+    if (requestFunc != nullptr) {
+        return (this->*requestFunc)(data, reply);
     }
 
     NETMGR_LOGI("stub default case, need check");
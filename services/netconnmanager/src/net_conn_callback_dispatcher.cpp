@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "net_conn_callback_dispatcher.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t DISPATCH_WORKER_NUM = 2;
+constexpr size_t MAX_BROADCAST_QUEUE_SIZE = 128;
+} // namespace
+
+NetConnCallbackDispatcher::NetConnCallbackDispatcher()
+{
+    for (uint32_t i = 0; i < DISPATCH_WORKER_NUM; i++) {
+        workers_.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+NetConnCallbackDispatcher::~NetConnCallbackDispatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void NetConnCallbackDispatcher::Notify(const sptr<INetConnCallback> &callback, const sptr<NetConnCallbackInfo> &info,
+    uint64_t netCapability)
+{
+    if (callback == nullptr || info == nullptr) {
+        NETMGR_LOGE("callback or info is nullptr");
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    IRemoteObject *key = callback->AsObject().GetRefPtr();
+    auto &subscriber = subscribers_[key];
+    if (subscriber == nullptr) {
+        subscriber = std::make_shared<Subscriber>();
+        subscriber->callback = callback;
+    }
+    stats_.enqueued++;
+    auto it = std::find_if(subscriber->pending.begin(), subscriber->pending.end(),
+        [&info, netCapability](const PendingState &pending) {
+            return pending.info->netType_ == info->netType_ && pending.netCapability == netCapability;
+        });
+    if (it != subscriber->pending.end()) {
+        it->info = info;
+        stats_.coalesced++;
+        return;
+    }
+    PendingState state;
+    state.netCapability = netCapability;
+    state.info = info;
+    subscriber->pending.push_back(state);
+    IncreaseDepth();
+    if (!subscriber->scheduled) {
+        subscriber->scheduled = true;
+        readyQueue_.push_back(subscriber);
+        lock.unlock();
+        cond_.notify_one();
+    }
+}
+
+void NetConnCallbackDispatcher::Broadcast(const BroadcastInfo &info, const std::map<std::string, std::string> &param)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    stats_.enqueued++;
+    if (broadcasts_.size() >= MAX_BROADCAST_QUEUE_SIZE) {
+        NETMGR_LOGE("broadcast queue is full, drop the oldest one");
+        broadcasts_.pop_front();
+        DecreaseDepth(1);
+        stats_.dropped++;
+    }
+    BroadcastEvent event;
+    event.info = info;
+    event.param = param;
+    broadcasts_.push_back(event);
+    IncreaseDepth();
+    lock.unlock();
+    cond_.notify_one();
+}
+
+void NetConnCallbackDispatcher::RemovePending(const sptr<INetConnCallback> &callback, int32_t netType,
+    uint64_t netCapability)
+{
+    if (callback == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = subscribers_.find(callback->AsObject().GetRefPtr());
+    if (it == subscribers_.end()) {
+        return;
+    }
+    auto &pending = it->second->pending;
+    size_t size = pending.size();
+    pending.erase(std::remove_if(pending.begin(), pending.end(), [netType, netCapability](const PendingState &state) {
+        return state.info->netType_ == static_cast<uint32_t>(netType) && state.netCapability == netCapability;
+    }), pending.end());
+    uint32_t removed = static_cast<uint32_t>(size - pending.size());
+    DecreaseDepth(removed);
+    stats_.dropped += removed;
+    if (pending.empty() && !it->second->scheduled) {
+        subscribers_.erase(it);
+    }
+}
+
+bool NetConnCallbackDispatcher::WaitIdle(uint32_t timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return idleCond_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+        [this]() { return stats_.queueDepth == 0 && busyWorkers_ == 0; });
+}
+
+NetConnDispatchStats NetConnCallbackDispatcher::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void NetConnCallbackDispatcher::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cond_.wait(lock, [this]() {
+            return stop_ || !readyQueue_.empty() || (!broadcasts_.empty() && !broadcasting_);
+        });
+        if (stop_) {
+            return;
+        }
+        busyWorkers_++;
+        if (!broadcasts_.empty() && !broadcasting_) {
+            DeliverBroadcast(lock);
+        } else {
+            std::shared_ptr<Subscriber> subscriber = readyQueue_.front();
+            readyQueue_.pop_front();
+            DeliverSubscriber(lock, subscriber);
+        }
+        busyWorkers_--;
+        if (stats_.queueDepth == 0 && busyWorkers_ == 0) {
+            idleCond_.notify_all();
+        }
+    }
+}
+
+void NetConnCallbackDispatcher::DeliverSubscriber(std::unique_lock<std::mutex> &lock,
+    const std::shared_ptr<Subscriber> &subscriber)
+{
+    std::vector<PendingState> events;
+    events.swap(subscriber->pending);
+    DecreaseDepth(static_cast<uint32_t>(events.size()));
+    lock.unlock();
+    for (const auto &event : events) {
+        subscriber->callback->NetConnStateChanged(event.info);
+    }
+    lock.lock();
+    stats_.delivered += events.size();
+    if (!subscriber->pending.empty()) {
+        // New states arrived while delivering, requeue behind the other subscribers
+        readyQueue_.push_back(subscriber);
+        cond_.notify_one();
+        return;
+    }
+    subscriber->scheduled = false;
+    auto it = subscribers_.find(subscriber->callback->AsObject().GetRefPtr());
+    if (it != subscribers_.end() && it->second == subscriber) {
+        subscribers_.erase(it);
+    }
+}
+
+void NetConnCallbackDispatcher::DeliverBroadcast(std::unique_lock<std::mutex> &lock)
+{
+    broadcasting_ = true;
+    BroadcastEvent event = broadcasts_.front();
+    broadcasts_.pop_front();
+    DecreaseDepth(1);
+    lock.unlock();
+    DelayedSingleton<BroadcastManager>::GetInstance()->SendBroadcast(event.info, event.param);
+    lock.lock();
+    stats_.delivered++;
+    broadcasting_ = false;
+    if (!broadcasts_.empty()) {
+        cond_.notify_one();
+    }
+}
+
+void NetConnCallbackDispatcher::IncreaseDepth()
+{
+    stats_.queueDepth++;
+    if (stats_.queueDepth > stats_.maxQueueDepth) {
+        stats_.maxQueueDepth = stats_.queueDepth;
+    }
+}
+
+void NetConnCallbackDispatcher::DecreaseDepth(uint32_t count)
+{
+    stats_.queueDepth = (stats_.queueDepth > count) ? (stats_.queueDepth - count) : 0;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "net_conn_registry.h"
+
+#include <algorithm>
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t SERVICE_KEY_NET_ID_SHIFT = 32;
+} // namespace
+
+NetConnRegistry::NetConnRegistry()
+{
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->serviceList = std::make_shared<const std::vector<sptr<NetService>>>();
+    snapshot_ = std::move(snapshot);
+}
+
+uint64_t NetConnRegistry::MakeServiceKey(int32_t netId, NetCapabilities netCapability)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(netId)) << SERVICE_KEY_NET_ID_SHIFT) |
+        static_cast<uint32_t>(netCapability);
+}
+
+void NetConnRegistry::PublishLocked(std::shared_ptr<const Snapshot> snapshot)
+{
+    std::atomic_store(&snapshot_, std::move(snapshot));
+}
+
+bool NetConnRegistry::AddSupplier(const sptr<NetSupplier> &supplier, const sptr<Network> &network)
+{
+    if (supplier == nullptr) {
+        NETMGR_LOGE("supplier is nullptr");
+        return false;
+    }
+    uint32_t supplierId = supplier->GetSupplierId();
+    SupplierEntry entry;
+    entry.supplier = supplier;
+    entry.network = network;
+    entry.key.netType = static_cast<uint32_t>(supplier->GetNetSupplierType());
+    entry.key.ident = supplier->GetNetSupplierIdent();
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_ptr<const Snapshot> current = std::atomic_load(&snapshot_);
+    if (current->supplierIdents.Find(entry.key) != nullptr) {
+        NETMGR_LOGE("supplier ident[%{public}s] already exists", entry.key.ident.c_str());
+        return false;
+    }
+    if (current->suppliers.Find(supplierId) != nullptr) {
+        NETMGR_LOGE("supplierId[%{public}d] already exists", supplierId);
+        return false;
+    }
+    auto next = std::make_shared<Snapshot>(*current);
+    next->suppliers.Insert(supplierId, entry);
+    next->supplierIdents.Insert(entry.key, supplierId);
+    PublishLocked(std::move(next));
+    return true;
+}
+
+bool NetConnRegistry::RemoveSupplier(uint32_t supplierId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_ptr<const Snapshot> current = std::atomic_load(&snapshot_);
+    const SupplierEntry *entry = current->suppliers.Find(supplierId);
+    if (entry == nullptr) {
+        return false;
+    }
+    auto next = std::make_shared<Snapshot>(*current);
+    if (entry->network != nullptr) {
+        int32_t netId = entry->network->GetNetId();
+        for (uint32_t cap = NET_CAPABILITIES_INTERNET; cap < NET_CAPABILITIES_MAX; cap <<= 1) {
+            RemoveServiceFrom(*next, netId, static_cast<NetCapabilities>(cap));
+        }
+    }
+    next->supplierIdents.Erase(entry->key);
+    next->suppliers.Erase(supplierId);
+    PublishLocked(std::move(next));
+    return true;
+}
+
+sptr<NetSupplier> NetConnRegistry::GetSupplier(uint32_t supplierId) const
+{
+    std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&snapshot_);
+    const SupplierEntry *entry = snapshot->suppliers.Find(supplierId);
+    return (entry == nullptr) ? nullptr : entry->supplier;
+}
+
+sptr<NetSupplier> NetConnRegistry::GetSupplier(uint32_t netType, const std::string &ident) const
+{
+    SupplierKey key;
+    key.netType = netType;
+    key.ident = ident;
+    std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&snapshot_);
+    const uint32_t *supplierId = snapshot->supplierIdents.Find(key);
+    if (supplierId == nullptr) {
+        return nullptr;
+    }
+    const SupplierEntry *entry = snapshot->suppliers.Find(*supplierId);
+    return (entry == nullptr) ? nullptr : entry->supplier;
+}
+
+sptr<Network> NetConnRegistry::GetNetwork(uint32_t supplierId) const
+{
+    std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&snapshot_);
+    const SupplierEntry *entry = snapshot->suppliers.Find(supplierId);
+    return (entry == nullptr) ? nullptr : entry->network;
+}
+
+bool NetConnRegistry::AddService(int32_t netId, const sptr<NetService> &service)
+{
+    if (service == nullptr) {
+        NETMGR_LOGE("service is nullptr");
+        return false;
+    }
+    uint64_t key = MakeServiceKey(netId, service->GetNetCapability());
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_ptr<const Snapshot> current = std::atomic_load(&snapshot_);
+    if (current->services.Find(key) != nullptr) {
+        NETMGR_LOGE("service of netId[%{public}d] already exists", netId);
+        return false;
+    }
+    auto next = std::make_shared<Snapshot>(*current);
+    next->services.Insert(key, service);
+    auto serviceList = std::make_shared<std::vector<sptr<NetService>>>(*current->serviceList);
+    serviceList->push_back(service);
+    next->serviceList = std::move(serviceList);
+    PublishLocked(std::move(next));
+    return true;
+}
+
+bool NetConnRegistry::RemoveService(int32_t netId, NetCapabilities netCapability)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto next = std::make_shared<Snapshot>(*std::atomic_load(&snapshot_));
+    if (!RemoveServiceFrom(*next, netId, netCapability)) {
+        return false;
+    }
+    PublishLocked(std::move(next));
+    return true;
+}
+
+bool NetConnRegistry::RemoveServiceFrom(Snapshot &snapshot, int32_t netId, NetCapabilities netCapability)
+{
+    uint64_t key = MakeServiceKey(netId, netCapability);
+    const sptr<NetService> *service = snapshot.services.Find(key);
+    if (service == nullptr) {
+        return false;
+    }
+    auto serviceList = std::make_shared<std::vector<sptr<NetService>>>(*snapshot.serviceList);
+    serviceList->erase(std::remove(serviceList->begin(), serviceList->end(), *service), serviceList->end());
+    snapshot.serviceList = std::move(serviceList);
+    snapshot.services.Erase(key);
+    return true;
+}
+
+void NetConnRegistry::RemoveServicesByNetId(int32_t netId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto next = std::make_shared<Snapshot>(*std::atomic_load(&snapshot_));
+    for (uint32_t cap = NET_CAPABILITIES_INTERNET; cap < NET_CAPABILITIES_MAX; cap <<= 1) {
+        RemoveServiceFrom(*next, netId, static_cast<NetCapabilities>(cap));
+    }
+    PublishLocked(std::move(next));
+}
+
+bool NetConnRegistry::IsServiceExist(int32_t netId, NetCapabilities netCapability) const
+{
+    std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&snapshot_);
+    return snapshot->services.Find(MakeServiceKey(netId, netCapability)) != nullptr;
+}
+
+sptr<NetService> NetConnRegistry::GetService(int32_t netId, NetCapabilities netCapability) const
+{
+    std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&snapshot_);
+    const sptr<NetService> *service = snapshot->services.Find(MakeServiceKey(netId, netCapability));
+    return (service == nullptr) ? nullptr : *service;
+}
+
+NetConnRegistry::NET_SERVICE_SNAPSHOT NetConnRegistry::GetServices() const
+{
+    return std::atomic_load(&snapshot_)->serviceList;
+}
+
+size_t NetConnRegistry::GetSupplierSize() const
+{
+    return std::atomic_load(&snapshot_)->suppliers.Size();
+}
+
+size_t NetConnRegistry::GetServiceSize() const
+{
+    return std::atomic_load(&snapshot_)->services.Size();
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -34,7 +34,18 @@ NetConnService::NetConnService()
 {
 }
 
-NetConnService::~NetConnService() {}
+NetConnService::~NetConnService()
+{
+    reConnectTimer_.Stop();
+    {
+        std::lock_guard<std::mutex> lock(reConnectMutex_);
+        reConnectStop_ = true;
+    }
+    reConnectCond_.notify_all();
+    if (reConnectThread_.joinable()) {
+        reConnectThread_.join();
+    }
+}
 
 void NetConnService::OnStart()
 {
@@ -89,7 +100,8 @@ int32_t NetConnService::RegisterNetSupplier(uint32_t netType, const std::string
         return ERR_INVALID_NETORK_TYPE;
     }
 
-    sptr<NetSupplier> supplier = GetNetSupplierFromList(netType, ident);
+    std::unique_lock<std::mutex> lock(writeMutex_);
+    sptr<NetSupplier> supplier = registry_.GetSupplier(netType, ident);
     if (supplier != nullptr) {
         NETMGR_LOGI("supplier already exists.");
         return supplier->GetSupplierId();
@@ -109,36 +121,42 @@ int32_t NetConnService::RegisterNetSupplier(uint32_t netType, const std::string
         return ERR_NO_NETWORK;
     }
 
+    // save supplier, network to registry
+    if (!registry_.AddSupplier(supplier, network)) {
+        NETMGR_LOGE("add supplier to registry failed");
+        return ERR_NO_SUPPLIER;
+    }
+
     // create service by netCapabilities
     NetworkType type = static_cast<NetworkType>(netType);
     if (netCapabilities & NET_CAPABILITIES_INTERNET) {
-        auto service = std::make_unique<NetService>(ident, type, NET_CAPABILITIES_INTERNET, network).release();
-        if (service != nullptr) {
-            netServices_.push_back(service);
+        sptr<NetService> service =
+            std::make_unique<NetService>(ident, type, NET_CAPABILITIES_INTERNET, network).release();
+        if (service != nullptr && registry_.AddService(network->GetNetId(), service)) {
             defaultNetService_ = service;
         }
     }
 
     if (netCapabilities & NET_CAPABILITIES_MMS) {
-        auto service = std::make_unique<NetService>(ident, type, NET_CAPABILITIES_MMS, network).release();
+        sptr<NetService> service = std::make_unique<NetService>(ident, type, NET_CAPABILITIES_MMS, network).release();
         if (service != nullptr) {
-            netServices_.push_back(service);
+            registry_.AddService(network->GetNetId(), service);
         }
     }
+    NETMGR_LOGI("suppliers size[%{public}zu] services size[%{public}zu]",
+        registry_.GetSupplierSize(), registry_.GetServiceSize());
 
-    // save supplier, network to list
-    netSupplier_.push_back(supplier);
-    networks_.push_back(network);
-    NETMGR_LOGI("netSupplier_ size[%{public}d] networks_ size[%{public}d] netServices_ size[%{public}d]",
-        netSupplier_.size(), networks_.size(), netServices_.size());
+    sptr<NetService> defaultNetService = defaultNetService_;
+    lock.unlock();
 
-     // connect service
-    if (defaultNetService_ != nullptr) {
+    // connect service
+    if (defaultNetService != nullptr) {
         NETMGR_LOGI("service is connecting...");
-        int32_t result = defaultNetService_->ServiceConnect();
+        int32_t result = defaultNetService->ServiceConnect();
         if (result != ERR_SERVICE_REQUEST_SUCCESS) {
             NETMGR_LOGE("connect service failed, errCode: %{public}X", result);
-            reConnectTimer_.StartOnce(CONNECT_SERVICE_WAIT_TIME, NetConnService::ReConnectServiceTask);
+            reConnectTimes_ = 0;
+            ScheduleReConnectService();
         }
     }
 
@@ -146,52 +164,104 @@ int32_t NetConnService::RegisterNetSupplier(uint32_t netType, const std::string
 }
 
 void NetConnService::ReConnectServiceTask()
+{
+    DelayedSingleton<NetConnService>::GetInstance()->PostReConnectService();
+}
+
+void NetConnService::PostReConnectService()
+{
+    std::lock_guard<std::mutex> lock(reConnectMutex_);
+    if (reConnectStop_) {
+        return;
+    }
+    reConnectPending_ = true;
+    if (!reConnectThread_.joinable()) {
+        reConnectThread_ = std::thread([this]() { ReConnectLoop(); });
+    }
+    reConnectCond_.notify_one();
+}
+
+void NetConnService::ReConnectLoop()
+{
+    std::unique_lock<std::mutex> lock(reConnectMutex_);
+    while (true) {
+        reConnectCond_.wait(lock, [this]() { return reConnectStop_ || reConnectPending_; });
+        if (reConnectStop_) {
+            return;
+        }
+        reConnectPending_ = false;
+        lock.unlock();
+        RunReConnectService();
+        lock.lock();
+    }
+}
+
+void NetConnService::RunReConnectService()
 {
     NETMGR_LOGI("defaultNetService reConnectService start");
-    int32_t result = DelayedSingleton<NetConnService>::GetInstance()->ReConnectService();
+    int32_t result = ReConnectService();
     if (result != ERR_SERVICE_REQUEST_SUCCESS) {
         NETMGR_LOGE("service reconnection failed! errCode:%{public}d", result);
+        if (result == ERR_SERVICE_REQUEST_CONNECT_FAIL) {
+            ScheduleReConnectService();
+        }
         return;
     }
 
+    reConnectTimes_ = 0;
     NETMGR_LOGI("defaultNetService reConnectService successfully!");
 }
 
+void NetConnService::ScheduleReConnectService()
+{
+    uint32_t times = reConnectTimes_++;
+    if (times >= MAX_RECONNECT_SERVICE_TIMES) {
+        NETMGR_LOGE("service reconnection failed %{public}u times, give up", times);
+        return;
+    }
+    // Back off exponentially with jitter so repeated failures neither spin nor retry in lockstep
+    uint32_t delay = TimerWheel::GetBackoffDelay(CONNECT_SERVICE_WAIT_TIME, MAX_CONNECT_SERVICE_WAIT_TIME, times);
+    NETMGR_LOGI("reconnect service after %{public}u ms", delay);
+    reConnectTimer_.StartOnce(delay, NetConnService::ReConnectServiceTask);
+}
+
 int32_t NetConnService::ReConnectService()
 {
-    if (defaultNetService_ == nullptr) {
+    sptr<NetService> defaultNetService = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        defaultNetService = defaultNetService_;
+    }
+    if (defaultNetService == nullptr) {
         NETMGR_LOGE("default service is nullptr");
         return  ERR_SERVICE_NULL_PTR;
     }
-    if (defaultNetService_->IsConnected() || defaultNetService_->IsConnecting()) {
-        defaultNetService_->ServiceDisConnect();
+    if (defaultNetService->IsConnected() || defaultNetService->IsConnecting()) {
+        defaultNetService->ServiceDisConnect();
     }
     NETMGR_LOGI("service is connecting...");
-    return defaultNetService_->ServiceConnect();
+    return defaultNetService->ServiceConnect();
 }
 
 int32_t NetConnService::UnregisterNetSupplier(uint32_t supplierId)
 {
     NETMGR_LOGI("UnregisterNetSupplier supplierId[%{public}d]", supplierId);
-    // Remove supplier from the list based on supplierId
-    sptr<NetSupplier> supplier = GetNetSupplierFromListById(supplierId);
+    // Remove supplier, its network and services from the registry based on supplierId
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    sptr<NetSupplier> supplier = registry_.GetSupplier(supplierId);
     if (supplier == nullptr) {
         NETMGR_LOGE("supplier doesn't exist.");
         return ERR_NO_SUPPLIER;
     }
 
-    sptr<Network> network = GetNetworkFromListBySupplierId(supplierId);
+    sptr<Network> network = registry_.GetNetwork(supplierId);
+    registry_.RemoveSupplier(supplierId);
     if (network == nullptr) {
-        NETMGR_LOGE("GetNetworkFromListBySupplierId get error, network is nullptr");
-        DeleteSupplierFromListById(supplierId);
+        NETMGR_LOGE("network of supplier is nullptr");
         return ERR_NO_NETWORK;
     }
-
-    DeleteServiceFromListByNet(*network);
-    DeleteNetworkFromListBySupplierId(supplierId);
-    DeleteSupplierFromListById(supplierId);
-    NETMGR_LOGI("netSupplier_ size[%{public}d], networks_ size[%{public}d], netServices_ size[%{public}d]",
-                netSupplier_.size(), networks_.size(), netServices_.size());
+    NETMGR_LOGI("suppliers size[%{public}zu] services size[%{public}zu]",
+        registry_.GetSupplierSize(), registry_.GetServiceSize());
 
     return ERR_NONE;
 }
@@ -203,12 +273,13 @@ int32_t NetConnService::RegisterNetConnCallback(const sptr<INetConnCallback> &ca
         return ERR_SERVICE_NULL_PTR;
     }
 
-    if (netServices_.empty()) {
-        NETMGR_LOGE("netServices_ is empty");
+    NetConnRegistry::NET_SERVICE_SNAPSHOT netServices = registry_.GetServices();
+    if (netServices->empty()) {
+        NETMGR_LOGE("netServices is empty");
         return ERR_NO_ANY_NET_TYPE;
     }
 
-    for (auto &netService : netServices_) {
+    for (auto &netService : *netServices) {
         netService->RegisterNetConnCallback(callback);
     }
 
@@ -223,12 +294,13 @@ int32_t NetConnService::RegisterNetConnCallback(const sptr<NetSpecifier> &netSpe
         return ERR_SERVICE_NULL_PTR;
     }
 
-    if (netServices_.empty()) {
-        NETMGR_LOGE("netServices_ is empty");
+    NetConnRegistry::NET_SERVICE_SNAPSHOT netServices = registry_.GetServices();
+    if (netServices->empty()) {
+        NETMGR_LOGE("netServices is empty");
         return ERR_NO_ANY_NET_TYPE;
     }
 
-    for (auto it = netServices_.begin(); it != netServices_.end(); ++it) {
+    for (auto it = netServices->begin(); it != netServices->end(); ++it) {
         NetCapabilities netCapabilit = (*it)->GetNetCapability();
         if ((*it)->GetNetworkType() == netSpecifier->netType_
             && (netCapabilit & netSpecifier->netCapabilities_) == netCapabilit) {
@@ -247,12 +319,13 @@ int32_t NetConnService::UnregisterNetConnCallback(const sptr<INetConnCallback> &
         return ERR_SERVICE_NULL_PTR;
     }
 
-    if (netServices_.empty()) {
-        NETMGR_LOGE("netServices_ is empty");
+    NetConnRegistry::NET_SERVICE_SNAPSHOT netServices = registry_.GetServices();
+    if (netServices->empty()) {
+        NETMGR_LOGE("netServices is empty");
         return ERR_NO_ANY_NET_TYPE;
     }
 
-    for (auto &netService : netServices_) {
+    for (auto &netService : *netServices) {
         netService->UnregisterNetConnCallback(callback);
     }
 
@@ -267,12 +340,13 @@ int32_t NetConnService::UnregisterNetConnCallback(const sptr<NetSpecifier> &netS
         return ERR_SERVICE_NULL_PTR;
     }
 
-    if (netServices_.empty()) {
-        NETMGR_LOGE("netServices_ is empty");
+    NetConnRegistry::NET_SERVICE_SNAPSHOT netServices = registry_.GetServices();
+    if (netServices->empty()) {
+        NETMGR_LOGE("netServices is empty");
         return ERR_NO_ANY_NET_TYPE;
     }
 
-    for (auto it = netServices_.begin(); it != netServices_.end(); ++it) {
+    for (auto it = netServices->begin(); it != netServices->end(); ++it) {
         NetCapabilities netCapabilit = (*it)->GetNetCapability();
         if ((*it)->GetNetworkType() == netSpecifier->netType_
             && (netCapabilit & netSpecifier->netCapabilities_) == netCapabilit) {
@@ -293,15 +367,15 @@ int32_t NetConnService::UpdateNetSupplierInfo(uint32_t supplierId, const sptr<Ne
 
     NETMGR_LOGI("Update supplier info: netSupplierInfo[%{public}s]", netSupplierInfo->ToString("").c_str());
 
-    // According to supplierId, get the supplier from the list
-    sptr<NetSupplier> supplier = GetNetSupplierFromListById(supplierId);
+    // According to supplierId, get the supplier from the registry
+    sptr<NetSupplier> supplier = registry_.GetSupplier(supplierId);
     if (supplier == nullptr) {
         NETMGR_LOGE("supplier is nullptr");
         return ERR_NO_SUPPLIER;
     }
 
     // Call NetSupplier class to update network connection status information
-    sptr<Network> network = GetNetworkFromListBySupplierId(supplier->GetSupplierId());
+    sptr<Network> network = registry_.GetNetwork(supplierId);
     if (network == nullptr) {
         NETMGR_LOGE("network is nullptr");
         return ERR_NO_NETWORK;
@@ -314,45 +388,45 @@ int32_t NetConnService::UpdateNetSupplierInfo(uint32_t supplierId, const sptr<Ne
 int32_t NetConnService::UpdateNetCapabilities(uint32_t supplierId, uint64_t netCapabilities)
 {
     NETMGR_LOGI("supplierId[%{public}d] netCapabilities[%{public}lld]", supplierId, netCapabilities);
-    // According to supplierId, get the supplier from the list
-    sptr<NetSupplier> supplier = GetNetSupplierFromListById(supplierId);
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    // According to supplierId, get the supplier from the registry
+    sptr<NetSupplier> supplier = registry_.GetSupplier(supplierId);
     if (supplier == nullptr) {
         NETMGR_LOGE("supplier is nullptr");
         return ERR_NO_SUPPLIER;
     }
 
-    // According to netId, get network from the list
-    sptr<Network> network = GetNetworkFromListBySupplierId(supplier->GetSupplierId());
+    // According to supplierId, get network from the registry
+    sptr<Network> network = registry_.GetNetwork(supplierId);
     if (network == nullptr) {
         NETMGR_LOGE("network is nullptr");
         return ERR_NO_NETWORK;
     }
     auto type = supplier->GetNetSupplierType();
     auto ident = supplier->GetNetSupplierIdent();
+    int32_t netId = network->GetNetId();
     // Create or delete network services based on the netCapabilities
     if (netCapabilities & NET_CAPABILITIES_INTERNET) {
-        if (!IsServiceInList(network->GetNetId(), NET_CAPABILITIES_INTERNET)) {
-            auto service = std::make_unique<NetService>(ident, type, NET_CAPABILITIES_INTERNET, network).release();
-            netServices_.push_back(service);
+        if (!registry_.IsServiceExist(netId, NET_CAPABILITIES_INTERNET)) {
+            sptr<NetService> service =
+                std::make_unique<NetService>(ident, type, NET_CAPABILITIES_INTERNET, network).release();
+            registry_.AddService(netId, service);
         }
     } else {
-        if (IsServiceInList(network->GetNetId(), NET_CAPABILITIES_INTERNET)) {
-            DeleteServiceFromListByCap(network->GetNetId(), NET_CAPABILITIES_INTERNET);
-        }
+        registry_.RemoveService(netId, NET_CAPABILITIES_INTERNET);
     }
 
     if (netCapabilities & NET_CAPABILITIES_MMS) {
-        if (!IsServiceInList(network->GetNetId(), NET_CAPABILITIES_MMS)) {
-            auto service = std::make_unique<NetService>(ident, type, NET_CAPABILITIES_MMS, network).release();
-            netServices_.push_back(service);
+        if (!registry_.IsServiceExist(netId, NET_CAPABILITIES_MMS)) {
+            sptr<NetService> service =
+                std::make_unique<NetService>(ident, type, NET_CAPABILITIES_MMS, network).release();
+            registry_.AddService(netId, service);
         }
     } else {
-        if (IsServiceInList(network->GetNetId(), NET_CAPABILITIES_MMS)) {
-            DeleteServiceFromListByCap(network->GetNetId(), NET_CAPABILITIES_MMS);
-        }
+        registry_.RemoveService(netId, NET_CAPABILITIES_MMS);
     }
-    NETMGR_LOGI("netSupplier_ size[%{public}d], networks_ size[%{public}d], netServices_ size[%{public}d]",
-                netSupplier_.size(), networks_.size(), netServices_.size());
+    NETMGR_LOGI("suppliers size[%{public}zu] services size[%{public}zu]",
+        registry_.GetSupplierSize(), registry_.GetServiceSize());
     return ERR_NONE;
 }
 
@@ -365,14 +439,14 @@ int32_t NetConnService::UpdateNetLinkInfo(uint32_t supplierId, const sptr<NetLin
     }
 
     NETMGR_LOGI("Update netlink info: netLinkInfo[%{public}s]", netLinkInfo->ToString("").c_str());
-    // According to supplierId, get the supplier from the list
-    sptr<NetSupplier> supplier = GetNetSupplierFromListById(supplierId);
+    // According to supplierId, get the supplier from the registry
+    sptr<NetSupplier> supplier = registry_.GetSupplier(supplierId);
     if (supplier == nullptr) {
         NETMGR_LOGE("supplier is nullptr");
         return ERR_NO_SUPPLIER;
     }
-    // According to supplier id, get network from the list
-    sptr<Network> network = GetNetworkFromListBySupplierId(supplier->GetSupplierId());
+    // According to supplier id, get network from the registry
+    sptr<Network> network = registry_.GetNetwork(supplierId);
     if (network == nullptr) {
         NETMGR_LOGE("network is nullptr");
         return ERR_NO_NETWORK;
@@ -381,114 +455,5 @@ int32_t NetConnService::UpdateNetLinkInfo(uint32_t supplierId, const sptr<NetLin
     network->UpdateNetLinkInfo(*netLinkInfo);
     return ERR_NONE;
 }
-
-sptr<NetSupplier> NetConnService::GetNetSupplierFromList(
-    uint32_t netType, const std::string &ident)
-{
-    for (auto it = netSupplier_.begin(); it != netSupplier_.end(); ++it) {
-        auto supplierType = (*it)->GetNetSupplierType();
-        auto supplierIdent = (*it)->GetNetSupplierIdent();
-        if ((netType == supplierType) && (ident.compare(supplierIdent) == 0)) {
-            return *it;
-        }
-    }
-
-    NETMGR_LOGE("net supplier is nullptr");
-    return nullptr;
-}
-
-sptr<NetSupplier> NetConnService::GetNetSupplierFromListById(uint32_t supplierId)
-{
-    for (auto it = netSupplier_.begin(); it != netSupplier_.end(); ++it) {
-        auto id = (*it)->GetSupplierId();
-        if (supplierId == id) {
-            return *it;
-        }
-    }
-
-    NETMGR_LOGE("net supplier is nullptr");
-    return nullptr;
-}
-
-void NetConnService::DeleteSupplierFromListById(uint32_t supplierId)
-{
-    for (auto it = netSupplier_.begin(); it != netSupplier_.end(); ++it) {
-        auto id = (*it)->GetSupplierId();
-        if (supplierId == id) {
-            netSupplier_.erase(it);
-            return;
-        }
-    }
-}
-
-void NetConnService::DeleteNetworkFromListBySupplierId(uint32_t supplierId)
-{
-    for (auto it = networks_.begin(); it != networks_.end(); ++it) {
-        sptr<NetSupplier> netSupplier = (*it)->GetNetSupplier();
-        if ((netSupplier != nullptr) && (netSupplier->GetSupplierId() == supplierId)) {
-            networks_.erase(it);
-            return;
-        }
-    }
-}
-
-sptr<Network> NetConnService::GetNetworkFromListBySupplierId(uint32_t supplierId)
-{
-    for (auto it = networks_.begin(); it != networks_.end(); ++it) {
-        sptr<NetSupplier> netSupplier = (*it)->GetNetSupplier();
-        if ((netSupplier != nullptr) && (netSupplier->GetSupplierId() == supplierId)) {
-            return *it;
-        }
-    }
-
-    NETMGR_LOGE("network is nullptr");
-    return nullptr;
-}
-
-void NetConnService::DeleteServiceFromListByNet(const Network &network)
-{
-    sptr<Network> currNetwork = nullptr;
-    for (auto it = netServices_.begin(); it != netServices_.end();) {
-        currNetwork = (*it)->GetNetwork();
-        if (currNetwork != nullptr && *currNetwork == network) {
-            netServices_.erase(it++);
-        } else {
-            ++it;
-        }
-    }
-}
-
-bool NetConnService::DeleteServiceFromListByCap(int32_t netId, const NetCapabilities &netCapability)
-{
-    sptr<Network> network = nullptr;
-    for (auto it = netServices_.begin(); it != netServices_.end(); ++it) {
-        network = (*it)->GetNetwork();
-        if (network == nullptr) {
-            continue;
-        }
-        if ((network->GetNetId() == netId) && (netCapability == (*it)->GetNetCapability())) {
-            netServices_.erase(it);
-            return true;
-        }
-    }
-
-    return false;
-}
-
-bool NetConnService::IsServiceInList(int32_t netId, const NetCapabilities &netCapability) const
-{
-    sptr<Network> network = nullptr;
-    for (auto it = netServices_.begin(); it != netServices_.end(); ++it) {
-        network = (*it)->GetNetwork();
-        if (network == nullptr) {
-            continue;
-        }
-        if ((network->GetNetId() == netId) && (netCapability == (*it)->GetNetCapability())) {
-            return true;
-        }
-    }
-
-    return false;
-}
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -15,7 +15,7 @@
 #include "net_service.h"
 
 #include "net_conn_types.h"
-#include "broadcast_manager.h"
+#include "net_conn_callback_dispatcher.h"
 #include "net_mgr_log_wrapper.h"
 
 namespace OHOS {
@@ -73,6 +73,7 @@ sptr<Network> NetService::GetNetwork() const
 int32_t NetService::ServiceConnect()
 {
     NETMGR_LOGI("service connect");
+    std::lock_guard<std::mutex> lock(connectMutex_);
     if (IsConnecting()) {
         NETMGR_LOGI("this service is connecting");
         return ERR_SERVICE_CONNECTING;
@@ -113,6 +114,7 @@ int32_t NetService::ServiceConnect()
 int32_t NetService::ServiceDisConnect()
 {
     NETMGR_LOGI("service disconnect");
+    std::lock_guard<std::mutex> lock(connectMutex_);
     if (state_ == SERVICE_STATE_DISCONNECTING) {
         NETMGR_LOGI("this service is disconnecting");
         return ERR_SERVICE_DISCONNECTING;
@@ -195,7 +197,7 @@ void NetService::UpdateServiceState(ServiceState serviceState)
     info.ordered = true;
     std::string netTypeName = std::to_string(static_cast<int32_t>(networkType_));
     std::map<std::string, std::string> param = {{"NetType", netTypeName}};
-    DelayedSingleton<BroadcastManager>::GetInstance()->SendBroadcast(info, param);
+    DelayedSingleton<NetConnCallbackDispatcher>::GetInstance()->Broadcast(info, param);
 
     sptr<NetConnCallbackInfo> netConnCallback = (std::make_unique<NetConnCallbackInfo>()).release();
     if (netConnCallback == nullptr) {
@@ -206,7 +208,7 @@ void NetService::UpdateServiceState(ServiceState serviceState)
     netConnCallback->netType_ = static_cast<int32_t>(networkType_);
     NotifyNetConnStateChanged(netConnCallback);
 
-    NETMGR_LOGI("serviceState is [%{public}d]", state_);
+    NETMGR_LOGI("serviceState is [%{public}d]", state_.load());
 }
 
 bool NetService::IsConnecting() const
@@ -263,6 +265,7 @@ void NetService::RegisterNetConnCallback(const sptr<INetConnCallback> &callback)
         return;
     }
 
+    std::lock_guard<std::mutex> lock(callbackMutex_);
     for (auto iter = netConnCallback_.begin(); iter != netConnCallback_.end(); ++iter) {
         if (callback->AsObject().GetRefPtr() == (*iter)->AsObject().GetRefPtr()) {
             NETMGR_LOGI("netConnCallback_ had this callback");
@@ -279,9 +282,12 @@ int32_t NetService::UnregisterNetConnCallback(const sptr<INetConnCallback> &call
         return ERR_SERVICE_NULL_PTR;
     }
 
+    std::lock_guard<std::mutex> lock(callbackMutex_);
     for (auto iter = netConnCallback_.begin(); iter != netConnCallback_.end(); ++iter) {
         if (callback->AsObject().GetRefPtr() == (*iter)->AsObject().GetRefPtr()) {
             netConnCallback_.erase(iter);
+            DelayedSingleton<NetConnCallbackDispatcher>::GetInstance()->RemovePending(callback,
+                static_cast<int32_t>(networkType_), static_cast<uint64_t>(netCapability_));
             return ERR_NONE;
         }
     }
@@ -291,8 +297,11 @@ int32_t NetService::UnregisterNetConnCallback(const sptr<INetConnCallback> &call
 
 int32_t NetService::NotifyNetConnStateChanged(const sptr<NetConnCallbackInfo> &info)
 {
+    // Remote callbacks run on the dispatcher, a slow subscriber must not hold up the state machine
+    std::lock_guard<std::mutex> lock(callbackMutex_);
     for (const auto &callback : netConnCallback_) {
-        callback->NetConnStateChanged(info);
+        DelayedSingleton<NetConnCallbackDispatcher>::GetInstance()->Notify(callback, info,
+            static_cast<uint64_t>(netCapability_));
     }
 
     return ERR_NONE;
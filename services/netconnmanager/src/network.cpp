@@ -15,12 +15,71 @@
 
 #include "network.h"
 
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
 #include "net_id_manager.h"
 #include "netd_controller.h"
 #include "net_mgr_log_wrapper.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
+namespace {
+/* Servers are compared in order, the resolver tries them in that order */
+bool IsSameDnsConfig(const std::list<INetAddr> &left, const std::list<INetAddr> &right)
+{
+    return std::equal(left.begin(), left.end(), right.begin(), right.end(),
+        [](const INetAddr &leftDns, const INetAddr &rightDns) {
+            return leftDns.address_ == rightDns.address_ && leftDns.hostName_ == rightDns.hostName_;
+        });
+}
+
+struct RouteHash {
+    size_t operator()(const Route *route) const
+    {
+        return route->Hash();
+    }
+};
+
+struct RouteEqual {
+    bool operator()(const Route *left, const Route *right) const
+    {
+        return *left == *right;
+    }
+};
+
+/* Points into the route lists being compared, which outlive the diff */
+using RouteSet = std::unordered_set<const Route *, RouteHash, RouteEqual>;
+} // namespace
+
+int32_t NetLinkNetd::AddInterface(int32_t netId, const std::string &iface)
+{
+    return NetdController::GetInstance()->NetworkAddInterface(netId, iface);
+}
+
+int32_t NetLinkNetd::RemoveInterface(int32_t netId, const std::string &iface)
+{
+    return NetdController::GetInstance()->NetworkRemoveInterface(netId, iface);
+}
+
+int32_t NetLinkNetd::ApplyRouteDelta(int32_t netId, const std::vector<Route> &removed,
+    const std::vector<Route> &added)
+{
+    return NetdController::GetInstance()->NetworkApplyRouteDelta(netId, removed, added);
+}
+
+int32_t NetLinkNetd::SetResolverConfig(int32_t netId, const std::vector<std::string> &servers,
+    const std::vector<std::string> &domains)
+{
+    return NetdController::GetInstance()->SetResolverConfig(netId, 0, 1, servers, domains);
+}
+
+int32_t NetLinkNetd::SetMtu(const std::string &iface, int32_t mtu)
+{
+    return NetdController::GetInstance()->InterfaceSetMtu(iface, mtu);
+}
+
 Network::Network(sptr<NetSupplier> &supplier) : supplier_(supplier)
 {
     netId_ = DelayedSingleton<NetIdManager>::GetInstance()->ReserveNetId();
@@ -81,12 +140,33 @@ bool Network::NetworkDisconnect(const NetCapabilities &netCapability)
 bool Network::UpdateNetLinkInfo(const NetLinkInfo &netLinkInfo)
 {
     NETMGR_LOGI("update net link information process");
-    UpdateInterfaces(netLinkInfo);
-    UpdateRoutes(netLinkInfo);
-    UpdateDnses(netLinkInfo);
-    updateMtu(netLinkInfo);
-    netLinkInfo_ = netLinkInfo;
-    return true;
+    std::lock_guard<std::mutex> lock(netLinkMutex_);
+    linkUpdateStats_.updates++;
+    /* Routes that came over IPC were parsed as they were read, only locally built ones are parsed here */
+    const NetLinkInfo *info = &netLinkInfo;
+    NetLinkInfo parsedInfo;
+    if (!std::all_of(netLinkInfo.routeList_.begin(), netLinkInfo.routeList_.end(),
+        [](const Route &route) { return route.parsed_; })) {
+        parsedInfo = netLinkInfo;
+        for (auto &route : parsedInfo.routeList_) {
+            route.Parse();
+        }
+        info = &parsedInfo;
+    }
+    UpdateInterfaces(*info);
+    bool routesApplied = UpdateRoutes(*info);
+    UpdateDnses(*info);
+    updateMtu(*info);
+    /* After a failed route delta the old list is kept, so the next update diffs against it and retries */
+    std::list<Route> routeList;
+    if (!routesApplied) {
+        routeList.swap(netLinkInfo_.routeList_);
+    }
+    netLinkInfo_ = *info;
+    if (!routesApplied) {
+        netLinkInfo_.routeList_.swap(routeList);
+    }
+    return routesApplied;
 }
 
 int32_t Network::GetNetId() const
@@ -111,9 +191,22 @@ void Network::SetRoute(const Route &route)
 
 NetLinkInfo Network::GetNetLinkInfo() const
 {
+    std::lock_guard<std::mutex> lock(netLinkMutex_);
     return netLinkInfo_;
 }
 
+NetLinkUpdateStats Network::GetLinkUpdateStats() const
+{
+    std::lock_guard<std::mutex> lock(netLinkMutex_);
+    return linkUpdateStats_;
+}
+
+void Network::SetNetLinkNetd(const std::shared_ptr<NetLinkNetd> &netd)
+{
+    std::lock_guard<std::mutex> lock(netLinkMutex_);
+    netd_ = (netd != nullptr) ? netd : std::make_shared<NetLinkNetd>();
+}
+
 INetAddr Network::GetIpAdress() const
 {
     return ipAddr_;
@@ -166,41 +259,65 @@ void Network::SetConnecting(bool connecting)
 void Network::UpdateInterfaces(const NetLinkInfo &netLinkInfo)
 {
     if (netLinkInfo.ifaceName_ == netLinkInfo_.ifaceName_) {
+        linkUpdateStats_.interfaceSkipped++;
         return;
     }
 
     // Call netd to add and remove interface
     if (!netLinkInfo.ifaceName_.empty()) {
-        NetdController::GetInstance()->NetworkAddInterface(netId_, netLinkInfo.ifaceName_);
+        netd_->AddInterface(netId_, netLinkInfo.ifaceName_);
     }
     if (!netLinkInfo_.ifaceName_.empty()) {
-        NetdController::GetInstance()->NetworkRemoveInterface(netId_, netLinkInfo_.ifaceName_);
+        netd_->RemoveInterface(netId_, netLinkInfo_.ifaceName_);
     }
 }
 
-void Network::UpdateRoutes(const NetLinkInfo &netLinkInfo)
+bool Network::UpdateRoutes(const NetLinkInfo &netLinkInfo)
 {
-    for (auto it = netLinkInfo.routeList_.begin(); it != netLinkInfo.routeList_.end(); ++it) {
-        const struct Route &route = *it;
-        if (std::find(netLinkInfo_.routeList_.begin(), netLinkInfo_.routeList_.end(), *it) ==
-            netLinkInfo_.routeList_.end()) {
-                NetdController::GetInstance()->NetworkAddRoute(
-                    netId_, route.iface_, route.destination_.address_, route.gateway_.address_);
+    RouteSet current;
+    for (const auto &route : netLinkInfo_.routeList_) {
+        current.insert(&route);
+    }
+    RouteSet next;
+    std::vector<Route> added;
+    for (const auto &route : netLinkInfo.routeList_) {
+        if (!next.insert(&route).second) {
+            continue;
+        }
+        if (current.count(&route) == 0) {
+            added.push_back(route);
+        } else {
+            linkUpdateStats_.routesSkipped++;
         }
     }
-
-    for (auto it = netLinkInfo_.routeList_.begin(); it != netLinkInfo_.routeList_.end(); ++it) {
-        const struct Route &route = *it;
-        if (std::find(netLinkInfo.routeList_.begin(), netLinkInfo.routeList_.end(), *it) ==
-            netLinkInfo.routeList_.end()) {
-                NetdController::GetInstance()->NetworkRemoveRoute(
-                    netId_, route.iface_, route.destination_.address_, route.gateway_.address_);
+    std::vector<Route> removed;
+    for (const auto &route : netLinkInfo_.routeList_) {
+        if (next.count(&route) == 0 && current.erase(&route) != 0) {
+            removed.push_back(route);
         }
     }
+    if (added.empty() && removed.empty()) {
+        return true;
+    }
+    int32_t ret = netd_->ApplyRouteDelta(netId_, removed, added);
+    if (ret != 0) {
+        NETMGR_LOGE("apply route delta failed, ret[%{public}d]", ret);
+        linkUpdateStats_.routeBatchesFailed++;
+        return false;
+    }
+    linkUpdateStats_.routeBatches++;
+    linkUpdateStats_.routesAdded += added.size();
+    linkUpdateStats_.routesRemoved += removed.size();
+    return true;
 }
 
 void Network::UpdateDnses(const NetLinkInfo &netLinkInfo)
 {
+    /* A renewal with the same servers must not reconfigure the resolver, that would throw its cache away */
+    if (IsSameDnsConfig(netLinkInfo.dnsList_, netLinkInfo_.dnsList_)) {
+        linkUpdateStats_.dnsSkipped++;
+        return;
+    }
     std::vector<std::string> servers;
     std::vector<std::string> doamains;
     for (auto it = netLinkInfo.dnsList_.begin(); it != netLinkInfo.dnsList_.end(); ++it) {
@@ -209,16 +326,18 @@ void Network::UpdateDnses(const NetLinkInfo &netLinkInfo)
         doamains.push_back(dns.hostName_);
     }
     // Call netd to set dns
-    NetdController::GetInstance()->SetResolverConfig(netId_, 0, 1, servers, doamains);
+    netd_->SetResolverConfig(netId_, servers, doamains);
+    linkUpdateStats_.dnsApplied++;
 }
 
 void Network::updateMtu(const NetLinkInfo &netLinkInfo)
 {
     if (netLinkInfo.mtu_ == netLinkInfo_.mtu_) {
+        linkUpdateStats_.mtuSkipped++;
         return;
     }
 
-    NetdController::GetInstance()->InterfaceSetMtu(netLinkInfo.ifaceName_, netLinkInfo.mtu_);
+    netd_->SetMtu(netLinkInfo.ifaceName_, netLinkInfo.mtu_);
 }
 } // namespace NetManagerStandard
 } // namespace OHOS
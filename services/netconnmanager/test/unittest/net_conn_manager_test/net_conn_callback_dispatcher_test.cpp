@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "net_conn_callback_dispatcher.h"
+#include "net_conn_callback_stub.h"
+#include "net_specifier.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t WAIT_TIME_MS = 3000;
+constexpr int32_t TEST_NET_TYPE = 1;
+constexpr uint64_t TEST_NET_CAPABILITY = NET_CAPABILITIES_INTERNET;
+} // namespace
+
+using namespace testing::ext;
+class BlockingNetConnCallback : public NetConnCallbackStub {
+public:
+    int32_t NetConnStateChanged(const sptr<NetConnCallbackInfo> &info) override
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        entered_++;
+        cv_.notify_all();
+        cv_.wait(lock, [this]() { return !blocked_; });
+        states_.push_back(info->netState_);
+        cv_.notify_all();
+        return 0;
+    }
+
+    void SetBlocked(bool blocked)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        blocked_ = blocked;
+        cv_.notify_all();
+    }
+
+    bool WaitForEntered(uint32_t count, uint32_t timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+            [this, count]() { return entered_ >= count; });
+    }
+
+    bool WaitForStates(size_t count, uint32_t timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+            [this, count]() { return states_.size() >= count; });
+    }
+
+    std::vector<int32_t> GetStates()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return states_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool blocked_ = false;
+    uint32_t entered_ = 0;
+    std::vector<int32_t> states_;
+};
+
+class NetConnCallbackDispatcherTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+    static sptr<NetConnCallbackInfo> MakeInfo(int32_t netState);
+};
+
+void NetConnCallbackDispatcherTest::SetUpTestCase() {}
+
+void NetConnCallbackDispatcherTest::TearDownTestCase() {}
+
+void NetConnCallbackDispatcherTest::SetUp() {}
+
+void NetConnCallbackDispatcherTest::TearDown() {}
+
+sptr<NetConnCallbackInfo> NetConnCallbackDispatcherTest::MakeInfo(int32_t netState)
+{
+    sptr<NetConnCallbackInfo> info = (std::make_unique<NetConnCallbackInfo>()).release();
+    info->netState_ = netState;
+    info->netType_ = TEST_NET_TYPE;
+    return info;
+}
+
+/**
+ * @tc.name: NetConnCallbackDispatcher001
+ * @tc.desc: Test one blocked subscriber neither blocks Notify nor other subscribers, and gets the latest state.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetConnCallbackDispatcherTest, NetConnCallbackDispatcher001, TestSize.Level1)
+{
+    auto dispatcher = DelayedSingleton<NetConnCallbackDispatcher>::GetInstance();
+    NetConnDispatchStats before = dispatcher->GetStats();
+    sptr<BlockingNetConnCallback> slow = (std::make_unique<BlockingNetConnCallback>()).release();
+    sptr<BlockingNetConnCallback> fast = (std::make_unique<BlockingNetConnCallback>()).release();
+    slow->SetBlocked(true);
+
+    auto start = std::chrono::steady_clock::now();
+    dispatcher->Notify(slow, MakeInfo(1), TEST_NET_CAPABILITY);
+    ASSERT_TRUE(slow->WaitForEntered(1, WAIT_TIME_MS));
+    dispatcher->Notify(slow, MakeInfo(2), TEST_NET_CAPABILITY);
+    dispatcher->Notify(slow, MakeInfo(3), TEST_NET_CAPABILITY);
+    dispatcher->Notify(slow, MakeInfo(4), TEST_NET_CAPABILITY);
+    dispatcher->Notify(fast, MakeInfo(1), TEST_NET_CAPABILITY);
+    auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    ASSERT_LT(cost.count(), WAIT_TIME_MS);
+    ASSERT_TRUE(fast->WaitForStates(1, WAIT_TIME_MS));
+
+    slow->SetBlocked(false);
+    ASSERT_TRUE(slow->WaitForStates(2, WAIT_TIME_MS));
+    ASSERT_TRUE(dispatcher->WaitIdle(WAIT_TIME_MS));
+    std::vector<int32_t> states = slow->GetStates();
+    ASSERT_EQ(states.size(), 2);
+    ASSERT_EQ(states.front(), 1);
+    ASSERT_EQ(states.back(), 4);
+
+    NetConnDispatchStats after = dispatcher->GetStats();
+    std::cout << "NetConnCallbackDispatcher001 enqueued:" << after.enqueued - before.enqueued
+              << " delivered:" << after.delivered - before.delivered
+              << " coalesced:" << after.coalesced - before.coalesced << " maxQueueDepth:" << after.maxQueueDepth
+              << std::endl;
+    ASSERT_EQ(after.coalesced - before.coalesced, 2);
+    ASSERT_EQ(after.queueDepth, 0);
+}
+
+/**
+ * @tc.name: NetConnCallbackDispatcher002
+ * @tc.desc: Test RemovePending drops the queued states of an unregistered subscriber.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetConnCallbackDispatcherTest, NetConnCallbackDispatcher002, TestSize.Level1)
+{
+    auto dispatcher = DelayedSingleton<NetConnCallbackDispatcher>::GetInstance();
+    NetConnDispatchStats before = dispatcher->GetStats();
+    sptr<BlockingNetConnCallback> callback = (std::make_unique<BlockingNetConnCallback>()).release();
+    callback->SetBlocked(true);
+    dispatcher->Notify(callback, MakeInfo(1), TEST_NET_CAPABILITY);
+    ASSERT_TRUE(callback->WaitForEntered(1, WAIT_TIME_MS));
+    dispatcher->Notify(callback, MakeInfo(2), TEST_NET_CAPABILITY);
+    dispatcher->RemovePending(callback, TEST_NET_TYPE, TEST_NET_CAPABILITY);
+    callback->SetBlocked(false);
+    ASSERT_TRUE(dispatcher->WaitIdle(WAIT_TIME_MS));
+
+    std::vector<int32_t> states = callback->GetStates();
+    ASSERT_EQ(states.size(), 1);
+    ASSERT_EQ(states.front(), 1);
+    NetConnDispatchStats after = dispatcher->GetStats();
+    ASSERT_EQ(after.dropped - before.dropped, 1);
+}
+
+/**
+ * @tc.name: NetConnCallbackDispatcher003
+ * @tc.desc: Test two services of one net type keep their own pending state and are removed apart.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetConnCallbackDispatcherTest, NetConnCallbackDispatcher003, TestSize.Level1)
+{
+    auto dispatcher = DelayedSingleton<NetConnCallbackDispatcher>::GetInstance();
+    NetConnDispatchStats before = dispatcher->GetStats();
+    sptr<BlockingNetConnCallback> callback = (std::make_unique<BlockingNetConnCallback>()).release();
+    callback->SetBlocked(true);
+    dispatcher->Notify(callback, MakeInfo(1), NET_CAPABILITIES_INTERNET);
+    ASSERT_TRUE(callback->WaitForEntered(1, WAIT_TIME_MS));
+    dispatcher->Notify(callback, MakeInfo(2), NET_CAPABILITIES_INTERNET);
+    dispatcher->Notify(callback, MakeInfo(12), NET_CAPABILITIES_MMS);
+    dispatcher->Notify(callback, MakeInfo(13), NET_CAPABILITIES_MMS);
+    dispatcher->RemovePending(callback, TEST_NET_TYPE, NET_CAPABILITIES_INTERNET);
+    callback->SetBlocked(false);
+    ASSERT_TRUE(dispatcher->WaitIdle(WAIT_TIME_MS));
+
+    std::vector<int32_t> states = callback->GetStates();
+    ASSERT_EQ(states.size(), 2);
+    ASSERT_EQ(states.front(), 1);
+    ASSERT_EQ(states.back(), 13);
+    NetConnDispatchStats after = dispatcher->GetStats();
+    ASSERT_EQ(after.coalesced - before.coalesced, 1);
+    ASSERT_EQ(after.dropped - before.dropped, 1);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -13,6 +13,10 @@
  * limitations under the License.
  */
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "net_conn_client.h"
@@ -23,6 +27,8 @@
 namespace OHOS {
 namespace NetManagerStandard {
 constexpr int WAIT_TIME_SECOND_LONG = 60;
+constexpr int32_t STRESS_THREAD_NUM = 8;
+constexpr int32_t STRESS_LOOP_NUM = 500;
 using namespace testing::ext;
 class NetConnManagerTest : public testing::Test {
 public:
@@ -254,5 +260,52 @@ HWTEST_F(NetConnManagerTest, NetConnManager007, TestSize.Level1)
     result = DelayedSingleton<NetConnClient>::GetInstance()->UnregisterNetConnCallback(netSpecifier, callback);
     ASSERT_TRUE(result == ERR_NONE);
 }
+
+/**
+ * @tc.name: NetConnManager008
+ * @tc.desc: Stress NetConnManager with concurrent RegisterNetConnCallback and UpdateNetLinkInfo.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetConnManagerTest, NetConnManager008, TestSize.Level2)
+{
+    uint64_t netCapabilities = NET_CAPABILITIES_INTERNET | NET_CAPABILITIES_MMS;
+    std::string ident = "ident08";
+    int32_t resSupplierId = DelayedSingleton<NetConnClient>::GetInstance()->RegisterNetSupplier(NET_TYPE_CELLULAR,
+        ident, netCapabilities);
+    ASSERT_TRUE(resSupplierId >= ERR_NONE);
+
+    sptr<NetLinkInfo> netLinkInfo = GetUpdateLinkInfoSample();
+    std::atomic<int32_t> failed(0);
+    std::vector<std::thread> threads;
+    for (int32_t i = 0; i < STRESS_THREAD_NUM; i++) {
+        threads.emplace_back([this, i, resSupplierId, netLinkInfo, &failed]() {
+            sptr<NetConnCallbackTest> callback = GetINetConnCallbackSample();
+            for (int32_t j = 0; j < STRESS_LOOP_NUM; j++) {
+                int32_t result = ERR_NONE;
+                if ((i % 2) == 0) {
+                    result = DelayedSingleton<NetConnClient>::GetInstance()->RegisterNetConnCallback(callback);
+                    if (result == ERR_NONE) {
+                        result = DelayedSingleton<NetConnClient>::GetInstance()->UnregisterNetConnCallback(callback);
+                    }
+                } else {
+                    result = DelayedSingleton<NetConnClient>::GetInstance()->UpdateNetLinkInfo(resSupplierId,
+                        netLinkInfo);
+                }
+                if (result != ERR_NONE) {
+                    failed++;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::cout << "NetConnManager008 calls:" << STRESS_THREAD_NUM * STRESS_LOOP_NUM << " failed:" << failed.load()
+              << std::endl;
+    ASSERT_EQ(failed.load(), 0);
+
+    int32_t result = DelayedSingleton<NetConnClient>::GetInstance()->UnregisterNetSupplier(resSupplierId);
+    ASSERT_TRUE(result == ERR_NONE);
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
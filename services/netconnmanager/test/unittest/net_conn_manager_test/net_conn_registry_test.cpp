@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "net_conn_registry.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t LOOKUP_ROUNDS = 100000;
+constexpr uint32_t READER_THREAD_NUM = 8;
+constexpr uint32_t WRITER_LOOP_NUM = 2000;
+} // namespace
+
+using namespace testing::ext;
+class NetConnRegistryTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+    static std::vector<uint32_t> FillRegistry(NetConnRegistry &registry, uint32_t count);
+    static double MeasureLookupNs(const NetConnRegistry &registry, const std::vector<uint32_t> &ids);
+};
+
+void NetConnRegistryTest::SetUpTestCase() {}
+
+void NetConnRegistryTest::TearDownTestCase() {}
+
+void NetConnRegistryTest::SetUp() {}
+
+void NetConnRegistryTest::TearDown() {}
+
+std::vector<uint32_t> NetConnRegistryTest::FillRegistry(NetConnRegistry &registry, uint32_t count)
+{
+    std::vector<uint32_t> ids;
+    for (uint32_t i = 0; i < count; i++) {
+        sptr<NetSupplier> supplier =
+            (std::make_unique<NetSupplier>(NET_TYPE_ETHERNET, "eth" + std::to_string(i))).release();
+        registry.AddSupplier(supplier, nullptr);
+        ids.push_back(supplier->GetSupplierId());
+    }
+    return ids;
+}
+
+double NetConnRegistryTest::MeasureLookupNs(const NetConnRegistry &registry, const std::vector<uint32_t> &ids)
+{
+    uint32_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < LOOKUP_ROUNDS; i++) {
+        if (registry.GetSupplier(ids[i % ids.size()]) != nullptr) {
+            found++;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    EXPECT_EQ(found, LOOKUP_ROUNDS);
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+        LOOKUP_ROUNDS;
+}
+
+/**
+ * @tc.name: NetConnRegistry001
+ * @tc.desc: Test NetConnRegistry supplier and service index add, lookup and remove.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetConnRegistryTest, NetConnRegistry001, TestSize.Level1)
+{
+    NetConnRegistry registry;
+    sptr<NetSupplier> supplier = (std::make_unique<NetSupplier>(NET_TYPE_ETHERNET, "eth0")).release();
+    ASSERT_TRUE(registry.AddSupplier(supplier, nullptr));
+    ASSERT_FALSE(registry.AddSupplier(supplier, nullptr));
+    ASSERT_TRUE(registry.GetSupplier(supplier->GetSupplierId()) == supplier);
+    ASSERT_TRUE(registry.GetSupplier(NET_TYPE_ETHERNET, "eth0") == supplier);
+    ASSERT_TRUE(registry.GetSupplier(NET_TYPE_CELLULAR, "eth0") == nullptr);
+
+    sptr<Network> network = nullptr;
+    sptr<NetService> service =
+        (std::make_unique<NetService>("eth0", NET_TYPE_ETHERNET, NET_CAPABILITIES_INTERNET, network)).release();
+    ASSERT_TRUE(registry.AddService(1, service));
+    ASSERT_TRUE(registry.IsServiceExist(1, NET_CAPABILITIES_INTERNET));
+    ASSERT_FALSE(registry.IsServiceExist(1, NET_CAPABILITIES_MMS));
+    ASSERT_TRUE(registry.RemoveService(1, NET_CAPABILITIES_INTERNET));
+    ASSERT_EQ(registry.GetServiceSize(), 0);
+
+    ASSERT_TRUE(registry.RemoveSupplier(supplier->GetSupplierId()));
+    ASSERT_TRUE(registry.GetSupplier(NET_TYPE_ETHERNET, "eth0") == nullptr);
+    ASSERT_EQ(registry.GetSupplierSize(), 0);
+}
+
+/**
+ * @tc.name: NetConnRegistry002
+ * @tc.desc: Benchmark NetConnRegistry lookup by supplierId from 10 to 10k suppliers.
+ * @tc.type: PERF
+ */
+HWTEST_F(NetConnRegistryTest, NetConnRegistry002, TestSize.Level2)
+{
+    const std::vector<uint32_t> scales = {10, 100, 1000, 10000};
+    double baseNs = 0;
+    for (auto scale : scales) {
+        NetConnRegistry registry;
+        std::vector<uint32_t> ids = FillRegistry(registry, scale);
+        ASSERT_EQ(registry.GetSupplierSize(), scale);
+        double ns = MeasureLookupNs(registry, ids);
+        if (baseNs == 0) {
+            baseNs = ns;
+        }
+        std::cout << "NetConnRegistry002 suppliers:" << scale << " lookup ns:" << ns << " growth:" << ns / baseNs
+                  << "x" << std::endl;
+        testing::Test::RecordProperty("NetConnRegistry.lookup_ns_" + std::to_string(scale), static_cast<int>(ns));
+    }
+}
+
+/**
+ * @tc.name: NetConnRegistry003
+ * @tc.desc: Test NetConnRegistry snapshot readers while a writer adds and removes services.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetConnRegistryTest, NetConnRegistry003, TestSize.Level2)
+{
+    NetConnRegistry registry;
+    std::vector<uint32_t> ids = FillRegistry(registry, READER_THREAD_NUM);
+    sptr<Network> network = nullptr;
+    std::atomic<bool> stop(false);
+    std::atomic<uint32_t> missed(0);
+    std::vector<std::thread> readers;
+    for (uint32_t i = 0; i < READER_THREAD_NUM; i++) {
+        readers.emplace_back([&registry, &ids, &stop, &missed, i]() {
+            while (!stop.load()) {
+                if (registry.GetSupplier(ids[i]) == nullptr) {
+                    missed++;
+                }
+                NetConnRegistry::NET_SERVICE_SNAPSHOT services = registry.GetServices();
+                for (const auto &service : *services) {
+                    if (service == nullptr) {
+                        missed++;
+                    }
+                }
+            }
+        });
+    }
+    for (uint32_t i = 0; i < WRITER_LOOP_NUM; i++) {
+        sptr<NetService> service =
+            (std::make_unique<NetService>("eth0", NET_TYPE_ETHERNET, NET_CAPABILITIES_INTERNET, network)).release();
+        /* EXPECT only, an early return would leave the readers running and unjoined */
+        EXPECT_TRUE(registry.AddService(static_cast<int32_t>(i), service));
+        if (i > 0) {
+            EXPECT_TRUE(registry.RemoveService(static_cast<int32_t>(i - 1), NET_CAPABILITIES_INTERNET));
+        }
+    }
+    stop = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    ASSERT_EQ(missed.load(), 0);
+    ASSERT_EQ(registry.GetServiceSize(), 1);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <sys/socket.h>
+
+#include "net_link_info.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+constexpr uint16_t TEST_MTU = 1500;
+constexpr int32_t PERF_ADDR_COUNT = 64;
+constexpr int32_t PERF_ROUTE_COUNT = 1000;
+constexpr int32_t PERF_ROUNDS = 200;
+constexpr int32_t OCTET = 256;
+
+INetAddr MakeAddr(const std::string &address, uint8_t prefixlen = 0)
+{
+    INetAddr addr;
+    addr.type_ = INetAddr::IPV4;
+    addr.family_ = AF_INET;
+    addr.prefixlen_ = prefixlen;
+    addr.address_ = address;
+    return addr;
+}
+
+std::string MakeAddress(int32_t id)
+{
+    return "10." + std::to_string(id / OCTET / OCTET) + "." + std::to_string(id / OCTET % OCTET) + "." +
+        std::to_string(id % OCTET);
+}
+
+NetLinkInfo MakeLinkInfo(int32_t addrCount, int32_t routeCount)
+{
+    NetLinkInfo info;
+    info.ifaceName_ = "eth0";
+    info.domain_ = "example.com";
+    info.mtu_ = TEST_MTU;
+    for (int32_t i = 0; i < addrCount; ++i) {
+        info.netAddrList_.push_back(MakeAddr(MakeAddress(i), 24));
+    }
+    info.dnsList_ = {MakeAddr("192.168.1.1"), MakeAddr("8.8.8.8")};
+    info.dnsList_.back().hostName_ = "dns.example.com";
+    for (int32_t i = 0; i < routeCount; ++i) {
+        Route route;
+        route.iface_ = "eth0";
+        route.destination_ = MakeAddr(MakeAddress(i), 32);
+        route.gateway_ = MakeAddr("192.168.1.1");
+        info.routeList_.push_back(route);
+    }
+    return info;
+}
+
+/* The decode NetLinkInfo::Unmarshalling used to do: one sptr per element, copied into the list */
+sptr<NetLinkInfo> ElementwiseUnmarshalling(Parcel &parcel)
+{
+    sptr<NetLinkInfo> ptr = (std::make_unique<NetLinkInfo>()).release();
+    uint32_t size = 0;
+    if (!parcel.ReadString(ptr->ifaceName_) || !parcel.ReadString(ptr->domain_) || !parcel.ReadUint32(size)) {
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        sptr<INetAddr> netAddr = INetAddr::Unmarshalling(parcel);
+        if (netAddr == nullptr) {
+            return nullptr;
+        }
+        ptr->netAddrList_.push_back(*netAddr);
+    }
+    if (!parcel.ReadUint32(size)) {
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        sptr<INetAddr> netAddr = INetAddr::Unmarshalling(parcel);
+        if (netAddr == nullptr) {
+            return nullptr;
+        }
+        ptr->dnsList_.push_back(*netAddr);
+    }
+    if (!parcel.ReadUint32(size)) {
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        sptr<Route> route = Route::Unmarshalling(parcel);
+        if (route == nullptr) {
+            return nullptr;
+        }
+        ptr->routeList_.push_back(*route);
+    }
+    if (!parcel.ReadUint16(ptr->mtu_)) {
+        return nullptr;
+    }
+    return ptr;
+}
+
+int64_t ElapsedUs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+class NetLinkInfoTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void NetLinkInfoTest::SetUpTestCase() {}
+
+void NetLinkInfoTest::TearDownTestCase() {}
+
+void NetLinkInfoTest::SetUp() {}
+
+void NetLinkInfoTest::TearDown() {}
+
+/**
+ * @tc.name: NetLinkInfo001
+ * @tc.desc: A link info survives a round trip, the parcel is sized once and the routes come back parsed
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetLinkInfoTest, NetLinkInfo001, TestSize.Level1)
+{
+    NetLinkInfo info = MakeLinkInfo(3, 5);
+    Parcel parcel;
+    ASSERT_TRUE(info.Marshalling(parcel));
+    EXPECT_EQ(parcel.GetDataSize(), info.GetMarshalledSize());
+    EXPECT_GE(parcel.GetDataCapacity(), info.GetMarshalledSize());
+
+    sptr<NetLinkInfo> copy = NetLinkInfo::Unmarshalling(parcel);
+    ASSERT_NE(copy, nullptr);
+    EXPECT_EQ(copy->ifaceName_, info.ifaceName_);
+    EXPECT_EQ(copy->domain_, info.domain_);
+    EXPECT_EQ(copy->mtu_, info.mtu_);
+    EXPECT_EQ(copy->netAddrList_, info.netAddrList_);
+    EXPECT_EQ(copy->dnsList_, info.dnsList_);
+    EXPECT_EQ(copy->routeList_, info.routeList_);
+    for (const auto &route : copy->routeList_) {
+        EXPECT_TRUE(route.parsed_);
+        EXPECT_TRUE(route.destination_.parsed_);
+    }
+
+    sptr<NetLinkInfo> object = (std::make_unique<NetLinkInfo>(info)).release();
+    Parcel staticParcel;
+    ASSERT_TRUE(NetLinkInfo::Marshalling(staticParcel, object));
+    EXPECT_EQ(staticParcel.GetDataSize(), parcel.GetDataSize());
+    EXPECT_FALSE(NetLinkInfo::Marshalling(staticParcel, nullptr));
+}
+
+/**
+ * @tc.name: NetLinkInfo002
+ * @tc.desc: A truncated parcel fails to decode instead of yielding a partial link info
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetLinkInfoTest, NetLinkInfo002, TestSize.Level1)
+{
+    Parcel parcel;
+    ASSERT_TRUE(parcel.WriteString("eth0"));
+    ASSERT_TRUE(parcel.WriteString(""));
+    ASSERT_TRUE(parcel.WriteUint32(1));
+    ASSERT_TRUE(MakeAddr("10.0.0.1", 24).Marshalling(parcel));
+    ASSERT_TRUE(parcel.WriteUint32(0));
+    /* The route count claims two routes, only one follows and the mtu is missing */
+    ASSERT_TRUE(parcel.WriteUint32(2));
+    Route route;
+    route.iface_ = "eth0";
+    route.destination_ = MakeAddr("10.0.0.0", 24);
+    ASSERT_TRUE(route.Marshalling(parcel));
+    EXPECT_EQ(NetLinkInfo::Unmarshalling(parcel), nullptr);
+}
+
+/**
+ * @tc.name: NetLinkInfo003
+ * @tc.desc: Round trips of a link info with 64 addresses and 1000 routes, in place decode against one sptr per element
+ * @tc.type: PERF
+ */
+HWTEST_F(NetLinkInfoTest, NetLinkInfo003, TestSize.Level2)
+{
+    NetLinkInfo info = MakeLinkInfo(PERF_ADDR_COUNT, PERF_ROUTE_COUNT);
+    int64_t marshalUs = 0;
+    int64_t inPlaceUs = 0;
+    int64_t elementwiseUs = 0;
+    for (int32_t i = 0; i < PERF_ROUNDS; ++i) {
+        Parcel parcel;
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_TRUE(info.Marshalling(parcel));
+        marshalUs += ElapsedUs(start);
+
+        start = std::chrono::steady_clock::now();
+        sptr<NetLinkInfo> copy = NetLinkInfo::Unmarshalling(parcel);
+        inPlaceUs += ElapsedUs(start);
+        ASSERT_NE(copy, nullptr);
+        ASSERT_EQ(copy->routeList_.size(), info.routeList_.size());
+
+        Parcel elementwiseParcel;
+        ASSERT_TRUE(info.Marshalling(elementwiseParcel));
+        start = std::chrono::steady_clock::now();
+        copy = ElementwiseUnmarshalling(elementwiseParcel);
+        elementwiseUs += ElapsedUs(start);
+        ASSERT_NE(copy, nullptr);
+    }
+    std::cout << PERF_ADDR_COUNT << " addresses, " << PERF_ROUTE_COUNT << " routes, "
+              << info.GetMarshalledSize() << " bytes: marshal " << marshalUs / PERF_ROUNDS << "us, unmarshal in place "
+              << inPlaceUs / PERF_ROUNDS << "us, one sptr per element " << elementwiseUs / PERF_ROUNDS << "us"
+              << std::endl;
+    testing::Test::RecordProperty("NetLinkInfo.unmarshal_us", static_cast<int>(inPlaceUs / PERF_ROUNDS));
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <sys/socket.h>
+
+#include "network.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+constexpr uint16_t TEST_MTU = 1500;
+constexpr int32_t PERF_ROUTE_COUNT = 5000;
+constexpr int32_t PERF_ROUNDS = 20;
+constexpr int32_t OCTET = 256;
+
+INetAddr MakeAddr(const std::string &address)
+{
+    INetAddr addr;
+    addr.family_ = AF_INET;
+    addr.address_ = address;
+    return addr;
+}
+
+Route MakeRoute(const std::string &destination)
+{
+    Route route;
+    route.iface_ = "eth0";
+    route.destination_ = MakeAddr(destination);
+    route.gateway_ = MakeAddr("192.168.1.1");
+    return route;
+}
+
+NetLinkInfo MakeLinkInfo()
+{
+    NetLinkInfo info;
+    info.ifaceName_ = "eth0";
+    info.mtu_ = TEST_MTU;
+    info.dnsList_ = {MakeAddr("192.168.1.1"), MakeAddr("8.8.8.8")};
+    info.routeList_ = {MakeRoute("0.0.0.0"), MakeRoute("192.168.1.0"), MakeRoute("10.0.0.0")};
+    return info;
+}
+
+NetLinkInfo MakePerfLinkInfo(int32_t changed, bool parsed)
+{
+    NetLinkInfo info = MakeLinkInfo();
+    info.routeList_.clear();
+    for (int32_t i = 0; i < PERF_ROUTE_COUNT; ++i) {
+        int32_t id = (i == 0) ? PERF_ROUTE_COUNT + changed : i;
+        Route route = MakeRoute("10." + std::to_string(id / OCTET / OCTET) + "." +
+            std::to_string(id / OCTET % OCTET) + "." + std::to_string(id % OCTET));
+        route.destination_.prefixlen_ = 32;
+        if (parsed) {
+            route.Parse();
+        }
+        info.routeList_.push_back(route);
+    }
+    return info;
+}
+
+/* Records the netd operations instead of changing the interfaces, routes and resolver of the host */
+class FakeNetLinkNetd : public NetLinkNetd {
+public:
+    int32_t AddInterface(int32_t netId, const std::string &iface) override
+    {
+        return 0;
+    }
+    int32_t RemoveInterface(int32_t netId, const std::string &iface) override
+    {
+        return 0;
+    }
+    int32_t ApplyRouteDelta(int32_t netId, const std::vector<Route> &removed,
+        const std::vector<Route> &added) override
+    {
+        routeDeltas_++;
+        return routeDeltaResult_;
+    }
+    int32_t SetResolverConfig(int32_t netId, const std::vector<std::string> &servers,
+        const std::vector<std::string> &domains) override
+    {
+        return 0;
+    }
+    int32_t SetMtu(const std::string &iface, int32_t mtu) override
+    {
+        return 0;
+    }
+
+    uint32_t routeDeltas_ = 0;
+    int32_t routeDeltaResult_ = 0;
+};
+
+int64_t ElapsedUs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+class NetworkTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+
+    sptr<Network> network_;
+    std::shared_ptr<FakeNetLinkNetd> netd_;
+};
+
+void NetworkTest::SetUpTestCase() {}
+
+void NetworkTest::TearDownTestCase() {}
+
+void NetworkTest::SetUp()
+{
+    sptr<NetSupplier> supplier = (std::make_unique<NetSupplier>(NET_TYPE_ETHERNET, "eth0")).release();
+    network_ = (std::make_unique<Network>(supplier)).release();
+    netd_ = std::make_shared<FakeNetLinkNetd>();
+    network_->SetNetLinkNetd(netd_);
+}
+
+void NetworkTest::TearDown()
+{
+    network_ = nullptr;
+    netd_ = nullptr;
+}
+
+/**
+ * @tc.name: Network001
+ * @tc.desc: A renewal carrying the same link info issues no netd operation
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetworkTest, Network001, TestSize.Level1)
+{
+    NetLinkInfo info = MakeLinkInfo();
+    ASSERT_TRUE(network_->UpdateNetLinkInfo(info));
+    NetLinkUpdateStats stats = network_->GetLinkUpdateStats();
+    EXPECT_EQ(stats.routesAdded, info.routeList_.size());
+    EXPECT_EQ(stats.dnsApplied, 1);
+    EXPECT_EQ(stats.interfaceSkipped, 0);
+    EXPECT_EQ(stats.mtuSkipped, 0);
+
+    ASSERT_TRUE(network_->UpdateNetLinkInfo(MakeLinkInfo()));
+    stats = network_->GetLinkUpdateStats();
+    EXPECT_EQ(stats.updates, 2);
+    EXPECT_EQ(stats.interfaceSkipped, 1);
+    EXPECT_EQ(stats.routesAdded, info.routeList_.size());
+    EXPECT_EQ(stats.routesRemoved, 0);
+    EXPECT_EQ(stats.routesSkipped, info.routeList_.size());
+    EXPECT_EQ(stats.routeBatches, 1);
+    EXPECT_EQ(netd_->routeDeltas_, 1);
+    EXPECT_EQ(stats.dnsApplied, 1);
+    EXPECT_EQ(stats.dnsSkipped, 1);
+    EXPECT_EQ(stats.mtuSkipped, 1);
+}
+
+/**
+ * @tc.name: Network002
+ * @tc.desc: Only the part of the link that changed is sent to netd, a new server order reconfigures the resolver
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetworkTest, Network002, TestSize.Level1)
+{
+    NetLinkInfo info = MakeLinkInfo();
+    ASSERT_TRUE(network_->UpdateNetLinkInfo(info));
+    info.routeList_.back() = MakeRoute("10.1.0.0");
+    ASSERT_TRUE(network_->UpdateNetLinkInfo(info));
+    NetLinkUpdateStats stats = network_->GetLinkUpdateStats();
+    EXPECT_EQ(stats.routesAdded, info.routeList_.size() + 1);
+    EXPECT_EQ(stats.routesRemoved, 1);
+    EXPECT_EQ(stats.routesSkipped, info.routeList_.size() - 1);
+    EXPECT_EQ(stats.routeBatches, 2);
+    EXPECT_EQ(stats.dnsSkipped, 1);
+
+    info.dnsList_.reverse();
+    ASSERT_TRUE(network_->UpdateNetLinkInfo(info));
+    info.dnsList_.front().hostName_ = "example.com";
+    ASSERT_TRUE(network_->UpdateNetLinkInfo(info));
+    stats = network_->GetLinkUpdateStats();
+    EXPECT_EQ(stats.dnsApplied, 3);
+    EXPECT_EQ(network_->GetNetLinkInfo().dnsList_.front().hostName_, "example.com");
+}
+
+/**
+ * @tc.name: Network003
+ * @tc.desc: A repeated route is applied once and a reordered route list changes nothing
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetworkTest, Network003, TestSize.Level1)
+{
+    NetLinkInfo info = MakeLinkInfo();
+    info.routeList_.push_back(info.routeList_.front());
+    ASSERT_TRUE(network_->UpdateNetLinkInfo(info));
+    NetLinkUpdateStats stats = network_->GetLinkUpdateStats();
+    EXPECT_EQ(stats.routesAdded, info.routeList_.size() - 1);
+
+    info.routeList_.reverse();
+    info.routeList_.pop_back();
+    ASSERT_TRUE(network_->UpdateNetLinkInfo(info));
+    stats = network_->GetLinkUpdateStats();
+    EXPECT_EQ(stats.routesAdded, info.routeList_.size());
+    EXPECT_EQ(stats.routesRemoved, 0);
+    EXPECT_EQ(stats.routeBatches, 1);
+}
+
+/**
+ * @tc.name: Network004
+ * @tc.desc: Parsed addresses compare by value, and parsing does not change the hash
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetworkTest, Network004, TestSize.Level1)
+{
+    Route left = MakeRoute("fd00::1");
+    Route right = MakeRoute("fd00:0:0::1");
+    EXPECT_FALSE(left == right);
+    size_t unparsedHash = left.Hash();
+    left.Parse();
+    right.Parse();
+    EXPECT_TRUE(left.parsed_);
+    EXPECT_TRUE(left.destination_.parsed_);
+    EXPECT_EQ(left.Hash(), unparsedHash);
+    EXPECT_TRUE(left == right);
+    EXPECT_EQ(left.Hash(), right.Hash());
+
+    right.iface_ = "eth1";
+    right.Parse();
+    EXPECT_FALSE(left == right);
+    Route invalid = MakeRoute("not-an-address");
+    EXPECT_FALSE(invalid.destination_.Parse());
+    invalid.Parse();
+    EXPECT_TRUE(invalid == MakeRoute("not-an-address"));
+}
+
+/**
+ * @tc.name: Network005
+ * @tc.desc: Link updates of 5000 routes, parsed at the IPC boundary or built locally
+ * @tc.type: PERF
+ */
+HWTEST_F(NetworkTest, Network005, TestSize.Level2)
+{
+    for (bool parsed : {true, false}) {
+        sptr<NetSupplier> supplier = (std::make_unique<NetSupplier>(NET_TYPE_ETHERNET, "eth0")).release();
+        sptr<Network> network = (std::make_unique<Network>(supplier)).release();
+        network->SetNetLinkNetd(netd_);
+        std::vector<NetLinkInfo> infos;
+        for (int32_t i = 0; i <= PERF_ROUNDS; ++i) {
+            infos.push_back(MakePerfLinkInfo(i / 2, parsed));
+        }
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_TRUE(network->UpdateNetLinkInfo(infos[0]));
+        int64_t initialUs = ElapsedUs(start);
+        start = std::chrono::steady_clock::now();
+        for (int32_t i = 1; i <= PERF_ROUNDS; ++i) {
+            ASSERT_TRUE(network->UpdateNetLinkInfo(infos[i]));
+        }
+        int64_t renewalUs = ElapsedUs(start) / PERF_ROUNDS;
+
+        NetLinkUpdateStats stats = network->GetLinkUpdateStats();
+        EXPECT_EQ(stats.routesAdded, PERF_ROUTE_COUNT + PERF_ROUNDS / 2);
+        EXPECT_EQ(stats.routesRemoved, PERF_ROUNDS / 2);
+        std::cout << PERF_ROUTE_COUNT << " routes " << (parsed ? "parsed at IPC" : "built locally")
+                  << ": first update " << initialUs << "us, renewal " << renewalUs << "us" << std::endl;
+    }
+}
+
+/**
+ * @tc.name: Network006
+ * @tc.desc: A failed route delta is not counted and keeps the old routes, so the next update sends it again
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetworkTest, Network006, TestSize.Level1)
+{
+    NetLinkInfo info = MakeLinkInfo();
+    ASSERT_TRUE(network_->UpdateNetLinkInfo(info));
+    NetLinkInfo next = info;
+    next.routeList_.back() = MakeRoute("10.1.0.0");
+    netd_->routeDeltaResult_ = -1;
+    EXPECT_FALSE(network_->UpdateNetLinkInfo(next));
+    NetLinkUpdateStats stats = network_->GetLinkUpdateStats();
+    EXPECT_EQ(stats.routesAdded, info.routeList_.size());
+    EXPECT_EQ(stats.routesRemoved, 0);
+    EXPECT_EQ(stats.routeBatches, 1);
+    EXPECT_EQ(stats.routeBatchesFailed, 1);
+    EXPECT_EQ(network_->GetNetLinkInfo().routeList_.size(), info.routeList_.size());
+    EXPECT_TRUE(network_->GetNetLinkInfo().routeList_.back() == info.routeList_.back());
+
+    netd_->routeDeltaResult_ = 0;
+    EXPECT_TRUE(network_->UpdateNetLinkInfo(next));
+    stats = network_->GetLinkUpdateStats();
+    EXPECT_EQ(netd_->routeDeltas_, 3);
+    EXPECT_EQ(stats.routesAdded, info.routeList_.size() + 1);
+    EXPECT_EQ(stats.routesRemoved, 1);
+    EXPECT_EQ(stats.routeBatches, 2);
+    EXPECT_TRUE(network_->GetNetLinkInfo().routeList_.back() == next.routeList_.back());
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "timer.h"
+#include "timer_wheel.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t SHORT_DELAY_MS = 20;
+constexpr uint32_t LONG_DELAY_MS = 600000;
+constexpr uint32_t WAIT_TIME_MS = 500;
+constexpr uint32_t SMALL_TIMER_NUM = 1000;
+constexpr uint32_t LARGE_TIMER_NUM = 100000;
+} // namespace
+
+using namespace testing::ext;
+class TimerWheelTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+    static void MeasureInsertCancel(uint32_t count, double &insertNs, double &cancelNs);
+};
+
+void TimerWheelTest::SetUpTestCase() {}
+
+void TimerWheelTest::TearDownTestCase() {}
+
+void TimerWheelTest::SetUp() {}
+
+void TimerWheelTest::TearDown() {}
+
+void TimerWheelTest::MeasureInsertCancel(uint32_t count, double &insertNs, double &cancelNs)
+{
+    auto wheel = DelayedSingleton<TimerWheel>::GetInstance();
+    std::vector<TimerWheel::TimerId> ids;
+    ids.reserve(count);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < count; i++) {
+        ids.push_back(wheel->StartOnce(LONG_DELAY_MS + i, []() {}));
+    }
+    auto end = std::chrono::steady_clock::now();
+    insertNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / count;
+    EXPECT_GE(wheel->GetPendingSize(), count);
+
+    start = std::chrono::steady_clock::now();
+    for (auto id : ids) {
+        wheel->Cancel(id);
+    }
+    end = std::chrono::steady_clock::now();
+    cancelNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / count;
+}
+
+/**
+ * @tc.name: TimerWheel001
+ * @tc.desc: Test one-shot timers fire once and cancelled ones never fire.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TimerWheelTest, TimerWheel001, TestSize.Level1)
+{
+    auto wheel = DelayedSingleton<TimerWheel>::GetInstance();
+    std::atomic<int32_t> fired(0);
+    std::atomic<int32_t> cancelled(0);
+    TimerWheel::TimerId firedId = wheel->StartOnce(SHORT_DELAY_MS, [&fired]() { fired++; });
+    TimerWheel::TimerId cancelId = wheel->StartOnce(SHORT_DELAY_MS, [&cancelled]() { cancelled++; });
+    ASSERT_NE(firedId, TimerWheel::INVALID_TIMER_ID);
+    ASSERT_TRUE(wheel->Cancel(cancelId));
+    std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_TIME_MS));
+    ASSERT_EQ(fired.load(), 1);
+    ASSERT_EQ(cancelled.load(), 0);
+    ASSERT_FALSE(wheel->IsPending(firedId));
+    ASSERT_FALSE(wheel->Cancel(firedId));
+}
+
+/**
+ * @tc.name: TimerWheel002
+ * @tc.desc: Test periodic timers repeat until cancelled, and Timer cancels its tasks on destruction.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TimerWheelTest, TimerWheel002, TestSize.Level1)
+{
+    auto wheel = DelayedSingleton<TimerWheel>::GetInstance();
+    std::atomic<int32_t> count(0);
+    TimerWheel::TimerId id = wheel->StartPeriodic(SHORT_DELAY_MS, [&count]() { count++; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_TIME_MS));
+    ASSERT_TRUE(wheel->Cancel(id));
+    int32_t stopped = count.load();
+    ASSERT_GT(stopped, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_TIME_MS));
+    ASSERT_EQ(count.load(), stopped);
+
+    std::atomic<int32_t> onceCount(0);
+    {
+        Timer timer;
+        timer.StartOnce(SHORT_DELAY_MS, [&onceCount]() { onceCount++; });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_TIME_MS));
+    ASSERT_EQ(onceCount.load(), 0);
+}
+
+/**
+ * @tc.name: TimerWheel003
+ * @tc.desc: Test exponential backoff delays stay within the jitter range and the upper bound.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TimerWheelTest, TimerWheel003, TestSize.Level1)
+{
+    const uint32_t baseMs = 1000;
+    const uint32_t maxMs = 30000;
+    for (uint32_t attempt = 0; attempt < 40; attempt++) {
+        uint64_t full = static_cast<uint64_t>(baseMs) << std::min<uint32_t>(attempt, 31);
+        full = std::min<uint64_t>(full, maxMs);
+        uint32_t delay = TimerWheel::GetBackoffDelay(baseMs, maxMs, attempt);
+        ASSERT_GE(delay, full / 2);
+        ASSERT_LE(delay, full);
+    }
+}
+
+/**
+ * @tc.name: TimerWheel004
+ * @tc.desc: Benchmark insert and cancel with 1k and 100k pending timers.
+ * @tc.type: PERF
+ */
+HWTEST_F(TimerWheelTest, TimerWheel004, TestSize.Level2)
+{
+    double smallInsertNs = 0;
+    double smallCancelNs = 0;
+    double largeInsertNs = 0;
+    double largeCancelNs = 0;
+    MeasureInsertCancel(SMALL_TIMER_NUM, smallInsertNs, smallCancelNs);
+    MeasureInsertCancel(LARGE_TIMER_NUM, largeInsertNs, largeCancelNs);
+    std::cout << "TimerWheel004 timers:" << SMALL_TIMER_NUM << " insert ns:" << smallInsertNs
+              << " cancel ns:" << smallCancelNs << std::endl;
+    std::cout << "TimerWheel004 timers:" << LARGE_TIMER_NUM << " insert ns:" << largeInsertNs
+              << " cancel ns:" << largeCancelNs << std::endl;
+    testing::Test::RecordProperty("TimerWheel.small_insert_ns", static_cast<int>(smallInsertNs));
+    testing::Test::RecordProperty("TimerWheel.small_cancel_ns", static_cast<int>(smallCancelNs));
+    testing::Test::RecordProperty("TimerWheel.large_insert_ns", static_cast<int>(largeInsertNs));
+    testing::Test::RecordProperty("TimerWheel.large_cancel_ns", static_cast<int>(largeCancelNs));
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
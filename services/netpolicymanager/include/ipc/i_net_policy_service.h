@@ -16,11 +16,16 @@
 #ifndef I_NET_POLICY_SERVICE_H
 #define I_NET_POLICY_SERVICE_H
 
+#include <utility>
+#include <vector>
+
 #include "iremote_broker.h"
 #include "net_policy_constants.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
+constexpr uint32_t MAX_UID_POLICY_BATCH_SIZE = 10000;
+
 class INetPolicyService : public IRemoteBroker {
 public:
     DECLARE_INTERFACE_DESCRIPTOR(u"OHOS.NetManagerStandard.INetPolicyService");
@@ -31,11 +36,13 @@ public:
         CMD_NSM_GET_UIDS = 3,
         CMD_NSM_IS_NET_ACCESS_METERED = 4,
         CMD_NSM_IS_NET_ACCESS_IFACENAME = 5,
+        CMD_NSM_SET_UID_POLICIES = 6,
         CMD_NSM_END = 100,
     };
 
 public:
     virtual NetPolicyResultCode SetUidPolicy(uint32_t uid, NetUidPolicy policy) = 0;
+    virtual NetPolicyResultCode SetUidPolicies(const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies) = 0;
     virtual NetUidPolicy GetUidPolicy(uint32_t uid) = 0;
     virtual std::vector<uint32_t> GetUids(NetUidPolicy policy) = 0;
     virtual bool IsUidNetAccess(uint32_t uid, bool metered) = 0;
@@ -28,6 +28,7 @@ public:
     explicit NetPolicyServiceProxy(const sptr<IRemoteObject> &impl);
     virtual ~NetPolicyServiceProxy();
     NetPolicyResultCode SetUidPolicy(uint32_t uid, NetUidPolicy policy) override;
+    NetPolicyResultCode SetUidPolicies(const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies) override;
     NetUidPolicy GetUidPolicy(uint32_t uid) override;
     std::vector<uint32_t> GetUids(NetUidPolicy policy) override;
     bool IsUidNetAccess(uint32_t uid, bool metered) override;
@@ -16,11 +16,10 @@
 #ifndef NET_POLICY_SERVICE_STUB_H
 #define NET_POLICY_SERVICE_STUB_H
 
-#include <map>
-
 #include "iremote_stub.h"
 
 #include "i_net_policy_service.h"
+#include "ipc_stub_dispatch_table.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
@@ -32,18 +31,17 @@ public:
     int32_t OnRemoteRequest(
         uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override;
 
-private:
-    using NetPolicyServiceFunc = int32_t (NetPolicyServiceStub::*)(MessageParcel &, MessageParcel &);
-
 private:
     int32_t OnSetUidPolicy(MessageParcel &data, MessageParcel &reply);
+    int32_t OnSetUidPolicies(MessageParcel &data, MessageParcel &reply);
     int32_t OnGetUidPolicy(MessageParcel &data, MessageParcel &reply);
     int32_t OnGetUids(MessageParcel &data, MessageParcel &reply);
     int32_t OnIsUidNetAccessMetered(MessageParcel &data, MessageParcel &reply);
     int32_t OnIsUidNetAccessIfaceName(MessageParcel &data, MessageParcel &reply);
 
 private:
-    std::map<uint32_t, NetPolicyServiceFunc> memberFuncMap_;
+    using DispatchTable = IpcStubDispatchTable<NetPolicyServiceStub, CMD_NSM_SET_UID_POLICIES + 1>;
+    static const DispatchTable &GetDispatchTable();
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -20,6 +20,11 @@ namespace OHOS {
 namespace NetManagerStandard {
 const mode_t CHOWN_RWX_USR_GRP = 0770;
 const char POLICY_FILE_NAME[] = "/data/system/net_policy.json";
+const char POLICY_JOURNAL_FILE_NAME[] = "/data/system/net_policy.journal";
+const char POLICY_SNAPSHOT_FILE_NAME[] = "/data/system/net_policy.bin";
+const char POLICY_FILE_TMP_SUFFIX[] = ".tmp";
+/* fold the journal into the snapshot once it holds this many records and at least as many as the uids */
+const uint32_t JOURNAL_COMPACT_MIN_RECORDS = 1024;
 const char CONFIG_HOS_VERSION[] = "hosVersion";
 const char CONFIG_UID_POLICY[] = "uidPolicy";
 const char CONFIG_UID[] = "uid";
@@ -22,6 +22,9 @@
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <unordered_set>
+#include <utility>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/sendfile.h>
@@ -33,6 +36,9 @@
 
 #include "net_policy_constants.h"
 #include "net_policy_define.h"
+#include "net_policy_journal.h"
+#include "net_policy_snapshot.h"
+#include "net_policy_uid_table.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
@@ -44,22 +50,84 @@ enum class NetUidPolicyOpType {
 
 class NetPolicyFile : public virtual RefBase {
 public:
+    NetPolicyFile();
+    NetPolicyFile(const std::string &policyFileName, const std::string &journalFileName,
+        const std::string &snapshotFileName);
+
+    /**
+     * @brief Map the binary snapshot and replay the journal on top of it, a legacy JSON policy file is migrated to
+     * a binary snapshot first
+     *
+     * @return Returns false if the legacy JSON policy file can not be read or parsed, it is kept for the next
+     * startup and the journal is not compacted until then
+     */
     bool InitPolicy();
     bool IsUidPolicyExist(uint32_t uid);
     bool ReadFile(const std::string& fileName, std::string& content);
     bool Json2Obj(const std::string& content, NetPolicy& netPolicy);
-    bool WriteFile(const std::string& fileName);
     bool WriteFile(const NetUidPolicyOpType netUidPolicyOpType, uint32_t uid, NetUidPolicy policy);
+
+    /**
+     * @brief Apply a batch of uid policys atomically and persist them with one journal flush
+     *
+     * @param uidPolicies Pairs of uid and policy, NET_POLICY_NONE deletes the uid policy
+     * @return Returns false if any policy is out of range or the batch could not be persisted
+     */
+    bool WriteFile(const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies);
+
+    /**
+     * @brief Write the whole policy set to the binary snapshot and empty the journal
+     *
+     * @return Returns true if the snapshot was replaced
+     */
+    bool Compact();
     NetUidPolicy GetUidPolicy(uint32_t uid);
     bool GetUids(NetUidPolicy policy, std::vector<uint32_t> &uids);
 
 private:
     bool FileExists(const std::string& fileName);
-    bool CreateFile(const std::string& fileName);
+    bool MigrateLegacyPolicy();
+    void ApplyJournalRecord(NetPolicyJournalOp op, uint32_t uid, uint32_t policy);
+
+    /* A uid policy change, applied to the uid policys only once its journal entry is durable */
+    struct StagedChange {
+        uint32_t uid;
+        uint32_t policy;
+        bool isRemove;
+    };
+
+    /* Changes staged by concurrent callers, flushed to the journal and applied by a single leader */
+    struct CommitGroup {
+        std::vector<NetPolicyJournalEntry> entries;
+        std::vector<StagedChange> changes;
+        bool done = false;
+        bool result = false;
+    };
+    std::shared_ptr<CommitGroup> StageLocked(NetUidPolicyOpType netUidPolicyOpType, uint32_t uid, NetUidPolicy policy);
+    bool Commit(const std::shared_ptr<CommitGroup> &group);
+    void ApplyChangesLocked(const std::vector<StagedChange> &changes, std::vector<StagedChange> *undo);
+    bool CompactJournal();
+
+    /* The uid policys are the mapped snapshot overlaid by the changes made since it was written */
+    void SetUidPolicyLocked(uint32_t uid, uint32_t policy);
+    void RemoveUidPolicyLocked(uint32_t uid);
+    bool FindUidPolicyLocked(uint32_t uid, uint32_t &policy) const;
+    void CollectUidPolicysLocked(std::vector<std::pair<uint32_t, uint32_t>> &uidPolicys) const;
+    bool WriteSnapshot();
 
 private:
-    NetPolicy netPolicy_;
+    std::string policyFileName_;
+    std::string snapshotFileName_;
+    NetPolicyJournal journal_;
+    NetPolicySnapshot snapshot_;
+    std::string hosVersion_ = HOS_VERSION;
+    NetPolicyUidTable uidPolicyTable_;
+    std::unordered_set<uint32_t> removedUids_;
     std::mutex mutex_;
+    std::condition_variable commitCond_;
+    std::shared_ptr<CommitGroup> openGroup_;
+    bool committing_ = false;
+    bool legacyPending_ = false;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_POLICY_JOURNAL_H
+#define NET_POLICY_JOURNAL_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+namespace OHOS {
+namespace NetManagerStandard {
+enum class NetPolicyJournalOp : uint8_t {
+    JOURNAL_OP_SET = 1,
+    JOURNAL_OP_DELETE = 2,
+};
+
+struct NetPolicyJournalEntry {
+    NetPolicyJournalOp op;
+    uint32_t uid;
+    uint32_t policy;
+};
+
+/**
+ * Append-only log of uid policy changes, replayed on top of the policy snapshot at startup. Each record carries a
+ * checksum, replay stops at the first torn or corrupted record.
+ */
+class NetPolicyJournal {
+public:
+    using ReplayCallback = std::function<void(NetPolicyJournalOp op, uint32_t uid, uint32_t policy)>;
+
+    explicit NetPolicyJournal(const std::string &fileName);
+    ~NetPolicyJournal();
+
+    /**
+     * @brief Apply every intact record in order, then drop the tail after the last intact record
+     *
+     * @param callback Called for each record
+     * @return The number of records applied
+     */
+    uint32_t Replay(const ReplayCallback &callback);
+    bool Append(NetPolicyJournalOp op, uint32_t uid, uint32_t policy);
+
+    /**
+     * @brief Append the entries with a single write and make them durable with one flush. On failure the journal
+     *        is cut back to its size before the call, so none of the entries is replayed
+     *
+     * @param entries The entries in apply order
+     * @return Returns true if every entry reached the disk
+     */
+    bool Append(const std::vector<NetPolicyJournalEntry> &entries);
+
+    /**
+     * @brief Empty the journal after its records were folded into a new snapshot
+     */
+    bool Reset();
+    uint32_t GetRecordCount() const;
+
+private:
+    struct Record {
+        uint32_t uid;
+        uint32_t policy;
+        uint8_t op;
+        uint8_t reserved[3];
+        uint32_t checksum;
+    };
+
+    bool Open();
+    void Close();
+    void Truncate(off_t offset);
+    static uint32_t Checksum(const Record &record);
+
+private:
+    std::string fileName_;
+    int32_t fd_ = -1;
+    uint32_t recordCount_ = 0;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_POLICY_JOURNAL_H
@@ -44,6 +44,15 @@ public:
      * @return Returns 0 success, otherwise fail
      */
     NetPolicyResultCode SetUidPolicy(uint32_t uid, NetUidPolicy policy) override;
+
+    /**
+     * @brief The interface is set the policys of many uids at once
+     *
+     * @param uidPolicies Pairs of uid and policy, NET_POLICY_NONE deletes the uid policy
+     *
+     * @return Returns 0 success, otherwise fail and no policy is changed
+     */
+    NetPolicyResultCode SetUidPolicies(const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies) override;
     NetUidPolicy GetUidPolicy(uint32_t uid) override;
     std::vector<uint32_t> GetUids(NetUidPolicy policy) override;
     bool IsUidNetAccess(uint32_t uid, bool metered) override;
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_POLICY_SNAPSHOT_H
+#define NET_POLICY_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Read only view of a binary uid policy snapshot mapped into memory. Lookups run directly on the mapping: the
+ * entries are sorted by uid for binary search and the uids of every policy are stored next to each other.
+ *
+ * Layout: Header | Entry[entryCount] sorted by uid | PolicyIndex[policyCount] | uid[entryCount] grouped by policy
+ */
+class NetPolicySnapshot {
+public:
+    NetPolicySnapshot() = default;
+    ~NetPolicySnapshot();
+    NetPolicySnapshot(const NetPolicySnapshot &) = delete;
+    NetPolicySnapshot &operator=(const NetPolicySnapshot &) = delete;
+
+    /**
+     * @brief Map the snapshot file and check its magic, version, layout and checksum
+     *
+     * @param fileName The snapshot file
+     * @return Returns false if the file is missing or invalid, the snapshot is empty then
+     */
+    bool Open(const std::string &fileName);
+    void Close();
+
+    /**
+     * @brief Exchange the mappings, so a snapshot opened aside replaces the current one in O(1)
+     *
+     * @param other The snapshot to exchange with
+     */
+    void Swap(NetPolicySnapshot &other);
+    bool IsOpen() const;
+    bool Find(uint32_t uid, uint32_t &policy) const;
+    bool Contains(uint32_t uid) const;
+
+    /**
+     * @brief The uids of the policy inside the mapping, in ascending order
+     *
+     * @param policy The policy
+     * @param count Set to the number of uids
+     * @return Pointer to the first uid, nullptr if there is none
+     */
+    const uint32_t *GetUids(uint32_t policy, uint32_t &count) const;
+    uint32_t Size() const;
+    std::string GetHosVersion() const;
+
+    template<typename Func>
+    void ForEach(Func func) const
+    {
+        for (uint32_t i = 0; i < entryCount_; i++) {
+            func(entries_[i].uid, entries_[i].policy);
+        }
+    }
+
+    /**
+     * @brief Write a snapshot of the entries to a temporary file, sync it and rename it over the file
+     *
+     * @param fileName The snapshot file
+     * @param hosVersion The version string kept in the header
+     * @param entries Pairs of uid and policy, sorted in place
+     * @return Returns true if the snapshot was replaced
+     */
+    static bool Write(const std::string &fileName, const std::string &hosVersion,
+        std::vector<std::pair<uint32_t, uint32_t>> &entries);
+
+private:
+    static constexpr size_t HOS_VERSION_LEN = 12;
+
+    struct Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t headerSize;
+        uint32_t entryCount;
+        uint32_t policyCount;
+        uint32_t checksum;
+        char hosVersion[HOS_VERSION_LEN];
+    };
+
+    struct Entry {
+        uint32_t uid;
+        uint32_t policy;
+    };
+
+    struct PolicyIndex {
+        uint32_t policy;
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    static size_t GetFileSize(uint32_t entryCount, uint32_t policyCount);
+    static uint32_t Checksum(const Header &header, const uint8_t *body, size_t len);
+    bool Check(size_t size);
+
+private:
+    void *mapAddr_ = nullptr;
+    size_t mapSize_ = 0;
+    const Header *header_ = nullptr;
+    const Entry *entries_ = nullptr;
+    const PolicyIndex *policyIndexs_ = nullptr;
+    const uint32_t *policyUids_ = nullptr;
+    uint32_t entryCount_ = 0;
+    uint32_t policyCount_ = 0;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_POLICY_SNAPSHOT_H
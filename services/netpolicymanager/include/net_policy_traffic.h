@@ -31,6 +31,7 @@ public:
     NetPolicyResultCode AddUidPolicy(uint32_t uid, NetUidPolicy policy);
     NetPolicyResultCode SetUidPolicy(uint32_t uid, NetUidPolicy policy);
     NetPolicyResultCode DeleteUidPolicy(uint32_t uid, NetUidPolicy policy);
+    NetPolicyResultCode SetUidPolicies(const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies);
     bool IsPolicyValid(NetUidPolicy &policy);
 
 private:
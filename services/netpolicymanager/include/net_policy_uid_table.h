@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_POLICY_UID_TABLE_H
+#define NET_POLICY_UID_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * uid -> policy table on an open addressing hash with linear probing, plus a per-policy list of uids.
+ */
+class NetPolicyUidTable {
+public:
+    static constexpr uint32_t MAX_POLICY = UINT8_MAX;
+
+    NetPolicyUidTable();
+
+    /**
+     * @brief Add the uid or update its policy
+     *
+     * @param uid The uid
+     * @param policy The policy bits, must fit in uint8_t
+     * @return Returns false if the policy is out of range
+     */
+    bool Set(uint32_t uid, uint32_t policy);
+    bool Remove(uint32_t uid);
+    bool Find(uint32_t uid, uint32_t &policy) const;
+    bool Contains(uint32_t uid) const;
+
+    /**
+     * @brief All uids of the policy, in no particular order
+     */
+    const std::vector<uint32_t> &GetUids(uint32_t policy) const;
+    size_t Size() const;
+    void Clear();
+
+    template<typename Func>
+    void ForEach(Func func) const
+    {
+        for (const auto &slot : slots_) {
+            if (slot.used) {
+                func(slot.uid, static_cast<uint32_t>(slot.policy));
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        uint32_t uid = 0;
+        uint32_t reversePos = 0;
+        uint8_t policy = 0;
+        bool used = false;
+    };
+
+    size_t IndexOf(uint32_t uid) const;
+    size_t FindSlot(uint32_t uid) const;
+    void Rehash(size_t capacity);
+    void AddReverse(Slot &slot);
+    void RemoveReverse(const Slot &slot);
+    void EraseSlot(size_t pos);
+
+private:
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+    uint32_t shift_ = 0;
+    std::unordered_map<uint8_t, std::vector<uint32_t>> reverse_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_POLICY_UID_TABLE_H
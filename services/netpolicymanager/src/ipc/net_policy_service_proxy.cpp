@@ -58,6 +58,54 @@ NetPolicyResultCode NetPolicyServiceProxy::SetUidPolicy(uint32_t uid, NetUidPoli
     return static_cast<NetPolicyResultCode>(reply.ReadInt32());
 }
 
+NetPolicyResultCode NetPolicyServiceProxy::SetUidPolicies(
+    const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies)
+{
+    if (uidPolicies.size() > MAX_UID_POLICY_BATCH_SIZE) {
+        NETMGR_LOGE("uid policy batch size[%{public}zu] exceeds the limit", uidPolicies.size());
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+    if (!WriteInterfaceToken(data)) {
+        NETMGR_LOGE("WriteInterfaceToken failed");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    std::vector<uint32_t> uids;
+    std::vector<uint32_t> policys;
+    uids.reserve(uidPolicies.size());
+    policys.reserve(uidPolicies.size());
+    for (const auto &uidPolicy : uidPolicies) {
+        uids.push_back(uidPolicy.first);
+        policys.push_back(static_cast<uint32_t>(uidPolicy.second));
+    }
+
+    if (!data.WriteUInt32Vector(uids)) {
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    if (!data.WriteUInt32Vector(policys)) {
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOGE("Remote is null");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    int32_t error = remote->SendRequest(CMD_NSM_SET_UID_POLICIES, data, reply, option);
+    if (error != ERR_NONE) {
+        NETMGR_LOGE("proxy SendRequest failed, error code: [%{public}d]", error);
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    return static_cast<NetPolicyResultCode>(reply.ReadInt32());
+}
+
 NetUidPolicy NetPolicyServiceProxy::GetUidPolicy(uint32_t uid)
 {
     MessageParcel data;
@@ -18,17 +18,24 @@
 
 namespace OHOS {
 namespace NetManagerStandard {
-NetPolicyServiceStub::NetPolicyServiceStub()
-{
-    memberFuncMap_[CMD_NSM_SET_UID_POLICY] = &NetPolicyServiceStub::OnSetUidPolicy;
-    memberFuncMap_[CMD_NSM_GET_UID_POLICY] = &NetPolicyServiceStub::OnGetUidPolicy;
-    memberFuncMap_[CMD_NSM_GET_UIDS] = &NetPolicyServiceStub::OnGetUids;
-    memberFuncMap_[CMD_NSM_IS_NET_ACCESS_METERED] = &NetPolicyServiceStub::OnIsUidNetAccessMetered;
-    memberFuncMap_[CMD_NSM_IS_NET_ACCESS_IFACENAME] = &NetPolicyServiceStub::OnIsUidNetAccessIfaceName;
-}
+NetPolicyServiceStub::NetPolicyServiceStub() {}
 
 NetPolicyServiceStub::~NetPolicyServiceStub() {}
 
+const NetPolicyServiceStub::DispatchTable &NetPolicyServiceStub::GetDispatchTable()
+{
+    /* constexpr so the table is built at compile time and a code past the table end fails to compile */
+    static constexpr DispatchTable table({
+        {CMD_NSM_SET_UID_POLICY, &NetPolicyServiceStub::OnSetUidPolicy},
+        {CMD_NSM_SET_UID_POLICIES, &NetPolicyServiceStub::OnSetUidPolicies},
+        {CMD_NSM_GET_UID_POLICY, &NetPolicyServiceStub::OnGetUidPolicy},
+        {CMD_NSM_GET_UIDS, &NetPolicyServiceStub::OnGetUids},
+        {CMD_NSM_IS_NET_ACCESS_METERED, &NetPolicyServiceStub::OnIsUidNetAccessMetered},
+        {CMD_NSM_IS_NET_ACCESS_IFACENAME, &NetPolicyServiceStub::OnIsUidNetAccessIfaceName},
+    });
+    return table;
+}
+
 int32_t NetPolicyServiceStub::OnRemoteRequest(
     uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option)
 {
@@ -39,12 +46,9 @@ int32_t NetPolicyServiceStub::OnRemoteRequest(
         return ERR_FLATTEN_OBJECT;
     }
 
-    auto itFunc = memberFuncMap_.find(code);
-    if (itFunc != memberFuncMap_.end()) {
-        auto requestFunc = itFunc->second;
-        if (requestFunc != nullptr) {
-            return (this->*requestFunc)(data, reply);
-        }
+    auto requestFunc = GetDispatchTable().Find(code);
+    if (requestFunc != nullptr) {
+        return (this->*requestFunc)(data, reply);
     }
 
     return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
@@ -69,6 +73,36 @@ int32_t NetPolicyServiceStub::OnSetUidPolicy(MessageParcel &data, MessageParcel
     return ERR_NONE;
 }
 
+int32_t NetPolicyServiceStub::OnSetUidPolicies(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<uint32_t> uids;
+    if (!data.ReadUInt32Vector(&uids)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    std::vector<uint32_t> policys;
+    if (!data.ReadUInt32Vector(&policys)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    if (uids.size() != policys.size() || uids.size() > MAX_UID_POLICY_BATCH_SIZE) {
+        NETMGR_LOGE("invalid uid policy batch, uids[%{public}zu] policys[%{public}zu]", uids.size(), policys.size());
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    std::vector<std::pair<uint32_t, NetUidPolicy>> uidPolicies;
+    uidPolicies.reserve(uids.size());
+    for (size_t i = 0; i < uids.size(); i++) {
+        uidPolicies.emplace_back(uids[i], static_cast<NetUidPolicy>(policys[i]));
+    }
+
+    if (!reply.WriteInt32(static_cast<int32_t>(SetUidPolicies(uidPolicies)))) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    return ERR_NONE;
+}
+
 int32_t NetPolicyServiceStub::OnGetUidPolicy(MessageParcel &data, MessageParcel &reply)
 {
     uint32_t uid;
@@ -14,6 +14,10 @@
  */
 #include "net_policy_file.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
 #include <json/json.h>
 #include <fcntl.h>
 
@@ -22,27 +26,40 @@
 
 namespace OHOS {
 namespace NetManagerStandard {
-bool NetPolicyFile::FileExists(const std::string &fileName)
+namespace {
+void ParseUidPolicys(const NetPolicy &netPolicy, std::vector<std::pair<uint32_t, uint32_t>> &uidPolicys)
 {
-    struct stat buffer;
-    return (stat(fileName.c_str(), &buffer) == static_cast<int32_t>(NetPolicyResultCode::ERR_NONE));
+    for (const auto &uidPolicy : netPolicy.uidPolicys) {
+        char *uidEnd = nullptr;
+        char *policyEnd = nullptr;
+        unsigned long uid = std::strtoul(uidPolicy.uid.c_str(), &uidEnd, CONVERT_LENGTH_TEN);
+        unsigned long policy = std::strtoul(uidPolicy.policy.c_str(), &policyEnd, CONVERT_LENGTH_TEN);
+        if (uidPolicy.uid.empty() || *uidEnd != '\0' || uid > UINT32_MAX ||
+            uidPolicy.policy.empty() || *policyEnd != '\0' || policy > NetPolicyUidTable::MAX_POLICY) {
+            NETMGR_LOGE("invalid uid policy, uid[%{public}s] policy[%{public}s]",
+                uidPolicy.uid.c_str(), uidPolicy.policy.c_str());
+            continue;
+        }
+        uidPolicys.emplace_back(static_cast<uint32_t>(uid), static_cast<uint32_t>(policy));
+    }
 }
+} // namespace
 
-bool NetPolicyFile::CreateFile(const std::string& fileName)
+NetPolicyFile::NetPolicyFile()
+    : NetPolicyFile(POLICY_FILE_NAME, POLICY_JOURNAL_FILE_NAME, POLICY_SNAPSHOT_FILE_NAME)
 {
-    if (fileName.empty() || FileExists(fileName)) {
-        NETMGR_LOGE("fileName empty or file not exists.");
-        return false;
-    }
+}
 
-    int32_t fd = open(fileName.c_str(), O_CREAT | O_WRONLY, CHOWN_RWX_USR_GRP);
-    if (fd < 0) {
-        NETMGR_LOGE("open file error.");
-        return false;
-    }
-    close(fd);
+NetPolicyFile::NetPolicyFile(const std::string &policyFileName, const std::string &journalFileName,
+    const std::string &snapshotFileName)
+    : policyFileName_(policyFileName), snapshotFileName_(snapshotFileName), journal_(journalFileName)
+{
+}
 
-    return true;
+bool NetPolicyFile::FileExists(const std::string &fileName)
+{
+    struct stat buffer;
+    return (stat(fileName.c_str(), &buffer) == static_cast<int32_t>(NetPolicyResultCode::ERR_NONE));
 }
 
 bool NetPolicyFile::Json2Obj(const std::string &content, NetPolicy &netPolicy)
@@ -72,7 +89,7 @@ bool NetPolicyFile::Json2Obj(const std::string &content, NetPolicy &netPolicy)
         }
     }
 
-    return true;
+    return isSuccess && errs.empty();
 }
 
 bool NetPolicyFile::ReadFile(const std::string &fileName, std::string &fileContent)
@@ -102,124 +119,325 @@ bool NetPolicyFile::ReadFile(const std::string &fileName, std::string &fileConte
     return true;
 }
 
-bool NetPolicyFile::WriteFile(const std::string &fileName)
+std::shared_ptr<NetPolicyFile::CommitGroup> NetPolicyFile::StageLocked(
+    NetUidPolicyOpType netUidPolicyOpType, uint32_t uid, NetUidPolicy policy)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (fileName.empty()) {
-        NETMGR_LOGE("fileName is empty.");
-        return false;
+    NetPolicyJournalOp journalOp = NetPolicyJournalOp::JOURNAL_OP_SET;
+    bool isRemove = (netUidPolicyOpType == NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_DELETE);
+    if (isRemove) {
+        journalOp = NetPolicyJournalOp::JOURNAL_OP_DELETE;
+    }
+    /* Temporary permission is not persisted, after a restart the uid has no policy */
+    if (policy == NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED) {
+        journalOp = NetPolicyJournalOp::JOURNAL_OP_DELETE;
     }
+    if (openGroup_ == nullptr) {
+        openGroup_ = std::make_shared<CommitGroup>();
+    }
+    openGroup_->entries.push_back({journalOp, uid, static_cast<uint32_t>(policy)});
+    openGroup_->changes.push_back({uid, static_cast<uint32_t>(policy), isRemove});
+    return openGroup_;
+}
 
-    Json::Value root;
-    Json::StreamWriterBuilder builder;
-    std::unique_ptr<Json::StreamWriter> streamWriter(builder.newStreamWriter());
-    std::fstream file(fileName.c_str(), std::fstream::out);
-    if (file.is_open() == false) {
-        NETMGR_LOGE("fstream failed.");
+void NetPolicyFile::ApplyChangesLocked(const std::vector<StagedChange> &changes, std::vector<StagedChange> *undo)
+{
+    for (const auto &change : changes) {
+        if (undo != nullptr) {
+            uint32_t policy = 0;
+            bool isFound = FindUidPolicyLocked(change.uid, policy);
+            undo->push_back({change.uid, policy, !isFound});
+        }
+        if (change.isRemove) {
+            RemoveUidPolicyLocked(change.uid);
+        } else {
+            SetUidPolicyLocked(change.uid, change.policy);
+        }
+    }
+}
+
+bool NetPolicyFile::WriteFile(const NetUidPolicyOpType netUidPolicyOpType, uint32_t uid, NetUidPolicy policy)
+{
+    if (static_cast<uint32_t>(policy) > NetPolicyUidTable::MAX_POLICY) {
+        NETMGR_LOGE("policy[%{public}u] is out of range", static_cast<uint32_t>(policy));
         return false;
     }
+    std::shared_ptr<CommitGroup> group;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        group = StageLocked(netUidPolicyOpType, uid, policy);
+    }
+    return Commit(group);
+}
 
-    root[CONFIG_HOS_VERSION] = Json::Value(netPolicy_.hosVersion);
-    uint32_t size = netPolicy_.uidPolicys.size();
-    for (uint32_t i = 0; i < size; i++) {
-        Json::Value uidPolicy;
-        uidPolicy[CONFIG_UID] = netPolicy_.uidPolicys[i].uid;
-        uidPolicy[CONFIG_POLICY] = netPolicy_.uidPolicys[i].policy;
-        std::string policy = std::to_string(static_cast<uint32_t>(NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED));
-        /* Temporary permission, no need to write files */
-        if (netPolicy_.uidPolicys[i].policy == policy) {
-            continue;
+bool NetPolicyFile::WriteFile(const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies)
+{
+    for (const auto &uidPolicy : uidPolicies) {
+        if (static_cast<uint32_t>(uidPolicy.second) > NetPolicyUidTable::MAX_POLICY) {
+            NETMGR_LOGE("policy[%{public}u] is out of range", static_cast<uint32_t>(uidPolicy.second));
+            return false;
         }
-        root[CONFIG_UID_POLICY].append(uidPolicy);
     }
-    std::ostringstream out;
-    streamWriter->write(root, &out);
-    file << out.str().c_str();
-    file.close();
-
-    return true;
+    if (uidPolicies.empty()) {
+        return true;
+    }
+    std::shared_ptr<CommitGroup> group;
+    {
+        /* Staged under one lock, the batch lands in one commit group and readers see all of it or none */
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (const auto &uidPolicy : uidPolicies) {
+            NetUidPolicyOpType opType = (uidPolicy.second == NetUidPolicy::NET_POLICY_NONE) ?
+                NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_DELETE : NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_UPDATE;
+            group = StageLocked(opType, uidPolicy.first, uidPolicy.second);
+        }
+    }
+    return Commit(group);
 }
 
-bool NetPolicyFile::WriteFile(const NetUidPolicyOpType netUidPolicyOpType, uint32_t uid, NetUidPolicy policy)
+bool NetPolicyFile::Commit(const std::shared_ptr<CommitGroup> &group)
 {
-    if (netUidPolicyOpType == NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_UPDATE) {
-        for (auto &uidPolicy : netPolicy_.uidPolicys) {
-            if (uidPolicy.uid == std::to_string(uid)) {
-                uidPolicy.policy = std::to_string(static_cast<uint32_t>(policy));
-                break;
-            }
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!group->done) {
+        if (committing_) {
+            /* Changes staged while another flush runs are merged into the next group */
+            commitCond_.wait(lock);
+            continue;
         }
-    } else if (netUidPolicyOpType == NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_DELETE) {
-        for (auto iter = netPolicy_.uidPolicys.begin(); iter != netPolicy_.uidPolicys.end(); ++iter) {
-            if (iter->uid == std::to_string(uid)) {
-                netPolicy_.uidPolicys.erase(iter);
-                break;
+        committing_ = true;
+        std::shared_ptr<CommitGroup> current = openGroup_;
+        openGroup_ = nullptr;
+        size_t uidCount = snapshot_.Size() + uidPolicyTable_.Size();
+        lock.unlock();
+
+        /* Only the leader changes the uid policys, readers never see a change that failed to persist */
+        bool result = journal_.Append(current->entries);
+        if (!result) {
+            NETMGR_LOGE("append journal failed, fall back to a full rewrite");
+            std::vector<StagedChange> undo;
+            lock.lock();
+            ApplyChangesLocked(current->changes, &undo);
+            lock.unlock();
+            result = CompactJournal();
+            if (!result) {
+                std::reverse(undo.begin(), undo.end());
+                lock.lock();
+                ApplyChangesLocked(undo, nullptr);
+                lock.unlock();
+            }
+        } else {
+            lock.lock();
+            ApplyChangesLocked(current->changes, nullptr);
+            lock.unlock();
+            if (journal_.GetRecordCount() >= JOURNAL_COMPACT_MIN_RECORDS && journal_.GetRecordCount() >= uidCount) {
+                /* Compact once the journal outgrows the table, every op pays O(1) amortized */
+                CompactJournal();
             }
         }
-    } else {
-        UidPolicy uidPolicy;
-        uidPolicy.uid = std::to_string(uid);
-        uidPolicy.policy = std::to_string(static_cast<uint32_t>(policy));
-        netPolicy_.uidPolicys.push_back(uidPolicy);
+
+        lock.lock();
+        current->done = true;
+        current->result = result;
+        committing_ = false;
+        commitCond_.notify_all();
     }
+    return group->result;
+}
 
-    if (!WriteFile(POLICY_FILE_NAME)) {
-        NETMGR_LOGE("WriteFile failed");
+bool NetPolicyFile::CompactJournal()
+{
+    if (legacyPending_) {
+        /* A snapshot would hide the legacy policy file that could not be migrated yet */
+        NETMGR_LOGE("legacy policy file not migrated, keep the journal");
         return false;
     }
+    if (!WriteSnapshot()) {
+        return false;
+    }
+    /* Replaying records already in the snapshot is harmless, a crash before the reset loses nothing */
+    return journal_.Reset();
+}
 
-    return true;
+bool NetPolicyFile::Compact()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    commitCond_.wait(lock, [this]() { return !committing_; });
+    committing_ = true;
+    lock.unlock();
+    bool result = CompactJournal();
+    lock.lock();
+    committing_ = false;
+    commitCond_.notify_all();
+    return result;
 }
 
-bool NetPolicyFile::IsUidPolicyExist(uint32_t uid)
+void NetPolicyFile::SetUidPolicyLocked(uint32_t uid, uint32_t policy)
 {
-    uint32_t size = netPolicy_.uidPolicys.size();
-    for (uint32_t i = 0; i < size; i++) {
-        if (static_cast<uint32_t>(std::stol(netPolicy_.uidPolicys[i].uid)) == uid) {
-            return true;
-        }
+    uidPolicyTable_.Set(uid, policy);
+    removedUids_.erase(uid);
+}
+
+void NetPolicyFile::RemoveUidPolicyLocked(uint32_t uid)
+{
+    uidPolicyTable_.Remove(uid);
+    if (snapshot_.Contains(uid)) {
+        removedUids_.insert(uid);
     }
+}
 
-    return false;
+bool NetPolicyFile::FindUidPolicyLocked(uint32_t uid, uint32_t &policy) const
+{
+    if (uidPolicyTable_.Find(uid, policy)) {
+        return true;
+    }
+    if (!removedUids_.empty() && removedUids_.count(uid) != 0) {
+        return false;
+    }
+    return snapshot_.Find(uid, policy);
 }
 
-NetUidPolicy NetPolicyFile::GetUidPolicy(uint32_t uid)
+void NetPolicyFile::CollectUidPolicysLocked(std::vector<std::pair<uint32_t, uint32_t>> &uidPolicys) const
 {
-    for (auto &uidPolicy : netPolicy_.uidPolicys) {
-        if (uidPolicy.uid == std::to_string(uid)) {
-            return static_cast<NetUidPolicy>(std::stol(uidPolicy.policy));
+    uint32_t temporaryPolicy = static_cast<uint32_t>(NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED);
+    uidPolicys.reserve(snapshot_.Size() + uidPolicyTable_.Size());
+    uidPolicyTable_.ForEach([&uidPolicys, temporaryPolicy](uint32_t uid, uint32_t policy) {
+        /* Temporary permission, no need to write files */
+        if (policy != temporaryPolicy) {
+            uidPolicys.emplace_back(uid, policy);
+        }
+    });
+    snapshot_.ForEach([this, &uidPolicys](uint32_t uid, uint32_t policy) {
+        if (!uidPolicyTable_.Contains(uid) && removedUids_.count(uid) == 0) {
+            uidPolicys.emplace_back(uid, policy);
         }
+    });
+}
+
+bool NetPolicyFile::WriteSnapshot()
+{
+    std::vector<std::pair<uint32_t, uint32_t>> uidPolicys;
+    std::string hosVersion;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        CollectUidPolicysLocked(uidPolicys);
+        hosVersion = hosVersion_;
+    }
+    /* Written, synced and mapped without the lock, the caller is the commit leader so nothing changes meanwhile */
+    if (!NetPolicySnapshot::Write(snapshotFileName_, hosVersion, uidPolicys)) {
+        NETMGR_LOGE("write snapshot failed");
+        return false;
+    }
+    NetPolicySnapshot snapshot;
+    bool isMapped = snapshot.Open(snapshotFileName_);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    /* Only the temporary permissions stay in the overlay, everything else is in the new snapshot */
+    std::vector<std::pair<uint32_t, uint32_t>> temporaryPolicys;
+    const std::vector<uint32_t> &temporaryUids =
+        uidPolicyTable_.GetUids(static_cast<uint32_t>(NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED));
+    for (auto uid : temporaryUids) {
+        temporaryPolicys.emplace_back(uid, static_cast<uint32_t>(NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED));
+    }
+    uidPolicyTable_.Clear();
+    removedUids_.clear();
+    snapshot_.Swap(snapshot);
+    if (!isMapped) {
+        NETMGR_LOGE("map the new snapshot failed, keep the policys in memory");
+        temporaryPolicys.insert(temporaryPolicys.end(), uidPolicys.begin(), uidPolicys.end());
+    }
+    for (const auto &item : temporaryPolicys) {
+        uidPolicyTable_.Set(item.first, item.second);
     }
+    return isMapped;
+}
 
-    return NetUidPolicy::NET_POLICY_NONE;
+bool NetPolicyFile::IsUidPolicyExist(uint32_t uid)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint32_t policy = 0;
+    return FindUidPolicyLocked(uid, policy);
+}
+
+NetUidPolicy NetPolicyFile::GetUidPolicy(uint32_t uid)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint32_t policy = static_cast<uint32_t>(NetUidPolicy::NET_POLICY_NONE);
+    FindUidPolicyLocked(uid, policy);
+    return static_cast<NetUidPolicy>(policy);
 }
 
 bool NetPolicyFile::GetUids(NetUidPolicy policy, std::vector<uint32_t> &uids)
 {
-    for (auto &uidPolicy : netPolicy_.uidPolicys) {
-        if (uidPolicy.policy == std::to_string(static_cast<uint32_t>(policy))) {
-            uint32_t uid = static_cast<uint32_t>(std::stol(uidPolicy.uid));
-            uids.push_back(uid);
+    std::unique_lock<std::mutex> lock(mutex_);
+    const std::vector<uint32_t> &policyUids = uidPolicyTable_.GetUids(static_cast<uint32_t>(policy));
+    uids.insert(uids.end(), policyUids.begin(), policyUids.end());
+    uint32_t count = 0;
+    const uint32_t *snapshotUids = snapshot_.GetUids(static_cast<uint32_t>(policy), count);
+    for (uint32_t i = 0; i < count; i++) {
+        /* Uids changed since the snapshot are answered by the overlay */
+        if (!uidPolicyTable_.Contains(snapshotUids[i]) && removedUids_.count(snapshotUids[i]) == 0) {
+            uids.push_back(snapshotUids[i]);
         }
     }
-
     return true;
 }
 
-bool NetPolicyFile::InitPolicy()
+void NetPolicyFile::ApplyJournalRecord(NetPolicyJournalOp op, uint32_t uid, uint32_t policy)
 {
+    if (op == NetPolicyJournalOp::JOURNAL_OP_DELETE) {
+        RemoveUidPolicyLocked(uid);
+    } else if (op == NetPolicyJournalOp::JOURNAL_OP_SET && policy <= NetPolicyUidTable::MAX_POLICY) {
+        SetUidPolicyLocked(uid, policy);
+    } else {
+        NETMGR_LOGE("invalid journal record, op[%{public}u] uid[%{public}u] policy[%{public}u]",
+            static_cast<uint32_t>(op), uid, policy);
+    }
+}
+
+bool NetPolicyFile::MigrateLegacyPolicy()
+{
+    /* Migrate the legacy JSON policy file once, later startups only map the binary snapshot */
     std::string content;
-    if (!ReadFile(POLICY_FILE_NAME, content)) {
-        if (!CreateFile(POLICY_FILE_NAME)) {
-            NETMGR_LOGE("CreateFile [%{public}s] failed", POLICY_FILE_NAME);
-            return false;
+    NetPolicy netPolicy;
+    if (!ReadFile(policyFileName_, content) || !Json2Obj(content, netPolicy)) {
+        /* Keep the file and retry on the next startup, the journal still records every change */
+        NETMGR_LOGE("Analysis fileconfig failed");
+        return false;
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> uidPolicys;
+    ParseUidPolicys(netPolicy, uidPolicys);
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        hosVersion_ = netPolicy.hosVersion;
+        for (const auto &item : uidPolicys) {
+            uidPolicyTable_.Set(item.first, item.second);
         }
     }
-    if (!content.empty() && !Json2Obj(content, netPolicy_)) {
-        NETMGR_LOGE("Analysis fileconfig failed");
+    /* The legacy file is the only copy until the snapshot is on disk */
+    if (!WriteSnapshot()) {
         return false;
     }
+    NETMGR_LOGI("migrated %{public}zu uid policys from [%{public}s]", uidPolicys.size(), policyFileName_.c_str());
+    unlink(policyFileName_.c_str());
     return true;
 }
+
+bool NetPolicyFile::InitPolicy()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (snapshot_.Open(snapshotFileName_)) {
+        hosVersion_ = snapshot_.GetHosVersion();
+    } else if (FileExists(policyFileName_)) {
+        lock.unlock();
+        legacyPending_ = !MigrateLegacyPolicy();
+        lock.lock();
+    }
+
+    /* The snapshot holds the state of the last compaction, the journal every change after it */
+    uint32_t replayed = journal_.Replay([this](NetPolicyJournalOp op, uint32_t uid, uint32_t policy) {
+        ApplyJournalRecord(op, uid, policy);
+    });
+    NETMGR_LOGI("replayed %{public}u journal records on %{public}u snapshot uid policys",
+        replayed, snapshot_.Size());
+    return !legacyPending_;
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
\ No newline at end of file
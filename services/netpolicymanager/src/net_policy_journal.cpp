@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "net_policy_journal.h"
+
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "net_mgr_log_wrapper.h"
+#include "net_policy_define.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t FNV_OFFSET_BASIS = 2166136261;
+constexpr uint32_t FNV_PRIME = 16777619;
+constexpr size_t RECORD_CHECKSUM_OFFSET = 12;
+} // namespace
+
+NetPolicyJournal::NetPolicyJournal(const std::string &fileName) : fileName_(fileName) {}
+
+NetPolicyJournal::~NetPolicyJournal()
+{
+    Close();
+}
+
+uint32_t NetPolicyJournal::Checksum(const Record &record)
+{
+    // FNV-1a over every field before the checksum
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(&record);
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < RECORD_CHECKSUM_OFFSET; i++) {
+        hash ^= data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+bool NetPolicyJournal::Open()
+{
+    if (fd_ >= 0) {
+        return true;
+    }
+    fd_ = open(fileName_.c_str(), O_CREAT | O_RDWR | O_APPEND | O_CLOEXEC, CHOWN_RWX_USR_GRP);
+    if (fd_ < 0) {
+        NETMGR_LOGE("open journal [%{public}s] failed, errno[%{public}d]", fileName_.c_str(), errno);
+        return false;
+    }
+    return true;
+}
+
+void NetPolicyJournal::Close()
+{
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+uint32_t NetPolicyJournal::Replay(const ReplayCallback &callback)
+{
+    if (!Open()) {
+        return 0;
+    }
+    recordCount_ = 0;
+    Record record;
+    off_t offset = 0;
+    while (pread(fd_, &record, sizeof(record), offset) == static_cast<ssize_t>(sizeof(record))) {
+        if (record.checksum != Checksum(record)) {
+            NETMGR_LOGE("journal record %{public}u is corrupted", recordCount_);
+            break;
+        }
+        if (callback != nullptr) {
+            callback(static_cast<NetPolicyJournalOp>(record.op), record.uid, record.policy);
+        }
+        recordCount_++;
+        offset += static_cast<off_t>(sizeof(record));
+    }
+    // Cut a torn tail so new records are not appended behind garbage
+    if (lseek(fd_, 0, SEEK_END) != offset && ftruncate(fd_, offset) != 0) {
+        NETMGR_LOGE("truncate journal failed, errno[%{public}d]", errno);
+    }
+    return recordCount_;
+}
+
+bool NetPolicyJournal::Append(NetPolicyJournalOp op, uint32_t uid, uint32_t policy)
+{
+    return Append(std::vector<NetPolicyJournalEntry>{{op, uid, policy}});
+}
+
+bool NetPolicyJournal::Append(const std::vector<NetPolicyJournalEntry> &entries)
+{
+    if (entries.empty()) {
+        return true;
+    }
+    if (!Open()) {
+        return false;
+    }
+    std::vector<Record> records(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        records[i].uid = entries[i].uid;
+        records[i].policy = entries[i].policy;
+        records[i].op = static_cast<uint8_t>(entries[i].op);
+        records[i].checksum = Checksum(records[i]);
+    }
+    off_t offset = lseek(fd_, 0, SEEK_END);
+    if (offset < 0) {
+        NETMGR_LOGE("seek journal failed, errno[%{public}d]", errno);
+        return false;
+    }
+    size_t size = records.size() * sizeof(Record);
+    ssize_t len = TEMP_FAILURE_RETRY(write(fd_, records.data(), size));
+    if (len != static_cast<ssize_t>(size)) {
+        NETMGR_LOGE("append journal failed, len[%{public}zd] errno[%{public}d]", len, errno);
+        Truncate(offset);
+        return false;
+    }
+    if (fdatasync(fd_) != 0) {
+        NETMGR_LOGE("sync journal failed, errno[%{public}d]", errno);
+        Truncate(offset);
+        return false;
+    }
+    recordCount_ += static_cast<uint32_t>(records.size());
+    return true;
+}
+
+void NetPolicyJournal::Truncate(off_t offset)
+{
+    // A rejected batch must not leave whole records behind, the next replay would apply part of it
+    if (ftruncate(fd_, offset) != 0 || fsync(fd_) != 0) {
+        NETMGR_LOGE("roll back journal failed, errno[%{public}d]", errno);
+    }
+}
+
+bool NetPolicyJournal::Reset()
+{
+    if (!Open()) {
+        return false;
+    }
+    if (ftruncate(fd_, 0) != 0) {
+        NETMGR_LOGE("reset journal failed, errno[%{public}d]", errno);
+        return false;
+    }
+    recordCount_ = 0;
+    return true;
+}
+
+uint32_t NetPolicyJournal::GetRecordCount() const
+{
+    return recordCount_;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
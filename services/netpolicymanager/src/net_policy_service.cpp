@@ -81,7 +81,7 @@ bool NetPolicyService::Init()
 
 NetPolicyResultCode NetPolicyService::SetUidPolicy(uint32_t uid, NetUidPolicy policy)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    /* No service lock, NetPolicyFile serializes the change and merges concurrent calls into one flush */
     NETMGR_LOGI("SetUidPolicy info: uid[%{public}d] policy[%{public}d]", uid, static_cast<uint32_t>(policy));
     /* delete uid policy */
     if (policy == NetUidPolicy::NET_POLICY_NONE) {
@@ -96,6 +96,12 @@ NetPolicyResultCode NetPolicyService::SetUidPolicy(uint32_t uid, NetUidPolicy po
     }
 }
 
+NetPolicyResultCode NetPolicyService::SetUidPolicies(const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies)
+{
+    NETMGR_LOGI("SetUidPolicies info: size[%{public}zu]", uidPolicies.size());
+    return netPolicyTraffic_->SetUidPolicies(uidPolicies);
+}
+
 NetUidPolicy NetPolicyService::GetUidPolicy(uint32_t uid)
 {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "net_policy_snapshot.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "securec.h"
+
+#include "net_mgr_log_wrapper.h"
+#include "net_policy_define.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t SNAPSHOT_MAGIC = 0x4E50534E;
+constexpr uint16_t SNAPSHOT_VERSION = 1;
+constexpr uint32_t FNV_OFFSET_BASIS = 2166136261;
+constexpr uint32_t FNV_PRIME = 16777619;
+
+uint32_t Fnv1a(uint32_t hash, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+} // namespace
+
+NetPolicySnapshot::~NetPolicySnapshot()
+{
+    Close();
+}
+
+size_t NetPolicySnapshot::GetFileSize(uint32_t entryCount, uint32_t policyCount)
+{
+    return sizeof(Header) + entryCount * sizeof(Entry) + policyCount * sizeof(PolicyIndex) +
+        entryCount * sizeof(uint32_t);
+}
+
+uint32_t NetPolicySnapshot::Checksum(const Header &header, const uint8_t *body, size_t len)
+{
+    // The header is covered with its checksum field cleared
+    Header copy = header;
+    copy.checksum = 0;
+    uint32_t hash = Fnv1a(FNV_OFFSET_BASIS, reinterpret_cast<const uint8_t *>(&copy), sizeof(copy));
+    return Fnv1a(hash, body, len);
+}
+
+bool NetPolicySnapshot::Open(const std::string &fileName)
+{
+    Close();
+    int32_t fd = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        NETMGR_LOGI("snapshot [%{public}s] not exist", fileName.c_str());
+        return false;
+    }
+    struct stat buffer;
+    if (fstat(fd, &buffer) != 0 || static_cast<size_t>(buffer.st_size) < sizeof(Header)) {
+        NETMGR_LOGE("snapshot [%{public}s] is truncated", fileName.c_str());
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(buffer.st_size);
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        NETMGR_LOGE("mmap snapshot failed, errno[%{public}d]", errno);
+        return false;
+    }
+    mapAddr_ = addr;
+    mapSize_ = size;
+    if (!Check(size)) {
+        NETMGR_LOGE("snapshot [%{public}s] is corrupted", fileName.c_str());
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool NetPolicySnapshot::Check(size_t size)
+{
+    const uint8_t *base = static_cast<const uint8_t *>(mapAddr_);
+    const Header *header = reinterpret_cast<const Header *>(base);
+    /* Bounds the counts so the layout size cannot overflow, there are never more policys than entries */
+    constexpr size_t maxBytesPerEntry = sizeof(Entry) + sizeof(PolicyIndex) + sizeof(uint32_t);
+    if (header->magic != SNAPSHOT_MAGIC || header->version != SNAPSHOT_VERSION ||
+        header->headerSize != sizeof(Header) ||
+        header->entryCount > (SIZE_MAX - sizeof(Header)) / maxBytesPerEntry ||
+        header->policyCount > header->entryCount ||
+        size != GetFileSize(header->entryCount, header->policyCount)) {
+        return false;
+    }
+    if (header->checksum != Checksum(*header, base + sizeof(Header), size - sizeof(Header))) {
+        return false;
+    }
+    const PolicyIndex *policyIndexs = reinterpret_cast<const PolicyIndex *>(
+        base + sizeof(Header) + header->entryCount * sizeof(Entry));
+    for (uint32_t i = 0; i < header->policyCount; i++) {
+        if (policyIndexs[i].offset > header->entryCount ||
+            policyIndexs[i].count > header->entryCount - policyIndexs[i].offset) {
+            return false;
+        }
+    }
+    header_ = header;
+    entries_ = reinterpret_cast<const Entry *>(base + sizeof(Header));
+    policyIndexs_ = policyIndexs;
+    policyUids_ = reinterpret_cast<const uint32_t *>(policyIndexs + header->policyCount);
+    entryCount_ = header->entryCount;
+    policyCount_ = header->policyCount;
+    return true;
+}
+
+void NetPolicySnapshot::Close()
+{
+    if (mapAddr_ != nullptr) {
+        munmap(mapAddr_, mapSize_);
+    }
+    mapAddr_ = nullptr;
+    mapSize_ = 0;
+    header_ = nullptr;
+    entries_ = nullptr;
+    policyIndexs_ = nullptr;
+    policyUids_ = nullptr;
+    entryCount_ = 0;
+    policyCount_ = 0;
+}
+
+void NetPolicySnapshot::Swap(NetPolicySnapshot &other)
+{
+    std::swap(mapAddr_, other.mapAddr_);
+    std::swap(mapSize_, other.mapSize_);
+    std::swap(header_, other.header_);
+    std::swap(entries_, other.entries_);
+    std::swap(policyIndexs_, other.policyIndexs_);
+    std::swap(policyUids_, other.policyUids_);
+    std::swap(entryCount_, other.entryCount_);
+    std::swap(policyCount_, other.policyCount_);
+}
+
+bool NetPolicySnapshot::IsOpen() const
+{
+    return header_ != nullptr;
+}
+
+bool NetPolicySnapshot::Find(uint32_t uid, uint32_t &policy) const
+{
+    const Entry *end = entries_ + entryCount_;
+    const Entry *it = std::lower_bound(entries_, end, uid,
+        [](const Entry &entry, uint32_t value) { return entry.uid < value; });
+    if (it == end || it->uid != uid) {
+        return false;
+    }
+    policy = it->policy;
+    return true;
+}
+
+bool NetPolicySnapshot::Contains(uint32_t uid) const
+{
+    uint32_t policy = 0;
+    return Find(uid, policy);
+}
+
+const uint32_t *NetPolicySnapshot::GetUids(uint32_t policy, uint32_t &count) const
+{
+    count = 0;
+    for (uint32_t i = 0; i < policyCount_; i++) {
+        if (policyIndexs_[i].policy == policy) {
+            count = policyIndexs_[i].count;
+            return policyUids_ + policyIndexs_[i].offset;
+        }
+    }
+    return nullptr;
+}
+
+uint32_t NetPolicySnapshot::Size() const
+{
+    return entryCount_;
+}
+
+std::string NetPolicySnapshot::GetHosVersion() const
+{
+    if (header_ == nullptr) {
+        return HOS_VERSION;
+    }
+    return std::string(header_->hosVersion, strnlen(header_->hosVersion, HOS_VERSION_LEN));
+}
+
+bool NetPolicySnapshot::Write(const std::string &fileName, const std::string &hosVersion,
+    std::vector<std::pair<uint32_t, uint32_t>> &entries)
+{
+    std::sort(entries.begin(), entries.end());
+    std::vector<std::pair<uint32_t, uint32_t>> byPolicy;
+    byPolicy.reserve(entries.size());
+    for (const auto &entry : entries) {
+        byPolicy.emplace_back(entry.second, entry.first);
+    }
+    std::sort(byPolicy.begin(), byPolicy.end());
+
+    std::vector<PolicyIndex> policyIndexs;
+    for (uint32_t i = 0; i < byPolicy.size(); i++) {
+        if (policyIndexs.empty() || policyIndexs.back().policy != byPolicy[i].first) {
+            policyIndexs.push_back({byPolicy[i].first, i, 0});
+        }
+        policyIndexs.back().count++;
+    }
+
+    Header header = {};
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.headerSize = sizeof(Header);
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    header.policyCount = static_cast<uint32_t>(policyIndexs.size());
+    if (strncpy_s(header.hosVersion, HOS_VERSION_LEN, hosVersion.c_str(), HOS_VERSION_LEN - 1) != EOK) {
+        NETMGR_LOGE("hosVersion [%{public}s] is invalid", hosVersion.c_str());
+        return false;
+    }
+
+    std::vector<uint8_t> content(GetFileSize(header.entryCount, header.policyCount));
+    uint8_t *pos = content.data() + sizeof(Header);
+    for (const auto &entry : entries) {
+        Entry item = {entry.first, entry.second};
+        pos = std::copy_n(reinterpret_cast<const uint8_t *>(&item), sizeof(item), pos);
+    }
+    pos = std::copy_n(reinterpret_cast<const uint8_t *>(policyIndexs.data()),
+        policyIndexs.size() * sizeof(PolicyIndex), pos);
+    for (const auto &item : byPolicy) {
+        pos = std::copy_n(reinterpret_cast<const uint8_t *>(&item.second), sizeof(uint32_t), pos);
+    }
+    header.checksum = Checksum(header, content.data() + sizeof(Header), content.size() - sizeof(Header));
+    std::copy_n(reinterpret_cast<const uint8_t *>(&header), sizeof(header), content.data());
+
+    /* Write a temporary file and rename it, a crash never leaves a half written snapshot */
+    std::string tmpFileName = fileName + POLICY_FILE_TMP_SUFFIX;
+    int32_t fd = open(tmpFileName.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, CHOWN_RWX_USR_GRP);
+    if (fd < 0) {
+        NETMGR_LOGE("open [%{public}s] failed, errno[%{public}d]", tmpFileName.c_str(), errno);
+        return false;
+    }
+    size_t written = 0;
+    while (written < content.size()) {
+        ssize_t len = TEMP_FAILURE_RETRY(write(fd, content.data() + written, content.size() - written));
+        if (len <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(len);
+    }
+    bool isSuccess = (written == content.size()) && (fsync(fd) == 0);
+    close(fd);
+    if (!isSuccess || rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+        NETMGR_LOGE("write [%{public}s] failed, errno[%{public}d]", fileName.c_str(), errno);
+        unlink(tmpFileName.c_str());
+        return false;
+    }
+    return true;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -105,5 +105,27 @@ NetPolicyResultCode NetPolicyTraffic::DeleteUidPolicy(uint32_t uid, NetUidPolicy
 
     return NetPolicyResultCode::ERR_NONE;
 }
+
+NetPolicyResultCode NetPolicyTraffic::SetUidPolicies(const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies)
+{
+    if (netPolicyFile_ == nullptr) {
+        NETMGR_LOGE("SetUidPolicies netPolicyFile is null");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    /* Validate the whole batch first, an invalid entry rejects the batch without changing any policy */
+    for (auto uidPolicy : uidPolicies) {
+        if (!IsPolicyValid(uidPolicy.second)) {
+            return NetPolicyResultCode::ERR_INVALID_POLICY;
+        }
+    }
+
+    if (!netPolicyFile_->WriteFile(uidPolicies)) {
+        NETMGR_LOGE("SetUidPolicies WriteFile failed");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    return NetPolicyResultCode::ERR_NONE;
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
\ No newline at end of file
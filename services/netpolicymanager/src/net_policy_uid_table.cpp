@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "net_policy_uid_table.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr size_t INIT_CAPACITY = 16;
+constexpr uint32_t INIT_SHIFT = 28;
+constexpr uint32_t HASH_MULTIPLIER = 0x9E3779B1;
+constexpr size_t MAX_LOAD_NUMERATOR = 3;
+constexpr size_t MAX_LOAD_DENOMINATOR = 4;
+} // namespace
+
+NetPolicyUidTable::NetPolicyUidTable() : slots_(INIT_CAPACITY), shift_(INIT_SHIFT) {}
+
+size_t NetPolicyUidTable::IndexOf(uint32_t uid) const
+{
+    // Fibonacci hashing, the top bits of the product spread sequential uids over the table
+    return static_cast<size_t>(static_cast<uint32_t>(uid * HASH_MULTIPLIER) >> shift_);
+}
+
+size_t NetPolicyUidTable::FindSlot(uint32_t uid) const
+{
+    size_t mask = slots_.size() - 1;
+    for (size_t i = IndexOf(uid); slots_[i].used; i = (i + 1) & mask) {
+        if (slots_[i].uid == uid) {
+            return i;
+        }
+    }
+    return slots_.size();
+}
+
+bool NetPolicyUidTable::Set(uint32_t uid, uint32_t policy)
+{
+    if (policy > MAX_POLICY) {
+        return false;
+    }
+    size_t pos = FindSlot(uid);
+    if (pos != slots_.size()) {
+        Slot &slot = slots_[pos];
+        if (slot.policy != policy) {
+            RemoveReverse(slot);
+            slot.policy = static_cast<uint8_t>(policy);
+            AddReverse(slot);
+        }
+        return true;
+    }
+    if ((size_ + 1) * MAX_LOAD_DENOMINATOR > slots_.size() * MAX_LOAD_NUMERATOR) {
+        Rehash(slots_.size() * 2);
+    }
+    size_t mask = slots_.size() - 1;
+    size_t i = IndexOf(uid);
+    while (slots_[i].used) {
+        i = (i + 1) & mask;
+    }
+    Slot &slot = slots_[i];
+    slot.uid = uid;
+    slot.policy = static_cast<uint8_t>(policy);
+    slot.used = true;
+    AddReverse(slot);
+    size_++;
+    return true;
+}
+
+bool NetPolicyUidTable::Remove(uint32_t uid)
+{
+    size_t pos = FindSlot(uid);
+    if (pos == slots_.size()) {
+        return false;
+    }
+    RemoveReverse(slots_[pos]);
+    EraseSlot(pos);
+    size_--;
+    return true;
+}
+
+bool NetPolicyUidTable::Find(uint32_t uid, uint32_t &policy) const
+{
+    size_t pos = FindSlot(uid);
+    if (pos == slots_.size()) {
+        return false;
+    }
+    policy = slots_[pos].policy;
+    return true;
+}
+
+bool NetPolicyUidTable::Contains(uint32_t uid) const
+{
+    return FindSlot(uid) != slots_.size();
+}
+
+const std::vector<uint32_t> &NetPolicyUidTable::GetUids(uint32_t policy) const
+{
+    static const std::vector<uint32_t> emptyUids;
+    if (policy > MAX_POLICY) {
+        return emptyUids;
+    }
+    auto it = reverse_.find(static_cast<uint8_t>(policy));
+    if (it == reverse_.end()) {
+        return emptyUids;
+    }
+    return it->second;
+}
+
+size_t NetPolicyUidTable::Size() const
+{
+    return size_;
+}
+
+void NetPolicyUidTable::Clear()
+{
+    slots_.assign(INIT_CAPACITY, Slot());
+    shift_ = INIT_SHIFT;
+    size_ = 0;
+    reverse_.clear();
+}
+
+void NetPolicyUidTable::Rehash(size_t capacity)
+{
+    std::vector<Slot> oldSlots(capacity);
+    oldSlots.swap(slots_);
+    shift_--;
+    size_t mask = slots_.size() - 1;
+    for (const auto &old : oldSlots) {
+        if (!old.used) {
+            continue;
+        }
+        size_t i = IndexOf(old.uid);
+        while (slots_[i].used) {
+            i = (i + 1) & mask;
+        }
+        slots_[i] = old;
+    }
+}
+
+void NetPolicyUidTable::AddReverse(Slot &slot)
+{
+    std::vector<uint32_t> &uids = reverse_[slot.policy];
+    slot.reversePos = static_cast<uint32_t>(uids.size());
+    uids.push_back(slot.uid);
+}
+
+void NetPolicyUidTable::RemoveReverse(const Slot &slot)
+{
+    std::vector<uint32_t> &uids = reverse_[slot.policy];
+    uint32_t last = uids.back();
+    uids.pop_back();
+    if (last == slot.uid) {
+        return;
+    }
+    // Swap remove, the moved uid takes over the position of the removed one
+    uids[slot.reversePos] = last;
+    slots_[FindSlot(last)].reversePos = slot.reversePos;
+}
+
+void NetPolicyUidTable::EraseSlot(size_t pos)
+{
+    // Backward shift deletion keeps every probe chain contiguous without tombstones
+    size_t mask = slots_.size() - 1;
+    size_t hole = pos;
+    slots_[hole].used = false;
+    for (size_t i = (hole + 1) & mask; slots_[i].used; i = (i + 1) & mask) {
+        size_t home = IndexOf(slots_[i].uid);
+        bool reachable = (hole <= i) ? (home > hole && home <= i) : (home > hole || home <= i);
+        if (reachable) {
+            continue;
+        }
+        slots_[hole] = slots_[i];
+        slots_[i].used = false;
+        hole = i;
+    }
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
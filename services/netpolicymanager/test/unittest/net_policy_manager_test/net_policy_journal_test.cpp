@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <json/json.h>
+
+#include "net_policy_constants.h"
+#include "net_policy_define.h"
+#include "net_policy_file.h"
+#include "net_policy_journal.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+const std::string TEST_POLICY_FILE = "/data/local/tmp/net_policy_test.json";
+const std::string TEST_JOURNAL_FILE = "/data/local/tmp/net_policy_test.journal";
+const std::string TEST_SNAPSHOT_FILE = "/data/local/tmp/net_policy_test.bin";
+/* A directory that does not exist, neither the journal nor a snapshot can be written there */
+const std::string TEST_MISSING_DIR = "/data/local/tmp/net_policy_test_missing/";
+constexpr uint32_t TEST_UID_BASE = 10000;
+constexpr uint32_t TEST_UID_NUM = 100;
+constexpr uint32_t BENCHMARK_OP_NUM = 2000;
+constexpr uint32_t BENCHMARK_REWRITE_BUDGET = 200000;
+const std::vector<uint32_t> BENCHMARK_UID_NUMS = {1000, 10000, 100000};
+constexpr uint32_t BATCH_UID_NUM = 5000;
+constexpr uint32_t CONCURRENT_THREAD_NUM = 8;
+constexpr uint32_t CONCURRENT_OP_NUM = 200;
+
+off_t GetFileSize(const std::string &fileName)
+{
+    struct stat buffer;
+    if (stat(fileName.c_str(), &buffer) != 0) {
+        return 0;
+    }
+    return buffer.st_size;
+}
+
+/* What every op cost before the journal: serialize all uid policys to JSON, then write, sync and rename */
+bool RewriteJsonPolicyFile(uint32_t uidNum)
+{
+    Json::Value root;
+    Json::StreamWriterBuilder builder;
+    std::unique_ptr<Json::StreamWriter> streamWriter(builder.newStreamWriter());
+    root[CONFIG_HOS_VERSION] = Json::Value(HOS_VERSION);
+    for (uint32_t i = 0; i < uidNum; i++) {
+        Json::Value uidPolicy;
+        uidPolicy[CONFIG_UID] = std::to_string(TEST_UID_BASE + i);
+        uidPolicy[CONFIG_POLICY] = std::to_string(static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_ALL));
+        root[CONFIG_UID_POLICY].append(uidPolicy);
+    }
+    std::ostringstream out;
+    streamWriter->write(root, &out);
+    std::string content = out.str();
+
+    std::string tmpFileName = TEST_POLICY_FILE + POLICY_FILE_TMP_SUFFIX;
+    int32_t fd = open(tmpFileName.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, CHOWN_RWX_USR_GRP);
+    if (fd < 0) {
+        return false;
+    }
+    bool isSuccess = (write(fd, content.data(), content.size()) == static_cast<ssize_t>(content.size())) &&
+        (fsync(fd) == 0);
+    close(fd);
+    return isSuccess && rename(tmpFileName.c_str(), TEST_POLICY_FILE.c_str()) == 0;
+}
+} // namespace
+
+using namespace testing::ext;
+class NetPolicyJournalTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void NetPolicyJournalTest::SetUpTestCase() {}
+
+void NetPolicyJournalTest::TearDownTestCase() {}
+
+void NetPolicyJournalTest::SetUp()
+{
+    unlink(TEST_POLICY_FILE.c_str());
+    unlink(TEST_JOURNAL_FILE.c_str());
+    unlink(TEST_SNAPSHOT_FILE.c_str());
+}
+
+void NetPolicyJournalTest::TearDown()
+{
+    unlink(TEST_POLICY_FILE.c_str());
+    unlink(TEST_JOURNAL_FILE.c_str());
+    unlink(TEST_SNAPSHOT_FILE.c_str());
+}
+
+/**
+ * @tc.name: NetPolicyJournal001
+ * @tc.desc: Test policy changes survive a restart through snapshot plus journal replay.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyJournalTest, NetPolicyJournal001, TestSize.Level1)
+{
+    {
+        NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+        ASSERT_TRUE(policyFile.InitPolicy());
+        for (uint32_t i = 0; i < TEST_UID_NUM; i++) {
+            ASSERT_TRUE(policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_ADD, TEST_UID_BASE + i,
+                NetUidPolicy::NET_POLICY_REJECT_ALL));
+        }
+        ASSERT_TRUE(policyFile.Compact());
+        ASSERT_TRUE(policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_UPDATE, TEST_UID_BASE,
+            NetUidPolicy::NET_POLICY_ALLOW_ALL));
+        ASSERT_TRUE(policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_DELETE, TEST_UID_BASE + 1,
+            NetUidPolicy::NET_POLICY_NONE));
+        ASSERT_TRUE(policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_UPDATE, TEST_UID_BASE + 2,
+            NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED));
+    }
+
+    NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+    ASSERT_TRUE(policyFile.InitPolicy());
+    ASSERT_EQ(policyFile.GetUidPolicy(TEST_UID_BASE), NetUidPolicy::NET_POLICY_ALLOW_ALL);
+    ASSERT_FALSE(policyFile.IsUidPolicyExist(TEST_UID_BASE + 1));
+    ASSERT_FALSE(policyFile.IsUidPolicyExist(TEST_UID_BASE + 2));
+    ASSERT_EQ(policyFile.GetUidPolicy(TEST_UID_BASE + 3), NetUidPolicy::NET_POLICY_REJECT_ALL);
+    std::vector<uint32_t> uids;
+    ASSERT_TRUE(policyFile.GetUids(NetUidPolicy::NET_POLICY_REJECT_ALL, uids));
+    ASSERT_EQ(uids.size(), TEST_UID_NUM - 3);
+}
+
+/**
+ * @tc.name: NetPolicyJournal002
+ * @tc.desc: Test replay stops at a torn record and later appends follow the last intact record.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyJournalTest, NetPolicyJournal002, TestSize.Level1)
+{
+    {
+        NetPolicyJournal journal(TEST_JOURNAL_FILE);
+        ASSERT_TRUE(journal.Append(NetPolicyJournalOp::JOURNAL_OP_SET, TEST_UID_BASE, 1));
+        ASSERT_TRUE(journal.Append(NetPolicyJournalOp::JOURNAL_OP_SET, TEST_UID_BASE + 1, 1));
+    }
+    off_t intactSize = GetFileSize(TEST_JOURNAL_FILE);
+    {
+        std::ofstream file(TEST_JOURNAL_FILE, std::ios::binary | std::ios::app);
+        file << "torn";
+    }
+
+    NetPolicyJournal journal(TEST_JOURNAL_FILE);
+    std::vector<uint32_t> uids;
+    auto collect = [&uids](NetPolicyJournalOp op, uint32_t uid, uint32_t policy) { uids.push_back(uid); };
+    ASSERT_EQ(journal.Replay(collect), 2);
+    ASSERT_EQ(GetFileSize(TEST_JOURNAL_FILE), intactSize);
+    ASSERT_TRUE(journal.Append(NetPolicyJournalOp::JOURNAL_OP_DELETE, TEST_UID_BASE, 0));
+    uids.clear();
+    ASSERT_EQ(journal.Replay(collect), 3);
+    ASSERT_EQ(uids.back(), TEST_UID_BASE);
+    ASSERT_TRUE(journal.Reset());
+    ASSERT_EQ(journal.Replay(collect), 0);
+}
+
+/**
+ * @tc.name: NetPolicyJournal003
+ * @tc.desc: Test the journal is folded into the snapshot once it outgrows the compaction threshold.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyJournalTest, NetPolicyJournal003, TestSize.Level1)
+{
+    NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+    ASSERT_TRUE(policyFile.InitPolicy());
+    for (uint32_t i = 0; i < JOURNAL_COMPACT_MIN_RECORDS + 1; i++) {
+        ASSERT_TRUE(policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_ADD, TEST_UID_BASE + i % 8,
+            (i % 2 == 0) ? NetUidPolicy::NET_POLICY_ALLOW_ALL : NetUidPolicy::NET_POLICY_REJECT_ALL));
+    }
+    ASSERT_LT(GetFileSize(TEST_JOURNAL_FILE), static_cast<off_t>(JOURNAL_COMPACT_MIN_RECORDS));
+
+    NetPolicyFile reloaded(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+    ASSERT_TRUE(reloaded.InitPolicy());
+    for (uint32_t i = 0; i < 8; i++) {
+        ASSERT_EQ(reloaded.GetUidPolicy(TEST_UID_BASE + i), policyFile.GetUidPolicy(TEST_UID_BASE + i));
+    }
+}
+
+/**
+ * @tc.name: NetPolicyJournal004
+ * @tc.desc: Benchmark per op latency of the journal against a full JSON rewrite at 1k/10k/100k uids.
+ * @tc.type: PERF
+ */
+HWTEST_F(NetPolicyJournalTest, NetPolicyJournal004, TestSize.Level2)
+{
+    for (auto uidNum : BENCHMARK_UID_NUMS) {
+        unlink(TEST_POLICY_FILE.c_str());
+        unlink(TEST_JOURNAL_FILE.c_str());
+        unlink(TEST_SNAPSHOT_FILE.c_str());
+        NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+        ASSERT_TRUE(policyFile.InitPolicy());
+        for (uint32_t i = 0; i < uidNum; i++) {
+            policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_ADD, TEST_UID_BASE + i,
+                NetUidPolicy::NET_POLICY_REJECT_ALL);
+        }
+        ASSERT_TRUE(policyFile.Compact());
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < BENCHMARK_OP_NUM; i++) {
+            policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_UPDATE, TEST_UID_BASE + i % uidNum,
+                (i % 2 == 0) ? NetUidPolicy::NET_POLICY_ALLOW_ALL : NetUidPolicy::NET_POLICY_REJECT_ALL);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double journalUs = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) / BENCHMARK_OP_NUM;
+
+        /* The old path rewrote the whole file on every op, bound the run by the number of uids written */
+        uint32_t rewriteNum = std::max(1u, std::min(BENCHMARK_OP_NUM, BENCHMARK_REWRITE_BUDGET / uidNum));
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < rewriteNum; i++) {
+            ASSERT_TRUE(RewriteJsonPolicyFile(uidNum));
+        }
+        end = std::chrono::steady_clock::now();
+        double rewriteUs = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) / rewriteNum;
+
+        std::cout << "NetPolicyJournal004 uids:" << uidNum << " journal us/op:" << journalUs
+                  << " json rewrite us/op:" << rewriteUs << std::endl;
+        ASSERT_LT(journalUs, rewriteUs);
+    }
+}
+
+/**
+ * @tc.name: NetPolicyJournal005
+ * @tc.desc: Test a uid policy batch is applied and persisted as a whole, an invalid entry rejects the batch.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyJournalTest, NetPolicyJournal005, TestSize.Level1)
+{
+    {
+        NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+        ASSERT_TRUE(policyFile.InitPolicy());
+        std::vector<std::pair<uint32_t, NetUidPolicy>> uidPolicies;
+        for (uint32_t i = 0; i < TEST_UID_NUM; i++) {
+            uidPolicies.emplace_back(TEST_UID_BASE + i, NetUidPolicy::NET_POLICY_REJECT_ALL);
+        }
+        uidPolicies.emplace_back(TEST_UID_BASE, NetUidPolicy::NET_POLICY_NONE);
+        ASSERT_TRUE(policyFile.WriteFile(uidPolicies));
+
+        uidPolicies = {{TEST_UID_BASE + 1, NetUidPolicy::NET_POLICY_ALLOW_ALL},
+            {TEST_UID_BASE + 2, static_cast<NetUidPolicy>(0x100)}};
+        ASSERT_FALSE(policyFile.WriteFile(uidPolicies));
+        ASSERT_EQ(policyFile.GetUidPolicy(TEST_UID_BASE + 1), NetUidPolicy::NET_POLICY_REJECT_ALL);
+    }
+
+    NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+    ASSERT_TRUE(policyFile.InitPolicy());
+    ASSERT_FALSE(policyFile.IsUidPolicyExist(TEST_UID_BASE));
+    std::vector<uint32_t> uids;
+    ASSERT_TRUE(policyFile.GetUids(NetUidPolicy::NET_POLICY_REJECT_ALL, uids));
+    ASSERT_EQ(uids.size(), TEST_UID_NUM - 1);
+}
+
+/**
+ * @tc.name: NetPolicyJournal006
+ * @tc.desc: Test concurrent single changes sharing commit groups are all persisted.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyJournalTest, NetPolicyJournal006, TestSize.Level1)
+{
+    {
+        NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+        ASSERT_TRUE(policyFile.InitPolicy());
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < CONCURRENT_THREAD_NUM; t++) {
+            threads.emplace_back([&policyFile, t]() {
+                for (uint32_t i = 0; i < CONCURRENT_OP_NUM; i++) {
+                    policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_ADD,
+                        TEST_UID_BASE + t * CONCURRENT_OP_NUM + i, NetUidPolicy::NET_POLICY_ALLOW_ALL);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+    ASSERT_TRUE(policyFile.InitPolicy());
+    std::vector<uint32_t> uids;
+    ASSERT_TRUE(policyFile.GetUids(NetUidPolicy::NET_POLICY_ALLOW_ALL, uids));
+    ASSERT_EQ(uids.size(), CONCURRENT_THREAD_NUM * CONCURRENT_OP_NUM);
+}
+
+/**
+ * @tc.name: NetPolicyJournal007
+ * @tc.desc: Benchmark provisioning 5000 uids one by one, from concurrent callers and as one batch.
+ * @tc.type: PERF
+ */
+HWTEST_F(NetPolicyJournalTest, NetPolicyJournal007, TestSize.Level2)
+{
+    NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+    ASSERT_TRUE(policyFile.InitPolicy());
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BATCH_UID_NUM; i++) {
+        policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_ADD, TEST_UID_BASE + i,
+            NetUidPolicy::NET_POLICY_REJECT_ALL);
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto singleUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < CONCURRENT_THREAD_NUM; t++) {
+        threads.emplace_back([&policyFile, t]() {
+            for (uint32_t i = t; i < BATCH_UID_NUM; i += CONCURRENT_THREAD_NUM) {
+                policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_UPDATE, TEST_UID_BASE + i,
+                    NetUidPolicy::NET_POLICY_ALLOW_ALL);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    end = std::chrono::steady_clock::now();
+    auto concurrentUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::vector<std::pair<uint32_t, NetUidPolicy>> uidPolicies;
+    for (uint32_t i = 0; i < BATCH_UID_NUM; i++) {
+        uidPolicies.emplace_back(TEST_UID_BASE + i, NetUidPolicy::NET_POLICY_REJECT_ALL);
+    }
+    start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(policyFile.WriteFile(uidPolicies));
+    end = std::chrono::steady_clock::now();
+    auto batchUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::cout << "NetPolicyJournal007 uids:" << BATCH_UID_NUM << " single us:" << singleUs
+              << " concurrent us:" << concurrentUs << " batch us:" << batchUs << std::endl;
+    ASSERT_LT(batchUs, singleUs);
+}
+
+/**
+ * @tc.name: NetPolicyJournal008
+ * @tc.desc: Test a batch that can not be persisted changes no policy, readers never see it.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyJournalTest, NetPolicyJournal008, TestSize.Level1)
+{
+    NetPolicyFile policyFile(TEST_MISSING_DIR + "policy.json", TEST_MISSING_DIR + "policy.journal",
+        TEST_MISSING_DIR + "policy.bin");
+    ASSERT_TRUE(policyFile.InitPolicy());
+    std::vector<std::pair<uint32_t, NetUidPolicy>> uidPolicies;
+    for (uint32_t i = 0; i < TEST_UID_NUM; i++) {
+        uidPolicies.emplace_back(TEST_UID_BASE + i, NetUidPolicy::NET_POLICY_REJECT_ALL);
+    }
+    ASSERT_FALSE(policyFile.WriteFile(uidPolicies));
+    ASSERT_FALSE(policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_ADD, TEST_UID_BASE + TEST_UID_NUM,
+        NetUidPolicy::NET_POLICY_ALLOW_ALL));
+    for (uint32_t i = 0; i <= TEST_UID_NUM; i++) {
+        ASSERT_FALSE(policyFile.IsUidPolicyExist(TEST_UID_BASE + i));
+    }
+    std::vector<uint32_t> uids;
+    ASSERT_TRUE(policyFile.GetUids(NetUidPolicy::NET_POLICY_REJECT_ALL, uids));
+    ASSERT_TRUE(uids.empty());
+}
+
+/**
+ * @tc.name: NetPolicyJournal009
+ * @tc.desc: Test a batch cut short by the file size limit leaves no record of it in the journal.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyJournalTest, NetPolicyJournal009, TestSize.Level1)
+{
+    NetPolicyJournal journal(TEST_JOURNAL_FILE);
+    ASSERT_TRUE(journal.Append(NetPolicyJournalOp::JOURNAL_OP_SET, TEST_UID_BASE, 1));
+    off_t committedSize = GetFileSize(TEST_JOURNAL_FILE);
+    std::vector<NetPolicyJournalEntry> entries;
+    for (uint32_t i = 1; i <= TEST_UID_NUM; i++) {
+        entries.push_back({NetPolicyJournalOp::JOURNAL_OP_SET, TEST_UID_BASE + i, 1});
+    }
+
+    /* Let the write through up to half a batch, the kernel then returns a short count */
+    struct rlimit oldLimit;
+    ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &oldLimit), 0);
+    auto oldHandler = signal(SIGXFSZ, SIG_IGN);
+    struct rlimit limit = oldLimit;
+    limit.rlim_cur = static_cast<rlim_t>(committedSize * (TEST_UID_NUM / 2 + 1));
+    ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+    bool isAppended = journal.Append(entries);
+    setrlimit(RLIMIT_FSIZE, &oldLimit);
+    signal(SIGXFSZ, oldHandler);
+
+    ASSERT_FALSE(isAppended);
+    ASSERT_EQ(GetFileSize(TEST_JOURNAL_FILE), committedSize);
+    ASSERT_EQ(journal.GetRecordCount(), 1);
+    std::vector<uint32_t> uids;
+    NetPolicyJournal reopened(TEST_JOURNAL_FILE);
+    reopened.Replay([&uids](NetPolicyJournalOp op, uint32_t uid, uint32_t policy) { uids.push_back(uid); });
+    ASSERT_EQ(uids.size(), 1);
+    ASSERT_EQ(uids.front(), TEST_UID_BASE);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
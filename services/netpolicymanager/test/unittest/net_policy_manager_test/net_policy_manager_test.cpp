@@ -99,5 +99,27 @@ HWTEST_F(NetPolicyManagerTest, NetPolicyManager005, TestSize.Level1)
     bool result = DelayedSingleton<NetPolicyClient>::GetInstance()->IsUidNetAccess(1, std::string("test"));
     ASSERT_TRUE(result == true);
 }
+
+/**
+ * @tc.name: NetPolicyManager006
+ * @tc.desc: Test NetPolicyManager SetUidPolicies.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyManagerTest, NetPolicyManager006, TestSize.Level1)
+{
+    std::vector<std::pair<uint32_t, NetUidPolicy>> uidPolicies = {
+        {2, NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND},
+        {3, NetUidPolicy::NET_POLICY_ALLOW_ALL},
+    };
+    NetPolicyResultCode result = DelayedSingleton<NetPolicyClient>::GetInstance()->SetUidPolicies(uidPolicies);
+    ASSERT_TRUE(result == NetPolicyResultCode::ERR_NONE);
+    ASSERT_TRUE(DelayedSingleton<NetPolicyClient>::GetInstance()->GetUidPolicy(3) == NetUidPolicy::NET_POLICY_ALLOW_ALL);
+
+    uidPolicies = {{2, NetUidPolicy::NET_POLICY_NONE}, {3, static_cast<NetUidPolicy>(3)}};
+    result = DelayedSingleton<NetPolicyClient>::GetInstance()->SetUidPolicies(uidPolicies);
+    ASSERT_TRUE(result == NetPolicyResultCode::ERR_INVALID_POLICY);
+    ASSERT_TRUE(DelayedSingleton<NetPolicyClient>::GetInstance()->GetUidPolicy(2) ==
+        NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND);
+}
 }
 }
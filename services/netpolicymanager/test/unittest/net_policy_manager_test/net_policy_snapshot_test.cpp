@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "net_policy_constants.h"
+#include "net_policy_define.h"
+#include "net_policy_file.h"
+#include "net_policy_snapshot.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+const std::string TEST_POLICY_FILE = "/data/local/tmp/net_policy_snapshot_test.json";
+const std::string TEST_JOURNAL_FILE = "/data/local/tmp/net_policy_snapshot_test.journal";
+const std::string TEST_SNAPSHOT_FILE = "/data/local/tmp/net_policy_snapshot_test.bin";
+constexpr uint32_t TEST_UID_BASE = 10000;
+constexpr uint32_t TEST_UID_NUM = 100;
+constexpr uint32_t BENCHMARK_UID_NUM = 100000;
+constexpr double MAX_STARTUP_RATIO = 0.1;
+
+bool FileExists(const std::string &fileName)
+{
+    struct stat buffer;
+    return stat(fileName.c_str(), &buffer) == 0;
+}
+
+void WriteLegacyPolicyFile(uint32_t uidNum)
+{
+    std::ostringstream out;
+    out << "{\"hosVersion\":\"1.0\",\"uidPolicy\":[";
+    for (uint32_t i = 0; i < uidNum; i++) {
+        out << (i == 0 ? "" : ",") << "{\"uid\":\"" << (TEST_UID_BASE + i) << "\",\"policy\":\""
+            << static_cast<uint32_t>((i % 2 == 0) ? NetUidPolicy::NET_POLICY_REJECT_ALL :
+            NetUidPolicy::NET_POLICY_ALLOW_ALL) << "\"}";
+    }
+    out << "]}";
+    std::ofstream file(TEST_POLICY_FILE, std::ios::trunc);
+    file << out.str();
+}
+} // namespace
+
+using namespace testing::ext;
+class NetPolicySnapshotTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void NetPolicySnapshotTest::SetUpTestCase() {}
+
+void NetPolicySnapshotTest::TearDownTestCase() {}
+
+void NetPolicySnapshotTest::SetUp()
+{
+    unlink(TEST_POLICY_FILE.c_str());
+    unlink(TEST_JOURNAL_FILE.c_str());
+    unlink(TEST_SNAPSHOT_FILE.c_str());
+}
+
+void NetPolicySnapshotTest::TearDown()
+{
+    unlink(TEST_POLICY_FILE.c_str());
+    unlink(TEST_JOURNAL_FILE.c_str());
+    unlink(TEST_SNAPSHOT_FILE.c_str());
+}
+
+/**
+ * @tc.name: NetPolicySnapshot001
+ * @tc.desc: Test NetPolicySnapshot write, map and query in place.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicySnapshotTest, NetPolicySnapshot001, TestSize.Level1)
+{
+    uint32_t allowAll = static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_ALL);
+    uint32_t rejectAll = static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_ALL);
+    std::vector<std::pair<uint32_t, uint32_t>> entries;
+    for (uint32_t i = TEST_UID_NUM; i > 0; i--) {
+        entries.emplace_back(TEST_UID_BASE + i, (i % 4 == 0) ? allowAll : rejectAll);
+    }
+    ASSERT_TRUE(NetPolicySnapshot::Write(TEST_SNAPSHOT_FILE, HOS_VERSION, entries));
+
+    NetPolicySnapshot snapshot;
+    ASSERT_TRUE(snapshot.Open(TEST_SNAPSHOT_FILE));
+    ASSERT_EQ(snapshot.Size(), TEST_UID_NUM);
+    ASSERT_EQ(snapshot.GetHosVersion(), HOS_VERSION);
+    uint32_t policy = 0;
+    ASSERT_TRUE(snapshot.Find(TEST_UID_BASE + 4, policy));
+    ASSERT_EQ(policy, allowAll);
+    ASSERT_TRUE(snapshot.Find(TEST_UID_BASE + TEST_UID_NUM, policy));
+    ASSERT_FALSE(snapshot.Contains(TEST_UID_BASE));
+    ASSERT_FALSE(snapshot.Contains(TEST_UID_BASE + TEST_UID_NUM + 1));
+
+    uint32_t count = 0;
+    const uint32_t *uids = snapshot.GetUids(allowAll, count);
+    ASSERT_EQ(count, TEST_UID_NUM / 4);
+    ASSERT_EQ(uids[0], TEST_UID_BASE + 4);
+    ASSERT_EQ(snapshot.GetUids(static_cast<uint32_t>(NetUidPolicy::NET_POLICY_NONE), count), nullptr);
+    ASSERT_EQ(count, 0);
+}
+
+/**
+ * @tc.name: NetPolicySnapshot002
+ * @tc.desc: Test NetPolicySnapshot rejects corrupted and truncated files.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicySnapshotTest, NetPolicySnapshot002, TestSize.Level1)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> entries = {{TEST_UID_BASE, 1}, {TEST_UID_BASE + 1, 4}};
+    ASSERT_TRUE(NetPolicySnapshot::Write(TEST_SNAPSHOT_FILE, HOS_VERSION, entries));
+    struct stat buffer;
+    ASSERT_EQ(stat(TEST_SNAPSHOT_FILE.c_str(), &buffer), 0);
+
+    int32_t fd = open(TEST_SNAPSHOT_FILE.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    char byte = 0;
+    off_t offset = buffer.st_size - 1;
+    ASSERT_EQ(pread(fd, &byte, sizeof(byte), offset), 1);
+    byte ^= 1;
+    ASSERT_EQ(pwrite(fd, &byte, sizeof(byte), offset), 1);
+    NetPolicySnapshot snapshot;
+    ASSERT_FALSE(snapshot.Open(TEST_SNAPSHOT_FILE));
+    ASSERT_FALSE(snapshot.IsOpen());
+    ASSERT_FALSE(snapshot.Contains(TEST_UID_BASE));
+
+    byte ^= 1;
+    ASSERT_EQ(pwrite(fd, &byte, sizeof(byte), offset), 1);
+    ASSERT_TRUE(snapshot.Open(TEST_SNAPSHOT_FILE));
+    ASSERT_EQ(ftruncate(fd, offset), 0);
+    close(fd);
+    ASSERT_FALSE(snapshot.Open(TEST_SNAPSHOT_FILE));
+}
+
+/**
+ * @tc.name: NetPolicySnapshot003
+ * @tc.desc: Test the legacy JSON policy file is migrated to a binary snapshot on the first startup.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicySnapshotTest, NetPolicySnapshot003, TestSize.Level1)
+{
+    WriteLegacyPolicyFile(TEST_UID_NUM);
+    {
+        NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+        ASSERT_TRUE(policyFile.InitPolicy());
+        ASSERT_FALSE(FileExists(TEST_POLICY_FILE));
+        ASSERT_TRUE(FileExists(TEST_SNAPSHOT_FILE));
+        ASSERT_EQ(policyFile.GetUidPolicy(TEST_UID_BASE), NetUidPolicy::NET_POLICY_REJECT_ALL);
+        ASSERT_TRUE(policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_DELETE, TEST_UID_BASE + 1,
+            NetUidPolicy::NET_POLICY_NONE));
+        ASSERT_TRUE(policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_UPDATE, TEST_UID_BASE + 2,
+            NetUidPolicy::NET_POLICY_ALLOW_ALL));
+    }
+
+    NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+    ASSERT_TRUE(policyFile.InitPolicy());
+    ASSERT_FALSE(policyFile.IsUidPolicyExist(TEST_UID_BASE + 1));
+    ASSERT_EQ(policyFile.GetUidPolicy(TEST_UID_BASE + 2), NetUidPolicy::NET_POLICY_ALLOW_ALL);
+    std::vector<uint32_t> uids;
+    ASSERT_TRUE(policyFile.GetUids(NetUidPolicy::NET_POLICY_ALLOW_ALL, uids));
+    ASSERT_EQ(uids.size(), TEST_UID_NUM / 2);
+    uids.clear();
+    ASSERT_TRUE(policyFile.GetUids(NetUidPolicy::NET_POLICY_REJECT_ALL, uids));
+    ASSERT_EQ(uids.size(), TEST_UID_NUM / 2 - 1);
+
+    ASSERT_TRUE(policyFile.Compact());
+    uids.clear();
+    ASSERT_TRUE(policyFile.GetUids(NetUidPolicy::NET_POLICY_ALLOW_ALL, uids));
+    ASSERT_EQ(uids.size(), TEST_UID_NUM / 2);
+}
+
+/**
+ * @tc.name: NetPolicySnapshot004
+ * @tc.desc: Benchmark startup with 100k uid policys from the legacy JSON file and from the binary snapshot.
+ * @tc.type: PERF
+ */
+HWTEST_F(NetPolicySnapshotTest, NetPolicySnapshot004, TestSize.Level2)
+{
+    WriteLegacyPolicyFile(BENCHMARK_UID_NUM);
+    NetPolicyFile legacyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+    auto start = std::chrono::steady_clock::now();
+    std::string content;
+    NetPolicy netPolicy;
+    ASSERT_TRUE(legacyFile.ReadFile(TEST_POLICY_FILE, content));
+    ASSERT_TRUE(legacyFile.Json2Obj(content, netPolicy));
+    auto end = std::chrono::steady_clock::now();
+    auto jsonUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    ASSERT_EQ(netPolicy.uidPolicys.size(), BENCHMARK_UID_NUM);
+
+    start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(legacyFile.InitPolicy());
+    end = std::chrono::steady_clock::now();
+    auto migrateUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+    start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(policyFile.InitPolicy());
+    end = std::chrono::steady_clock::now();
+    auto snapshotUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::steady_clock::now();
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < BENCHMARK_UID_NUM; i++) {
+        found += policyFile.IsUidPolicyExist(TEST_UID_BASE + i) ? 1 : 0;
+    }
+    end = std::chrono::steady_clock::now();
+    double lookupNs = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / BENCHMARK_UID_NUM;
+
+    std::cout << "NetPolicySnapshot004 uids:" << BENCHMARK_UID_NUM << " json parse us:" << jsonUs
+              << " migrate us:" << migrateUs << " snapshot startup us:" << snapshotUs
+              << " lookup ns:" << lookupNs << std::endl;
+    ASSERT_EQ(found, BENCHMARK_UID_NUM);
+    ASSERT_LT(snapshotUs, jsonUs * MAX_STARTUP_RATIO);
+}
+
+/**
+ * @tc.name: NetPolicySnapshot005
+ * @tc.desc: Test a legacy JSON policy file that does not parse is kept and no snapshot hides it.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicySnapshotTest, NetPolicySnapshot005, TestSize.Level1)
+{
+    {
+        std::ofstream file(TEST_POLICY_FILE, std::ios::trunc);
+        file << "{\"hosVersion\":\"1.0\",\"uidPolicy\":[{\"uid\":\"10000\",";
+    }
+    {
+        NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+        ASSERT_FALSE(policyFile.InitPolicy());
+        ASSERT_TRUE(FileExists(TEST_POLICY_FILE));
+        ASSERT_FALSE(FileExists(TEST_SNAPSHOT_FILE));
+        ASSERT_TRUE(policyFile.WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_ADD, TEST_UID_BASE + 1,
+            NetUidPolicy::NET_POLICY_ALLOW_ALL));
+        ASSERT_FALSE(policyFile.Compact());
+        ASSERT_FALSE(FileExists(TEST_SNAPSHOT_FILE));
+    }
+
+    /* Once the file is readable again it is migrated and the journal is replayed on top of it */
+    WriteLegacyPolicyFile(TEST_UID_NUM);
+    NetPolicyFile policyFile(TEST_POLICY_FILE, TEST_JOURNAL_FILE, TEST_SNAPSHOT_FILE);
+    ASSERT_TRUE(policyFile.InitPolicy());
+    ASSERT_FALSE(FileExists(TEST_POLICY_FILE));
+    ASSERT_EQ(policyFile.GetUidPolicy(TEST_UID_BASE), NetUidPolicy::NET_POLICY_REJECT_ALL);
+    ASSERT_EQ(policyFile.GetUidPolicy(TEST_UID_BASE + 1), NetUidPolicy::NET_POLICY_ALLOW_ALL);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
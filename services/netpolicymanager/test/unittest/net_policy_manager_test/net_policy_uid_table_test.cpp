@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "net_policy_constants.h"
+#include "net_policy_uid_table.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t BENCHMARK_UID_NUM = 100000;
+constexpr uint32_t BENCHMARK_LOOKUP_NUM = 1000000;
+constexpr uint32_t BENCHMARK_UID_BASE = 10000;
+constexpr double MAX_LOOKUP_NS = 100.0;
+constexpr uint32_t RANDOM_OP_NUM = 20000;
+constexpr uint32_t RANDOM_UID_RANGE = 512;
+} // namespace
+
+using namespace testing::ext;
+class NetPolicyUidTableTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void NetPolicyUidTableTest::SetUpTestCase() {}
+
+void NetPolicyUidTableTest::TearDownTestCase() {}
+
+void NetPolicyUidTableTest::SetUp() {}
+
+void NetPolicyUidTableTest::TearDown() {}
+
+/**
+ * @tc.name: NetPolicyUidTable001
+ * @tc.desc: Test NetPolicyUidTable set, update, remove and reverse lookup.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyUidTableTest, NetPolicyUidTable001, TestSize.Level1)
+{
+    NetPolicyUidTable table;
+    uint32_t allowAll = static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_ALL);
+    uint32_t rejectAll = static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_ALL);
+    ASSERT_TRUE(table.Set(1000, allowAll));
+    ASSERT_TRUE(table.Set(1001, allowAll));
+    ASSERT_TRUE(table.Set(1002, rejectAll));
+    ASSERT_FALSE(table.Set(1003, 0x100));
+    ASSERT_EQ(table.Size(), 3);
+
+    uint32_t policy = 0;
+    ASSERT_TRUE(table.Find(1001, policy));
+    ASSERT_EQ(policy, allowAll);
+    ASSERT_FALSE(table.Contains(1003));
+    ASSERT_EQ(table.GetUids(allowAll).size(), 2);
+
+    ASSERT_TRUE(table.Set(1000, rejectAll));
+    ASSERT_EQ(table.GetUids(allowAll).size(), 1);
+    ASSERT_EQ(table.GetUids(rejectAll).size(), 2);
+
+    ASSERT_TRUE(table.Remove(1002));
+    ASSERT_FALSE(table.Remove(1002));
+    std::vector<uint32_t> uids = table.GetUids(rejectAll);
+    ASSERT_EQ(uids.size(), 1);
+    ASSERT_EQ(uids.front(), 1000);
+    ASSERT_EQ(table.Size(), 2);
+}
+
+/**
+ * @tc.name: NetPolicyUidTable002
+ * @tc.desc: Test NetPolicyUidTable against std::map with random set and remove.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyUidTableTest, NetPolicyUidTable002, TestSize.Level1)
+{
+    NetPolicyUidTable table;
+    std::map<uint32_t, uint32_t> expect;
+    std::mt19937 engine(1);
+    const std::vector<uint32_t> policys = {1, 2, 4, 32, 64};
+    for (uint32_t i = 0; i < RANDOM_OP_NUM; i++) {
+        uint32_t uid = engine() % RANDOM_UID_RANGE;
+        if (engine() % 3 == 0) {
+            ASSERT_EQ(table.Remove(uid), expect.erase(uid) == 1);
+        } else {
+            uint32_t policy = policys[engine() % policys.size()];
+            ASSERT_TRUE(table.Set(uid, policy));
+            expect[uid] = policy;
+        }
+    }
+    ASSERT_EQ(table.Size(), expect.size());
+    for (const auto &item : expect) {
+        uint32_t policy = 0;
+        ASSERT_TRUE(table.Find(item.first, policy));
+        ASSERT_EQ(policy, item.second);
+    }
+    for (auto policy : policys) {
+        std::vector<uint32_t> uids = table.GetUids(policy);
+        std::sort(uids.begin(), uids.end());
+        std::vector<uint32_t> expectUids;
+        for (const auto &item : expect) {
+            if (item.second == policy) {
+                expectUids.push_back(item.first);
+            }
+        }
+        ASSERT_EQ(uids, expectUids);
+    }
+}
+
+/**
+ * @tc.name: NetPolicyUidTable003
+ * @tc.desc: Benchmark NetPolicyUidTable lookup with 100k uids.
+ * @tc.type: PERF
+ */
+HWTEST_F(NetPolicyUidTableTest, NetPolicyUidTable003, TestSize.Level2)
+{
+    NetPolicyUidTable table;
+    for (uint32_t i = 0; i < BENCHMARK_UID_NUM; i++) {
+        table.Set(BENCHMARK_UID_BASE + i, static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_ALL));
+    }
+    std::vector<uint32_t> uids;
+    std::mt19937 engine(1);
+    for (uint32_t i = 0; i < BENCHMARK_LOOKUP_NUM; i++) {
+        uids.push_back(BENCHMARK_UID_BASE + engine() % (BENCHMARK_UID_NUM * 2));
+    }
+
+    uint32_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto uid : uids) {
+        uint32_t policy = 0;
+        if (table.Find(uid, policy)) {
+            found++;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double lookupNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+        BENCHMARK_LOOKUP_NUM;
+
+    start = std::chrono::steady_clock::now();
+    size_t reverseSize = table.GetUids(static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_ALL)).size();
+    end = std::chrono::steady_clock::now();
+    std::cout << "NetPolicyUidTable003 uids:" << BENCHMARK_UID_NUM << " found:" << found
+              << " lookup ns:" << lookupNs << " GetUids ns:"
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() << std::endl;
+    ASSERT_EQ(reverseSize, BENCHMARK_UID_NUM);
+    ASSERT_LT(lookupNs, MAX_LOOKUP_NS);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
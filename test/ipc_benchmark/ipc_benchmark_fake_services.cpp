@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ipc_benchmark_fake_services.h"
+
+#include <sys/socket.h>
+
+#include "ipc_loopback_remote_object.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t POLICY_UID_COUNT = 64;
+constexpr uint32_t POLICY_FIRST_UID = 10000;
+constexpr uint16_t DNS_TIMEOUT_MSEC = 5000;
+constexpr uint8_t DNS_RETRY_COUNT = 2;
+constexpr uint64_t DNS_STATS_QUERIES = 1000;
+
+INetAddr MakeAddr(uint8_t family, const std::string &address)
+{
+    INetAddr addr;
+    addr.type_ = (family == AF_INET) ? INetAddr::IPV4 : INetAddr::IPV6;
+    addr.family_ = family;
+    addr.address_ = address;
+    return addr;
+}
+
+/* A dual stack answer of two addresses per family */
+std::vector<INetAddr> MakeAnswer()
+{
+    return {MakeAddr(AF_INET, "192.0.2.10"), MakeAddr(AF_INET, "192.0.2.11"),
+        MakeAddr(AF_INET6, "2001:db8::10"), MakeAddr(AF_INET6, "2001:db8::11")};
+}
+} // namespace
+
+int32_t FakeNetConnService::SystemReady()
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeNetConnService::RegisterNetSupplier(uint32_t netType, const std::string &ident, uint64_t netCapabilities)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeNetConnService::UnregisterNetSupplier(uint32_t supplierId)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeNetConnService::RegisterNetConnCallback(const sptr<INetConnCallback> &callback)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeNetConnService::RegisterNetConnCallback(const sptr<NetSpecifier> &netSpecifier,
+    const sptr<INetConnCallback> &callback)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeNetConnService::UnregisterNetConnCallback(const sptr<INetConnCallback> &callback)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeNetConnService::UnregisterNetConnCallback(const sptr<NetSpecifier> &netSpecifier,
+    const sptr<INetConnCallback> &callback)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeNetConnService::UpdateNetSupplierInfo(uint32_t supplierId, const sptr<NetSupplierInfo> &netSupplierInfo)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeNetConnService::UpdateNetCapabilities(uint32_t supplierId, uint64_t netCapabilities)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeNetConnService::UpdateNetLinkInfo(uint32_t supplierId, const sptr<NetLinkInfo> &netLinkInfo)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+NetPolicyResultCode FakeNetPolicyService::SetUidPolicy(uint32_t uid, NetUidPolicy policy)
+{
+    IpcBenchServiceScope scope;
+    return NetPolicyResultCode::ERR_NONE;
+}
+
+NetPolicyResultCode FakeNetPolicyService::SetUidPolicies(
+    const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies)
+{
+    IpcBenchServiceScope scope;
+    return NetPolicyResultCode::ERR_NONE;
+}
+
+NetUidPolicy FakeNetPolicyService::GetUidPolicy(uint32_t uid)
+{
+    IpcBenchServiceScope scope;
+    return NetUidPolicy::NET_POLICY_ALLOW_METERED_BACKGROUND;
+}
+
+std::vector<uint32_t> FakeNetPolicyService::GetUids(NetUidPolicy policy)
+{
+    IpcBenchServiceScope scope;
+    std::vector<uint32_t> uids;
+    for (uint32_t i = 0; i < POLICY_UID_COUNT; ++i) {
+        uids.push_back(POLICY_FIRST_UID + i);
+    }
+    return uids;
+}
+
+bool FakeNetPolicyService::IsUidNetAccess(uint32_t uid, bool metered)
+{
+    IpcBenchServiceScope scope;
+    return true;
+}
+
+bool FakeNetPolicyService::IsUidNetAccess(uint32_t uid, const std::string &ifaceName)
+{
+    IpcBenchServiceScope scope;
+    return true;
+}
+
+int32_t FakeDnsResolverService::GetAddressesByName(const std::string &hostName, std::vector<INetAddr> &addrInfo)
+{
+    IpcBenchServiceScope scope;
+    addrInfo = MakeAnswer();
+    return 0;
+}
+
+int32_t FakeDnsResolverService::GetAddressesByNamePacked(const std::string &hostName, DnsAddrBlob &addrBlob)
+{
+    IpcBenchServiceScope scope;
+    for (const auto &addr : MakeAnswer()) {
+        addrBlob.Append(addr);
+    }
+    return 0;
+}
+
+int32_t FakeDnsResolverService::GetAddrInfo(const std::string &hostName, const std::string &server,
+    const sptr<DnsAddrInfo> &hints, std::vector<sptr<DnsAddrInfo>> &dnsAddrInfo)
+{
+    IpcBenchServiceScope scope;
+    for (const auto &addr : MakeAnswer()) {
+        sptr<DnsAddrInfo> info = (std::make_unique<DnsAddrInfo>()).release();
+        info->family_ = addr.family_;
+        info->sockType_ = SOCK_STREAM;
+        info->addr_ = addr.address_;
+        dnsAddrInfo.push_back(info);
+    }
+    return 0;
+}
+
+int32_t FakeDnsResolverService::CreateNetworkCache(uint16_t netId)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeDnsResolverService::DestoryNetworkCache(uint16_t netId)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeDnsResolverService::FlushNetworkCache(uint16_t netId)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeDnsResolverService::SetResolverConfig(uint16_t netId, uint16_t baseTimeoutMsec, uint8_t retryCount,
+    const std::vector<std::string> &servers, const std::vector<std::string> &domains)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeDnsResolverService::GetResolverInfo(uint16_t netId, std::vector<std::string> &servers,
+    std::vector<std::string> &domains, uint16_t &baseTimeoutMsec, uint8_t &retryCount)
+{
+    IpcBenchServiceScope scope;
+    servers = {"192.0.2.53", "2001:db8::53"};
+    domains = {"example.com"};
+    baseTimeoutMsec = DNS_TIMEOUT_MSEC;
+    retryCount = DNS_RETRY_COUNT;
+    return 0;
+}
+
+int32_t FakeDnsResolverService::GetAddressesByNames(const std::vector<std::string> &hostNames,
+    std::vector<int32_t> &results, std::vector<std::vector<INetAddr>> &addrInfos)
+{
+    IpcBenchServiceScope scope;
+    results.assign(hostNames.size(), 0);
+    addrInfos.assign(hostNames.size(), MakeAnswer());
+    return 0;
+}
+
+int32_t FakeDnsResolverService::GetAddressesByNamesPacked(const std::vector<std::string> &hostNames,
+    std::vector<int32_t> &results, std::vector<DnsAddrBlob> &addrBlobs)
+{
+    IpcBenchServiceScope scope;
+    results.assign(hostNames.size(), 0);
+    addrBlobs.assign(hostNames.size(), {});
+    for (auto &addrBlob : addrBlobs) {
+        for (const auto &addr : MakeAnswer()) {
+            addrBlob.Append(addr);
+        }
+    }
+    return 0;
+}
+
+int32_t FakeDnsResolverService::GetAddressesByNameAsync(const std::string &hostName,
+    const sptr<IDnsResolverCallback> &callback)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeDnsResolverService::GetAddressesByNameDualStack(const std::string &hostName,
+    const sptr<IDnsResolverCallback> &callback)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+int32_t FakeDnsResolverService::GetResolverStats(uint16_t netId, std::vector<DnsServerStats> &stats)
+{
+    IpcBenchServiceScope scope;
+    for (const std::string server : {"192.0.2.53", "2001:db8::53"}) {
+        DnsServerStats serverStats;
+        serverStats.server_ = server;
+        serverStats.queries_ = DNS_STATS_QUERIES;
+        serverStats.successes_ = DNS_STATS_QUERIES;
+        serverStats.latencyBuckets_.assign(DNS_LATENCY_BUCKETS, DNS_STATS_QUERIES / DNS_LATENCY_BUCKETS);
+        stats.push_back(serverStats);
+    }
+    return 0;
+}
+
+int32_t FakeEthernetService::SetIfaceConfig(const std::string &iface, sptr<InterfaceConfiguration> &ic)
+{
+    IpcBenchServiceScope scope;
+    return 0;
+}
+
+sptr<InterfaceConfiguration> FakeEthernetService::GetIfaceConfig(const std::string &iface)
+{
+    IpcBenchServiceScope scope;
+    sptr<InterfaceConfiguration> config = (std::make_unique<InterfaceConfiguration>()).release();
+    config->mode_ = STATIC;
+    config->ipStatic_.ipAddr_ = MakeAddr(AF_INET, "192.0.2.2");
+    config->ipStatic_.route_ = MakeAddr(AF_INET, "0.0.0.0");
+    config->ipStatic_.gate_ = MakeAddr(AF_INET, "192.0.2.1");
+    config->ipStatic_.netMask_ = MakeAddr(AF_INET, "255.255.255.0");
+    config->ipStatic_.dnsServers_ = {MakeAddr(AF_INET, "192.0.2.53"), MakeAddr(AF_INET, "198.51.100.53")};
+    config->ipStatic_.domain_ = "example.com";
+    return config;
+}
+
+int32_t FakeEthernetService::IsActivate(const std::string &iface)
+{
+    IpcBenchServiceScope scope;
+    return 1;
+}
+
+std::vector<std::string> FakeEthernetService::GetActivateInterfaces()
+{
+    IpcBenchServiceScope scope;
+    return {"eth0", "eth1"};
+}
+
+int32_t FakeNetConnCallback::NetConnStateChanged(const sptr<NetConnCallbackInfo> &info)
+{
+    return 0;
+}
+
+int32_t FakeDnsResolverCallback::OnResolved(const std::string &hostName, int32_t result,
+    const std::vector<INetAddr> &addrInfo)
+{
+    return 0;
+}
+
+int32_t FakeDnsResolverCallback::OnPartialResolved(const std::string &hostName, const std::vector<INetAddr> &addrInfo)
+{
+    return 0;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
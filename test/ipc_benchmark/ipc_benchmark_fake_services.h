@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IPC_BENCHMARK_FAKE_SERVICES_H
+#define IPC_BENCHMARK_FAKE_SERVICES_H
+
+#include "dns_resolver_callback_stub.h"
+#include "dns_resolver_service_stub.h"
+#include "ethernet_service_stub.h"
+#include "net_conn_callback_stub.h"
+#include "net_conn_service_stub.h"
+#include "net_policy_service_stub.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/*
+ * Services behind the real stubs that do no work beyond filling replies of a typical size, so a benchmark run
+ * measures the IPC layer alone. Every method marks its entry and exit on the IpcBenchClock.
+ */
+class FakeNetConnService : public NetConnServiceStub {
+public:
+    int32_t SystemReady() override;
+    int32_t RegisterNetSupplier(uint32_t netType, const std::string &ident, uint64_t netCapabilities) override;
+    int32_t UnregisterNetSupplier(uint32_t supplierId) override;
+    int32_t RegisterNetConnCallback(const sptr<INetConnCallback> &callback) override;
+    int32_t RegisterNetConnCallback(const sptr<NetSpecifier> &netSpecifier,
+        const sptr<INetConnCallback> &callback) override;
+    int32_t UnregisterNetConnCallback(const sptr<INetConnCallback> &callback) override;
+    int32_t UnregisterNetConnCallback(const sptr<NetSpecifier> &netSpecifier,
+        const sptr<INetConnCallback> &callback) override;
+    int32_t UpdateNetSupplierInfo(uint32_t supplierId, const sptr<NetSupplierInfo> &netSupplierInfo) override;
+    int32_t UpdateNetCapabilities(uint32_t supplierId, uint64_t netCapabilities) override;
+    int32_t UpdateNetLinkInfo(uint32_t supplierId, const sptr<NetLinkInfo> &netLinkInfo) override;
+};
+
+class FakeNetPolicyService : public NetPolicyServiceStub {
+public:
+    NetPolicyResultCode SetUidPolicy(uint32_t uid, NetUidPolicy policy) override;
+    NetPolicyResultCode SetUidPolicies(const std::vector<std::pair<uint32_t, NetUidPolicy>> &uidPolicies) override;
+    NetUidPolicy GetUidPolicy(uint32_t uid) override;
+    std::vector<uint32_t> GetUids(NetUidPolicy policy) override;
+    bool IsUidNetAccess(uint32_t uid, bool metered) override;
+    bool IsUidNetAccess(uint32_t uid, const std::string &ifaceName) override;
+};
+
+class FakeDnsResolverService : public DnsResolverServiceStub {
+public:
+    int32_t GetAddressesByName(const std::string &hostName, std::vector<INetAddr> &addrInfo) override;
+    int32_t GetAddressesByNamePacked(const std::string &hostName, DnsAddrBlob &addrBlob) override;
+    int32_t GetAddrInfo(const std::string &hostName, const std::string &server,
+        const sptr<DnsAddrInfo> &hints, std::vector<sptr<DnsAddrInfo>> &dnsAddrInfo) override;
+    int32_t CreateNetworkCache(uint16_t netId) override;
+    int32_t DestoryNetworkCache(uint16_t netId) override;
+    int32_t FlushNetworkCache(uint16_t netId) override;
+    int32_t SetResolverConfig(uint16_t netId, uint16_t baseTimeoutMsec, uint8_t retryCount,
+        const std::vector<std::string> &servers, const std::vector<std::string> &domains) override;
+    int32_t GetResolverInfo(uint16_t netId, std::vector<std::string> &servers,
+        std::vector<std::string> &domains, uint16_t &baseTimeoutMsec, uint8_t &retryCount) override;
+    int32_t GetAddressesByNames(const std::vector<std::string> &hostNames, std::vector<int32_t> &results,
+        std::vector<std::vector<INetAddr>> &addrInfos) override;
+    int32_t GetAddressesByNamesPacked(const std::vector<std::string> &hostNames, std::vector<int32_t> &results,
+        std::vector<DnsAddrBlob> &addrBlobs) override;
+    int32_t GetAddressesByNameAsync(const std::string &hostName,
+        const sptr<IDnsResolverCallback> &callback) override;
+    int32_t GetAddressesByNameDualStack(const std::string &hostName,
+        const sptr<IDnsResolverCallback> &callback) override;
+    int32_t GetResolverStats(uint16_t netId, std::vector<DnsServerStats> &stats) override;
+};
+
+class FakeEthernetService : public EthernetServiceStub {
+public:
+    int32_t SetIfaceConfig(const std::string &iface, sptr<InterfaceConfiguration> &ic) override;
+    sptr<InterfaceConfiguration> GetIfaceConfig(const std::string &iface) override;
+    int32_t IsActivate(const std::string &iface) override;
+    std::vector<std::string> GetActivateInterfaces() override;
+};
+
+class FakeNetConnCallback : public NetConnCallbackStub {
+public:
+    int32_t NetConnStateChanged(const sptr<NetConnCallbackInfo> &info) override;
+};
+
+class FakeDnsResolverCallback : public DnsResolverCallbackStub {
+public:
+    int32_t OnResolved(const std::string &hostName, int32_t result, const std::vector<INetAddr> &addrInfo) override;
+    int32_t OnPartialResolved(const std::string &hostName, const std::vector<INetAddr> &addrInfo) override;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // IPC_BENCHMARK_FAKE_SERVICES_H
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+
+#include "dns_resolver_service_proxy.h"
+#include "ethernet_service_proxy.h"
+#include "ipc_benchmark_fake_services.h"
+#include "ipc_loopback_remote_object.h"
+#include "ipc_stub_dispatch_table.h"
+#include "net_conn_service_proxy.h"
+#include "net_policy_service_proxy.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+using namespace testing::ext;
+constexpr int32_t WARMUP_CALLS = 200;
+constexpr int32_t MEASURED_CALLS = 5000;
+constexpr int32_t PERCENT_P50 = 50;
+constexpr int32_t PERCENT_P90 = 90;
+constexpr int32_t PERCENT_P99 = 99;
+constexpr int32_t PERCENT_MAX = 100;
+constexpr int32_t NAME_WIDTH = 32;
+constexpr uint32_t SUPPLIER_ID = 1;
+constexpr uint32_t TEST_UID = 10000;
+constexpr uint32_t POLICY_BATCH_SIZE = 64;
+constexpr uint16_t TEST_NET_ID = 100;
+constexpr uint16_t TEST_MTU = 1500;
+constexpr uint16_t DNS_TIMEOUT_MSEC = 5000;
+constexpr uint8_t DNS_RETRY_COUNT = 2;
+constexpr uint32_t BATCH_HOST_COUNT = 8;
+constexpr uint32_t DISPATCH_CODE_COUNT = 11;
+constexpr int32_t DISPATCH_LOOKUPS = 10000000;
+const std::string TEST_HOST = "www.example.com";
+const std::string TEST_IFACE = "eth0";
+
+struct IpcBenchCase {
+    std::string name;
+    std::function<void()> call;
+};
+
+/* Spans of every measured call of one case, in nanoseconds */
+struct IpcBenchSamples {
+    std::vector<int64_t> endToEnd;
+    std::vector<int64_t> proxyMarshal;
+    std::vector<int64_t> stubDispatch;
+    std::vector<int64_t> service;
+    std::vector<int64_t> stubReply;
+    std::vector<int64_t> proxyUnmarshal;
+    int32_t serviceMissed = 0;
+};
+
+int64_t Percentile(std::vector<int64_t> samples, int32_t percent)
+{
+    if (samples.empty()) {
+        return -1;
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[(samples.size() - 1) * percent / PERCENT_MAX];
+}
+
+int64_t Mean(const std::vector<int64_t> &samples)
+{
+    if (samples.empty()) {
+        return -1;
+    }
+    int64_t sum = 0;
+    for (int64_t sample : samples) {
+        sum += sample;
+    }
+    return sum / static_cast<int64_t>(samples.size());
+}
+
+IpcBenchSamples Measure(const IpcBenchCase &benchCase)
+{
+    for (int32_t i = 0; i < WARMUP_CALLS; ++i) {
+        benchCase.call();
+    }
+    IpcBenchSamples samples;
+    for (int32_t i = 0; i < MEASURED_CALLS; ++i) {
+        IpcBenchClock::Reset();
+        IpcBenchClock::Mark(MARK_CALL);
+        benchCase.call();
+        IpcBenchClock::Mark(MARK_DONE);
+        samples.endToEnd.push_back(IpcBenchClock::Span(MARK_CALL, MARK_DONE));
+        samples.proxyMarshal.push_back(IpcBenchClock::Span(MARK_CALL, MARK_SEND));
+        samples.proxyUnmarshal.push_back(IpcBenchClock::Span(MARK_RETURN, MARK_DONE));
+        if (IpcBenchClock::Get(MARK_SERVICE_ENTER) == 0) {
+            samples.serviceMissed++;
+            continue;
+        }
+        samples.stubDispatch.push_back(IpcBenchClock::Span(MARK_SEND, MARK_SERVICE_ENTER));
+        samples.service.push_back(IpcBenchClock::Span(MARK_SERVICE_ENTER, MARK_SERVICE_LEAVE));
+        samples.stubReply.push_back(IpcBenchClock::Span(MARK_SERVICE_LEAVE, MARK_RETURN));
+    }
+    return samples;
+}
+
+/* One line per code path, the p99 also goes to the test report so runs can be compared */
+void RunCases(const std::string &serviceName, const std::vector<IpcBenchCase> &cases)
+{
+    std::cout << serviceName << ": " << MEASURED_CALLS << " calls per code, ns" << std::endl;
+    for (const auto &benchCase : cases) {
+        IpcBenchSamples samples = Measure(benchCase);
+        EXPECT_EQ(samples.serviceMissed, 0) << serviceName << "." << benchCase.name << " did not reach the service";
+        int64_t p99 = Percentile(samples.endToEnd, PERCENT_P99);
+        std::cout << "  " << std::left << std::setw(NAME_WIDTH) << benchCase.name << std::right
+                  << " p50 " << Percentile(samples.endToEnd, PERCENT_P50)
+                  << " p90 " << Percentile(samples.endToEnd, PERCENT_P90) << " p99 " << p99
+                  << " max " << Percentile(samples.endToEnd, PERCENT_MAX)
+                  << " | proxy marshal " << Mean(samples.proxyMarshal)
+                  << " stub dispatch " << Mean(samples.stubDispatch)
+                  << " service " << Mean(samples.service)
+                  << " stub reply " << Mean(samples.stubReply)
+                  << " proxy unmarshal " << Mean(samples.proxyUnmarshal) << std::endl;
+        testing::Test::RecordProperty(serviceName + "." + benchCase.name + ".p99_ns", static_cast<int>(p99));
+    }
+}
+
+INetAddr MakeAddr(uint8_t family, const std::string &address, uint8_t prefixlen = 0)
+{
+    INetAddr addr;
+    addr.type_ = (family == AF_INET) ? INetAddr::IPV4 : INetAddr::IPV6;
+    addr.family_ = family;
+    addr.address_ = address;
+    addr.prefixlen_ = prefixlen;
+    return addr;
+}
+
+Route MakeRoute(const std::string &destination, uint8_t prefixlen)
+{
+    Route route;
+    route.iface_ = TEST_IFACE;
+    route.destination_ = MakeAddr(AF_INET, destination, prefixlen);
+    route.gateway_ = MakeAddr(AF_INET, "192.0.2.1");
+    return route;
+}
+
+/* A stub shaped like DnsResolverServiceStub, whose codes are the densest and most often called */
+class DispatchBenchStub {
+public:
+    int32_t OnFirst(MessageParcel &data, MessageParcel &reply)
+    {
+        return 0;
+    }
+
+    int32_t OnOther(MessageParcel &data, MessageParcel &reply)
+    {
+        return 1;
+    }
+
+    using DispatchTable = IpcStubDispatchTable<DispatchBenchStub, DISPATCH_CODE_COUNT>;
+
+    static const DispatchTable &GetDispatchTable()
+    {
+        static constexpr DispatchTable table({
+            {0, &DispatchBenchStub::OnFirst}, {1, &DispatchBenchStub::OnOther}, {2, &DispatchBenchStub::OnOther},
+            {3, &DispatchBenchStub::OnOther}, {4, &DispatchBenchStub::OnOther}, {5, &DispatchBenchStub::OnOther},
+            {6, &DispatchBenchStub::OnOther}, {7, &DispatchBenchStub::OnOther}, {8, &DispatchBenchStub::OnOther},
+            {9, &DispatchBenchStub::OnOther}, {10, &DispatchBenchStub::OnOther},
+        });
+        return table;
+    }
+};
+
+template <typename Lookup>
+int64_t TimeLookups(Lookup lookup)
+{
+    uintptr_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < DISPATCH_LOOKUPS; ++i) {
+        found += lookup(static_cast<uint32_t>(i) % (DISPATCH_CODE_COUNT + 1)) ? 1 : 0;
+    }
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(found, static_cast<uintptr_t>(DISPATCH_LOOKUPS - DISPATCH_LOOKUPS / (DISPATCH_CODE_COUNT + 1)));
+    return elapsed;
+}
+
+/* What a DHCP lease hands to netconn */
+sptr<NetLinkInfo> MakeLinkInfo()
+{
+    sptr<NetLinkInfo> info = (std::make_unique<NetLinkInfo>()).release();
+    info->ifaceName_ = TEST_IFACE;
+    info->domain_ = "example.com";
+    info->netAddrList_ = {MakeAddr(AF_INET, "192.0.2.2", 24), MakeAddr(AF_INET6, "2001:db8::2", 64)};
+    info->dnsList_ = {MakeAddr(AF_INET, "192.0.2.53"), MakeAddr(AF_INET6, "2001:db8::53")};
+    info->routeList_ = {MakeRoute("0.0.0.0", 0), MakeRoute("192.0.2.0", 24), MakeRoute("198.51.100.0", 24)};
+    info->mtu_ = TEST_MTU;
+    return info;
+}
+} // namespace
+
+class IpcBenchmarkTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+
+    template <typename Proxy>
+    static sptr<Proxy> MakeProxy(const sptr<IPCObjectStub> &service)
+    {
+        sptr<IRemoteObject> remote = (std::make_unique<IpcLoopbackRemoteObject>(service)).release();
+        return (std::make_unique<Proxy>(remote)).release();
+    }
+};
+
+void IpcBenchmarkTest::SetUpTestCase() {}
+
+void IpcBenchmarkTest::TearDownTestCase() {}
+
+void IpcBenchmarkTest::SetUp() {}
+
+void IpcBenchmarkTest::TearDown() {}
+
+/**
+ * @tc.name: IpcBenchmark001
+ * @tc.desc: Per call cost of every NetConnService code through proxy, loopback and stub
+ * @tc.type: PERF
+ */
+HWTEST_F(IpcBenchmarkTest, IpcBenchmark001, TestSize.Level2)
+{
+    sptr<FakeNetConnService> service = (std::make_unique<FakeNetConnService>()).release();
+    sptr<NetConnServiceProxy> proxy = MakeProxy<NetConnServiceProxy>(service);
+    sptr<INetConnCallback> callback = (std::make_unique<FakeNetConnCallback>()).release();
+    sptr<NetSpecifier> specifier = (std::make_unique<NetSpecifier>()).release();
+    specifier->ident_ = TEST_IFACE;
+    specifier->netType_ = NET_TYPE_ETHERNET;
+    specifier->netCapabilities_ = NET_CAPABILITIES_INTERNET;
+    sptr<NetSupplierInfo> supplierInfo = (std::make_unique<NetSupplierInfo>()).release();
+    supplierInfo->isAvailable_ = true;
+    sptr<NetLinkInfo> linkInfo = MakeLinkInfo();
+
+    RunCases("NetConnService", {
+        {"SystemReady", [&]() { proxy->SystemReady(); }},
+        {"RegisterNetSupplier",
+            [&]() { proxy->RegisterNetSupplier(NET_TYPE_ETHERNET, TEST_IFACE, NET_CAPABILITIES_INTERNET); }},
+        {"UnregisterNetSupplier", [&]() { proxy->UnregisterNetSupplier(SUPPLIER_ID); }},
+        {"RegisterNetConnCallback", [&]() { proxy->RegisterNetConnCallback(callback); }},
+        {"RegisterNetConnCallbackBySpec", [&]() { proxy->RegisterNetConnCallback(specifier, callback); }},
+        {"UnregisterNetConnCallback", [&]() { proxy->UnregisterNetConnCallback(callback); }},
+        {"UnregisterNetConnCallbackBySpec", [&]() { proxy->UnregisterNetConnCallback(specifier, callback); }},
+        {"UpdateNetSupplierInfo", [&]() { proxy->UpdateNetSupplierInfo(SUPPLIER_ID, supplierInfo); }},
+        {"UpdateNetCapabilities", [&]() { proxy->UpdateNetCapabilities(SUPPLIER_ID, NET_CAPABILITIES_INTERNET); }},
+        {"UpdateNetLinkInfo", [&]() { proxy->UpdateNetLinkInfo(SUPPLIER_ID, linkInfo); }},
+    });
+}
+
+/**
+ * @tc.name: IpcBenchmark002
+ * @tc.desc: Per call cost of every NetPolicyService code through proxy, loopback and stub
+ * @tc.type: PERF
+ */
+HWTEST_F(IpcBenchmarkTest, IpcBenchmark002, TestSize.Level2)
+{
+    sptr<FakeNetPolicyService> service = (std::make_unique<FakeNetPolicyService>()).release();
+    sptr<NetPolicyServiceProxy> proxy = MakeProxy<NetPolicyServiceProxy>(service);
+    std::vector<std::pair<uint32_t, NetUidPolicy>> uidPolicies;
+    for (uint32_t i = 0; i < POLICY_BATCH_SIZE; ++i) {
+        uidPolicies.emplace_back(TEST_UID + i, NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND);
+    }
+
+    RunCases("NetPolicyService", {
+        {"SetUidPolicy",
+            [&]() { proxy->SetUidPolicy(TEST_UID, NetUidPolicy::NET_POLICY_ALLOW_METERED_BACKGROUND); }},
+        {"SetUidPolicies", [&]() { proxy->SetUidPolicies(uidPolicies); }},
+        {"GetUidPolicy", [&]() { proxy->GetUidPolicy(TEST_UID); }},
+        {"GetUids", [&]() { proxy->GetUids(NetUidPolicy::NET_POLICY_ALLOW_METERED_BACKGROUND); }},
+        {"IsUidNetAccessMetered", [&]() { proxy->IsUidNetAccess(TEST_UID, true); }},
+        {"IsUidNetAccessIfaceName", [&]() { proxy->IsUidNetAccess(TEST_UID, TEST_IFACE); }},
+    });
+}
+
+/**
+ * @tc.name: IpcBenchmark003
+ * @tc.desc: Per call cost of every DnsResolverService code through proxy, loopback and stub
+ * @tc.type: PERF
+ */
+HWTEST_F(IpcBenchmarkTest, IpcBenchmark003, TestSize.Level2)
+{
+    sptr<FakeDnsResolverService> service = (std::make_unique<FakeDnsResolverService>()).release();
+    sptr<DnsResolverServiceProxy> proxy = MakeProxy<DnsResolverServiceProxy>(service);
+    sptr<IDnsResolverCallback> callback = (std::make_unique<FakeDnsResolverCallback>()).release();
+    sptr<DnsAddrInfo> hints = (std::make_unique<DnsAddrInfo>()).release();
+    hints->family_ = AF_UNSPEC;
+    hints->sockType_ = SOCK_STREAM;
+    const std::vector<std::string> servers = {"192.0.2.53", "2001:db8::53"};
+    const std::vector<std::string> domains = {"example.com"};
+    std::vector<std::string> hostNames;
+    for (uint32_t i = 0; i < BATCH_HOST_COUNT; ++i) {
+        hostNames.push_back("host" + std::to_string(i) + ".example.com");
+    }
+
+    RunCases("DnsResolverService", {
+        {"GetAddressesByName", [&]() {
+            std::vector<INetAddr> addrInfo;
+            proxy->GetAddressesByName(TEST_HOST, addrInfo);
+        }},
+        {"GetAddrInfo", [&]() {
+            std::vector<sptr<DnsAddrInfo>> dnsAddrInfo;
+            proxy->GetAddrInfo(TEST_HOST, "", hints, dnsAddrInfo);
+        }},
+        {"CreateNetworkCache", [&]() { proxy->CreateNetworkCache(TEST_NET_ID); }},
+        {"DestoryNetworkCache", [&]() { proxy->DestoryNetworkCache(TEST_NET_ID); }},
+        {"FlushNetworkCache", [&]() { proxy->FlushNetworkCache(TEST_NET_ID); }},
+        {"SetResolverConfig", [&]() {
+            proxy->SetResolverConfig(TEST_NET_ID, DNS_TIMEOUT_MSEC, DNS_RETRY_COUNT, servers, domains);
+        }},
+        {"GetResolverInfo", [&]() {
+            std::vector<std::string> outServers;
+            std::vector<std::string> outDomains;
+            uint16_t baseTimeoutMsec = 0;
+            uint8_t retryCount = 0;
+            proxy->GetResolverInfo(TEST_NET_ID, outServers, outDomains, baseTimeoutMsec, retryCount);
+        }},
+        {"GetAddressesByNames", [&]() {
+            std::vector<int32_t> results;
+            std::vector<std::vector<INetAddr>> addrInfos;
+            proxy->GetAddressesByNames(hostNames, results, addrInfos);
+        }},
+        {"GetAddressesByNameAsync", [&]() { proxy->GetAddressesByNameAsync(TEST_HOST, callback); }},
+        {"GetAddressesByNameDualStack", [&]() { proxy->GetAddressesByNameDualStack(TEST_HOST, callback); }},
+        {"GetResolverStats", [&]() {
+            std::vector<DnsServerStats> stats;
+            proxy->GetResolverStats(TEST_NET_ID, stats);
+        }},
+    });
+}
+
+/**
+ * @tc.name: IpcBenchmark004
+ * @tc.desc: Per call cost of every EthernetService code through proxy, loopback and stub
+ * @tc.type: PERF
+ */
+HWTEST_F(IpcBenchmarkTest, IpcBenchmark004, TestSize.Level2)
+{
+    sptr<FakeEthernetService> service = (std::make_unique<FakeEthernetService>()).release();
+    sptr<EthernetServiceProxy> proxy = MakeProxy<EthernetServiceProxy>(service);
+    sptr<InterfaceConfiguration> config = service->GetIfaceConfig(TEST_IFACE);
+
+    RunCases("EthernetService", {
+        {"SetIfaceConfig", [&]() { proxy->SetIfaceConfig(TEST_IFACE, config); }},
+        {"GetIfaceConfig", [&]() { proxy->GetIfaceConfig(TEST_IFACE); }},
+        {"IsActivate", [&]() { proxy->IsActivate(TEST_IFACE); }},
+        {"GetActivateInterfaces", [&]() { proxy->GetActivateInterfaces(); }},
+    });
+}
+
+/**
+ * @tc.name: IpcBenchmark005
+ * @tc.desc: Handler lookup of the stub dispatch table against the std::map the stubs used before
+ * @tc.type: PERF
+ */
+HWTEST_F(IpcBenchmarkTest, IpcBenchmark005, TestSize.Level2)
+{
+    std::map<uint32_t, DispatchBenchStub::DispatchTable::Handler> handlerMap;
+    for (uint32_t code = 0; code < DISPATCH_CODE_COUNT; ++code) {
+        handlerMap[code] = DispatchBenchStub::GetDispatchTable().Find(code);
+    }
+    /* One code in every DISPATCH_CODE_COUNT + 1 has no handler, as an unknown request would */
+    int64_t mapNs = TimeLookups([&handlerMap](uint32_t code) {
+        auto it = handlerMap.find(code);
+        return it != handlerMap.end() && it->second != nullptr;
+    });
+    int64_t tableNs = TimeLookups([](uint32_t code) {
+        return DispatchBenchStub::GetDispatchTable().Find(code) != nullptr;
+    });
+    std::cout << "Dispatch lookup of " << DISPATCH_CODE_COUNT << " codes, " << DISPATCH_LOOKUPS
+              << " lookups: std::map " << mapNs / DISPATCH_LOOKUPS << "." << mapNs * 10 / DISPATCH_LOOKUPS % 10
+              << "ns, table " << tableNs / DISPATCH_LOOKUPS << "." << tableNs * 10 / DISPATCH_LOOKUPS % 10
+              << "ns per lookup" << std::endl;
+    testing::Test::RecordProperty("Dispatch.map_ns_per_1000", static_cast<int>(mapNs * 1000 / DISPATCH_LOOKUPS));
+    testing::Test::RecordProperty("Dispatch.table_ns_per_1000", static_cast<int>(tableNs * 1000 / DISPATCH_LOOKUPS));
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ipc_loopback_remote_object.h"
+
+#include <chrono>
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+thread_local std::array<int64_t, MARK_COUNT> g_marks = {};
+
+int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+void IpcBenchClock::Reset()
+{
+    g_marks.fill(0);
+}
+
+void IpcBenchClock::Mark(IpcBenchMark mark)
+{
+    g_marks[mark] = NowNs();
+}
+
+int64_t IpcBenchClock::Get(IpcBenchMark mark)
+{
+    return g_marks[mark];
+}
+
+int64_t IpcBenchClock::Span(IpcBenchMark from, IpcBenchMark to)
+{
+    if (g_marks[from] == 0 || g_marks[to] == 0) {
+        return -1;
+    }
+    return g_marks[to] - g_marks[from];
+}
+
+IpcBenchServiceScope::IpcBenchServiceScope()
+{
+    IpcBenchClock::Mark(MARK_SERVICE_ENTER);
+}
+
+IpcBenchServiceScope::~IpcBenchServiceScope()
+{
+    IpcBenchClock::Mark(MARK_SERVICE_LEAVE);
+}
+
+IpcLoopbackRemoteObject::IpcLoopbackRemoteObject(const sptr<IPCObjectStub> &stub) : stub_(stub) {}
+
+int IpcLoopbackRemoteObject::SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply,
+    MessageOption &option)
+{
+    IpcBenchClock::Mark(MARK_SEND);
+    int ret = stub_->OnRemoteRequest(code, data, reply, option);
+    IpcBenchClock::Mark(MARK_RETURN);
+    return ret;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IPC_LOOPBACK_REMOTE_OBJECT_H
+#define IPC_LOOPBACK_REMOTE_OBJECT_H
+
+#include <array>
+#include <cstdint>
+
+#include "ipc_object_stub.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/* Points of one call, in the order a loopback call passes them */
+enum IpcBenchMark {
+    MARK_CALL = 0,
+    MARK_SEND,
+    MARK_SERVICE_ENTER,
+    MARK_SERVICE_LEAVE,
+    MARK_RETURN,
+    MARK_DONE,
+    MARK_COUNT,
+};
+
+/**
+ * Timestamps of the call running on this thread, in nanoseconds of the steady clock. The loopback object marks the
+ * send and the return, the fake services mark their entry and exit, so the spans between the marks are the proxy
+ * marshalling, the stub descriptor check, memberFuncMap_ lookup and argument unmarshalling, the reply marshalling and
+ * the proxy unmarshalling.
+ */
+class IpcBenchClock {
+public:
+    static void Reset();
+    static void Mark(IpcBenchMark mark);
+    static int64_t Get(IpcBenchMark mark);
+
+    /**
+     * @brief Get the time between two marks of the last call
+     *
+     * @return The span in nanoseconds, -1 if the call did not pass one of the marks
+     */
+    static int64_t Span(IpcBenchMark from, IpcBenchMark to);
+};
+
+/* Marks entry and exit of a fake service method */
+class IpcBenchServiceScope {
+public:
+    IpcBenchServiceScope();
+    ~IpcBenchServiceScope();
+};
+
+/**
+ * In-process stand-in for the binder driver. Requests go straight to the wrapped stub on the caller's parcels, as the
+ * IPC framework does for a local object, so the measured cost is the marshalling and dispatch of this repository and
+ * not the kernel transaction.
+ */
+class IpcLoopbackRemoteObject : public IPCObjectStub {
+public:
+    explicit IpcLoopbackRemoteObject(const sptr<IPCObjectStub> &stub);
+    ~IpcLoopbackRemoteObject() = default;
+
+    int SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override;
+
+private:
+    sptr<IPCObjectStub> stub_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // IPC_LOOPBACK_REMOTE_OBJECT_H